@@ -37,6 +37,7 @@ class PGate;
 class PGenerate;
 class PModport;
 class PSpecPath;
+class PTimingCheck;
 class PTask;
 class PFunction;
 class PWire;
@@ -135,6 +136,7 @@ class Module : public PScopeExtra, public PNamedItem {
       map<perm_string,PModport*> modports;
 
       list<PSpecPath*> specify_paths;
+      list<PTimingCheck*> timing_checks;
 
 	// The mod_name() is the name of the module type.
       perm_string mod_name() const { return pscope_name(); }
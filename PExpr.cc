@@ -28,6 +28,7 @@
 # include  "Module.h"
 # include  "netmisc.h"
 # include  "util.h"
+# include  "ObjectHeap.h"
 # include  <typeinfo>
 
 PExpr::PExpr()
@@ -42,6 +43,18 @@ PExpr::~PExpr()
 {
 }
 
+static ObjectHeap pexpr_heap ("PExpr");
+
+void* PExpr::operator new(size_t size)
+{
+      return pexpr_heap.alloc(size);
+}
+
+void PExpr::operator delete(void*ptr, size_t size)
+{
+      pexpr_heap.free(ptr, size);
+}
+
 void PExpr::declare_implicit_nets(LexicalScope*, NetNet::Type)
 {
 }
@@ -60,6 +60,10 @@ class PExpr : public LineInfo {
       PExpr();
       virtual ~PExpr();
 
+	// Expressions are allocated from a pool (see ObjectHeap.h).
+      static void* operator new(size_t size);
+      static void operator delete(void*ptr, size_t size);
+
       virtual void dump(ostream&) const;
 
         // This method tests whether the expression contains any identifiers
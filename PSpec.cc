@@ -18,6 +18,7 @@
  */
 
 # include  "PSpec.h"
+# include  "PExpr.h"
 
 PSpecPath::PSpecPath(unsigned src_cnt, unsigned dst_cnt, char polarity,
                      bool full_flag)
@@ -32,3 +33,23 @@ PSpecPath::PSpecPath(unsigned src_cnt, unsigned dst_cnt, char polarity,
 PSpecPath::~PSpecPath()
 {
 }
+
+PTimingCheck::event_t::~event_t()
+{
+      delete expr;
+      delete condition;
+}
+
+PTimingCheck::PTimingCheck(check_t t, event_t*r, event_t*d,
+			   PExpr*l1, PExpr*l2, perm_string n)
+: type(t), ref(r), data(d), limit1(l1), limit2(l2), notifier(n)
+{
+}
+
+PTimingCheck::~PTimingCheck()
+{
+      delete ref;
+      delete data;
+      delete limit1;
+      delete limit2;
+}
@@ -84,4 +84,58 @@ class PSpecPath  : public LineInfo {
       std::vector<class PExpr*>delays;
 };
 
+/*
+* The PTimingCheck is the parse of a $setup, $hold, $setuphold,
+* $recovery, $width or $period timing check. The parser normalizes the
+* argument order so that "ref" is always the reference (clock-like)
+* event and "data" is the data event. The $width and $period checks
+* have no data event.
+*
+* The edge of an event is a mask of the transitions that trigger it,
+* using the vpiEdge encoding of vpi_user.h. A z in an edge descriptor
+* is treated like an x. An event without an edge triggers on any
+* transition.
+*
+* The limit1 is the main limit of the check. The limit2 is the hold
+* limit of a $setuphold and the threshold of a $width, and is nil
+* otherwise. The notifier is the name of a reg in the module, or nil.
+*/
+class PTimingCheck  : public LineInfo {
+
+    public:
+      enum check_t { SETUP, HOLD, SETUPHOLD, RECOVERY, WIDTH, PERIOD };
+
+      enum { EDGE_01 = 0x01, EDGE_10 = 0x02, EDGE_0X = 0x04,
+	     EDGE_X1 = 0x08, EDGE_1X = 0x10, EDGE_X0 = 0x20,
+	     EDGE_POS = EDGE_01|EDGE_0X|EDGE_X1,
+	     EDGE_NEG = EDGE_10|EDGE_1X|EDGE_X0,
+	     EDGE_ANY = EDGE_POS|EDGE_NEG };
+
+      struct event_t {
+	    event_t() : edge(EDGE_ANY), expr(0), condition(0) { }
+	    ~event_t();
+	    unsigned edge;
+	    class PExpr*expr;
+	      // The &&& condition, if present.
+	    class PExpr*condition;
+      };
+
+      PTimingCheck(check_t type, event_t*ref, event_t*data,
+		   class PExpr*limit1, class PExpr*limit2,
+		   perm_string notifier);
+      ~PTimingCheck();
+
+      void elaborate(class Design*des, class NetScope*scope) const;
+
+      void dump(std::ostream&out, unsigned ind) const;
+
+    public:
+      check_t type;
+      event_t*ref;
+      event_t*data;
+      class PExpr*limit1;
+      class PExpr*limit2;
+      perm_string notifier;
+};
+
 #endif /* IVL_PSpec_H */
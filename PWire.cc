@@ -20,8 +20,21 @@
 # include "config.h"
 # include  "PWire.h"
 # include  "PExpr.h"
+# include  "ObjectHeap.h"
 # include  <cassert>
 
+static ObjectHeap pwire_heap ("PWire");
+
+void* PWire::operator new(size_t size)
+{
+      return pwire_heap.alloc(size);
+}
+
+void PWire::operator delete(void*ptr, size_t size)
+{
+      pwire_heap.free(ptr, size);
+}
+
 PWire::PWire(perm_string n,
 	     NetNet::Type t,
 	     NetNet::PortType pt,
@@ -59,6 +59,10 @@ class PWire : public PNamedItem {
 	    NetNet::PortType pt,
 	    ivl_variable_type_t dt);
 
+	// Wires are allocated from a pool (see ObjectHeap.h).
+      static void* operator new(size_t size);
+      static void operator delete(void*ptr, size_t size);
+
 	// Return a hierarchical name.
       perm_string basename() const;
 
@@ -22,11 +22,24 @@
 # include  "Statement.h"
 # include  "PExpr.h"
 # include  "ivl_assert.h"
+# include  "ObjectHeap.h"
 
 Statement::~Statement()
 {
 }
 
+static ObjectHeap statement_heap ("Statement");
+
+void* Statement::operator new(size_t size)
+{
+      return statement_heap.alloc(size);
+}
+
+void Statement::operator delete(void*ptr, size_t size)
+{
+      statement_heap.free(ptr, size);
+}
+
 PAssign_::PAssign_(PExpr*lval__, PExpr*ex, bool is_constant)
 : event_(0), count_(0), lval_(lval__), rval_(ex), is_constant_(is_constant)
 {
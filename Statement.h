@@ -81,6 +81,10 @@ class Statement : virtual public LineInfo {
       Statement() { }
       virtual ~Statement() =0;
 
+	// Statements are allocated from a pool (see ObjectHeap.h).
+      static void* operator new(size_t size);
+      static void operator delete(void*ptr, size_t size);
+
       virtual void dump(ostream&out, unsigned ind) const;
       virtual NetProc* elaborate(Design*des, NetScope*scope) const;
       virtual void elaborate_scope(Design*des, NetScope*scope) const;
@@ -429,6 +433,9 @@ class PEventStatement  : public Statement {
 
       bool has_aa_term(Design*des, NetScope*scope);
 
+	// Return true if this is a plain @* (not always_comb/latch).
+      bool is_star() const { return expr_.count() == 0 && !always_sens_; }
+
 	// This method is used to elaborate, but attach a previously
 	// elaborated statement to the event.
       NetProc* elaborate_st(Design*des, NetScope*scope, NetProc*st) const;
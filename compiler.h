@@ -140,6 +140,16 @@ extern bool disable_virtual_pins;
  * LPM objects so this flag is used to block them from being generated. */
 extern bool disable_concatz_generation;
 
+/* Targets that only look at part of the design (the null, sizer and
+ * blif targets, for example) set this flag so that the statements of
+ * processes and task/function definitions are converted to the
+ * ivl_target form only when the target first asks for them. The rest
+ * are converted after the target is done, so that their errors are
+ * still reported, and are freed again at once. Errors found that way
+ * make the compile fail, but the target has already run by then, so
+ * any output it wrote is left in place. */
+extern bool lazy_target_statements;
+
 /* Limit to size of devirtualized arrays */
 extern unsigned long array_size_limit;
 
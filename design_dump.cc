@@ -373,6 +373,23 @@ void NetDelaySrc::dump(ostream&o, unsigned ind) const
       dump_node_pins(o, ind+4);
 }
 
+void NetTimingCheck::dump(ostream&o, unsigned ind) const
+{
+      static const char*names[] = { "$setup", "$hold", "$setuphold",
+				    "$recovery", "$width", "$period" };
+
+      o << setw(ind) << "" << "timing check " << names[type_]
+	<< " ref_edge=0x" << hex << ref_edge_;
+      if (has_data())
+	    o << " data_edge=0x" << data_edge_;
+      o << dec << " limits=(" << limits_[0] << "," << limits_[1] << ")";
+      if (notifier_)
+	    o << " notifier=" << notifier_->name();
+      o << " scope=" << scope_path(scope())
+	<< " // " << get_fileline() << endl;
+      dump_node_pins(o, ind+4);
+}
+
 static inline ostream&operator<<(ostream&out, const netrange_t&that)
 {
       if (that.defined())
@@ -1276,6 +1293,12 @@ void NetEvProbe::dump_node(ostream&o, unsigned ind) const
       }
       o << setw(ind) << "" << "-> " << event_->name() << "; " << endl;
       dump_node_pins(o, ind+4);
+      for (unsigned idx = 0 ;  idx < pin_count() ;  idx += 1) {
+	    if (part_wid(idx) == 0)
+		  continue;
+	    o << setw(ind+4) << "" << "pin " << idx << " watches ["
+	      << part_base(idx) << " +: " << part_wid(idx) << "]" << endl;
+      }
       dump_obj_attr(o, ind+4);
 }
 
@@ -1561,6 +1584,9 @@ void NetScope::dump(ostream&o) const
 	    cur->second->dump_net(o, 4);
       }
 
+      for (unsigned idx = 0 ;  idx < timing_checks_.size() ;  idx += 1)
+	    timing_checks_[idx]->dump(o, 4);
+
       switch (type_) {
 	  case FUNC:
 	    if (func_def())
@@ -4423,38 +4423,15 @@ NetProc* PEventStatement::elaborate_st(Design*des, NetScope*scope,
 					   ev, NetEvProbe::ANYEDGE,
 					   nset->size());
 	    for (unsigned idx = 0 ;  idx < nset->size() ;  idx += 1) {
+		  unsigned base = nset->at(idx).base;
 		  unsigned wid = nset->at(idx).wid;
 		  unsigned vwid = nset->at(idx).lnk.nexus()->vector_width();
-		    // Is this a part select?
-		  if (always_sens_ && (wid != vwid)) {
-			cerr << get_fileline() << ": sorry: constant "
-			        "selects in always_* processes are not "
-			        "currently supported (all bits will be "
-			        "included)." << endl;
-# if 0
-			unsigned base = nset->at(idx).base;
-cerr << get_fileline() << ": base = " << base << endl;
-// FIXME: make this work with selects that go before the base.
-			assert(base < vwid);
-			if (base + wid > vwid) wid = vwid - base;
-cerr << get_fileline() << ": base = " << base << ", width = " << wid
-     << ", expr width = " << vwid << endl;
-nset->at(idx).lnk.dump_link(cerr, 4);
-cerr << endl;
-// FIXME: Convert the link to the appropriate NetNet
-			netvector_t*tmp_vec = new netvector_t(IVL_VT_BOOL, vwid, 0);
-			NetNet*sig = new NetNet(scope, scope->local_symbol(), NetNet::IMPLICIT, tmp_vec);
-			NetPartSelect*tmp = new NetPartSelect(sig, base, wid, NetPartSelect::VP);
-			des->add_node(tmp);
-			tmp->set_line(*this);
-// FIXME: create a part select to get the correct bits to connect.
-			connect(tmp->pin(1), nset->at(idx).lnk);
-			connect(tmp->pin(0), pr->pin(idx));
-# endif
-			connect(nset->at(idx).lnk, pr->pin(idx));
-		  } else {
-			connect(nset->at(idx).lnk, pr->pin(idx));
-		  }
+		  connect(nset->at(idx).lnk, pr->pin(idx));
+		    // An always_* process is only sensitive to the bits
+		    // of a constant select, so only watch those.
+		  if (always_sens_ && (wid < vwid) && (base < vwid)
+		      && (wid <= vwid - base))
+			pr->set_part(idx, base, wid);
 	    }
 
 	    delete nset;
@@ -5573,6 +5550,306 @@ NetProc* PWhile::elaborate(Design*des, NetScope*scope) const
       return loop;
 }
 
+/*
+ * These test that a statement in an @* process does nothing but
+ * compute and assign values, so that splitting the process does not
+ * change the order or the number of times that anything else runs.
+ */
+static bool split_pure_expr(const NetExpr*expr)
+{
+      if (expr == 0)
+	    return true;
+
+      if (dynamic_cast<const NetEConst*>(expr))
+	    return true;
+      if (dynamic_cast<const NetECReal*>(expr))
+	    return true;
+      if (const NetESignal*sig = dynamic_cast<const NetESignal*>(expr))
+	    return split_pure_expr(sig->word_index());
+      if (const NetESelect*sel = dynamic_cast<const NetESelect*>(expr))
+	    return split_pure_expr(sel->sub_expr())
+		  && split_pure_expr(sel->select());
+      if (const NetEUnary*uni = dynamic_cast<const NetEUnary*>(expr))
+	    return split_pure_expr(uni->expr());
+      if (const NetEBinary*bin = dynamic_cast<const NetEBinary*>(expr))
+	    return split_pure_expr(bin->left())
+		  && split_pure_expr(bin->right());
+      if (const NetETernary*ter = dynamic_cast<const NetETernary*>(expr))
+	    return split_pure_expr(ter->cond_expr())
+		  && split_pure_expr(ter->true_expr())
+		  && split_pure_expr(ter->false_expr());
+      if (const NetEConcat*cat = dynamic_cast<const NetEConcat*>(expr)) {
+	    for (unsigned idx = 0 ;  idx < cat->nparms() ;  idx += 1) {
+		  if (! split_pure_expr(cat->parm(idx)))
+			return false;
+	    }
+	    return true;
+      }
+
+	// Function calls and anything else may have side effects.
+      return false;
+}
+
+static bool split_pure_proc(const NetProc*proc)
+{
+      if (proc == 0)
+	    return true;
+
+      if (const NetAssign*asn = dynamic_cast<const NetAssign*>(proc)) {
+	    if (asn->get_delay())
+		  return false;
+	    for (unsigned idx = 0 ;  idx < asn->l_val_count() ;  idx += 1) {
+		  const NetAssign_*lv = asn->l_val(idx);
+		  if (lv->sig() == 0 || lv->nest() || ! lv->get_property().nil())
+			return false;
+		  if (! split_pure_expr(lv->word()) ||
+		      ! split_pure_expr(lv->get_base()))
+			return false;
+		    // NetAssign_::nex_output adds nothing for a variable
+		    // word select, so the dependencies of the statement
+		    // cannot be known. Do not split such a block.
+		  long word;
+		  if (lv->word() && ! eval_as_long(word, lv->word()))
+			return false;
+	    }
+	    return split_pure_expr(asn->rval());
+      }
+
+      if (const NetCondit*con = dynamic_cast<const NetCondit*>(proc)) {
+	    NetCondit*tmp = const_cast<NetCondit*>(con);
+	    return split_pure_expr(con->expr())
+		  && split_pure_proc(tmp->if_clause())
+		  && split_pure_proc(tmp->else_clause());
+      }
+
+      if (const NetCase*cas = dynamic_cast<const NetCase*>(proc)) {
+	    if (! split_pure_expr(cas->expr()))
+		  return false;
+	    for (unsigned idx = 0 ;  idx < cas->nitems() ;  idx += 1) {
+		  if (! split_pure_expr(cas->expr(idx)) ||
+		      ! split_pure_proc(cas->stat(idx)))
+			return false;
+	    }
+	    return true;
+      }
+
+      if (const NetBlock*blk = dynamic_cast<const NetBlock*>(proc)) {
+	    if (blk->type() != NetBlock::SEQU || blk->subscope())
+		  return false;
+	    for (const NetProc*cur = blk->proc_first() ; cur
+		       ; cur = blk->proc_next(cur)) {
+		  if (! split_pure_proc(cur))
+			return false;
+	    }
+	    return true;
+      }
+
+      return false;
+}
+
+/*
+ * Two statements depend on each other if they touch the same nexus
+ * at all. This ignores the parts, so it may find dependencies that
+ * are not really there, but never misses one.
+ */
+static bool split_overlap(NexusSet&a, NexusSet&b)
+{
+      for (unsigned adx = 0 ;  adx < a.size() ;  adx += 1) {
+	    const Nexus*nex = a[adx].lnk.nexus();
+	    for (unsigned bdx = 0 ;  bdx < b.size() ;  bdx += 1) {
+		  if (b[bdx].lnk.nexus() == nex)
+			return true;
+	    }
+      }
+      return false;
+}
+
+static unsigned split_find(vector<unsigned>&group, unsigned idx)
+{
+      while (group[idx] != idx) {
+	    group[idx] = group[group[idx]];
+	    idx = group[idx];
+      }
+      return idx;
+}
+
+/*
+ * The input sets of the statements and groups are only used to split
+ * the process, so get them without the "@* is sensitive to all ..."
+ * warnings. The sensitivity of the original process already printed
+ * them once.
+ */
+static NexusSet* split_nex_input(const NetProc*proc)
+{
+      bool save_vec = warn_sens_entire_vec;
+      bool save_arr = warn_sens_entire_arr;
+      warn_sens_entire_vec = false;
+      warn_sens_entire_arr = false;
+      NexusSet*res = proc->nex_input(false);
+      warn_sens_entire_vec = save_vec;
+      warn_sens_entire_arr = save_arr;
+      return res;
+}
+
+static void split_star_probe(Design*des, NetScope*scope, NetEvent*ev,
+			     NexusSet*nset)
+{
+      NetEvProbe*pr = new NetEvProbe(scope, scope->local_symbol(),
+				     ev, NetEvProbe::ANYEDGE,
+				     nset->size());
+      for (unsigned idx = 0 ;  idx < nset->size() ;  idx += 1)
+	    connect(nset->at(idx).lnk, pr->pin(idx));
+      des->add_node(pr);
+}
+
+/*
+ * An always @* process runs all of its statements again when any of
+ * its inputs change. If the statements of its block fall into groups
+ * that share no variables, then each group is made into a process of
+ * its own that is only sensitive to its own inputs. A large decoder
+ * then only runs the part that an input change can affect.
+ */
+static void split_always_star(Design*des, NetScope*scope, NetProcTop*top)
+{
+      extern bool synthesis; /* Synthesis flag from main.cc */
+      if (synthesis)
+	    return;
+
+      NetEvWait*wa = dynamic_cast<NetEvWait*>(top->statement());
+      if (wa == 0 || wa->nevents() != 1)
+	    return;
+
+      NetEvent*ev = wa->event(0);
+      if (ev->nprobe() != 1 || ev->nwait() != 1)
+	    return;
+
+      NetBlock*blk = dynamic_cast<NetBlock*>(wa->statement());
+      if (blk == 0 || blk->type() != NetBlock::SEQU || blk->subscope())
+	    return;
+
+      vector<NetProc*> stmts;
+      for (const NetProc*cur = blk->proc_first() ; cur
+		 ; cur = blk->proc_next(cur)) {
+	    if (! split_pure_proc(cur))
+		  return;
+	    stmts.push_back(const_cast<NetProc*>(cur));
+      }
+
+      if (stmts.size() < 2)
+	    return;
+
+	/* Group the statements that read or write what another
+	   statement writes. */
+      vector<NexusSet*> ins (stmts.size());
+      vector<NexusSet*> outs (stmts.size());
+      vector<unsigned> group (stmts.size());
+      for (unsigned idx = 0 ;  idx < stmts.size() ;  idx += 1) {
+	    ins[idx] = split_nex_input(stmts[idx]);
+	    outs[idx] = new NexusSet;
+	    stmts[idx]->nex_output(*outs[idx]);
+	    group[idx] = idx;
+      }
+
+      for (unsigned idx = 0 ;  idx < stmts.size() ;  idx += 1) {
+	    for (unsigned jdx = idx+1 ;  jdx < stmts.size() ;  jdx += 1) {
+		  if (split_overlap(*outs[idx], *outs[jdx]) ||
+		      split_overlap(*outs[idx], *ins[jdx]) ||
+		      split_overlap(*ins[idx], *outs[jdx]))
+			group[split_find(group, jdx)] = split_find(group, idx);
+	    }
+      }
+
+      for (unsigned idx = 0 ;  idx < stmts.size() ;  idx += 1) {
+	    delete ins[idx];
+	    delete outs[idx];
+      }
+
+	/* Put the statements of each group in a block of its own,
+	   keeping the original order. */
+      map<unsigned,NetBlock*> blocks;
+      vector<NetBlock*> block_list;
+      for (unsigned idx = 0 ;  idx < stmts.size() ;  idx += 1) {
+	    unsigned root = split_find(group, idx);
+	    if (blocks.find(root) == blocks.end()) {
+		  NetBlock*tmp = new NetBlock(NetBlock::SEQU, 0);
+		  tmp->set_line(*blk);
+		  blocks[root] = tmp;
+		  block_list.push_back(tmp);
+	    }
+      }
+
+      if (block_list.size() < 2) {
+	    for (unsigned idx = 0 ;  idx < block_list.size() ;  idx += 1)
+		  delete block_list[idx];
+	    return;
+      }
+
+      while (blk->proc_remove_first()) { }
+      for (unsigned idx = 0 ;  idx < stmts.size() ;  idx += 1)
+	    blocks[split_find(group, idx)]->append(stmts[idx]);
+
+	/* A group with no inputs (constant assignments) runs every
+	   time any input of the original process changes. No split
+	   process has that sensitivity, so leave the process whole. */
+      vector<NexusSet*> sens;
+      bool all_sens = true;
+      for (unsigned idx = 0 ;  idx < block_list.size() ;  idx += 1) {
+	    sens.push_back(split_nex_input(block_list[idx]));
+	    if (sens[idx]->size() == 0)
+		  all_sens = false;
+      }
+
+      if (! all_sens) {
+	    for (unsigned idx = 0 ;  idx < block_list.size() ;  idx += 1) {
+		  while (block_list[idx]->proc_remove_first()) { }
+		  delete block_list[idx];
+		  delete sens[idx];
+	    }
+	    for (unsigned idx = 0 ;  idx < stmts.size() ;  idx += 1)
+		  blk->append(stmts[idx]);
+	    return;
+      }
+
+	/* The first group keeps the original process, and the other
+	   groups get new processes. */
+      for (unsigned idx = 0 ;  idx < block_list.size() ;  idx += 1) {
+	    NetBlock*cur = block_list[idx];
+	    if (idx == 0) {
+		  while (NetProc*tmp = cur->proc_remove_first())
+			blk->append(tmp);
+		  delete cur;
+
+		  delete ev->probe(0);
+		  split_star_probe(des, scope, ev, sens[idx]);
+		  delete sens[idx];
+		  continue;
+	    }
+
+	    NetEvent*nev = new NetEvent(scope->local_symbol());
+	    nev->set_line(*ev);
+	    nev->local_flag(true);
+	    scope->add_event(nev);
+	    split_star_probe(des, scope, nev, sens[idx]);
+	    delete sens[idx];
+
+	    NetEvWait*nwa = new NetEvWait(cur);
+	    nwa->set_line(*wa);
+	    nwa->add_event(nev);
+
+	    NetProcTop*ntop = new NetProcTop(scope, top->type(), nwa);
+	    for (unsigned adx = 0 ;  adx < top->attr_cnt() ;  adx += 1)
+		  ntop->attribute(top->attr_key(adx), top->attr_value(adx));
+	    ntop->set_line(*top);
+	    des->add_process(ntop);
+      }
+
+      if (debug_elaborate) {
+	    cerr << top->get_fileline() << ": split_always_star: "
+		 << "Split @* process into " << block_list.size()
+		 << " processes." << endl;
+      }
+}
+
 bool PProcess::elaborate(Design*des, NetScope*scope) const
 {
       scope->in_final(type() == IVL_PR_FINAL);
@@ -5640,6 +5917,13 @@ bool PProcess::elaborate(Design*des, NetScope*scope) const
 			   verinum(1));
       } while (0);
 
+      if (type() == IVL_PR_ALWAYS) {
+	    const PEventStatement*pev
+		  = dynamic_cast<const PEventStatement*>(statement_);
+	    if (pev && pev->is_star())
+		  split_always_star(des, scope, top);
+      }
+
       return true;
 }
 
@@ -5867,6 +6151,200 @@ void PSpecPath::elaborate(Design*des, NetScope*scope) const
       }
 }
 
+/*
+ * The signals of a timing check event must be simple scalar signal
+ * names in the module. Other terms were ignored before timing checks
+ * were supported, so for them print a warning and skip the check
+ * instead of failing the compile of existing cell libraries.
+ */
+static NetNet* elaborate_tchk_signal(Design*des, NetScope*scope,
+				     const LineInfo&li, const PExpr*expr)
+{
+      const PEIdent*id = dynamic_cast<const PEIdent*>(expr);
+      if (id == 0 || id->path().size() != 1
+	  || !id->path().back().index.empty()) {
+	    cerr << li.get_fileline() << ": warning: Timing check events "
+		 << "must be simple signal names (" << *expr << "). "
+		 << "The check is ignored." << endl;
+	    return 0;
+      }
+
+      perm_string name = peek_tail_name(id->path());
+      NetNet*sig = scope->find_signal(name);
+      if (sig == 0) {
+	    cerr << li.get_fileline() << ": error: No wire '"
+		 << name << "' in this module." << endl;
+	    des->errors += 1;
+	    return 0;
+      }
+
+      if (sig->vector_width() != 1) {
+	    cerr << li.get_fileline() << ": warning: Timing check events "
+		 << "on vectors are not supported (" << name << "). "
+		 << "The check is ignored." << endl;
+	    return 0;
+      }
+
+      return sig;
+}
+
+static NetNet* elaborate_tchk_condition(Design*des, NetScope*scope,
+					PExpr*condition)
+{
+      NetExpr*tmp = elab_and_eval(des, scope, condition, -1);
+      if (tmp == 0)
+	    return 0;
+
+      NetNet*sig = tmp->synthesize(des, scope, tmp);
+      ivl_assert(*condition, sig);
+      return sig;
+}
+
+/*
+ * A negative limit is only meaningful to the negative timing check
+ * algorithm of $setuphold and $recrem, which needs the delayed
+ * signals. They are not driven, so a negative limit is clamped to 0
+ * with a warning and the check runs with the non-negative window.
+ */
+static uint64_t elaborate_tchk_limit(Design*des, NetScope*scope,
+				     const LineInfo&li, PExpr*limit)
+{
+      NetExpr*cur = elab_and_eval(des, scope, limit, -1);
+      if (cur == 0)
+	    return 0;
+
+      uint64_t res = 0;
+      if (NetEConst*con = dynamic_cast<NetEConst*> (cur)) {
+	    verinum fn = con->value();
+	    if (fn.is_negative()) {
+		  cerr << li.get_fileline() << ": warning: Negative timing "
+		       << "check limit " << *cur << " is treated as 0." << endl;
+	    } else {
+		  res = des->scale_to_precision(fn.as_ulong64(), scope);
+	    }
+
+      } else if (NetECReal*rcon = dynamic_cast<NetECReal*>(cur)) {
+	    if (rcon->value().as_double() < 0.0) {
+		  cerr << li.get_fileline() << ": warning: Negative timing "
+		       << "check limit " << *cur << " is treated as 0." << endl;
+	    } else {
+		  res = get_scaled_time_from_real(des, scope, rcon);
+	    }
+
+      } else {
+	    cerr << li.get_fileline() << ": error: Timing check limit "
+		 << "must be constant (" << *cur << ")." << endl;
+	    des->errors += 1;
+      }
+
+      delete cur;
+      return res;
+}
+
+void PTimingCheck::elaborate(Design*des, NetScope*scope) const
+{
+	/* Timing checks go with the specify blocks. */
+      if (!gn_specify_blocks_flag) return;
+
+      ivl_tchk_type_t tchk_type = IVL_TCHK_SETUP;
+      switch (type) {
+	  case SETUP:
+	    tchk_type = IVL_TCHK_SETUP;
+	    break;
+	  case HOLD:
+	    tchk_type = IVL_TCHK_HOLD;
+	    break;
+	  case SETUPHOLD:
+	    tchk_type = IVL_TCHK_SETUPHOLD;
+	    break;
+	  case RECOVERY:
+	    tchk_type = IVL_TCHK_RECOVERY;
+	    break;
+	  case WIDTH:
+	    tchk_type = IVL_TCHK_WIDTH;
+	    break;
+	  case PERIOD:
+	    tchk_type = IVL_TCHK_PERIOD;
+	    break;
+      }
+
+	/* The $width and $period checks measure from one edge of the
+	   reference to the next, so they need an edge to start. */
+      if ((type == WIDTH || type == PERIOD) && ref->edge == EDGE_ANY) {
+	    cerr << get_fileline() << ": warning: The reference event of a "
+		 << (type == WIDTH ? "$width" : "$period")
+		 << " timing check must be an edge. "
+		 << "The check is ignored." << endl;
+	    return;
+      }
+
+      NetNet*ref_sig = elaborate_tchk_signal(des, scope, *this, ref->expr);
+      NetNet*data_sig = 0;
+      if (data)
+	    data_sig = elaborate_tchk_signal(des, scope, *this, data->expr);
+
+      if (ref_sig == 0 || (data && data_sig == 0))
+	    return;
+
+      uint64_t limits[2];
+      limits[0] = elaborate_tchk_limit(des, scope, *this, limit1);
+      limits[1] = 0;
+      if (limit2)
+	    limits[1] = elaborate_tchk_limit(des, scope, *this, limit2);
+
+      NetNet*notifier_sig = 0;
+      if (! notifier.nil()) {
+	    notifier_sig = scope->find_signal(notifier);
+	    if (notifier_sig == 0) {
+		  cerr << get_fileline() << ": error: No reg '"
+		       << notifier << "' in this module for the timing "
+		       << "check notifier." << endl;
+		  des->errors += 1;
+		  return;
+	    }
+	    if (notifier_sig->type() != NetNet::REG) {
+		  cerr << get_fileline() << ": error: The timing check "
+		       << "notifier " << notifier << " must be a reg." << endl;
+		  des->errors += 1;
+		  return;
+	    }
+      }
+
+      NetTimingCheck*tchk = new NetTimingCheck(scope, scope->local_symbol(),
+					       tchk_type);
+      tchk->set_line(*this);
+      tchk->set_limits(limits[0], limits[1]);
+      tchk->set_notifier(notifier_sig);
+
+      tchk->set_ref_edge(ref->edge);
+      connect(ref_sig->pin(0), tchk->ref_pin());
+      if (ref->condition) {
+	    if (NetNet*cond = elaborate_tchk_condition(des, scope,
+						       ref->condition))
+		  connect(cond->pin(0), tchk->ref_cond_pin());
+      }
+
+      if (data) {
+	    tchk->set_data_edge(data->edge);
+	    connect(data_sig->pin(0), tchk->data_pin());
+	    if (data->condition) {
+		  if (NetNet*cond = elaborate_tchk_condition(des, scope,
+							     data->condition))
+			connect(cond->pin(0), tchk->data_cond_pin());
+	    }
+      }
+
+      if (debug_elaborate) {
+	    cerr << get_fileline() << ": debug: Timing check on "
+		 << ref_sig->name();
+	    if (data_sig)
+		  cerr << " and " << data_sig->name();
+	    cerr << " limits " << limits[0] << "," << limits[1] << endl;
+      }
+
+      scope->add_timing_check(tchk);
+}
+
 static void elaborate_functions(Design*des, NetScope*scope,
 				const map<perm_string,PFunction*>&funcs)
 {
@@ -5987,6 +6465,12 @@ bool Module::elaborate(Design*des, NetScope*scope) const
 	    (*sp)->elaborate(des, scope);
       }
 
+      for (list<PTimingCheck*>::const_iterator tc = timing_checks.begin()
+		 ; tc != timing_checks.end() ; ++ tc ) {
+
+	    (*tc)->elaborate(des, scope);
+      }
+
       return result_flag;
 }
 
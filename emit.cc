@@ -459,6 +459,9 @@ void NetScope::emit_scope(struct target_t*tgt) const
 	    tgt->signal_paths(cur->second);
       }
 
+      for (unsigned idx = 0 ;  idx < timing_checks_.size() ;  idx += 1)
+	    tgt->timing_check(timing_checks_[idx]);
+
       if (type_ == MODULE) tgt->convert_module_ports(this);
 }
 
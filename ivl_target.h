@@ -191,6 +191,7 @@ typedef struct ivl_scope_s    *ivl_scope_t;
 typedef struct ivl_signal_s   *ivl_signal_t;
 typedef struct ivl_port_info_s*ivl_port_info_t;
 typedef struct ivl_switch_s   *ivl_switch_t;
+typedef struct ivl_tchk_s     *ivl_tchk_t;
 typedef struct ivl_memory_s   *ivl_memory_t; //XXXX __attribute__((deprecated));
 typedef struct ivl_statement_s*ivl_statement_t;
 typedef const _CLASS ivl_type_s*ivl_type_t;
@@ -353,6 +354,16 @@ typedef enum ivl_path_edge_e {
       IVL_PE_COUNT
 } ivl_path_edge_t;
 
+/* This is the kind of a specify block timing check. */
+typedef enum ivl_tchk_type_e {
+      IVL_TCHK_SETUP     = 0,
+      IVL_TCHK_HOLD      = 1,
+      IVL_TCHK_SETUPHOLD = 2,
+      IVL_TCHK_RECOVERY  = 3,
+      IVL_TCHK_WIDTH     = 4,
+      IVL_TCHK_PERIOD    = 5
+} ivl_tchk_type_t;
+
 /* Processes are initial, always, or final blocks with a statement. This is
    the type of the ivl_process_t object. */
 typedef enum ivl_process_type_e ENUM_UNSIGNED_INT {
@@ -544,6 +555,59 @@ extern int ivl_path_is_parallel(ivl_delaypath_t obj);
 extern int ivl_path_source_posedge(ivl_delaypath_t obj);
 extern int ivl_path_source_negedge(ivl_delaypath_t obj);
 
+/* TIMING CHECK
+ * Timing check objects represent the $setup, $hold, $setuphold,
+ * $recovery, $width and $period checks of a specify block. The scope
+ * of the specify block holds the checks (see ivl_scope_tchk).
+ *
+ * ivl_tchk_scope
+ *    This returns the scope of the specify block of the check.
+ *
+ * ivl_tchk_type
+ *    This returns the kind of the check.
+ *
+ * ivl_tchk_file
+ * ivl_tchk_lineno
+ *    The source location of the check, for use in violation messages.
+ *
+ * ivl_tchk_ref
+ * ivl_tchk_ref_edge
+ * ivl_tchk_ref_cond
+ *    The reference event of the check is a transition of the ref
+ *    nexus that matches the edge mask. The mask uses the vpiEdge
+ *    encoding of vpi_user.h. The ref_cond is the nexus of the &&&
+ *    condition of the event, or nil if the event has no condition.
+ *
+ * ivl_tchk_data
+ * ivl_tchk_data_edge
+ * ivl_tchk_data_cond
+ *    These describe the data event in the same way. The $width and
+ *    $period checks have no data event, and ivl_tchk_data returns nil
+ *    for them.
+ *
+ * ivl_tchk_limit
+ *    Limit 0 is the limit of the check, or the setup limit of a
+ *    $setuphold. Limit 1 is the hold limit of a $setuphold or the
+ *    threshold of a $width, and 0 for the other checks. The limits
+ *    are in the units of the design precision, like path delays.
+ *
+ * ivl_tchk_notifier
+ *    This is the reg that the check toggles for each violation, or
+ *    nil if the check has no notifier.
+ */
+extern ivl_scope_t ivl_tchk_scope(ivl_tchk_t net);
+extern ivl_tchk_type_t ivl_tchk_type(ivl_tchk_t net);
+extern const char* ivl_tchk_file(ivl_tchk_t net);
+extern unsigned ivl_tchk_lineno(ivl_tchk_t net);
+extern ivl_nexus_t ivl_tchk_ref(ivl_tchk_t net);
+extern unsigned ivl_tchk_ref_edge(ivl_tchk_t net);
+extern ivl_nexus_t ivl_tchk_ref_cond(ivl_tchk_t net);
+extern ivl_nexus_t ivl_tchk_data(ivl_tchk_t net);
+extern unsigned ivl_tchk_data_edge(ivl_tchk_t net);
+extern ivl_nexus_t ivl_tchk_data_cond(ivl_tchk_t net);
+extern uint64_t ivl_tchk_limit(ivl_tchk_t net, unsigned idx);
+extern ivl_signal_t ivl_tchk_notifier(ivl_tchk_t net);
+
 /* DESIGN
  * When handed a design (ivl_design_t) there are a few things that you
  * can do with it. The Verilog program has one design that carries the
@@ -760,6 +824,15 @@ extern unsigned ivl_enum_lineno(ivl_enumtype_t net);
  * type of edge to be watched for on that node. For example, nodes to
  * be watched for positive edges are accessed via the ivl_event_npos
  * and ivl_event_pos functions.
+ *
+ * ivl_event_any_base
+ * ivl_event_any_width
+ *    An any edge node may be watched for changes in only a part of
+ *    its vector, for example when an always_comb or always_latch
+ *    process only reads a constant select of a signal. (A plain @*
+ *    always watches the whole vector.) These return the canonical
+ *    base and the width of the watched part. A width of 0 means the
+ *    whole vector.
  */
 extern const char* ivl_event_name(ivl_event_t net);
 extern const char* ivl_event_basename(ivl_event_t net);
@@ -767,6 +840,8 @@ extern ivl_scope_t ivl_event_scope(ivl_event_t net);
 
 extern unsigned    ivl_event_nany(ivl_event_t net);
 extern ivl_nexus_t ivl_event_any(ivl_event_t net, unsigned idx);
+extern unsigned    ivl_event_any_base(ivl_event_t net, unsigned idx);
+extern unsigned    ivl_event_any_width(ivl_event_t net, unsigned idx);
 
 extern unsigned    ivl_event_nneg(ivl_event_t net);
 extern ivl_nexus_t ivl_event_neg(ivl_event_t net, unsigned idx);
@@ -1831,6 +1906,11 @@ extern unsigned    ivl_parameter_lineno(ivl_parameter_t net);
  *    anything that can become and ivl_signal_t, include synthetic
  *    signals generated by the compiler.
  *
+ * ivl_scope_tchk
+ * ivl_scope_tchks
+ *    Module scopes have 0 or more timing checks from their specify
+ *    blocks.
+ *
  * ivl_scope_time_precision
  *    Scopes have their own intrinsic time precision, typically from
  *    the timescale compiler directive. This method returns the
@@ -1893,6 +1973,8 @@ extern unsigned     ivl_scope_sigs(ivl_scope_t net);
 extern ivl_signal_t ivl_scope_sig(ivl_scope_t net, unsigned idx);
 extern unsigned     ivl_scope_switches(ivl_scope_t net);
 extern ivl_switch_t ivl_scope_switch(ivl_scope_t net, unsigned idx);
+extern unsigned     ivl_scope_tchks(ivl_scope_t net);
+extern ivl_tchk_t   ivl_scope_tchk(ivl_scope_t net, unsigned idx);
 extern ivl_scope_type_t ivl_scope_type(ivl_scope_t net);
 extern const char*  ivl_scope_tname(ivl_scope_t net);
 extern int          ivl_scope_time_precision(ivl_scope_t net);
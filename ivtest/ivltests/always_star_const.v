@@ -0,0 +1,33 @@
+// An always @* block whose statements use different inputs is split
+// into a process for each group. A constant assignment in the block
+// must still run when any of the inputs change.
+module top;
+   reg a, b;
+   reg c, y, z;
+
+   always @* begin
+      c = 1'b1;
+      y = a;
+      z = b;
+   end
+
+   reg pass;
+
+   initial begin
+      pass = 1'b1;
+
+      #1 b = 1'b0;
+      #1 if (c !== 1'b1 || z !== 1'b0 || y !== 1'bx) begin
+	 $display("FAILED: c=%b, y=%b, z=%b (expected 1, x, 0)", c, y, z);
+	 pass = 1'b0;
+      end
+
+      a = 1'b1;
+      #1 if (y !== 1'b1 || z !== 1'b0) begin
+	 $display("FAILED: y=%b, z=%b (expected 1, 0)", y, z);
+	 pass = 1'b0;
+      end
+
+      if (pass) $display("PASSED");
+   end
+endmodule
@@ -0,0 +1,67 @@
+// VPI handles for the words of a variable array are made a page of 256
+// words at a time, as they are asked for. This reaches words on both
+// sides of page boundaries, the last word of a large memory, the words
+// of a short array and of an array that does not start at 0, through
+// $readmemh, $writememh and $sformat.
+module top;
+   reg [15:0] mem [0:99999];
+   reg [15:0] copy [0:99999];
+   reg [7:0] tiny [0:9];
+   reg [7:0] off [1000:1600];
+   reg [8*16:1] str;
+   integer idx, fd;
+   reg pass;
+
+   task fail(input [8*32:1] what);
+      begin
+	 $display("FAILED: %0s", what);
+	 pass = 1'b0;
+      end
+   endtask
+
+   initial begin
+      pass = 1'b1;
+
+      for (idx = 0 ; idx < 100000 ; idx = idx + 1)
+	 mem[idx] = idx ^ 16'h5a5a;
+
+      $writememh("work/array_pages.hex", mem, 250, 520);
+      $readmemh("work/array_pages.hex", copy, 250, 520);
+      for (idx = 250 ; idx <= 520 ; idx = idx + 1)
+	 if (copy[idx] !== mem[idx]) begin
+	    $display("FAILED: copy[%0d]=%h (expected %h)",
+		     idx, copy[idx], mem[idx]);
+	    pass = 1'b0;
+	 end
+      if (copy[249] !== 16'bx || copy[521] !== 16'bx)
+	 fail("$readmemh wrote outside its range");
+
+	// Load single words with $readmemh address records.
+      fd = $fopen("work/array_pages.dat", "w");
+      $fdisplay(fd, "@ff 0255 0256 @1869f cafe");
+      $fclose(fd);
+      $readmemh("work/array_pages.dat", mem);
+      if (mem[255] !== 16'h0255 || mem[256] !== 16'h0256 ||
+	  mem[99999] !== 16'hcafe || mem[257] !== (257 ^ 16'h5a5a))
+	 fail("$readmemh words");
+
+      $sformat(str, "%h %h", mem[0], mem[99999]);
+      if (str != "5a5a cafe") fail("$sformat");
+
+      fd = $fopen("work/array_pages.dat", "w");
+      $fdisplay(fd, "@9 99 @0 11");
+      $fclose(fd);
+      $readmemh("work/array_pages.dat", tiny);
+      if (tiny[9] !== 8'h99 || tiny[0] !== 8'h11 || tiny[5] !== 8'bx)
+	 fail("tiny array");
+
+      fd = $fopen("work/array_pages.dat", "w");
+      $fdisplay(fd, "@3e8 01 @4e8 02 @640 03");
+      $fclose(fd);
+      $readmemh("work/array_pages.dat", off);
+      if (off[1000] !== 8'h01 || off[1256] !== 8'h02 || off[1600] !== 8'h03)
+	 fail("offset array");
+
+      if (pass) $display("PASSED");
+   end
+endmodule
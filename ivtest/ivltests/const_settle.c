@@ -0,0 +1,110 @@
+/*
+ * VPI routines for the const_settle test.
+ *
+ * $const_settle_watch(net, value) puts a value change callback on a
+ * net that is driven only by constants. The constants settle before
+ * time 0, but the callback must still run at time 0, after the
+ * StartOfSim callbacks, and see the settled value. The call itself,
+ * after time 0, checks that the callback ran that way, once.
+ */
+# include  <vpi_user.h>
+
+static int start_of_sim_done = 0;
+static int changes = 0;
+static int errors = 0;
+
+static PLI_INT32 start_of_sim(p_cb_data cb)
+{
+      (void)cb;  /* Parameter is not used. */
+      start_of_sim_done = 1;
+      return 0;
+}
+
+static PLI_INT32 value_change(p_cb_data cb)
+{
+      PLI_INT32 want = (PLI_INT32)(long)cb->user_data;
+
+      if (! start_of_sim_done) {
+	    vpi_printf("FAILED: value change before StartOfSim\n");
+	    errors += 1;
+      }
+      if (cb->time->low != 0 || cb->time->high != 0) {
+	    vpi_printf("FAILED: value change at time %u\n",
+		       (unsigned)cb->time->low);
+	    errors += 1;
+      }
+      if (cb->value->value.integer != want) {
+	    vpi_printf("FAILED: value change to %d (expected %d)\n",
+		       (int)cb->value->value.integer, (int)want);
+	    errors += 1;
+      }
+      changes += 1;
+      return 0;
+}
+
+static PLI_INT32 watch_compiletf(PLI_BYTE8*data)
+{
+      vpiHandle sys = vpi_handle(vpiSysTfCall, 0);
+      vpiHandle argv = vpi_iterate(vpiArgument, sys);
+      vpiHandle net = vpi_scan(argv);
+      vpiHandle arg = vpi_scan(argv);
+      s_vpi_value want;
+      static s_vpi_time cb_time = { vpiSimTime, 0, 0, 0.0 };
+      static s_vpi_value cb_value = { vpiIntVal, { 0 } };
+      s_cb_data cb;
+
+      (void)data;  /* Parameter is not used. */
+
+      vpi_free_object(argv);
+
+      want.format = vpiIntVal;
+      vpi_get_value(arg, &want);
+
+      cb.reason = cbValueChange;
+      cb.cb_rtn = value_change;
+      cb.obj = net;
+      cb.time = &cb_time;
+      cb.value = &cb_value;
+      cb.index = 0;
+      cb.user_data = (PLI_BYTE8*)(long)want.value.integer;
+      vpi_register_cb(&cb);
+      return 0;
+}
+
+static PLI_INT32 watch_calltf(PLI_BYTE8*data)
+{
+      (void)data;  /* Parameter is not used. */
+
+      if (changes != 1) {
+	    vpi_printf("FAILED: %d value changes (expected 1)\n", changes);
+	    errors += 1;
+      }
+      vpi_printf("$const_settle_watch: %d errors\n", errors);
+      return 0;
+}
+
+static void const_settle_register(void)
+{
+      s_vpi_systf_data tf_data;
+      s_cb_data cb;
+
+      tf_data.type = vpiSysTask;
+      tf_data.sysfunctype = 0;
+      tf_data.tfname = "$const_settle_watch";
+      tf_data.calltf = watch_calltf;
+      tf_data.compiletf = watch_compiletf;
+      tf_data.sizetf = 0;
+      tf_data.user_data = 0;
+      vpi_register_systf(&tf_data);
+
+      cb.reason = cbStartOfSimulation;
+      cb.cb_rtn = start_of_sim;
+      cb.obj = 0;
+      cb.time = 0;
+      cb.value = 0;
+      cb.index = 0;
+      cb.user_data = 0;
+      vpi_register_cb(&cb);
+}
+
+void (*vlog_startup_routines[])(void) = { &const_settle_register, 0 };
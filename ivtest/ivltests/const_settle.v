@@ -0,0 +1,67 @@
+// Logic driven only by constants settles before time 0, so the first
+// threads already see the settled values. Processes that wait on an
+// edge of a constant-driven net still see that edge at time 0, and so
+// do the VPI value change callbacks, after the StartOfSim callbacks.
+// The nets can still be forced and released.
+module top;
+   wire en = ~1'b0;
+   wire [7:0] sum = 8'h0f + 8'h01;
+   wire chain_a, chain_b, chain_c;
+   wire ws;
+
+   and g1 (chain_a, 1'b1, 1'b1);
+   not g2 (chain_b, chain_a);
+   xor g3 (chain_c, chain_a, chain_b);
+
+   assign (weak1, weak0) ws = 1'b1;
+   assign ws = 1'b0;
+
+   integer posedges, sum_changes;
+   initial begin
+      posedges = 0;
+      sum_changes = 0;
+   end
+
+   always @(posedge en) posedges = posedges + 1;
+   always @(sum) sum_changes = sum_changes + 1;
+
+   reg pass;
+
+   task fail(input [8*32:1] what);
+      begin
+	 $display("FAILED: %0s", what);
+	 pass = 1'b0;
+      end
+   endtask
+
+   initial begin
+      pass = 1'b1;
+
+	// These run at time 0, before any time 0 events.
+      if (en !== 1'b1) fail("en is not settled");
+      if (sum !== 8'h10) fail("sum is not settled");
+      if (chain_a !== 1'b1 || chain_b !== 1'b0 || chain_c !== 1'b1)
+	 fail("gate chain is not settled");
+      if (ws !== 1'b0) fail("strength is not resolved");
+
+      #1;
+      if (posedges !== 1) begin
+	 $display("FAILED: %0d time 0 edges of en (expected 1)", posedges);
+	 pass = 1'b0;
+      end
+      if (sum_changes !== 1) begin
+	 $display("FAILED: %0d time 0 changes of sum (expected 1)",
+		  sum_changes);
+	 pass = 1'b0;
+      end
+      $const_settle_watch(sum, 8'h10);
+
+      force en = 1'b0;
+      #1 if (en !== 1'b0) fail("force");
+      release en;
+      #1 if (en !== 1'b1) fail("release");
+      if (posedges !== 2) fail("edge after the release");
+
+      if (pass) $display("PASSED");
+   end
+endmodule
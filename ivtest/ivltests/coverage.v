@@ -0,0 +1,127 @@
+// vvp -c collects toggle and statement coverage for a scope and merges
+// it into the coverage database at the end of the run. The test runs
+// twice with +phase to fill the database, then once with +check to
+// read the database back and check the merged counts.
+module cnt;
+   reg [3:0] q;
+   integer i, hits, missed;
+
+   initial begin
+      q = 4'b0000;
+      hits = 0;
+      if ($test$plusargs("phase")) begin
+	 #1 q = 4'b0101;
+	 #1 q = 4'b0000;
+	 for (i = 0 ; i < 3 ; i = i + 1)
+	    hits = hits + 1;
+      end else begin
+	 missed = 1;
+      end
+   end
+endmodule
+
+module top;
+   // These are the lines of the counted statements in cnt.
+   localparam HIT_LINE = 16;
+   localparam MISS_LINE = 18;
+
+   cnt dut ();
+
+   integer fd, count, idx, wid, lineno;
+   reg [63:0] toggles, hits, rise, fall;
+   reg [8*64:1] name;
+   reg found_q, found_hit, found_miss, pass;
+
+   function [63:0] get_u(input integer nbytes);
+      integer k;
+      reg [63:0] ch;
+      begin
+	 get_u = 0;
+	 for (k = 0 ; k < nbytes ; k = k + 1) begin
+	    ch = $fgetc(fd) & 255;
+	    get_u = get_u | (ch << 8*k);
+	 end
+      end
+   endfunction
+
+   task get_str;
+      integer len, k;
+      begin
+	 len = get_u(4);
+	 name = 0;
+	 for (k = 0 ; k < len ; k = k + 1)
+	    name = (name << 8) | ($fgetc(fd) & 255);
+      end
+   endtask
+
+   initial if ($test$plusargs("check")) begin
+      pass = 1'b1;
+      found_q = 1'b0;
+      found_hit = 1'b0;
+      found_miss = 1'b0;
+
+      fd = $fopen("work/coverage.cov", "rb");
+      if (fd == 0) begin
+	 $display("FAILED: the coverage database was not written");
+	 $finish;
+      end
+
+      name = 0;
+      for (idx = 0 ; idx < 8 ; idx = idx + 1)
+	 name = (name << 8) | ($fgetc(fd) & 255);
+      if (name != "VVPCOV2\n") begin
+	 $display("FAILED: bad database magic");
+	 $finish;
+      end
+
+      count = get_u(4);
+      for (idx = 0 ; idx < count ; idx = idx + 1) begin
+	 get_str;
+	 wid = get_u(4);
+	 toggles = get_u(8);
+	 rise = get_u((wid+7)/8);
+	 fall = get_u((wid+7)/8);
+	 if (name == "top.dut.q") begin
+	    found_q = 1'b1;
+	    if (wid != 4 || toggles != 8 || rise != 5 || fall != 5) begin
+	       $display("FAILED: q wid=%0d, toggles=%0d, rise=%h, fall=%h",
+			wid, toggles, rise, fall);
+	       $display("        (expected 4, 8, 05, 05)");
+	       pass = 1'b0;
+	    end
+	 end
+      end
+
+      count = get_u(4);
+      for (idx = 0 ; idx < count ; idx = idx + 1) begin
+	 get_str;
+	 lineno = get_u(4);
+	 hits = get_u(8);
+	 if (name == `__FILE__ && lineno == HIT_LINE) begin
+	    found_hit = 1'b1;
+	    if (hits != 6) begin
+	       $display("FAILED: line %0d has %0d hits (expected 6)",
+			lineno, hits);
+	       pass = 1'b0;
+	    end
+	 end
+	 if (name == `__FILE__ && lineno == MISS_LINE) begin
+	    found_miss = 1'b1;
+	    if (hits != 0) begin
+	       $display("FAILED: line %0d has %0d hits (expected 0)",
+			lineno, hits);
+	       pass = 1'b0;
+	    end
+	 end
+      end
+      $fclose(fd);
+
+      if (!found_q || !found_hit || !found_miss) begin
+	 $display("FAILED: missing records (q=%b, line %0d=%b, line %0d=%b)",
+		  found_q, HIT_LINE, found_hit, MISS_LINE, found_miss);
+	 pass = 1'b0;
+      end
+
+      if (pass) $display("PASSED");
+   end
+endmodule
@@ -0,0 +1,30 @@
+// vvp -R merges coverage databases and prints a report. The test runs
+// once with +a and once with +b, each into its own database, then
+// merges the two with -R. The report is checked against the gold file:
+// the statements and branch directions that only one run covered are
+// covered in the merged database.
+module dut;
+   reg [1:0] q;
+   reg never;
+   reg [1:0] n;
+
+   initial begin
+      q = 2'b00;
+      never = 1'b0;
+      n = 0;
+      #1;
+      if ($test$plusargs("a")) begin
+	 q = 2'b11;
+	 n = n + 1;
+      end else begin
+	 q = 2'b01;
+      end
+      #1 q = 2'b00;
+      if (n > 2)
+	 never = 1'b1;
+   end
+endmodule
+
+module top;
+   dut dut ();
+endmodule
@@ -0,0 +1,76 @@
+// A +dumpctl file selects the signals to dump with include and exclude
+// patterns, and turns the dump off outside its time window.
+module top;
+   reg [3:0] da, db, dx, other;
+
+   initial begin
+      da = 0;
+      db = 0;
+      dx = 0;
+      other = 0;
+      forever #1 begin
+	 da = da + 1;
+	 db = db + 1;
+	 dx = dx + 1;
+	 other = other + 1;
+      end
+   end
+endmodule
+
+// The checker is a separate root module so that it is not dumped.
+module check;
+   reg [8*16:1] kind, id, name;
+   integer fd, code, size, t, nvars, in_window;
+   reg [8*80:1] line;
+   reg pass;
+
+   initial begin
+      pass = 1'b1;
+      $dumpfile("work/dump_ctl.vcd");
+      $dumpvars(0, top);
+
+      #30 $dumpflush;
+
+      fd = $fopen("work/dump_ctl.vcd", "r");
+      if (fd == 0) begin
+	 $display("FAILED: the dump file was not written");
+	 $finish;
+      end
+
+      nvars = 0;
+      in_window = 0;
+      while (! $feof(fd)) begin
+	 line = 0;
+	 code = $fgets(line, fd);
+	 if ($sscanf(line, "$var %s %d %s %s", kind, size, id, name) == 4)
+	 begin
+	    nvars = nvars + 1;
+	    if (name != "da" && name != "db") begin
+	       $display("FAILED: %0s was dumped", name);
+	       pass = 1'b0;
+	    end
+	 end else if ($sscanf(line, "#%d", t) == 1) begin
+	    if (t > 10 && t < 20)
+	       in_window = in_window + 1;
+	    else if (t != 0 && t != 10 && t != 20) begin
+	       $display("FAILED: values dumped at time %0d", t);
+	       pass = 1'b0;
+	    end
+	 end
+      end
+      $fclose(fd);
+
+      if (nvars != 2) begin
+	 $display("FAILED: %0d signals dumped (expected 2)", nvars);
+	 pass = 1'b0;
+      end
+      if (in_window != 9) begin
+	 $display("FAILED: %0d time steps in the window (expected 9)",
+		  in_window);
+	 pass = 1'b0;
+      end
+
+      if (pass) $display("PASSED");
+      $finish;
+   end
+endmodule
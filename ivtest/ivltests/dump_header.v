@@ -0,0 +1,101 @@
+// The $dumpvars header lists the items of each scope grouped by type
+// (events, nets, variables, then the sub-scopes) in scope order. A
+// signal that was dumped explicitly is not listed again, and signals
+// that share a nexus share a VCD identifier.
+module sub(input in);
+   reg s;
+endmodule
+
+module top;
+   reg r;
+   integer n;
+   wire w;
+   event e;
+
+   initial begin : blk
+      reg b;
+      b = 1'b0;
+      n = 0;
+      -> e;
+   end
+
+   sub u (w);
+endmodule
+
+// The checker is a separate root module so that it is not dumped.
+module check;
+   reg [8*16:1] exp [0:16];
+   reg [8*16:1] kind, name, id, id_w, id_in, id_s, tok;
+   integer fd, code, size, idx;
+   reg [8*80:1] line;
+   reg pass;
+
+   initial begin
+      exp[0] = "top";  exp[1] = "u";    exp[2] = "s";   exp[3] = "}";
+      exp[4] = "}";    exp[5] = "top";  exp[6] = "e";   exp[7] = "w";
+      exp[8] = "r";    exp[9] = "n";    exp[10] = "u";  exp[11] = "in";
+      exp[12] = "}";   exp[13] = "blk"; exp[14] = "b";  exp[15] = "}";
+      exp[16] = "}";
+
+      pass = 1'b1;
+      $dumpfile("work/dump_header.vcd");
+      $dumpvars(0, top.u.s);
+      $dumpvars(0, top);
+      $dumpvars(1, top.r);
+
+      #1 $dumpflush;
+
+      fd = $fopen("work/dump_header.vcd", "r");
+      if (fd == 0) begin
+	 $display("FAILED: the dump file was not written");
+	 $finish;
+      end
+
+      idx = 0;
+      while (! $feof(fd)) begin
+	 line = 0;
+	 code = $fgets(line, fd);
+	 tok = 0;
+	 if ($sscanf(line, "$scope %s %s", kind, name) == 2) begin
+	    tok = name;
+	 end else if ($sscanf(line, "$var %s %d %s %s", kind, size, id,
+			      name) == 4) begin
+	    tok = name;
+	    if (name == "w") id_w = id;
+	    if (name == "in") id_in = id;
+	    if (name == "s") id_s = id;
+	 end else if ($sscanf(line, "$upscope %s", kind) == 1) begin
+	    tok = "}";
+	 end
+
+	 if (tok != 0) begin
+	    if (idx > 16) begin
+	       $display("FAILED: extra header item %0s", tok);
+	       pass = 1'b0;
+	    end else if (tok != exp[idx]) begin
+	       $display("FAILED: header item %0d is %0s (expected %0s)",
+			idx, tok, exp[idx]);
+	       pass = 1'b0;
+	    end
+	    idx = idx + 1;
+	 end
+      end
+      $fclose(fd);
+
+      if (idx != 17) begin
+	 $display("FAILED: %0d header items (expected 17)", idx);
+	 pass = 1'b0;
+      end
+      if (id_in !== id_w) begin
+	 $display("FAILED: u.in is %0s, but w is %0s", id_in, id_w);
+	 pass = 1'b0;
+      end
+      if (id_s === id_w) begin
+	 $display("FAILED: u.s and w are both %0s", id_s);
+	 pass = 1'b0;
+      end
+
+      if (pass) $display("PASSED");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,60 @@
+// The flight recorder dumper (vvp -ring) keeps the value changes in a
+// ring of compressed blocks. With a small $dumplimit the oldest blocks
+// are dropped, and $dumpflush_window writes a VCD file that starts at
+// a $dumpall checkpoint and runs up to the current time.
+module top;
+   reg [31:0] count;
+
+   integer fd, code, t, first, last, dumpall;
+   reg [8*64:1] line;
+   reg pass;
+
+   initial begin
+      pass = 1'b1;
+      $dumplimit(1);
+      $dumpvars(0, top);
+
+      for (count = 0 ; count < 100000 ; count = count + 1)
+	 #1;
+
+      $dumpflush_window("work/dump_ring.vcd");
+
+      fd = $fopen("work/dump_ring.vcd", "r");
+      if (fd == 0) begin
+	 $display("FAILED: the window file was not written");
+	 $finish;
+      end
+
+      first = -1;
+      last = -1;
+      dumpall = 0;
+      while (! $feof(fd)) begin
+	 line = 0;
+	 code = $fgets(line, fd);
+	 if ($sscanf(line, "#%d", t) == 1) begin
+	    if (first < 0) first = t;
+	    last = t;
+	 end
+	 if (line == "$dumpall\n") dumpall = dumpall + 1;
+      end
+      $fclose(fd);
+
+      if (first <= 0) begin
+	 $display("FAILED: the window starts at %0d, the old blocks were kept",
+		  first);
+	 pass = 1'b0;
+      end
+      if (dumpall == 0) begin
+	 $display("FAILED: the window does not start at a checkpoint");
+	 pass = 1'b0;
+      end
+      if (last != $time) begin
+	 $display("FAILED: the window ends at %0d (expected %0d)",
+		  last, $time);
+	 pass = 1'b0;
+      end
+
+      if (pass) $display("PASSED");
+      $finish;
+   end
+endmodule
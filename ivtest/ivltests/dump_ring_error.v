@@ -0,0 +1,62 @@
+// The flight recorder dumper (vvp -ring) writes its window when $error
+// is called, not when the simulation finishes. A second $error in the
+// same time step does not write another window, and a later one
+// writes the next numbered file.
+module top;
+   reg [31:0] count;
+
+   integer fd, code, t, last;
+   reg [8*64:1] line;
+   reg pass;
+
+   task check_window(input [8*40:1] name, input integer when);
+      begin
+	 fd = $fopen(name, "r");
+	 if (fd == 0) begin
+	    $display("FAILED: %0s was not written", name);
+	    pass = 1'b0;
+	 end else begin
+	    last = -1;
+	    while (! $feof(fd)) begin
+	       line = 0;
+	       code = $fgets(line, fd);
+	       if ($sscanf(line, "#%d", t) == 1) last = t;
+	    end
+	    $fclose(fd);
+	    if (last != when) begin
+	       $display("FAILED: %0s ends at %0d (expected %0d)",
+			name, last, when);
+	       pass = 1'b0;
+	    end
+	 end
+      end
+   endtask
+
+   initial begin
+      pass = 1'b1;
+      $dumpfile("work/dump_ring_error.vcd");
+      $dumpvars(0, top);
+
+      for (count = 0 ; count < 50 ; count = count + 1)
+	 #1;
+      $error("first error");
+      $error("second error in the same time step");
+
+      for (count = 50 ; count < 80 ; count = count + 1)
+	 #1;
+      check_window("work/dump_ring_error.vcd", 50);
+
+      fd = $fopen("work/dump_ring_error.vcd.1", "r");
+      if (fd != 0) begin
+	 $display("FAILED: the second error wrote a window");
+	 $fclose(fd);
+	 pass = 1'b0;
+      end
+
+      $error("third error");
+      check_window("work/dump_ring_error.vcd.1", 80);
+
+      if (pass) $display("PASSED");
+      $finish;
+   end
+endmodule
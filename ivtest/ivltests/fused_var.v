@@ -0,0 +1,78 @@
+// Static variables are built as one fused object that holds the net,
+// the functor and the filter. Writes, part writes, force, release and
+// procedural assign/deassign must behave as before for narrow and wide
+// variables, and the values must reach the nets and events that
+// depend on them.
+module top;
+   reg r1;
+   reg [31:0] r32;
+   reg [64:0] r65;
+   reg [199:0] r200;
+   reg signed [15:0] rs;
+
+   wire [64:0] w65 = r65;
+   wire [199:0] w200 = ~r200;
+
+   integer changes;
+   initial changes = 0;
+   always @(r200) changes = changes + 1;
+
+   reg pass;
+
+   task fail(input [8*32:1] what);
+      begin
+	 $display("FAILED: %0s", what);
+	 pass = 1'b0;
+      end
+   endtask
+
+   initial begin
+      pass = 1'b1;
+
+      #1 if (r1 !== 1'bx || r32 !== 32'bx || r200 !== 200'bx)
+	 fail("initial value");
+
+      r1 = 1'b1;
+      r32 = 32'hdead_beef;
+      r65 = {1'b1, 64'h0123_4567_89ab_cdef};
+      r200 = {200{1'b1}};
+      rs = -16'sd2;
+      #1;
+      if (r1 !== 1'b1 || r32 !== 32'hdead_beef) fail("narrow write");
+      if (w65 !== {1'b1, 64'h0123_4567_89ab_cdef}) fail("wide write");
+      if (w200 !== 200'b0) fail("wide net");
+      if (rs >>> 1 !== -16'sd1) fail("signed value");
+
+      r65[63:60] = 4'h5;
+      r200[150 +: 8] = 8'h00;
+      #1;
+      if (w65 !== {1'b1, 64'h5123_4567_89ab_cdef}) fail("part write");
+      if (w200[157:150] !== 8'hff || w200[149:0] !== 150'b0)
+	 fail("wide part write");
+
+      force r32 = 32'h1234_5678;
+      r32 = 32'h0;
+      #1 if (r32 !== 32'h1234_5678) fail("force");
+      release r32;
+      #1 if (r32 !== 32'h1234_5678) fail("release keeps the value");
+      r32 = 32'h0;
+      #1 if (r32 !== 32'h0) fail("write after release");
+
+      force r65[64:32] = 33'h0;
+      #1 if (w65 !== {33'h0, 32'h89ab_cdef}) fail("part force");
+      release r65[64:32];
+      r65 = 65'h1;
+      #1 if (w65 !== 65'h1) fail("write after part release");
+
+      assign r200 = 200'h5;
+      r200 = 200'h0;
+      #1 if (r200 !== 200'h5 || w200 !== ~200'h5) fail("assign");
+      deassign r200;
+      r200 = 200'h6;
+      #1 if (r200 !== 200'h6) fail("write after deassign");
+
+      if (changes !== 4) fail("events on r200");
+
+      if (pass) $display("PASSED");
+   end
+endmodule
@@ -0,0 +1,94 @@
+// vvp keeps the code of each basic block packed until a thread first
+// runs it. This runs code with many kinds of operands for the first
+// time at different points of the simulation: large and negative
+// immediates, real constants, strings, jumps into loops and case
+// items, recursive automatic functions, tasks that are only called
+// late, fork/join and disable.
+module top;
+   reg [63:0] big;
+   reg signed [31:0] neg;
+   real r;
+   reg [8*8:1] str;
+   integer idx, sum, sel, res;
+   reg pass;
+
+   function automatic integer fact(input integer n);
+      if (n <= 1) fact = 1;
+      else fact = n * fact(n - 1);
+   endfunction
+
+   function [7:0] swap(input [7:0] v);
+      swap = {v[3:0], v[7:4]};
+   endfunction
+
+   wire [7:0] swapped = swap(big[7:0]);
+
+   task late_task(output integer out);
+      begin : body
+	 out = 0;
+	 for (idx = 0 ; idx < 100 ; idx = idx + 1) begin
+	    if (idx == 10) disable body;
+	    out = out + idx;
+	 end
+      end
+   endtask
+
+   task never_called;
+      $display("FAILED: never_called ran");
+   endtask
+
+   task check(input integer got, input integer exp, input [8*16:1] what);
+      if (got !== exp) begin
+	 $display("FAILED: %0s is %0d (expected %0d)", what, got, exp);
+	 pass = 1'b0;
+      end
+   endtask
+
+   initial begin
+      pass = 1'b1;
+
+      big = 64'hfedc_ba98_7654_3210;
+      neg = -123456789;
+      r = 1.5e-300;
+      str = "packed";
+      #1;
+      if (big !== 64'hfedc_ba98_7654_3210 || neg !== -123456789 ||
+	  r != 1.5e-300 || str != "packed") begin
+	 $display("FAILED: big=%h, neg=%0d, r=%g, str=%0s",
+		  big, neg, r, str);
+	 pass = 1'b0;
+      end
+      check(swapped, 8'h01, "swapped");
+
+      #10 check(fact(10), 3628800, "fact(10)");
+
+      sum = 0;
+      for (sel = 0 ; sel < 6 ; sel = sel + 1) begin
+	 case (sel)
+	    0: sum = sum + 1;
+	    3: sum = sum + 30;
+	    5: sum = sum + 500;
+	    default: sum = sum + 1000;
+	 endcase
+      end
+      check(sum, 3531, "case sum");
+
+      #100 late_task(res);
+      check(res, 45, "late_task");
+
+      sum = 0;
+      fork
+	 #1 sum = sum + 1;
+	 #2 sum = sum + 2;
+	 begin : blk
+	    #3 sum = sum + 4;
+	 end
+      join
+      check(sum, 7, "fork sum");
+
+      big = 64'h0000_0000_0000_00a5;
+      #1 check(swapped, 8'h5a, "swapped");
+
+      if (pass) $display("PASSED");
+   end
+endmodule
@@ -0,0 +1,46 @@
+// The LXT2 dumper compresses its partial sections on a pool of
+// threads. The list file runs this test with one and with four
+// compression threads and checks that the two dump files are the
+// same. The dump file name is given with +dumpfile=<name>.
+module top;
+   reg [31:0] r [0:63];
+   reg [31:0] lfsr;
+   integer idx, step;
+
+   genvar i;
+   generate for (i = 0 ; i < 64 ; i = i + 1) begin : g
+      wire [31:0] w = r[i];
+   end endgenerate
+
+   initial begin
+      lfsr = 32'h1;
+      for (idx = 0 ; idx < 64 ; idx = idx + 1)
+	 r[idx] = 0;
+
+      for (step = 0 ; step < 20000 ; step = step + 1) begin
+	 #1;
+	 for (idx = 0 ; idx < 8 ; idx = idx + 1) begin
+	    lfsr = {lfsr[30:0], lfsr[31] ^ lfsr[21] ^ lfsr[1] ^ lfsr[0]};
+	    r[lfsr[5:0]] = lfsr;
+	 end
+      end
+
+      $display("PASSED");
+      $finish;
+   end
+endmodule
+
+// The file name is not dumped, so the dumper is a separate root module.
+module dump;
+   reg [8*64:1] fname;
+
+   initial begin
+      if (! $value$plusargs("dumpfile=%s", fname)) begin
+	 $display("FAILED: no +dumpfile given");
+	 $finish;
+      end
+
+      $dumpfile(fname);
+      $dumpvars(0, top);
+   end
+endmodule
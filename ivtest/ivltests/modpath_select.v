@@ -0,0 +1,76 @@
+// A module path delay is chosen from the sources that changed last, of
+// those whose condition is true. An ifnone path only applies when no
+// conditional path of that source is enabled.
+module mux(input a, b, s, output y);
+   assign y = s ? b : a;
+
+   specify
+      if (!s) (a => y) = (2, 3);
+      if (s) (b => y) = (5, 7);
+      (s => y) = (10, 11);
+   endspecify
+endmodule
+
+module buf_cell(input a, s, output y);
+   assign y = a;
+
+   specify
+      if (s) (a => y) = 4;
+      ifnone (a => y) = 8;
+   endspecify
+endmodule
+
+module top;
+   reg a, b, s, e;
+   wire y, z;
+   time ty, tz, t0;
+
+   mux u_mux (a, b, s, y);
+   buf_cell u_buf (a, e, z);
+
+   always @(y) ty = $time;
+   always @(z) tz = $time;
+
+   reg pass;
+
+   task check(input time got, input time exp, input [8*24:1] what);
+      if (got !== exp) begin
+	 $display("FAILED: %0s delay is %0t (expected %0t)", what, got, exp);
+	 pass = 1'b0;
+      end
+   endtask
+
+   initial begin
+      pass = 1'b1;
+      a = 1'b0;
+      b = 1'b0;
+      s = 1'b0;
+      e = 1'b1;
+
+      #100 t0 = $time; a = 1'b1;
+      #50 check(ty - t0, 2, "a rise");
+      check(tz - t0, 4, "a rise if (s)");
+
+      t0 = $time; a = 1'b0;
+      #50 check(ty - t0, 3, "a fall");
+
+      s = 1'b1;
+      #50 t0 = $time; b = 1'b1;
+      #50 check(ty - t0, 5, "b rise");
+
+      t0 = $time; s = 1'b0;
+      #50 check(ty - t0, 11, "s fall");
+
+	// The a and b paths woke at the same time, but only the a
+	// path is enabled.
+      t0 = $time; a = 1'b1; b = 1'b0;
+      #50 check(ty - t0, 2, "a and b");
+
+      e = 1'b0;
+      #50 t0 = $time; a = 1'b0;
+      #50 check(tz - t0, 8, "a fall ifnone");
+
+      if (pass) $display("PASSED");
+      $finish;
+   end
+endmodule
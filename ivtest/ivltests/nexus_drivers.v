@@ -0,0 +1,86 @@
+// The compiler caches what drives each nexus. The cache must follow
+// the connections that elaboration makes and breaks: ports that join
+// nets of different types, pull nets, wired logic, multiple drivers
+// and nets with no driver at all.
+module pass_in(input i, output o);
+   assign o = i;
+endmodule
+
+module pull_up(output tri1 o);
+endmodule
+
+module drive_both(inout io, input en, input v);
+   assign io = en ? v : 1'bz;
+endmodule
+
+module top;
+   reg a, b, en1, en2;
+
+   wire floating;
+   wire multi;
+   wor wired_or;
+   tri0 pulled_down;
+   wire pulled_up;
+   wire shared;
+   wire out;
+
+   assign multi = a;
+   assign multi = b;
+
+   assign wired_or = a;
+   assign wired_or = b;
+
+   pull_up u_pull (pulled_up);
+
+   drive_both u_d1 (shared, en1, a);
+   drive_both u_d2 (shared, en2, b);
+
+   pass_in u_pass (shared, out);
+
+   reg pass;
+
+   task check(input got, input exp, input [8*16:1] what);
+      if (got !== exp) begin
+	 $display("FAILED: %0s=%b (expected %b)", what, got, exp);
+	 pass = 1'b0;
+      end
+   endtask
+
+   initial begin
+      pass = 1'b1;
+      a = 1'b0;
+      b = 1'b1;
+      en1 = 1'b0;
+      en2 = 1'b0;
+      #1;
+      check(floating, 1'bz, "floating");
+      check(multi, 1'bx, "multi");
+      check(wired_or, 1'b1, "wired_or");
+      check(pulled_down, 1'b0, "pulled_down");
+      check(pulled_up, 1'b1, "pulled_up");
+      check(shared, 1'bz, "shared");
+      check(out, 1'bz, "out");
+
+      en1 = 1'b1;
+      #1;
+      check(shared, 1'b0, "shared");
+      check(out, 1'b0, "out");
+
+      en2 = 1'b1;
+      #1;
+      check(shared, 1'bx, "shared");
+      check(out, 1'bx, "out");
+
+      en1 = 1'b0;
+      #1;
+      check(shared, 1'b1, "shared");
+      check(out, 1'b1, "out");
+
+      b = 1'b0;
+      #1;
+      check(multi, 1'b0, "multi");
+      check(wired_or, 1'b0, "wired_or");
+
+      if (pass) $display("PASSED");
+   end
+endmodule
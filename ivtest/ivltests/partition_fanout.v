@@ -0,0 +1,31 @@
+// In a distributed simulation (vvp -P) a net that is driven in one
+// partition and read in two others must reach both of them.
+module src(output [7:0] out);
+   reg [7:0] r;
+
+   assign #3 out = r;
+
+   initial begin
+      r = 8'h01;
+      #10 r = 8'h02;
+   end
+endmodule
+
+module dst(input [7:0] in);
+   initial begin
+      #8 if (in !== 8'h01) $display("FAILED: dst got %h at time 8", in);
+      #10 if (in !== 8'h02) $display("FAILED: dst got %h at time 18", in);
+   end
+endmodule
+
+module top;
+   wire [7:0] w;
+
+   (* ivl_partition = 1 *) src u_src (w);
+   (* ivl_partition = 2 *) dst u_dst (w);
+
+   initial begin
+      #20 if (w !== 8'h02) $display("FAILED: top got %h", w);
+      else $display("PASSED");
+   end
+endmodule
@@ -0,0 +1,25 @@
+// In a distributed simulation (vvp -P) a $finish in one partition
+// stops the others at the end of the time window, which the boundary
+// delay makes 100 long. Nothing after the window may run.
+module src(output out);
+   reg r;
+
+   assign #100 out = r;
+
+   initial begin
+      r = 1'b0;
+      #5 $display("PASSED");
+      $finish;
+   end
+endmodule
+
+module dst(input in);
+   initial #150 $display("FAILED: ran past the window of the $finish");
+endmodule
+
+module top;
+   wire w;
+
+   (* ivl_partition = 1 *) src u_src (w);
+   (* ivl_partition = 2 *) dst u_dst (w);
+endmodule
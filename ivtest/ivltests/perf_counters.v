@@ -0,0 +1,53 @@
+// $ivl_perf_counters reads the vvp runtime performance counters. The
+// counters only count up, and nonblocking assignments and time steps
+// are counted as they are scheduled.
+module top;
+   reg [7:0] q;
+   integer idx;
+   reg [63:0] ev0, ev1, nb0, nb1, ts0, ts1, now;
+   reg pass;
+
+   initial begin
+      pass = 1'b1;
+      q = 0;
+
+      #1;
+      ev0 = $ivl_perf_counters("events");
+      nb0 = $ivl_perf_counters("nb_assigns");
+      ts0 = $ivl_perf_counters("time_steps");
+
+      for (idx = 0 ; idx < 5 ; idx = idx + 1)
+	 q <= q + 1;
+
+      for (idx = 0 ; idx < 10 ; idx = idx + 1)
+	 #1;
+
+      ev1 = $ivl_perf_counters("events");
+      nb1 = $ivl_perf_counters("nb_assigns");
+      ts1 = $ivl_perf_counters("time_steps");
+      now = $ivl_perf_counters("sim_time");
+
+      if (nb1 - nb0 != 5) begin
+	 $display("FAILED: %0d nonblocking assigns (expected 5)", nb1 - nb0);
+	 pass = 1'b0;
+      end
+      if (ts1 - ts0 < 10) begin
+	 $display("FAILED: %0d time steps (expected at least 10)", ts1 - ts0);
+	 pass = 1'b0;
+      end
+      if (ev1 <= ev0) begin
+	 $display("FAILED: the event count went from %0d to %0d", ev0, ev1);
+	 pass = 1'b0;
+      end
+      if (now != $time) begin
+	 $display("FAILED: sim_time is %0d (expected %0d)", now, $time);
+	 pass = 1'b0;
+      end
+      if ($ivl_perf_counters("no_such_counter") != 0) begin
+	 $display("FAILED: an unknown counter is not 0");
+	 pass = 1'b0;
+      end
+
+      if (pass) $display("PASSED");
+   end
+endmodule
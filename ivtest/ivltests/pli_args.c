@@ -0,0 +1,143 @@
+/*
+ * PLI1 routines for the pli_args test.
+ *
+ * $pli_sum(out, in...) puts the sum of its inputs into out with
+ * tf_getp/tf_putp and checks tf_nump. The test calls it from more than
+ * one call site, so the cached argument handles of one site must not
+ * be used for another.
+ *
+ * $pli_walk(scope_a, scope_b, count_a, count_b) walks the nets and
+ * regs of two scopes with acc_next, with the steps of the walks
+ * interleaved, and checks each against a walk done on its own.
+ */
+# include  <veriuser.h>
+# include  <acc_user.h>
+# include  <string.h>
+
+static int sum_calltf(int data, int reason)
+{
+      int nump = tf_nump();
+      int idx;
+      PLI_INT32 sum = 0;
+
+      (void)data;  /* Parameter is not used. */
+      (void)reason;  /* Parameter is not used. */
+
+      for (idx = 2 ; idx <= nump ; idx += 1)
+	    sum += tf_getp(idx);
+
+      tf_putp(1, sum);
+      io_printf("$pli_sum: %d arguments, sum %d\n", nump, (int)sum);
+      return 0;
+}
+
+#define MAX_ITEMS 64
+
+static PLI_INT32 walk_types[] = { accNet, accReg, 0 };
+
+/* Walk all of scope in one go and save the handles. */
+static int walk_alone(handle scope, handle*items)
+{
+      handle cur = 0;
+      int cnt = 0;
+
+      while ((cur = acc_next(walk_types, scope, cur))) {
+	    if (cnt < MAX_ITEMS)
+		  items[cnt] = cur;
+	    cnt += 1;
+      }
+
+      return cnt;
+}
+
+static int check_item(const char*what, handle*items, int cnt, int idx,
+		      handle got)
+{
+      if (idx >= cnt || got != items[idx]) {
+	    io_printf("FAILED: %s item %d is %s\n", what, idx,
+		      got ? acc_fetch_name(got) : "<none>");
+	    return 1;
+      }
+      return 0;
+}
+
+static int walk_calltf(int data, int reason)
+{
+      handle scope_a = acc_handle_tfarg(1);
+      handle scope_b = acc_handle_tfarg(2);
+      int want_a = tf_getp(3);
+      int want_b = tf_getp(4);
+      handle items_a[MAX_ITEMS], items_b[MAX_ITEMS];
+      handle cur_a = 0, cur_b = 0, cur_a2 = 0;
+      int cnt_a, cnt_b, idx_a = 0, idx_b = 0, idx_a2 = 0;
+      int errors = 0;
+
+      (void)data;  /* Parameter is not used. */
+      (void)reason;  /* Parameter is not used. */
+
+      acc_initialize();
+
+      cnt_a = walk_alone(scope_a, items_a);
+      cnt_b = walk_alone(scope_b, items_b);
+      if (cnt_a != want_a || cnt_b != want_b) {
+	    io_printf("FAILED: found %d and %d items, expected %d and %d\n",
+		      cnt_a, cnt_b, want_a, want_b);
+	    errors += 1;
+      }
+
+	/* Interleave a walk of each scope, and a second walk of
+	   scope_a that runs one item behind the first. */
+      for (;;) {
+	    int busy = 0;
+
+	    if (idx_a == 0 || cur_a) {
+		  cur_a = acc_next(walk_types, scope_a, cur_a);
+		  if (cur_a)
+			errors += check_item("scope_a", items_a, cnt_a,
+					     idx_a++, cur_a);
+		  busy = 1;
+	    }
+	    if (idx_b == 0 || cur_b) {
+		  cur_b = acc_next(walk_types, scope_b, cur_b);
+		  if (cur_b)
+			errors += check_item("scope_b", items_b, cnt_b,
+					     idx_b++, cur_b);
+		  busy = 1;
+	    }
+	    if (idx_a > 1 && (idx_a2 == 0 || cur_a2)) {
+		  cur_a2 = acc_next(walk_types, scope_a, cur_a2);
+		  if (cur_a2)
+			errors += check_item("second scope_a", items_a, cnt_a,
+					     idx_a2++, cur_a2);
+		  busy = 1;
+	    }
+	    if (! busy)
+		  break;
+	    if (errors)
+		  break;
+      }
+
+      if (idx_a != cnt_a || idx_b != cnt_b || idx_a2 != cnt_a) {
+	    io_printf("FAILED: interleaved walks found %d, %d and %d items\n",
+		      idx_a, idx_b, idx_a2);
+	    errors += 1;
+      }
+
+      acc_close();
+
+      io_printf("$pli_walk: %d and %d items\n", cnt_a, cnt_b);
+      return 0;
+}
+
+static s_tfcell pli_args_tfs[] = {
+      { usertask, 0, 0, 0, sum_calltf, 0, "$pli_sum", 1, 0, 0, {0} },
+      { usertask, 0, 0, 0, walk_calltf, 0, "$pli_walk", 1, 0, 0, {0} },
+      { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, {0} }
+};
+
+static void pli_args_register(void)
+{
+      veriusertfs_register_table(pli_args_tfs);
+}
+
+void (*vlog_startup_routines[])(void) = { &pli_args_register, 0 };
@@ -0,0 +1,49 @@
+// The PLI1 tf_* routines cache the argument handles of each call
+// site, and acc_next resumes a scan where the caller left off. Call
+// the same PLI task from more than one call site, and interleave
+// acc_next walks of two scopes. The routines are in pli_args.c.
+module sub3;
+   reg b;
+   wire a = b;
+   wire [3:0] c = {4{b}};
+
+   initial b = 1'b0;
+endmodule
+
+module sub2;
+   reg x;
+   wire y = ~x;
+
+   initial x = 1'b1;
+endmodule
+
+module top;
+   sub3 u3();
+   sub2 u2();
+
+   reg [31:0] r1, r2;
+   reg [31:0] i1, i2;
+   integer k;
+   reg pass;
+
+   initial begin
+      pass = 1'b1;
+      i2 = 7;
+
+	// Each call site runs twice, with new argument values.
+      for (k = 0 ; k < 2 ; k = k + 1) begin
+	 i1 = 5 - 4*k;
+	 $pli_sum(r1, i1, i2);
+	 $pli_sum(r2, 100, i1, i2, 3);
+	 if (r1 !== i1 + 7 || r2 !== i1 + 110) begin
+	    $display("FAILED: i1=%0d r1=%0d r2=%0d", i1, r1, r2);
+	    pass = 1'b0;
+	 end
+      end
+
+      #1 $pli_walk(u3, u2, 3, 2);
+      $pli_walk(u2, u3, 2, 3);
+
+      if (pass) $display("PASSED");
+   end
+endmodule
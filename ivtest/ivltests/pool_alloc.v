@@ -0,0 +1,48 @@
+// The compiler allocates the parse tree and netlist objects from pools
+// and reuses the space that elaboration, constant propagation and the
+// removal of dangling nets give back. This design makes many objects
+// of different sizes, deletes many of them, and has a net wide enough
+// that its pins do not fit in a pool size class.
+module leaf #(parameter K = 0) (input [7:0] a, output [7:0] y);
+   wire [7:0] unused = a ^ 8'hff;
+   assign y = a + (K * 2 - K);
+endmodule
+
+module top;
+   reg [7:0] a;
+   wire [8*200-1:0] all;
+
+   genvar i;
+   generate for (i = 0 ; i < 200 ; i = i + 1) begin : g
+      wire [7:0] y;
+      leaf #(.K(i)) u (a, y);
+      assign all[8*i +: 8] = y;
+   end endgenerate
+
+   wire [4095:0] wide = {512{a}};
+
+   integer idx;
+   reg [7:0] exp;
+   reg pass;
+
+   initial begin
+      pass = 1'b1;
+      a = 8'd3;
+      #1;
+      for (idx = 0 ; idx < 200 ; idx = idx + 1) begin
+	 exp = a + idx;
+	 if (all[8*idx +: 8] !== exp) begin
+	    $display("FAILED: g[%0d].y=%0d (expected %0d)",
+		     idx, all[8*idx +: 8], exp);
+	    pass = 1'b0;
+	 end
+      end
+
+      if (wide[4095:4088] !== a || wide[7:0] !== a || ^wide !== 1'b0) begin
+	 $display("FAILED: wide=%h...%h", wide[4095:4088], wide[7:0]);
+	 pass = 1'b0;
+      end
+
+      if (pass) $display("PASSED");
+   end
+endmodule
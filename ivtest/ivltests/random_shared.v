@@ -0,0 +1,23 @@
+// The unseeded $random is a native vvp instruction and $random(seed)
+// is the VPI function. Both use the same generator, so from the same
+// seed they give the same sequence.
+module top;
+   integer seed, idx, a, b;
+   reg pass;
+
+   initial begin
+      pass = 1'b1;
+      seed = 0;
+      for (idx = 0 ; idx < 8 ; idx = idx + 1) begin
+	 a = $random;
+	 b = $random(seed);
+	 if (a !== b) begin
+	    $display("FAILED: call %0d, $random=%0d, $random(seed)=%0d",
+		     idx, a, b);
+	    pass = 1'b0;
+	 end
+      end
+
+      if (pass) $display("PASSED");
+   end
+endmodule
@@ -0,0 +1,60 @@
+// $table_model turns the data points into a grid and interpolates on
+// it, reusing the interval of the previous call when it can. The table
+// holds x*x + y for x = 0..4 and y = 0 and 10, in no particular order.
+module top;
+   real x, y, res, exp;
+   integer idx;
+   reg pass;
+
+   task check(input real got, input real want, input [8*24:1] what);
+      if (got - want > 1.0e-9 || want - got > 1.0e-9) begin
+	 $display("FAILED: %0s at (%g, %g) is %g (expected %g)",
+		  what, x, y, got, want);
+	 pass = 1'b0;
+      end
+   endtask
+
+   initial begin
+      pass = 1'b1;
+
+	// Quadratic interpolation is exact for x*x. Sweep up and then
+	// down so that the interval search moves both ways.
+      y = 5.0;
+      for (idx = 0 ; idx <= 32 ; idx = idx + 1) begin
+	 x = idx / 8.0;
+	 check($table_model(x, y, "ivltests/table_model.tbl", "2,1"),
+	       x*x + y, "quadratic");
+      end
+      for (idx = 32 ; idx >= 0 ; idx = idx - 3) begin
+	 x = idx / 8.0;
+	 check($table_model(x, y, "ivltests/table_model.tbl", "2,1"),
+	       x*x + y, "quadratic");
+      end
+
+	// Cubic interpolation is exact too.
+      x = 2.5;
+      check($table_model(x, y, "ivltests/table_model.tbl", "3,1"),
+	    11.25, "cubic");
+
+	// Linear interpolation between x = 2 and 3.
+      check($table_model(x, y, "ivltests/table_model.tbl", "1,1"),
+	    11.5, "linear");
+
+	// The closest point in x is 2.
+      x = 2.4;
+      check($table_model(x, y, "ivltests/table_model.tbl", "D,1"),
+	    9.0, "closest point");
+
+	// Constant extrapolation in x and linear extrapolation in y.
+      x = 6.0;
+      y = 20.0;
+      check($table_model(x, y, "ivltests/table_model.tbl", "2C,1L"),
+	    36.0, "extrapolation");
+      x = -1.0;
+      y = -10.0;
+      check($table_model(x, y, "ivltests/table_model.tbl", "2C,1L"),
+	    -10.0, "extrapolation");
+
+      if (pass) $display("PASSED");
+   end
+endmodule
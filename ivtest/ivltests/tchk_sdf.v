@@ -0,0 +1,64 @@
+// $sdf_annotate sets the limits of the $setup and $hold timing checks
+// from the SDF TIMINGCHECK entries. The violations below are only
+// found with the annotated limits.
+`timescale 1ns/1ns
+
+module dff(input clk, input d, output reg q);
+   reg notify_setup, notify_hold;
+
+   always @(posedge clk) q <= d;
+
+   specify
+      $setup(d, posedge clk, 1, notify_setup);
+      $hold(posedge clk, d, 1, notify_hold);
+   endspecify
+endmodule
+
+module top;
+   reg clk, d;
+   wire q;
+
+   dff dut (clk, d, q);
+
+   integer setups, holds;
+
+   initial begin
+      setups = 0;
+      holds = 0;
+   end
+
+   always @(dut.notify_setup) setups = setups + 1;
+   always @(dut.notify_hold) holds = holds + 1;
+
+   reg pass;
+
+   initial begin
+      $sdf_annotate("ivltests/tchk_sdf.sdf", top);
+
+      pass = 1'b1;
+      clk = 1'b0;
+      d = 1'b0;
+
+	// Data changes 3ns before the clock edge.
+      #100 d = 1'b1;
+      #3 clk = 1'b1;
+      #1 if (setups !== 1 || holds !== 0) begin
+	 $display("FAILED: setups=%0d, holds=%0d (expected 1, 0)",
+		  setups, holds);
+	 pass = 1'b0;
+      end
+
+	// Data changes 2ns after the clock edge.
+      #10 clk = 1'b0;
+      #100 clk = 1'b1;
+      #2 d = 1'b0;
+      #1 if (setups !== 1 || holds !== 1) begin
+	 $display("FAILED: setups=%0d, holds=%0d (expected 1, 1)",
+		  setups, holds);
+	 pass = 1'b0;
+      end
+
+      if (pass) $display("PASSED");
+      $finish;
+   end
+endmodule
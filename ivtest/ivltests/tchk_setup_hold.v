@@ -0,0 +1,84 @@
+// The $setup and $hold timing checks run natively in vvp and toggle
+// their notifier on a violation. $setup lists the data event first
+// and the reference event second, so a data change followed too soon
+// by a clock edge fails it, but a clock edge followed by a data change
+// does not.
+`timescale 1ns/1ns
+
+module dff(input clk, input d, output reg q);
+   reg notify_setup, notify_hold;
+
+   always @(posedge clk) q <= d;
+
+   specify
+      $setup(d, posedge clk, 5, notify_setup);
+      $hold(posedge clk, d, 2, notify_hold);
+   endspecify
+endmodule
+
+module top;
+   reg clk, d;
+   wire q;
+
+   dff dut (clk, d, q);
+
+   integer setups, holds;
+
+   initial begin
+      setups = 0;
+      holds = 0;
+   end
+
+   always @(dut.notify_setup) setups = setups + 1;
+   always @(dut.notify_hold) holds = holds + 1;
+
+   reg pass;
+
+   task check(input integer exp_setups, input integer exp_holds,
+	      input [8*24:1] what);
+      begin
+	 if (setups !== exp_setups || holds !== exp_holds) begin
+	    $display("FAILED: %0s: setups=%0d, holds=%0d (expected %0d, %0d)",
+		     what, setups, holds, exp_setups, exp_holds);
+	    pass = 1'b0;
+	 end
+      end
+   endtask
+
+   initial begin
+      pass = 1'b1;
+      clk = 1'b0;
+      d = 1'b0;
+
+	// Data settles long before the clock edge.
+      #100 clk = 1'b1;
+      #10 clk = 1'b0;
+      #1 check(0, 0, "no violation");
+
+	// Data changes 2ns before the clock edge.
+      #100 d = 1'b1;
+      #2 clk = 1'b1;
+      #1 check(1, 0, "setup violation");
+
+	// Data changes 3ns after the clock edge. This is only a
+	// violation if the $setup operands were swapped.
+      #10 clk = 1'b0;
+      #100 clk = 1'b1;
+      #3 d = 1'b0;
+      #1 check(1, 0, "data after clock");
+
+	// Data changes 1ns after the clock edge.
+      #10 clk = 1'b0;
+      #100 clk = 1'b1;
+      #1 d = 1'b1;
+      #1 check(1, 1, "hold violation");
+
+	// A falling clock edge is not a reference event.
+      #100 d = 1'b0;
+      #1 clk = 1'b0;
+      #1 check(1, 1, "negedge clock");
+
+      if (pass) $display("PASSED");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,69 @@
+// 2-state variables turn X and Z bits into 0 when they are written or
+// forced, and 2-state arithmetic must give the same results as the
+// 4-state instructions, including for X results of a division by zero.
+module top;
+   bit [7:0] b;
+   int i, j, q;
+   bit [99:0] wide_a, wide_b;
+   logic [31:0] l;
+   wire [7:0] w = b;
+   reg pass;
+
+   task fail(input [8*32:1] what);
+      begin
+	 $display("FAILED: %0s", what);
+	 pass = 1'b0;
+      end
+   endtask
+
+   initial begin
+      pass = 1'b1;
+
+      b = 8'bx1z0_1010;
+      #1 if (b !== 8'b0100_1010 || w !== 8'b0100_1010) fail("X/Z write");
+
+      i = 'x;
+      if (i !== 0) fail("int X write");
+
+      l = 32'bz0x1_0101;
+      b = l[7:0];
+      #1 if (b !== 8'b0001_0101 || w !== 8'b0001_0101) fail("X/Z copy");
+
+      force b = 8'hzx;
+      #1 if (b !== 8'h00 || w !== 8'h00) fail("X/Z force");
+      release b;
+      b = 8'h5a;
+      #1 if (b !== 8'h5a || w !== 8'h5a) fail("write after release");
+
+      i = -7;
+      j = 2;
+      if (i / j !== -3) fail("signed divide");
+      if (i % j !== -1) fail("signed modulus");
+      if (i * j !== -14) fail("multiply");
+      if (i + j !== -5 || i - j !== -9) fail("add/subtract");
+      if (!(i < j) || (j < i) || (i == j)) fail("compare");
+
+      q = 32'h7fff_ffff;
+      if (q + 1 !== 32'sh8000_0000) fail("add wraps");
+
+      wide_a = 100'h8_0000_0000_0000_0000_0000_0003;
+      wide_b = 100'h2;
+      if (wide_a * wide_b !== 100'h6) fail("wide multiply");
+      if (wide_a / wide_b !== 100'h4_0000_0000_0000_0000_0000_0001)
+	 fail("wide divide");
+      if (wide_a % wide_b !== 100'h1) fail("wide modulus");
+      if (!(wide_b < wide_a)) fail("wide compare");
+
+	// A division by zero is X, even inside a 2-state expression.
+      j = 0;
+      l = i / j + 1;
+      if (l !== 32'bx) fail("divide by zero");
+      l = i % j;
+      if (l !== 32'bx) fail("modulus by zero");
+      if (i / j < i) fail("compare with divide by zero");
+      q = i / j + 1;
+      if (q !== 0) fail("2-state divide by zero");
+
+      if (pass) $display("PASSED");
+   end
+endmodule
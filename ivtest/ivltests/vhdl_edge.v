@@ -0,0 +1,64 @@
+// The VHDL 'event, rising_edge() and falling_edge() on a 1-bit clock.
+// An edge needs the value before the change to be the opposite 0/1,
+// so X->1 and X->0 are events but not edges. clk takes the native
+// .event vhdl path and the array word mem[0] takes the VPI path.
+module top;
+   reg clk;
+   reg mem [0:0];
+
+   reg pass;
+
+   task set(input v);
+      begin
+	 clk = v;
+	 mem[0] = v;
+      end
+   endtask
+
+   task check(input [8*8-1:0] what, input ev, input re, input fe);
+      begin
+	 if ($ivlh_attribute_event(clk) !== ev
+	     || $ivlh_rising_edge(clk) !== re
+	     || $ivlh_falling_edge(clk) !== fe) begin
+	    $display("FAILED: %0s native: event=%b rising=%b falling=%b",
+		     what, $ivlh_attribute_event(clk),
+		     $ivlh_rising_edge(clk), $ivlh_falling_edge(clk));
+	    pass = 1'b0;
+	 end
+	 if ($ivlh_attribute_event(mem[0]) !== ev
+	     || $ivlh_rising_edge(mem[0]) !== re
+	     || $ivlh_falling_edge(mem[0]) !== fe) begin
+	    $display("FAILED: %0s VPI: event=%b rising=%b falling=%b",
+		     what, $ivlh_attribute_event(mem[0]),
+		     $ivlh_rising_edge(mem[0]), $ivlh_falling_edge(mem[0]));
+	    pass = 1'b0;
+	 end
+      end
+   endtask
+
+   initial begin
+      pass = 1'b1;
+
+      #1 set(1'b1);
+      #0 check("X->1", 1'b1, 1'b0, 1'b0);
+      #1 check("steady", 1'b0, 1'b0, 1'b0);
+
+      set(1'b0);
+      #0 check("1->0", 1'b1, 1'b0, 1'b1);
+
+      #1 set(1'b1);
+      #0 check("0->1", 1'b1, 1'b1, 1'b0);
+
+      #1 set(1'bx);
+      #0 check("1->X", 1'b1, 1'b0, 1'b0);
+
+      #1 set(1'b0);
+      #0 check("X->0", 1'b1, 1'b0, 1'b0);
+
+      #1 set(1'bz);
+      #1 set(1'b1);
+      #0 check("Z->1", 1'b1, 1'b0, 1'b0);
+
+      if (pass) $display("PASSED");
+   end
+endmodule
@@ -0,0 +1,38 @@
+// The native VHDL 'event test sees a change to a part of a net that
+// does not hold bit 0. That is an event on the net, but not a rising
+// or falling edge.
+module top;
+   reg [1:0] hi;
+   wire [3:0] w;
+
+   assign w[3:2] = hi;
+
+   reg pass;
+
+   initial begin
+      pass = 1'b1;
+      hi = 2'b00;
+
+      #1 hi = 2'b01;
+      #0 if ($ivlh_attribute_event(w) !== 1'b1) begin
+	 $display("FAILED: no 'event for a part off bit 0");
+	 pass = 1'b0;
+      end
+      if ($ivlh_rising_edge(w) !== 1'b0) begin
+	 $display("FAILED: rising_edge for a part off bit 0");
+	 pass = 1'b0;
+      end
+
+      #1 if ($ivlh_attribute_event(w) !== 1'b0) begin
+	 $display("FAILED: 'event with no change");
+	 pass = 1'b0;
+      end
+
+      if (w !== 4'b01zz) begin
+	 $display("FAILED: w=%b (expected 01zz)", w);
+	 pass = 1'b0;
+      end
+
+      if (pass) $display("PASSED");
+   end
+endmodule
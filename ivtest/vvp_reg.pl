@@ -0,0 +1,158 @@
+#!/usr/bin/env perl
+#
+# Run the regression tests in a list file with the installed iverilog
+# and vvp. See README.txt for the list file format.
+#
+#  Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+#
+#    This source code is free software; you can redistribute it
+#    and/or modify it in source code form under the terms of the GNU
+#    General Public License as published by the Free Software
+#    Foundation; either version 2 of the License, or (at your option)
+#    any later version.
+#
+#    This program is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#    GNU General Public License for more details.
+#
+#    You should have received a copy of the GNU General Public License
+#    along with this program; if not, write to the Free Software
+#    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+#
+
+use strict;
+use warnings;
+use File::Compare;
+
+my $suffix = "";
+my $list = "regress.list";
+
+foreach my $arg (@ARGV) {
+      if ($arg =~ /^--suffix=(.*)$/) {
+	    $suffix = $1;
+      } else {
+	    $list = $arg;
+      }
+}
+
+my $iverilog = "iverilog$suffix";
+my $iverilog_vpi = "iverilog-vpi$suffix";
+my $vvp = "vvp$suffix";
+
+mkdir "log" unless -d "log";
+mkdir "work" unless -d "work";
+
+open(my $lf, "<", $list) or die "Unable to open $list: $!\n";
+
+my $total = 0;
+my @failed;
+
+while (my $line = <$lf>) {
+      chomp $line;
+      $line =~ s/^\s+//;
+      next if $line eq "" or $line =~ /^#/;
+
+      my ($name, $type, $dir, @opts) = split(/\s+/, $line);
+      die "$list:$.: Missing directory for $name\n" unless defined $dir;
+
+      my @args = split(/,/, $type);
+      $type = shift @args;
+      die "$list:$.: Unknown test type $type\n"
+	    unless $type eq "normal" or $type eq "CE";
+
+      my $gold;
+      my $vpi;
+      my $flags = "";
+      my @runs;
+      my @cmds;
+      my @diffs;
+      foreach my $opt (@opts) {
+	    if ($opt =~ /^gold=(.*)$/) {
+		  $gold = $1;
+	    } elsif ($opt =~ /^vpi=(.*)$/) {
+		  $vpi = $1;
+	    } elsif ($opt =~ /^vvp=(.*)$/) {
+		  $flags = join(" ", split(/,/, $1));
+	    } elsif ($opt =~ /^run=(.*)$/) {
+		  push @runs, join(" ", split(/,/, $1));
+	    } elsif ($opt =~ /^cmd=(.*)$/) {
+		  push @cmds, join(" ", split(/,/, $1));
+	    } elsif ($opt =~ /^diff=(.*):(.*)$/) {
+		  push @diffs, [$1, $2];
+	    } else {
+		  die "$list:$.: Unknown option $opt\n";
+	    }
+      }
+      push @runs, "" unless @runs;
+
+      $total += 1;
+      my $log = "log/$name.log";
+      my $out = "work/$name.vvp";
+      unlink $log, glob("work/$name.*");
+      foreach my $pair (@diffs) {
+	    unlink @$pair;
+      }
+
+      my $res = test_one($name, $type, $dir, $log, $out,
+			 join(" ", @args), $vpi, $flags, \@runs, \@cmds,
+			 $gold, \@diffs);
+      printf("%-30s %s\n", $name, $res);
+      push @failed, $name if $res ne "Passed";
+}
+
+close($lf);
+
+printf("\nTotal=%d, Passed=%d, Failed=%d\n",
+       $total, $total - scalar(@failed), scalar(@failed));
+exit(@failed ? 1 : 0);
+
+sub test_one {
+      my ($name, $type, $dir, $log, $out, $args, $vpi, $flags, $runs,
+	  $cmds, $gold, $diffs) = @_;
+
+      my $rc = system("$iverilog $args -o $out $dir/$name.v > $log 2>&1");
+      if ($type eq "CE") {
+	    return $rc ? "Passed" : "Failed - compiled";
+      }
+      return "Failed - compile" if $rc;
+
+      if (defined $vpi) {
+	      # Build the module in work, where iverilog-vpi also leaves
+	      # the object files, and load it from there.
+	    $rc = system("cd work && $iverilog_vpi --name=$name ../$dir/$vpi"
+			 . " >> ../$log 2>&1");
+	    return "Failed - vpi" if $rc;
+	    $flags = "-M work -m $name $flags";
+      }
+
+      foreach my $run (@$runs) {
+	    $rc = system("$vvp $flags $out $run >> $log 2>&1");
+	    return "Failed - vvp" if $rc;
+      }
+
+      foreach my $cmd (@$cmds) {
+	    $rc = system("$vvp $cmd >> $log 2>&1");
+	    return "Failed - vvp" if $rc;
+      }
+
+      if (defined $gold) {
+	    return "Failed - gold" if compare($log, "gold/$gold") != 0;
+      } else {
+	    open(my $fh, "<", $log) or return "Failed - no log";
+	    my $passed = 0;
+	    my $failed = 0;
+	    while (my $text = <$fh>) {
+		  $passed = 1 if $text =~ /^PASSED/;
+		  $failed = 1 if $text =~ /FAILED/;
+	    }
+	    close($fh);
+	    return "Failed - output" if $failed or not $passed;
+      }
+
+      foreach my $pair (@$diffs) {
+	    return "Failed - diff" if compare($pair->[0], $pair->[1]) != 0;
+      }
+
+      return "Passed";
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "ObjectHeap.h"
+# include  <new>
+# include  <cassert>
+
+ObjectHeap*ObjectHeap::heap_list_ = 0;
+
+ObjectHeap::ObjectHeap(const char*name)
+: name_(name), chunks_(0), chunk_ptr_(0), chunk_rem_(0),
+  alloc_count_(0), free_count_(0), large_count_(0),
+  live_bytes_(0), peak_bytes_(0), chunk_bytes_(0)
+{
+      for (unsigned idx = 0 ; idx < MAX_CLASS ; idx += 1)
+	    free_[idx] = 0;
+
+      next_heap_ = heap_list_;
+      heap_list_ = this;
+}
+
+ObjectHeap::~ObjectHeap()
+{
+	// This is a planned memory leak. The objects in the heap may
+	// be referenced until the very end of the program.
+}
+
+void* ObjectHeap::carve_(size_t bytes)
+{
+      if (chunk_rem_ < bytes) {
+	      // The tail of the old chunk is lost, but it is always
+	      // smaller than the largest size class.
+	    chunk_t*chunk = static_cast<chunk_t*>
+		  (::operator new(CHUNK_SIZE));
+	    chunk->next = chunks_;
+	    chunks_ = chunk;
+	    chunk_bytes_ += CHUNK_SIZE;
+
+	    size_t hdr = (sizeof(chunk_t) + GRAIN - 1) / GRAIN * GRAIN;
+	    chunk_ptr_ = reinterpret_cast<char*>(chunk) + hdr;
+	    chunk_rem_ = CHUNK_SIZE - hdr;
+      }
+
+      void*res = chunk_ptr_;
+      chunk_ptr_ += bytes;
+      chunk_rem_ -= bytes;
+      return res;
+}
+
+void* ObjectHeap::alloc(size_t size)
+{
+      alloc_count_ += 1;
+      live_bytes_ += size;
+      if (live_bytes_ > peak_bytes_)
+	    peak_bytes_ = live_bytes_;
+
+      if (size == 0)
+	    size = 1;
+
+      size_t cls = (size + GRAIN - 1) / GRAIN;
+      if (cls > MAX_CLASS) {
+	    large_count_ += 1;
+	    return ::operator new(size);
+      }
+
+      cell_t*cell = free_[cls-1];
+      if (cell) {
+	    free_[cls-1] = cell->next;
+	    return cell;
+      }
+
+      return carve_(cls * GRAIN);
+}
+
+void ObjectHeap::free(void*ptr, size_t size)
+{
+      if (ptr == 0)
+	    return;
+
+      free_count_ += 1;
+      assert(live_bytes_ >= size);
+      live_bytes_ -= size;
+
+      if (size == 0)
+	    size = 1;
+
+      size_t cls = (size + GRAIN - 1) / GRAIN;
+      if (cls > MAX_CLASS) {
+	    ::operator delete(ptr);
+	    return;
+      }
+
+      cell_t*cell = static_cast<cell_t*>(ptr);
+      cell->next = free_[cls-1];
+      free_[cls-1] = cell;
+}
+
+void ObjectHeap::dump_statistics(ostream&out)
+{
+      for (const ObjectHeap*cur = heap_list_ ; cur ; cur = cur->next_heap_) {
+	    out << "heap " << cur->name_ << ":"
+		<< " alloc_count=" << cur->alloc_count_
+		<< " free_count=" << cur->free_count_
+		<< " large_count=" << cur->large_count_
+		<< " live_bytes=" << cur->live_bytes_
+		<< " peak_bytes=" << cur->peak_bytes_
+		<< " chunk_bytes=" << cur->chunk_bytes_
+		<< endl;
+      }
+}
+
+void ObjectHeap::release_all()
+{
+      for (ObjectHeap*cur = heap_list_ ; cur ; cur = cur->next_heap_) {
+	    while (cur->chunks_) {
+		  chunk_t*tmp = cur->chunks_;
+		  cur->chunks_ = tmp->next;
+		  ::operator delete(tmp);
+	    }
+	    for (unsigned idx = 0 ; idx < MAX_CLASS ; idx += 1)
+		  cur->free_[idx] = 0;
+	    cur->chunk_ptr_ = 0;
+	    cur->chunk_rem_ = 0;
+      }
+}
@@ -0,0 +1,92 @@
+#ifndef IVL_ObjectHeap_H
+#define IVL_ObjectHeap_H
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  <cstddef>
+# include  <iostream>
+
+using namespace std;
+
+/*
+ * An ObjectHeap is a pool allocator for a family of objects, for
+ * example all the PExpr derived classes. The class at the root of the
+ * family declares class operator new/delete that call alloc() and
+ * free() on its heap. Memory is carved out of large chunks and kept on
+ * per-size free lists, so there is no per-object malloc header, and a
+ * deleted object's space is reused by the next object of the same
+ * size. Objects too large for the size classes (large Link arrays for
+ * example) fall back to the global operator new.
+ *
+ * The chunks are never returned to the system while the compiler
+ * runs. release_all() drops all the chunks of all the heaps at once,
+ * so nothing allocated from any heap may be used after that.
+ */
+class ObjectHeap {
+
+    public:
+      explicit ObjectHeap(const char*name);
+      ~ObjectHeap();
+
+      void* alloc(size_t size);
+      void free(void*ptr, size_t size);
+
+      const char*name() const { return name_; }
+
+	// Print a line of statistics for every heap.
+      static void dump_statistics(ostream&out);
+	// Bulk teardown of every heap. This is how the compiler
+	// frees the design at exit: main() does not delete the
+	// design, so the pooled objects are never destroyed one
+	// at a time. Objects that are not pooled are left for the
+	// system to reclaim when the process exits.
+      static void release_all();
+
+    private:
+	// GRAIN matches the alignment of max_align_t, so objects with
+	// long double members come out aligned as from operator new.
+      enum { GRAIN = 16, MAX_CLASS = 16, CHUNK_SIZE = 256*1024 };
+
+      struct cell_t { cell_t*next; };
+      struct chunk_t { chunk_t*next; };
+
+      void* carve_(size_t bytes);
+
+      const char*name_;
+      cell_t*free_[MAX_CLASS];
+      chunk_t*chunks_;
+      char*chunk_ptr_;
+      size_t chunk_rem_;
+
+      unsigned long alloc_count_;
+      unsigned long free_count_;
+      unsigned long large_count_;
+      size_t live_bytes_;
+      size_t peak_bytes_;
+      size_t chunk_bytes_;
+
+      ObjectHeap*next_heap_;
+      static ObjectHeap*heap_list_;
+
+    private: // not implemented
+      ObjectHeap(const ObjectHeap&);
+      ObjectHeap& operator= (const ObjectHeap&);
+};
+
+#endif /* IVL_ObjectHeap_H */
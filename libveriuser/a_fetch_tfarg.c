@@ -26,21 +26,17 @@
  */
 double acc_fetch_itfarg(PLI_INT32 n, handle obj)
 {
-      vpiHandle iter, hand = 0;
+      vpiHandle hand;
       s_vpi_value value;
-      int idx = n;
       double rtn;
 
-      iter = vpi_iterate(vpiArgument, obj);
-
-      /* scan to nth argument */
-      while (idx > 0 && (hand = vpi_scan(iter))) idx--;
+      /* get the nth argument */
+      hand = __tf_argument(obj, n);
 
       if (hand) {
 	    value.format=vpiRealVal;
 	    vpi_get_value(hand, &value);
 	    rtn = value.value.real;
-	    vpi_free_object(iter);
       } else {
 	    rtn = 0.0;
       }
@@ -61,21 +57,17 @@ double acc_fetch_tfarg(PLI_INT32 n)
 
 PLI_INT32 acc_fetch_itfarg_int(PLI_INT32 n, handle obj)
 {
-      vpiHandle iter, hand = 0;
+      vpiHandle hand;
       s_vpi_value value;
-      int idx = n;
       int rtn;
 
-      iter = vpi_iterate(vpiArgument, obj);
-
-      /* scan to nth argument */
-      while (idx > 0 && (hand = vpi_scan(iter))) idx--;
+      /* get the nth argument */
+      hand = __tf_argument(obj, n);
 
       if (hand) {
 	    value.format=vpiIntVal;
 	    vpi_get_value(hand, &value);
 	    rtn = value.value.integer;
-	    vpi_free_object(iter);
       } else {
 	    rtn = 0;
       }
@@ -96,21 +88,17 @@ PLI_INT32 acc_fetch_tfarg_int(PLI_INT32 n)
 
 char *acc_fetch_itfarg_str(PLI_INT32 n, handle obj)
 {
-      vpiHandle iter, hand = 0;
+      vpiHandle hand;
       s_vpi_value value;
-      int idx = n;
       char *rtn;
 
-      iter = vpi_iterate(vpiArgument, obj);
-
-      /* scan to nth argument */
-      while (idx > 0 && (hand = vpi_scan(iter))) idx -= 1;
+      /* get the nth argument */
+      hand = __tf_argument(obj, n);
 
       if (hand) {
 	    value.format=vpiStringVal;
 	    vpi_get_value(hand, &value);
 	    rtn = __acc_newstring(value.value.str);
-	    vpi_free_object(iter);
       } else {
 	    rtn = (char *) 0;
       }
@@ -19,35 +19,18 @@
 
 #include  <acc_user.h>
 #include  <vpi_user.h>
+#include  "priv.h"
 
 /*
  * acc_handle_tfarg implemented using VPI interface
  */
 handle acc_handle_tfarg(int n)
 {
-      vpiHandle rtn_h = 0;
+      if (n <= 0)
+	    return (vpiHandle) 0;
 
-      if (n > 0) {
-	    vpiHandle sys_h, sys_i;
-
-	    sys_h = vpi_handle(vpiSysTfCall, 0 /* NULL */);
-	    sys_i = vpi_iterate(vpiArgument, sys_h);
-
-	    /* find nth arg */
-	    while (n > 0) {
-		  rtn_h = vpi_scan(sys_i);
-		  if (rtn_h == 0)
-			break;
-		  n--;
-	    }
-
-	    if (rtn_h) vpi_free_object(sys_i);
-
-      } else {
-	    rtn_h = (vpiHandle) 0;
-      }
-
-      return rtn_h;
+      /* find nth arg */
+      return __tf_argument(vpi_handle(vpiSysTfCall, 0 /* NULL */), n);
 }
 
 handle acc_handle_tfinst(void)
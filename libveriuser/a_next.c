@@ -22,11 +22,104 @@
 #include  <vpi_user.h>
 #include  "priv.h"
 
+/*
+ * The acc_next_* functions need to be reentrant, so in general we need
+ * to rescan all the items up to the previous one, then return the next
+ * one. That makes a complete scan O(n^2), so keep a few resumable
+ * cursors keyed by the scope and type list. If the caller passes back
+ * the handle that a cursor last returned, the scan continues from the
+ * saved iterator instead of starting over.
+ */
+#define ACC_NEXT_CURSORS 8
+#define ACC_NEXT_MAX_TYPES 16
+
+struct acc_next_cursor {
+      handle scope;
+      PLI_INT32 type[ACC_NEXT_MAX_TYPES];
+      vpiHandle iter;
+      handle last;
+};
+
+static struct acc_next_cursor cursor_table[ACC_NEXT_CURSORS];
+static unsigned cursor_victim = 0;
+
+static int same_type_list(const PLI_INT32*a, const PLI_INT32*b)
+{
+      while (*a && *a == *b) {
+	    a += 1;
+	    b += 1;
+      }
+      return *a == *b;
+}
+
+static void cursor_release(struct acc_next_cursor*cur)
+{
+      if (cur->iter) vpi_free_object(cur->iter);
+      cur->scope = 0;
+      cur->iter = 0;
+      cur->last = 0;
+}
+
+/*
+ * Find the cursor that can continue the scan after prev, or return 0.
+ */
+static struct acc_next_cursor* cursor_find(PLI_INT32*type, handle scope,
+					   handle prev)
+{
+      unsigned idx;
+
+      if (prev == 0)
+	    return 0;
+
+      for (idx = 0 ; idx < ACC_NEXT_CURSORS ; idx += 1) {
+	    struct acc_next_cursor*cur = cursor_table + idx;
+	    if (cur->iter && cur->scope == scope && cur->last == prev
+		&& same_type_list(cur->type, type))
+		  return cur;
+      }
+
+      return 0;
+}
+
+/*
+ * Save the live iterator in a cursor so that the next call can pick
+ * up where this one left off. Type lists that do not fit are not
+ * cached, the iterator is simply released.
+ */
+static void cursor_save(struct acc_next_cursor*cur, PLI_INT32*type,
+			handle scope, vpiHandle iter, handle hand)
+{
+      unsigned cnt = 0;
+
+      while (type[cnt]) {
+	    cnt += 1;
+	    if (cnt == ACC_NEXT_MAX_TYPES) {
+		  if (cur) cursor_release(cur);
+		  vpi_free_object(iter);
+		  return;
+	    }
+      }
+
+      if (cur == 0) {
+	    cur = cursor_table + cursor_victim;
+	    cursor_victim = (cursor_victim + 1) % ACC_NEXT_CURSORS;
+	    cursor_release(cur);
+	    cur->scope = scope;
+	    for (cnt = 0 ; type[cnt] ; cnt += 1)
+		  cur->type[cnt] = type[cnt];
+	    cur->type[cnt] = 0;
+      }
+
+      cur->iter = iter;
+      cur->last = hand;
+}
+
 /*
  * acc_next and friends implemented using VPI
  */
 handle acc_next(PLI_INT32 *type, handle scope, handle prev)
 {
+      struct acc_next_cursor*cur;
       vpiHandle iter, hand = 0;
 
       /* trace */
@@ -47,28 +140,36 @@ handle acc_next(PLI_INT32 *type, handle scope, handle prev)
 	    fflush(pli_trace);
       }
 
-      /*
-       * The acc_next_* functions need to be reentrant, so we need to
-       * rescan all the items up to the previous one, then return
-       * the next one.
-      */
-      iter = vpi_iterate(vpiScope, scope);	/* ICARUS extension */
-      if (prev) {
-	    while ((hand = vpi_scan(iter))) {
-		  if (hand == prev) break;
+      cur = cursor_find(type, scope, prev);
+      if (cur) {
+	      /* Resume the scan right after prev. */
+	    iter = cur->iter;
+	    cur->iter = 0;
+
+      } else {
+	      /* Rescan all the items up to the previous one. */
+	    iter = vpi_iterate(vpiScope, scope);	/* ICARUS extension */
+	    if (prev && iter) {
+		  while ((hand = vpi_scan(iter))) {
+			if (hand == prev) break;
+		  }
+		  if (hand == 0) iter = 0;
 	    }
       }
 
       /* scan for next */
-      if (!prev || hand) {
+      hand = 0;
+      if (iter) {
 	    while ((hand = vpi_scan(iter))) {
 		  if (acc_object_in_typelist(hand, type))
 			break;
 	    }
       }
 
-      /* don't leak iterators */
-      if (hand) vpi_free_object(iter);
+      /* The iterator is freed by vpi_scan when it runs out, otherwise
+	 keep it so the next call can resume the scan. */
+      if (hand) cursor_save(cur, type, scope, iter, hand);
+      else if (cur) cursor_release(cur);
 
       /* trace */
       if (pli_trace) {
@@ -22,28 +22,23 @@
 #include  <assert.h>
 #include  <veriuser.h>
 #include  <vpi_user.h>
+#include  "priv.h"
 
 /*
  * tf_getlongp implemented using VPI interface
  */
 int tf_getlongp(int *highvalue, int n)
 {
-      vpiHandle sys_h, sys_i, arg_h = 0;
+      vpiHandle arg_h;
       s_vpi_value value;
       int len, rtn;
 
       assert(highvalue);
       assert(n > 0);
 
-      /* get task/func handle */
-      sys_h = vpi_handle(vpiSysTfCall, 0);
-      sys_i = vpi_iterate(vpiArgument, sys_h);
-
-      /* find nth arg */
-      while (n > 0) {
-	    if (!(arg_h = vpi_scan(sys_i))) assert(0);
-	    n--;
-      }
+      /* get the nth arg of the task/func */
+      arg_h = __tf_argument(vpi_handle(vpiSysTfCall, 0), n);
+      assert(arg_h);
 
       /* get the value */
       value.format = vpiHexStrVal;
@@ -64,7 +59,5 @@ int tf_getlongp(int *highvalue, int n)
 	    rtn = (int) strtoul(value.value.str, 0, 16);
       }
 
-      vpi_free_object(sys_i);
-
       return rtn;
 }
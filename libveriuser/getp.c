@@ -28,21 +28,15 @@
  */
 PLI_INT32 tf_igetp(PLI_INT32 n, void *obj)
 {
-      vpiHandle sys_h, sys_i, arg_h = 0;
+      vpiHandle arg_h;
       s_vpi_value value;
       int rtn = 0;
 
       assert(n > 0);
 
-      /* get task/func handle */
-      sys_h = (vpiHandle)obj;
-      sys_i = vpi_iterate(vpiArgument, sys_h);
-
-      /* find nth arg */
-      while (n > 0) {
-	    if (!(arg_h = vpi_scan(sys_i))) { goto out; }
-	    n--;
-      }
+      /* get the nth arg of the task/func */
+      arg_h = __tf_argument((vpiHandle)obj, n);
+      if (!arg_h) goto out;
 
       /* If it is a constant string, return a pointer to it else int value */
       if (vpi_get(vpiType, arg_h) == vpiConstant &&
@@ -59,8 +53,6 @@ PLI_INT32 tf_igetp(PLI_INT32 n, void *obj)
 	    rtn = value.value.integer;
       }
 
-      vpi_free_object(sys_i);
-
 out:
       if (pli_trace) {
 	    fprintf(pli_trace, "tf_igetp(n=%d, obj=%p) --> %d\n",
@@ -80,21 +72,15 @@ PLI_INT32 tf_getp(PLI_INT32 n)
 
 double tf_igetrealp(PLI_INT32 n, void *obj)
 {
-      vpiHandle sys_h, sys_i, arg_h = 0;
+      vpiHandle arg_h;
       s_vpi_value value;
       double rtn = 0.0;
 
       assert(n > 0);
 
-      /* get task/func handle */
-      sys_h = (vpiHandle)obj;
-      sys_i = vpi_iterate(vpiArgument, sys_h);
-
-      /* find nth arg */
-      while (n > 0) {
-	    if (!(arg_h = vpi_scan(sys_i))) { goto out; }
-	    n--;
-      }
+      /* get the nth arg of the task/func */
+      arg_h = __tf_argument((vpiHandle)obj, n);
+      if (!arg_h) goto out;
 
       if (vpi_get(vpiType, arg_h) == vpiConstant &&
 	  vpi_get(vpiConstType, arg_h) == vpiStringConst)
@@ -106,8 +92,6 @@ double tf_igetrealp(PLI_INT32 n, void *obj)
 	    rtn = value.value.real;
       }
 
-      vpi_free_object(sys_i);
-
 out:
       if (pli_trace) {
 	    fprintf(pli_trace, "tf_igetrealp(n=%d, obj=%p) --> %f\n",
@@ -127,21 +111,15 @@ double tf_getrealp(PLI_INT32 n)
 
 char *tf_istrgetp(PLI_INT32 n, PLI_INT32 fmt, void *obj)
 {
-      vpiHandle sys_h, sys_i, arg_h = 0;
+      vpiHandle arg_h;
       s_vpi_value value;
       char *rtn = 0;
 
       assert(n > 0);
 
-      /* get task/func handle */
-      sys_h = (vpiHandle)obj;
-      sys_i = vpi_iterate(vpiArgument, sys_h);
-
-      /* find nth arg */
-      while (n > 0) {
-	    if (!(arg_h = vpi_scan(sys_i))) { goto out; }
-	    n--;
-      }
+      /* get the nth arg of the task/func */
+      arg_h = __tf_argument((vpiHandle)obj, n);
+      if (!arg_h) goto out;
 
       if (vpi_get(vpiType, arg_h) == vpiConstant &&
 	  vpi_get(vpiConstType, arg_h) == vpiStringConst)
@@ -163,8 +141,6 @@ char *tf_istrgetp(PLI_INT32 n, PLI_INT32 fmt, void *obj)
 	    }
       }
 
-      vpi_free_object(sys_i);
-
 out:
       if (pli_trace) {
 	    fprintf(pli_trace, "tf_istrgetp(n=%d, fmt=%c, obj=%p) --> \"%s\"\n",
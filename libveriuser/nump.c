@@ -20,6 +20,7 @@
 #include  <vpi_user.h>
 #include  <stdio.h>
 #include "veriuser.h"
+#include "priv.h"
 
 /*
  * tf_nump implemented using VPI interface
@@ -27,16 +28,8 @@
 
 int tf_inump(void *obj)
 {
-      vpiHandle sys_h, sys_i;
-      int cnt;
-
-      sys_h = (vpiHandle)obj;
-      sys_i = vpi_iterate(vpiArgument, sys_h);
-
         /* count number of args */
-      for (cnt = 0; sys_i && vpi_scan(sys_i); cnt++);
-
-      return cnt;
+      return __tf_argument_count((vpiHandle)obj);
 }
 
 int tf_nump(void)
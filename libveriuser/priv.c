@@ -18,8 +18,10 @@
  */
 
 # include  "priv.h"
+# include  <stdlib.h>
 # include  <string.h>
 # include  <assert.h>
+# include  "ivl_alloc.h"
 
 FILE* pli_trace = 0;
 
@@ -52,3 +54,108 @@ char* __acc_newstring(const char*txt)
 
       return res;
 }
+
+/*
+ * The argument handles of a system task/function call never change,
+ * so keep them in a small hash table keyed by the call handle. The
+ * first lookup for a call site scans the arguments once, and every
+ * later lookup is a hash probe and an array index.
+ */
+struct tfarg_cell {
+      vpiHandle sys;
+      int argc;
+      vpiHandle*argv;
+      struct tfarg_cell*next;
+};
+
+#define TFARG_HASH_SIZE 1024
+static struct tfarg_cell*tfarg_table[TFARG_HASH_SIZE];
+
+static unsigned tfarg_hash(vpiHandle sys)
+{
+      unsigned long key = (unsigned long)sys;
+      return (unsigned)((key >> 4) ^ (key >> 14)) % TFARG_HASH_SIZE;
+}
+
+static PLI_INT32 tfarg_cleanup(p_cb_data cause)
+{
+      unsigned idx;
+
+      (void) cause;  /* Parameter is not used. */
+
+      for (idx = 0 ; idx < TFARG_HASH_SIZE ; idx += 1) {
+	    while (tfarg_table[idx]) {
+		  struct tfarg_cell*cur = tfarg_table[idx];
+		  tfarg_table[idx] = cur->next;
+		  free(cur->argv);
+		  free(cur);
+	    }
+      }
+
+      return 0;
+}
+
+static struct tfarg_cell* tfarg_lookup(vpiHandle sys)
+{
+      static int need_cleanup_cb = 1;
+      unsigned key = tfarg_hash(sys);
+      struct tfarg_cell*cur;
+      vpiHandle argv, arg;
+
+      for (cur = tfarg_table[key] ; cur ; cur = cur->next) {
+	    if (cur->sys == sys)
+		  return cur;
+      }
+
+      cur = calloc(1, sizeof(struct tfarg_cell));
+      cur->sys = sys;
+
+      argv = vpi_iterate(vpiArgument, sys);
+      if (argv) {
+	    while ((arg = vpi_scan(argv))) {
+		  cur->argc += 1;
+		  cur->argv = realloc(cur->argv,
+		                      cur->argc * sizeof(vpiHandle));
+		  cur->argv[cur->argc-1] = arg;
+	    }
+      }
+
+      cur->next = tfarg_table[key];
+      tfarg_table[key] = cur;
+
+      if (need_cleanup_cb) {
+	    s_cb_data cb;
+	    cb.reason = cbEndOfSimulation;
+	    cb.cb_rtn = tfarg_cleanup;
+	    cb.obj = 0;
+	    cb.time = 0;
+	    cb.value = 0;
+	    cb.user_data = 0;
+	    vpi_register_cb(&cb);
+	    need_cleanup_cb = 0;
+      }
+
+      return cur;
+}
+
+vpiHandle __tf_argument(vpiHandle sys, int n)
+{
+      struct tfarg_cell*cur;
+
+      if (sys == 0 || n <= 0)
+	    return 0;
+
+      cur = tfarg_lookup(sys);
+      if (n > cur->argc)
+	    return 0;
+
+      return cur->argv[n-1];
+}
+
+int __tf_argument_count(vpiHandle sys)
+{
+      if (sys == 0)
+	    return 0;
+
+      return tfarg_lookup(sys)->argc;
+}
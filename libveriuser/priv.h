@@ -20,6 +20,7 @@
  */
 
 # include  <stdio.h>
+# include  <vpi_user.h>
 
 /*
  * This function implements the acc_ string buffer, by adding the
@@ -28,6 +29,20 @@
  */
 extern char* __acc_newstring(const char*txt);
 
+/*
+ * Return the handle of the nth (1 based) argument of the system
+ * task/function call sys, or 0 if there is no such argument. The
+ * argument handles of each call site are collected once and cached,
+ * so the tf_* and acc_*tfarg routines do not need to iterate the
+ * arguments on every call.
+ */
+extern vpiHandle __tf_argument(vpiHandle sys, int n);
+
+/*
+ * Return the number of arguments of the system task/function call.
+ */
+extern int __tf_argument_count(vpiHandle sys);
+
 /*
  * Trace file for logging ACC and TF calls.
  */
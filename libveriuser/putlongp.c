@@ -21,13 +21,14 @@
 #include  <assert.h>
 #include  <veriuser.h>
 #include  <vpi_user.h>
+#include  "priv.h"
 
 /*
  * tf_putlongp implemented using VPI interface
  */
 void tf_putlongp(int n, int lowvalue, int highvalue)
 {
-      vpiHandle sys_h, sys_i, arg_h = 0;
+      vpiHandle sys_h, arg_h = 0;
       s_vpi_value val;
       int type;
       char str[20];
@@ -37,7 +38,6 @@ void tf_putlongp(int n, int lowvalue, int highvalue)
 
       /* get task/func handle */
       sys_h = vpi_handle(vpiSysTfCall, 0);
-      sys_i = vpi_iterate(vpiArgument, sys_h);
 
       type = vpi_get(vpiType, sys_h);
 
@@ -45,17 +45,16 @@ void tf_putlongp(int n, int lowvalue, int highvalue)
       assert(!(n == 0 && type != vpiSysFuncCall));
 
       /* find nth arg */
-      while (n > 0) {
-	    if (!(arg_h = vpi_scan(sys_i))) assert(0);
-	    n--;
+      if (n > 0) {
+	    arg_h = __tf_argument(sys_h, n);
+	    assert(arg_h);
+      } else {
+	    arg_h = sys_h;
       }
-      if (!arg_h) arg_h = sys_h;
 
       /* fill in vpi_value */
       sprintf(str, "%x%08x", highvalue, lowvalue);
       val.format = vpiHexStrVal;
       val.value.str = str;
       vpi_put_value(arg_h, &val, 0, vpiNoDelay);
-
-      vpi_free_object(sys_i);
 }
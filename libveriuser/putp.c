@@ -27,7 +27,7 @@
  */
 PLI_INT32 tf_iputp(PLI_INT32 n, PLI_INT32 value, void *obj)
 {
-      vpiHandle sys_h, sys_i, arg_h = 0;
+      vpiHandle sys_h, arg_h;
       s_vpi_value val;
       int rtn = 0, type;
 
@@ -60,22 +60,15 @@ PLI_INT32 tf_iputp(PLI_INT32 n, PLI_INT32 value, void *obj)
 	    return 1;
       }
 
-      sys_i = vpi_iterate(vpiArgument, sys_h);
-
       /* find nth arg */
-      while (n > 0) {
-	    if (!(arg_h = vpi_scan(sys_i))) { rtn = 1; goto out; }
-	    n--;
-      }
+      arg_h = __tf_argument(sys_h, n);
+      if (!arg_h) { rtn = 1; goto out; }
 
       /* fill in vpi_value */
       val.format = vpiIntVal;
       val.value.integer = value;
       vpi_put_value(arg_h, &val, 0, vpiNoDelay);
 
-      if (arg_h)
-	    vpi_free_object(sys_i);
-
  out:
       if (pli_trace) {
 	    fprintf(pli_trace, "tf_iputp(n=%d, value=%d, obj=%p) --> %d\n",
@@ -95,7 +88,7 @@ PLI_INT32 tf_putp(PLI_INT32 n, PLI_INT32 value)
 
 PLI_INT32 tf_iputrealp(PLI_INT32 n, double value, void *obj)
 {
-      vpiHandle sys_h, sys_i, arg_h = 0;
+      vpiHandle sys_h, arg_h;
       s_vpi_value val;
       int rtn = 0, type;
 
@@ -103,28 +96,25 @@ PLI_INT32 tf_iputrealp(PLI_INT32 n, double value, void *obj)
 
       /* get task/func handle */
       sys_h = (vpiHandle)obj;
-      sys_i = vpi_iterate(vpiArgument, sys_h);
 
       type = vpi_get(vpiType, sys_h);
 
       /* verify function */
-      if (n == 0 && type != vpiSysFuncCall) { rtn = 1; goto free; }
+      if (n == 0 && type != vpiSysFuncCall) { rtn = 1; goto out; }
 
       /* find nth arg */
-      while (n > 0) {
-	    if (!(arg_h = vpi_scan(sys_i))) { rtn = 1; goto out; }
-	    n--;
+      if (n > 0) {
+	    arg_h = __tf_argument(sys_h, n);
+	    if (!arg_h) { rtn = 1; goto out; }
+      } else {
+	    arg_h = sys_h;
       }
-      if (!arg_h) arg_h = sys_h;
 
       /* fill in vpi_value */
       val.format = vpiRealVal;
       val.value.real = value;
       vpi_put_value(arg_h, &val, 0, vpiNoDelay);
 
-free:
-      vpi_free_object(sys_i);
-
 out:
       if (pli_trace) {
 	    fprintf(pli_trace, "tf_iputrealp(n=%d, value=%f, obj=%p) --> %d\n",
@@ -20,25 +20,20 @@
 #include  <assert.h>
 #include  <veriuser.h>
 #include  <vpi_user.h>
+#include  "priv.h"
 
 PLI_INT32 tf_typep(PLI_INT32 narg)
 {
-      vpiHandle sys_h, argv, arg_h = 0;
+      vpiHandle arg_h;
       int rtn;
 
       assert(narg > 0);
 
-      /* get task/func handle */
-      sys_h = vpi_handle(vpiSysTfCall, 0);
-      argv = vpi_iterate(vpiArgument, sys_h);
-
-      /* find nth arg */
-      while (narg > 0) {
-	      /* Watch that the argument is not out of range. */
-	    if (!(arg_h = vpi_scan(argv)))
-		  return TF_NULLPARAM;
-	    narg -= 1;
-      }
+      /* find nth arg of the task/func */
+      arg_h = __tf_argument(vpi_handle(vpiSysTfCall, 0), narg);
+	/* Watch that the argument is not out of range. */
+      if (!arg_h)
+	    return TF_NULLPARAM;
 
       switch (vpi_get(vpiType, arg_h)) {
 	  case vpiConstant:
@@ -70,6 +65,5 @@ PLI_INT32 tf_typep(PLI_INT32 narg)
 	    break;
       }
 
-      vpi_free_object(argv);
       return rtn;
 }
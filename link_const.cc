@@ -29,9 +29,10 @@
  */
 bool Nexus::drivers_constant() const
 {
-      if (driven_ == VAR)
+      summary_t&sum = get_summary_();
+      if (sum.driven == VAR)
 	    return false;
-      if (driven_ != NO_GUESS)
+      if (sum.driven != NO_GUESS)
 	    return true;
 
       unsigned constant_drivers = 0;
@@ -41,7 +42,7 @@ bool Nexus::drivers_constant() const
 		 can't be treated as constant. */
 	    const NetNet*sig = dynamic_cast<const NetNet*>(cur->get_obj());
 	    if (sig && (sig->peek_lref() > 0)) {
-		  driven_ = VAR;
+		  sum.driven = VAR;
 		  return false;
 	    }
 
@@ -49,7 +50,7 @@ bool Nexus::drivers_constant() const
 		 on the other side of the tran. We could try checking
 		 for this, but for now, be pessimistic. */
 	    if (dynamic_cast<const NetTran*>(cur->get_obj())) {
-		  driven_ = VAR;
+		  sum.driven = VAR;
 		  return false;
 	    }
 
@@ -80,7 +81,7 @@ bool Nexus::drivers_constant() const
 		  if (sig->port_type() == NetNet::POUTPUT)
 			continue;
 
-		  driven_ = VAR;
+		  sum.driven = VAR;
 		  return false;
 	    }
 
@@ -91,12 +92,12 @@ bool Nexus::drivers_constant() const
 		      case NetNet::SUPPLY0:
 		      case NetNet::TRI0:
 			constant_drivers += 1;
-			driven_ = V0;
+			sum.driven = V0;
 			continue;
 		      case NetNet::SUPPLY1:
 		      case NetNet::TRI1:
 			constant_drivers += 1;
-			driven_ = V1;
+			sum.driven = V1;
 			continue;
 		      default:
 			break;
@@ -109,12 +110,12 @@ bool Nexus::drivers_constant() const
 			constant_drivers += 1;
 			continue;
 		  }
-		  driven_ = VAR;
+		  sum.driven = VAR;
 		  return false;
 	    }
 
 	    if (! dynamic_cast<const NetConst*>(cur->get_obj())) {
-		  driven_ = VAR;
+		  sum.driven = VAR;
 		  return false;
 	    }
 
@@ -127,7 +128,7 @@ bool Nexus::drivers_constant() const
 	   will rarely occur, so for now leave the resolution to be done
 	   at run time. */
       if (constant_drivers > 1) {
-	    driven_ = VAR;
+	    sum.driven = VAR;
 	    return false;
       }
 
@@ -136,7 +137,8 @@ bool Nexus::drivers_constant() const
 
 verinum::V Nexus::driven_value() const
 {
-      switch (driven_) {
+      summary_t&sum = get_summary_();
+      switch (sum.driven) {
 	  case V0:
 	    return verinum::V0;
 	  case V1:
@@ -188,16 +190,16 @@ verinum::V Nexus::driven_value() const
 	/* Cache the result. */
       switch (val) {
 	  case verinum::V0:
-	    driven_ = V0;
+	    sum.driven = V0;
 	    break;
 	  case verinum::V1:
-	    driven_ = V1;
+	    sum.driven = V1;
 	    break;
 	  case verinum::Vx:
-	    driven_ = Vx;
+	    sum.driven = Vx;
 	    break;
 	  case verinum::Vz:
-	    driven_ = Vz;
+	    sum.driven = Vz;
 	    break;
       }
 
@@ -270,11 +272,11 @@ verinum Nexus::driven_vector() const
  * Calculate a vector that represent all the bits of the vector, with
  * each driven bit set to true, otherwise false.
  */
-vector<bool> Nexus::driven_mask(void) const
+static vector<bool> collect_driven_mask(const Nexus*nex)
 {
-      vector<bool> mask (vector_width());
+      vector<bool> mask (nex->vector_width());
 
-      for (const Link*cur = first_nlink() ; cur ; cur = cur->next_nlink()) {
+      for (const Link*cur = nex->first_nlink() ; cur ; cur = cur->next_nlink()) {
 
 	    Link::DIR link_dir = cur->get_dir();
 	    if (link_dir==Link::PASSIVE)
@@ -326,3 +328,17 @@ vector<bool> Nexus::driven_mask(void) const
 
       return mask;
 }
+
+/*
+ * The mask is kept in the connectivity summary, so it is only
+ * collected again after the links of the nexus change.
+ */
+vector<bool> Nexus::driven_mask(void) const
+{
+      summary_t&sum = get_summary_();
+      if (! sum.mask_valid) {
+	    sum.mask = collect_driven_mask(this);
+	    sum.mask_valid = true;
+      }
+      return sum.mask;
+}
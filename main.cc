@@ -61,6 +61,8 @@ const char NOTICE[] =
 # include  "compiler.h"
 # include  "discipline.h"
 # include  "t-dll.h"
+# include  "ObjectHeap.h"
+# include  "rebuild_cache.h"
 
 #if defined(__MINGW32__) && !defined(HAVE_GETOPT_H)
 extern "C" int getopt(int argc, char*argv[], const char*fmt);
@@ -200,6 +202,7 @@ bool disable_virtual_pins = false;
 unsigned long array_size_limit = 16777216;  // Minimum required by IEEE-1364?
 unsigned recursive_mod_limit = 10;
 bool disable_concatz_generation = false;
+bool lazy_target_statements = false;
 
 /*
  * Verbose messages enabled.
@@ -896,6 +899,10 @@ static void EOC_cleanup(void)
       lex_strings.cleanup();
       bits_strings.cleanup();
       filename_strings.cleanup();
+
+	// main() does not delete the design. The pooled parse tree
+	// and netlist objects all go away here, at once.
+      ObjectHeap::release_all();
 }
 
 int main(int argc, char*argv[])
@@ -934,6 +941,7 @@ int main(int argc, char*argv[])
 
 	  case 'C':
 	    read_iconfig_file(optarg);
+	    rebuild_cache_config(optarg);
 	    break;
 	  case 'F':
 	    read_sources_file(optarg);
@@ -1118,8 +1126,23 @@ int main(int argc, char*argv[])
       flag_tmp = flags["DISABLE_CONCATZ_GENERATION"];
       if (flag_tmp) disable_concatz_generation = strcmp(flag_tmp,"true")==0;
 
+      flag_tmp = flags["LAZY_STATEMENTS"];
+      if (flag_tmp) lazy_target_statements = strcmp(flag_tmp,"true")==0;
+
+	/* If the same design was compiled before with the same
+	   configuration, use the output of that compile. The debug
+	   dumps and dependency files need the real compile. */
+      flag_tmp = flags["CACHE_DIR"];
+      if (flag_tmp && depfile_name == 0 && pf_path == 0 && net_path == 0
+	  && rebuild_cache_open(flag_tmp, flags, source_files)
+	  && rebuild_cache_lookup(flags["-o"])) {
+	    EOC_cleanup();
+	    return 0;
+      }
+
 	/* Parse the input. Make the pform. */
       int rc = 0;
+      int emit_rc = 0;
       for (unsigned idx = 0; idx < source_files.size(); idx += 1) {
 	    rc += pform_parse(source_files[idx]);
       }
@@ -1312,7 +1335,13 @@ int main(int argc, char*argv[])
 	    cout << "CODE GENERATION" << endl;
       }
 
-      if (int emit_rc = des->emit(&dll_target_obj)) {
+      if (rebuild_cache_enabled)
+	    rebuild_cache_target_begin();
+      emit_rc = des->emit(&dll_target_obj);
+      if (rebuild_cache_enabled)
+	    rebuild_cache_target_end();
+
+      if (emit_rc) {
 	    if (emit_rc > 0) {
 		  cerr << "error: Code generation had "
 		       << emit_rc << " error(s)."
@@ -1326,6 +1355,9 @@ int main(int argc, char*argv[])
 	    assert(emit_rc);
       }
 
+      if (rebuild_cache_enabled)
+	    rebuild_cache_store(flags["-o"]);
+
       if (verbose_flag) {
 	    if (times_flag) {
 		  times(cycles+4);
@@ -1342,9 +1374,10 @@ int main(int argc, char*argv[])
 		 << " add_count=" << lex_strings.add_count()
 		 << " hit_count=" << lex_strings.add_hit_count()
 		 << endl;
+	    ObjectHeap::dump_statistics(cout);
       }
 
-      delete des;
+	// The design is not deleted, see EOC_cleanup().
       EOC_cleanup();
       return 0;
 
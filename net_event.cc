@@ -297,6 +297,30 @@ NetEvProbe::edge_t NetEvProbe::edge() const
       return edge_;
 }
 
+void NetEvProbe::set_part(unsigned idx, unsigned base, unsigned wid)
+{
+      ivl_assert(*this, edge_ == ANYEDGE);
+      ivl_assert(*this, idx < pin_count());
+
+      if (part_wid_.empty()) {
+	    part_base_.resize(pin_count(), 0);
+	    part_wid_.resize(pin_count(), 0);
+      }
+
+      part_base_[idx] = base;
+      part_wid_[idx] = wid;
+}
+
+unsigned NetEvProbe::part_base(unsigned idx) const
+{
+      return part_base_.empty()? 0 : part_base_[idx];
+}
+
+unsigned NetEvProbe::part_wid(unsigned idx) const
+{
+      return part_wid_.empty()? 0 : part_wid_[idx];
+}
+
 NetEvent* NetEvProbe::event()
 {
       return event_;
@@ -340,6 +364,12 @@ void NetEvProbe::find_similar_probes(list<NetEvProbe*>&plist)
 		  if (! pin(idx).is_linked(tmp->pin(idx)))
 			ok_flag = false;
 
+	      // Probes that watch different parts are not the same.
+	    for (unsigned idx = 0 ;  ok_flag && idx < pin_count() ;  idx += 1)
+		  if (part_base(idx) != tmp->part_base(idx) ||
+		      part_wid(idx) != tmp->part_wid(idx))
+			ok_flag = false;
+
 	    if (ok_flag == true)
 		  plist .push_back(tmp);
       }
@@ -26,6 +26,7 @@
 # include  "netmisc.h"
 # include  <iostream>
 # include  "ivl_assert.h"
+# include  "ObjectHeap.h"
 
 NetExpr::NetExpr(unsigned w)
 : net_type_(0), width_(w), signed_flag_(false)
@@ -41,6 +42,18 @@ NetExpr::~NetExpr()
 {
 }
 
+static ObjectHeap netexpr_heap ("NetExpr");
+
+void* NetExpr::operator new(size_t size)
+{
+      return netexpr_heap.alloc(size);
+}
+
+void NetExpr::operator delete(void*ptr, size_t size)
+{
+      netexpr_heap.free(ptr, size);
+}
+
 ivl_type_t NetExpr::net_type() const
 {
       return net_type_;
@@ -27,6 +27,7 @@
 # include  <string>
 # include  <typeinfo>
 # include  <cstdlib>
+# include  "ObjectHeap.h"
 # include  "ivl_alloc.h"
 
 void Nexus::connect(Link&r)
@@ -37,6 +38,7 @@ void Nexus::connect(Link&r)
 
       delete[] name_;
       name_ = 0;
+      summary_valid_ = false;
 
 	// Special case: This nexus is empty. Simply copy all the
 	// links of the other nexus to this one, and delete the old
@@ -46,9 +48,9 @@ void Nexus::connect(Link&r)
 		  list_ = &r;
 		  r.next_ = &r;
 		  r.nexus_ = this;
-		  driven_ = NO_GUESS;
+		  nlinks_ = 1;
 	    } else {
-		  driven_ = r_nexus->driven_;
+		  nlinks_ = r_nexus->nlinks_;
 		  list_ = r_nexus->list_;
 		  list_->nexus_ = this;
 		  r_nexus->list_ = 0;
@@ -61,20 +63,15 @@ void Nexus::connect(Link&r)
 	// the current list and move the list_ pointer and nexus_ back
 	// pointer to suit.
       if (r.next_ == 0) {
-	    if (r.get_dir() != Link::INPUT)
-		  driven_ = NO_GUESS;
-
 	    r.nexus_ = this;
 	    r.next_ = list_->next_;
 	    list_->next_ = &r;
 	    list_->nexus_ = 0;
 	    list_ = &r;
+	    nlinks_ += 1;
 	    return;
       }
 
-      if (r_nexus->driven_ != Vz)
-	    driven_ = NO_GUESS;
-
 	// Splice the list of links from the "tmp" nexus to the end of
 	// this nexus. Adjust the nexus pointers as needed.
       Link*save_first = list_->next_;
@@ -83,6 +80,7 @@ void Nexus::connect(Link&r)
       list_->nexus_ = 0;
       list_ = r_nexus->list_;
       list_->nexus_ = this;
+      nlinks_ += r_nexus->nlinks_;
 
       r_nexus->list_ = 0;
       delete r_nexus;
@@ -125,6 +123,18 @@ Link::~Link()
       }
 }
 
+static ObjectHeap link_heap ("Link");
+
+void* Link::operator new[](size_t size)
+{
+      return link_heap.alloc(size);
+}
+
+void Link::operator delete[](void*ptr, size_t size)
+{
+      link_heap.free(ptr, size);
+}
+
 Nexus* Link::find_nexus_() const
 {
       assert(next_);
@@ -154,7 +164,12 @@ const Nexus* Link::nexus() const
 
 void Link::set_dir(DIR d)
 {
+      if (dir_ == d)
+	    return;
+
       dir_ = d;
+      if (next_)
+	    find_nexus_()->connectivity_changed();
 }
 
 Link::DIR Link::get_dir() const
@@ -249,21 +264,21 @@ bool Link::is_linked(const Link&that) const
 Nexus::Nexus(Link&that)
 {
       name_ = 0;
-      driven_ = NO_GUESS;
       t_cookie_ = 0;
+      summary_valid_ = false;
 
       if (that.next_ == 0) {
 	    list_ = &that;
 	    that.next_ = &that;
 	    that.nexus_ = this;
-	    driven_ = NO_GUESS;
+	    nlinks_ = 1;
 
       } else {
 	    Nexus*tmp = that.find_nexus_();
 	    list_ = tmp->list_;
 	    list_->nexus_ = this;
-	    driven_ = tmp->driven_;
 	    name_ = tmp->name_;
+	    nlinks_ = tmp->nlinks_;
 
 	    tmp->list_ = 0;
 	    tmp->name_ = 0;
@@ -277,6 +292,18 @@ Nexus::~Nexus()
       delete[] name_;
 }
 
+static ObjectHeap nexus_heap ("Nexus");
+
+void* Nexus::operator new(size_t size)
+{
+      return nexus_heap.alloc(size);
+}
+
+void Nexus::operator delete(void*ptr, size_t size)
+{
+      nexus_heap.free(ptr, size);
+}
+
 bool Nexus::assign_lval() const
 {
       for (const Link*cur = first_nlink() ; cur ; cur = cur->next_nlink()) {
@@ -295,65 +322,79 @@ bool Nexus::assign_lval() const
       return false;
 }
 
-void Nexus::count_io(unsigned&inp, unsigned&out) const
-{
-      for (const Link*cur = first_nlink() ;  cur ; cur = cur->next_nlink()) {
+/*
+ * Collect the connectivity summary in one walk of the link list. The
+ * summary stays valid until a link is connected or unlinked, or until
+ * connectivity_changed() is called.
+ */
+Nexus::summary_t& Nexus::get_summary_() const
+{
+      if (summary_valid_)
+	    return summary_;
+
+      summary_.inputs = 0;
+      summary_.outputs = 0;
+      summary_.passive_drivers = false;
+      summary_.any_net = 0;
+      summary_.any_node = 0;
+      summary_.driven = NO_GUESS;
+      summary_.mask_valid = false;
+
+      for (Link*cur = list_? list_->next_ : 0 ; cur ; cur = cur->next_nlink()) {
+	    NetPins*obj = cur->get_obj();
+	    NetNet*net = dynamic_cast<NetNet*>(obj);
+	    if (net && summary_.any_net == 0)
+		  summary_.any_net = net;
+	    if (summary_.any_node == 0)
+		  summary_.any_node = dynamic_cast<NetNode*>(obj);
+
 	    switch (cur->get_dir()) {
 		case Link::INPUT:
-		  inp += 1;
+		  summary_.inputs += 1;
 		  break;
 		case Link::OUTPUT:
-		  out += 1;
+		  summary_.outputs += 1;
 		  break;
 		default:
+		    // Some kinds of PASSIVE nets may drive the
+		    // nexus. Note that supply0/1 and tri0/1 nets
+		    // are classified as OUTPUT.
+		  if (net) switch (net->type()) {
+		      case NetNet::WAND:
+		      case NetNet::WOR:
+		      case NetNet::TRIAND:
+		      case NetNet::TRIOR:
+		      case NetNet::REG:
+			summary_.passive_drivers = true;
+			break;
+		      default:
+			break;
+		  }
 		  break;
 	    }
       }
+
+      summary_valid_ = true;
+      return summary_;
 }
 
-bool Nexus::has_floating_input() const
+void Nexus::count_io(unsigned&inp, unsigned&out) const
 {
-      bool found_input = false;
-      for (const Link*cur = first_nlink() ;  cur ; cur = cur->next_nlink()) {
-	    if (cur->get_dir() == Link::OUTPUT)
-		  return false;
-
-	    if (cur->get_dir() == Link::INPUT)
-		  found_input = true;
-      }
+      const summary_t&sum = get_summary_();
+      inp += sum.inputs;
+      out += sum.outputs;
+}
 
-      return found_input;
+bool Nexus::has_floating_input() const
+{
+      const summary_t&sum = get_summary_();
+      return sum.outputs == 0 && sum.inputs > 0;
 }
 
 bool Nexus::drivers_present() const
 {
-      for (const Link*cur = first_nlink() ;  cur ; cur = cur->next_nlink()) {
-	    if (cur->get_dir() == Link::OUTPUT)
-		  return true;
-
-	    if (cur->get_dir() == Link::INPUT)
-		  continue;
-
-	      // Must be PASSIVE, so if it is some kind of net, see if
-	      // it is the sort that might drive the nexus. Note that
-	      // supply0/1 and tri0/1 nets are classified as OUTPUT.
-	    const NetPins*obj;
-	    unsigned pin;
-	    cur->cur_link(obj, pin);
-	    if (const NetNet*net = dynamic_cast<const NetNet*>(obj))
-		  switch (net->type()) {
-		      case NetNet::WAND:
-		      case NetNet::WOR:
-		      case NetNet::TRIAND:
-		      case NetNet::TRIOR:
-		      case NetNet::REG:
-			return true;
-		      default:
-			break;
-		  }
-      }
-
-      return false;
+      const summary_t&sum = get_summary_();
+      return sum.outputs > 0 || sum.passive_drivers;
 }
 
 void Nexus::drivers_delays(NetExpr*rise, NetExpr*fall, NetExpr*decay)
@@ -387,8 +428,11 @@ void Nexus::unlink(Link*that)
 {
       delete[] name_;
       name_ = 0;
+      summary_valid_ = false;
 
       assert(that);
+      assert(nlinks_ > 0);
+      nlinks_ -= 1;
 
 	// Special case: the Link is the only link in the nexus. In
 	// this case, the unlink is trivial. Also clear the Nexus
@@ -397,17 +441,11 @@ void Nexus::unlink(Link*that)
 	    assert(that->nexus_ == this);
 	    assert(list_ == that);
 	    list_ = 0;
-	    driven_ = NO_GUESS;
 	    that->nexus_ = 0;
 	    that->next_ = 0;
 	    return;
       }
 
-	// If the link I'm removing was a driver for this nexus, then
-	// cancel my guess of the driven value.
-      if (that->get_dir() != Link::INPUT)
-	    driven_ = NO_GUESS;
-
 	// Look for the Link that points to "that". We know that there
 	// will be one because the list is a circle. When we find the
 	// prev pointer, then remove that from the list.
@@ -459,37 +497,18 @@ void Nexus::t_cookie(ivl_nexus_t val) const
 
 unsigned Nexus::vector_width() const
 {
-      for (const Link*cur = first_nlink() ; cur ; cur = cur->next_nlink()) {
-	    const NetNet*sig = dynamic_cast<const NetNet*>(cur->get_obj());
-	    if (sig == 0)
-		  continue;
-
-	    return sig->vector_width();
-      }
-
-      return 0;
+      const NetNet*sig = get_summary_().any_net;
+      return sig? sig->vector_width() : 0;
 }
 
 NetNet* Nexus::pick_any_net()
 {
-      for (Link*cur = first_nlink() ; cur ; cur = cur->next_nlink()) {
-	    NetNet*sig = dynamic_cast<NetNet*>(cur->get_obj());
-	    if (sig != 0)
-		  return sig;
-      }
-
-      return 0;
+      return get_summary_().any_net;
 }
 
 NetNode* Nexus::pick_any_node()
 {
-      for (Link*cur = first_nlink() ; cur ; cur = cur->next_nlink()) {
-	    NetNode*node = dynamic_cast<NetNode*>(cur->get_obj());
-	    if (node != 0)
-		  return node;
-      }
-
-      return 0;
+      return get_summary_().any_node;
 }
 
 const char* Nexus::name() const
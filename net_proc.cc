@@ -83,6 +83,21 @@ const NetProc* NetBlock::proc_next(const NetProc*cur) const
       return cur->next_;
 }
 
+NetProc* NetBlock::proc_remove_first()
+{
+      if (last_ == 0)
+	    return 0;
+
+      NetProc*cur = last_->next_;
+      if (cur == last_)
+	    last_ = 0;
+      else
+	    last_->next_ = cur->next_;
+
+      cur->next_ = cur;
+      return cur;
+}
+
 NetCase::NetCase(ivl_case_quality_t q, NetCase::TYPE c, NetExpr*ex, unsigned cnt)
 : quality_(q), type_(c), expr_(ex), items_(cnt)
 {
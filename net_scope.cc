@@ -635,6 +635,11 @@ void NetScope::add_event(NetEvent*ev)
       events_ = ev;
 }
 
+void NetScope::add_timing_check(NetTimingCheck*tchk)
+{
+      timing_checks_.push_back(tchk);
+}
+
 void NetScope::rem_event(NetEvent*ev)
 {
       assert(ev->scope_ == this);
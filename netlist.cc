@@ -36,6 +36,7 @@
 # include  "netstruct.h"
 # include  "netvector.h"
 # include  "ivl_assert.h"
+# include  "ObjectHeap.h"
 
 
 ostream& operator<< (ostream&o, NetNet::Type t)
@@ -478,6 +479,121 @@ bool NetDelaySrc::is_parallel() const
       return parallel_;
 }
 
+NetTimingCheck::NetTimingCheck(NetScope*s, perm_string n, ivl_tchk_type_t t)
+: NetObj(s, n, 4), type_(t), ref_edge_(0), data_edge_(0), notifier_(0)
+{
+      limits_[0] = 0;
+      limits_[1] = 0;
+      for (unsigned idx = 0 ;  idx < pin_count() ;  idx += 1)
+	    pin(idx).set_dir(Link::INPUT);
+}
+
+NetTimingCheck::~NetTimingCheck()
+{
+}
+
+ivl_tchk_type_t NetTimingCheck::type() const
+{
+      return type_;
+}
+
+void NetTimingCheck::set_ref_edge(unsigned mask)
+{
+      ref_edge_ = mask;
+}
+
+void NetTimingCheck::set_data_edge(unsigned mask)
+{
+      data_edge_ = mask;
+}
+
+unsigned NetTimingCheck::ref_edge() const
+{
+      return ref_edge_;
+}
+
+unsigned NetTimingCheck::data_edge() const
+{
+      return data_edge_;
+}
+
+void NetTimingCheck::set_limits(uint64_t limit0, uint64_t limit1)
+{
+      limits_[0] = limit0;
+      limits_[1] = limit1;
+}
+
+uint64_t NetTimingCheck::limit(unsigned idx) const
+{
+      ivl_assert(*this, idx < 2);
+      return limits_[idx];
+}
+
+void NetTimingCheck::set_notifier(NetNet*sig)
+{
+      notifier_ = sig;
+}
+
+const NetNet* NetTimingCheck::notifier() const
+{
+      return notifier_;
+}
+
+Link& NetTimingCheck::ref_pin()
+{
+      return pin(0);
+}
+
+const Link& NetTimingCheck::ref_pin() const
+{
+      return pin(0);
+}
+
+Link& NetTimingCheck::data_pin()
+{
+      return pin(1);
+}
+
+const Link& NetTimingCheck::data_pin() const
+{
+      return pin(1);
+}
+
+Link& NetTimingCheck::ref_cond_pin()
+{
+      return pin(2);
+}
+
+const Link& NetTimingCheck::ref_cond_pin() const
+{
+      return pin(2);
+}
+
+Link& NetTimingCheck::data_cond_pin()
+{
+      return pin(3);
+}
+
+const Link& NetTimingCheck::data_cond_pin() const
+{
+      return pin(3);
+}
+
+bool NetTimingCheck::has_data() const
+{
+      return pin(1).is_linked();
+}
+
+bool NetTimingCheck::has_ref_cond() const
+{
+      return pin(2).is_linked();
+}
+
+bool NetTimingCheck::has_data_cond() const
+{
+      return pin(3).is_linked();
+}
+
 PortType::Enum PortType::merged( Enum lhs, Enum rhs )
 {
     if( lhs == NOT_A_PORT || rhs == NOT_A_PORT )
@@ -645,6 +761,18 @@ NetNet::NetNet(NetScope*s, perm_string n, Type t, netvector_t*ty)
       s->add_signal(this);
 }
 
+static ObjectHeap netnet_heap ("NetNet");
+
+void* NetNet::operator new(size_t size)
+{
+      return netnet_heap.alloc(size);
+}
+
+void NetNet::operator delete(void*ptr, size_t size)
+{
+      netnet_heap.free(ptr, size);
+}
+
 NetNet::~NetNet()
 {
       if (eref_count_ > 0) {
@@ -679,6 +807,15 @@ void NetNet::type(NetNet::Type t)
       type_ = t;
 
       initialize_dir_();
+
+	// The type decides whether a passive net drives its nexus.
+      if (! pins_are_virtual()) {
+	    const NetNet*self = this;
+	    for (unsigned idx = 0 ; idx < pin_count() ; idx += 1) {
+		  if (const Nexus*nex = self->pin(idx).nexus())
+			nex->connectivity_changed();
+	    }
+      }
 }
 
 
@@ -114,6 +114,10 @@ class Link {
       Link();
       ~Link();
 
+	// The pin arrays are allocated from a pool (see ObjectHeap.h).
+      static void* operator new[](size_t size);
+      static void operator delete[](void*ptr, size_t size);
+
     public:
 	// Manipulate the link direction.
       void set_dir(DIR d);
@@ -362,6 +366,10 @@ class Nexus {
       explicit Nexus(Link&r);
       ~Nexus();
 
+	// Nexus objects are allocated from a pool (see ObjectHeap.h).
+      static void* operator new(size_t size);
+      static void operator delete(void*ptr, size_t size);
+
     public:
 
       void connect(Link&r);
@@ -374,6 +382,16 @@ class Nexus {
       Link*first_nlink();
       const Link* first_nlink()const;
 
+	/* The number of links in this nexus. This is kept up to date
+	   as links are connected and unlinked, so it costs nothing. */
+      unsigned link_count() const { return nlinks_; }
+
+	/* Discard the cached connectivity summary. The Nexus does
+	   this itself when links come and go, but the owner of a
+	   linked pin must call it if it changes something that the
+	   summary depends on, such as the type of a NetNet. */
+      void connectivity_changed() const { summary_valid_ = false; }
+
 	/* Get the width of the Nexus, or 0 if there are no vectors
 	   (in the form of NetNet objects) linked. */
       unsigned vector_width() const;
@@ -427,7 +445,29 @@ class Nexus {
       mutable ivl_nexus_t t_cookie_;
 
       enum VALUE { NO_GUESS, V0, V1, Vx, Vz, VAR };
-      mutable VALUE driven_;
+
+      unsigned nlinks_;
+
+	// The connectivity queries (count_io, drivers_present,
+	// pick_any_net, etc.) are answered from this summary, which
+	// is collected in a single walk of the link list the first
+	// time it is needed after a change. The drivers_constant and
+	// driven_value verdict and the driven_mask are filled in the
+	// first time they are asked for, and are discarded with the
+	// rest of the summary.
+      struct summary_t {
+	    unsigned inputs;
+	    unsigned outputs;
+	    bool passive_drivers;
+	    NetNet*any_net;
+	    NetNode*any_node;
+	    VALUE driven;
+	    bool mask_valid;
+	    std::vector<bool> mask;
+      };
+      mutable summary_t summary_;
+      mutable bool summary_valid_;
+      summary_t& get_summary_() const;
 
     private: // not implemented
       Nexus(const Nexus&);
@@ -607,6 +647,68 @@ class NetDelaySrc  : public NetObj {
       NetDelaySrc& operator= (const NetDelaySrc&);
 };
 
+/*
+ * A NetTimingCheck is a $setup, $hold, $setuphold, $recovery, $width
+ * or $period timing check from a specify block. The check belongs to
+ * the scope of the specify block, and the pins connect it to the
+ * signals that it watches:
+ *
+ *    pin 0 -- The reference signal
+ *    pin 1 -- The data signal (not connected for $width and $period)
+ *    pin 2 -- The &&& condition of the reference event, if any
+ *    pin 3 -- The &&& condition of the data event, if any
+ *
+ * The edges are masks in the vpiEdge encoding. The limits are in the
+ * units of the design precision. limit(0) is the limit of the check
+ * (the setup limit of a $setuphold) and limit(1) is the hold limit of
+ * a $setuphold or the threshold of a $width.
+ */
+class NetTimingCheck  : public NetObj {
+
+    public:
+      explicit NetTimingCheck(NetScope*s, perm_string n, ivl_tchk_type_t t);
+      ~NetTimingCheck();
+
+      ivl_tchk_type_t type() const;
+
+      void set_ref_edge(unsigned mask);
+      void set_data_edge(unsigned mask);
+      unsigned ref_edge() const;
+      unsigned data_edge() const;
+
+      void set_limits(uint64_t limit0, uint64_t limit1);
+      uint64_t limit(unsigned idx) const;
+
+      void set_notifier(NetNet*sig);
+      const NetNet* notifier() const;
+
+      Link&ref_pin();
+      const Link&ref_pin() const;
+      Link&data_pin();
+      const Link&data_pin() const;
+      Link&ref_cond_pin();
+      const Link&ref_cond_pin() const;
+      Link&data_cond_pin();
+      const Link&data_cond_pin() const;
+
+      bool has_data() const;
+      bool has_ref_cond() const;
+      bool has_data_cond() const;
+
+      void dump(ostream&, unsigned ind) const;
+
+    private:
+      ivl_tchk_type_t type_;
+      unsigned ref_edge_;
+      unsigned data_edge_;
+      uint64_t limits_[2];
+      NetNet*notifier_;
+
+    private: // Not implemented
+      NetTimingCheck(const NetTimingCheck&);
+      NetTimingCheck& operator= (const NetTimingCheck&);
+};
+
 /*
  * NetNet is a special kind of NetObj that doesn't really do anything,
  * but carries the properties of the wire/reg/trireg, including its
@@ -686,6 +788,10 @@ class NetNet  : public NetObj, public PortType {
 
       virtual ~NetNet();
 
+	// Nets are allocated from a pool (see ObjectHeap.h).
+      static void* operator new(size_t size);
+      static void operator delete(void*ptr, size_t size);
+
       Type type() const;
       void type(Type t);
 
@@ -1002,6 +1108,13 @@ class NetScope : public Definitions, public Attrib {
       void rem_event(NetEvent*);
       NetEvent*find_event(perm_string name);
 
+	/* These methods manage the timing checks of the specify
+	   blocks of this scope. */
+      void add_timing_check(NetTimingCheck*);
+      unsigned timing_checks() const { return timing_checks_.size(); }
+      const NetTimingCheck*timing_check(unsigned idx) const
+            { return timing_checks_[idx]; }
+
 	/* These methods add or find a genvar that lives in this scope. */
       void add_genvar(perm_string name, LineInfo *li);
       LineInfo* find_genvar(perm_string name);
@@ -1287,6 +1400,8 @@ class NetScope : public Definitions, public Attrib {
 
       NetEvent *events_;
 
+      vector<NetTimingCheck*> timing_checks_;
+
       map<perm_string,LineInfo*> genvars_;
 
       typedef std::map<perm_string,NetNet*>::const_iterator signals_map_iter_t;
@@ -2008,6 +2123,10 @@ class NetExpr  : public LineInfo {
       explicit NetExpr(ivl_type_t t);
       virtual ~NetExpr() =0;
 
+	// Expressions are allocated from a pool (see ObjectHeap.h).
+      static void* operator new(size_t size);
+      static void operator delete(void*ptr, size_t size);
+
       virtual void expr_scan(struct expr_scan_t*) const =0;
       virtual void dump(ostream&) const;
 
@@ -3025,6 +3144,10 @@ class NetBlock  : public NetProc {
       const NetProc*proc_first() const;
       const NetProc*proc_next(const NetProc*cur) const;
 
+	// Unlink the first statement from the block and return it,
+	// or return nil if the block is empty.
+      NetProc*proc_remove_first();
+
       bool evaluate_function(const LineInfo&loc,
 			     map<perm_string,LocalVar>&ctx) const;
 
@@ -3528,6 +3651,12 @@ class NetEvProbe  : public NetNode {
       NetEvent* event();
       const NetEvent* event() const;
 
+	// An ANYEDGE probe may watch only a part of the vector on a
+	// pin. A zero width (the default) watches the whole vector.
+      void set_part(unsigned pin, unsigned base, unsigned wid);
+      unsigned part_base(unsigned pin) const;
+      unsigned part_wid(unsigned pin) const;
+
       void find_similar_probes(list<NetEvProbe*>&);
 
       virtual bool emit_node(struct target_t*) const;
@@ -3536,6 +3665,8 @@ class NetEvProbe  : public NetNode {
     private:
       NetEvent*event_;
       edge_t edge_;
+      std::vector<unsigned> part_base_;
+      std::vector<unsigned> part_wid_;
 	// The NetEvent class uses this to list me.
       NetEvProbe*enext_;
 };
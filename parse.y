@@ -458,6 +458,7 @@ static void current_function_set_statement(const YYLTYPE&loc, vector<Statement*>
       verireal* realtime;
 
       PSpecPath* specpath;
+      PTimingCheck::event_t* tchk_event;
       list<index_component_t> *dimensions;
 
       LexicalScope::lifetime_t lifetime;
@@ -478,7 +479,7 @@ static void current_function_set_statement(const YYLTYPE&loc, vector<Statement*>
 %token K_PSTAR K_STARP K_DOTSTAR
 %token K_LOR K_LAND K_NAND K_NOR K_NXOR K_TRIGGER K_LEQUIV
 %token K_SCOPE_RES
-%token K_edge_descriptor
+%token <int_val> K_edge_descriptor
 
  /* The base tokens from 1364-1995. */
 %token K_always K_and K_assign K_begin K_buf K_bufif0 K_bufif1 K_case
@@ -674,6 +675,9 @@ static void current_function_set_statement(const YYLTYPE&loc, vector<Statement*>
 
 %type <specpath> specify_simple_path specify_simple_path_decl
 %type <specpath> specify_edge_path specify_edge_path_decl
+%type <tchk_event> spec_reference_event
+%type <int_val> edge_descriptor_list
+%type <pform_name> spec_notifier spec_notifier_opt
 
 %type <real_type> non_integer_type
 %type <int_val> assert_or_assume
@@ -6098,59 +6102,83 @@ specify_item
 		}
 	| K_Sfullskew '(' spec_reference_event ',' spec_reference_event
 	  ',' delay_value ',' delay_value spec_notifier_opt ')' ';'
-		{ delete $7;
+		{ delete $3;
+		  delete $5;
+		  delete $7;
 		  delete $9;
+		  delete $10;
 		}
 	| K_Shold '(' spec_reference_event ',' spec_reference_event
 	  ',' delay_value spec_notifier_opt ')' ';'
-		{ delete $7;
+		{ pform_module_timing_check(@1, PTimingCheck::HOLD,
+					    $3, $5, $7, 0, $8);
 		}
 	| K_Snochange '(' spec_reference_event ',' spec_reference_event
 	  ',' delay_value ',' delay_value spec_notifier_opt ')' ';'
-		{ delete $7;
+		{ delete $3;
+		  delete $5;
+		  delete $7;
 		  delete $9;
+		  delete $10;
 		}
 	| K_Speriod '(' spec_reference_event ',' delay_value
 	  spec_notifier_opt ')' ';'
-		{ delete $5;
+		{ pform_module_timing_check(@1, PTimingCheck::PERIOD,
+					    $3, 0, $5, 0, $6);
 		}
 	| K_Srecovery '(' spec_reference_event ',' spec_reference_event
 	  ',' delay_value spec_notifier_opt ')' ';'
-		{ delete $7;
+		{ pform_module_timing_check(@1, PTimingCheck::RECOVERY,
+					    $3, $5, $7, 0, $8);
 		}
 	| K_Srecrem '(' spec_reference_event ',' spec_reference_event
 	  ',' delay_value ',' delay_value spec_notifier_opt ')' ';'
-		{ delete $7;
+		{ delete $3;
+		  delete $5;
+		  delete $7;
 		  delete $9;
+		  delete $10;
 		}
 	| K_Sremoval '(' spec_reference_event ',' spec_reference_event
 	  ',' delay_value spec_notifier_opt ')' ';'
-		{ delete $7;
+		{ delete $3;
+		  delete $5;
+		  delete $7;
+		  delete $8;
 		}
 	| K_Ssetup '(' spec_reference_event ',' spec_reference_event
 	  ',' delay_value spec_notifier_opt ')' ';'
-		{ delete $7;
+		{ /* $setup(data_event, reference_event, limit) */
+		  pform_module_timing_check(@1, PTimingCheck::SETUP,
+					    $5, $3, $7, 0, $8);
 		}
 	| K_Ssetuphold '(' spec_reference_event ',' spec_reference_event
 	  ',' delay_value ',' delay_value spec_notifier_opt ')' ';'
-		{ delete $7;
-		  delete $9;
+		{ pform_module_timing_check(@1, PTimingCheck::SETUPHOLD,
+					    $3, $5, $7, $9, $10);
 		}
 	| K_Sskew '(' spec_reference_event ',' spec_reference_event
 	  ',' delay_value spec_notifier_opt ')' ';'
-		{ delete $7;
+		{ delete $3;
+		  delete $5;
+		  delete $7;
+		  delete $8;
 		}
 	| K_Stimeskew '(' spec_reference_event ',' spec_reference_event
 	  ',' delay_value spec_notifier_opt ')' ';'
-		{ delete $7;
+		{ delete $3;
+		  delete $5;
+		  delete $7;
+		  delete $8;
 		}
 	| K_Swidth '(' spec_reference_event ',' delay_value ',' expression
 	  spec_notifier_opt ')' ';'
-		{ delete $5;
-		  delete $7;
+		{ pform_module_timing_check(@1, PTimingCheck::WIDTH,
+					    $3, 0, $5, $7, $8);
 		}
 	| K_Swidth '(' spec_reference_event ',' delay_value ')' ';'
-		{ delete $5;
+		{ pform_module_timing_check(@1, PTimingCheck::WIDTH,
+					    $3, 0, $5, 0, 0);
 		}
 	| K_pulsestyle_onevent specify_path_identifiers ';'
 		{ delete $2;
@@ -6379,64 +6407,87 @@ spec_polarity
 
 spec_reference_event
   : K_posedge expression
-    { delete $2; }
+    { $$ = new PTimingCheck::event_t;
+      $$->edge = PTimingCheck::EDGE_POS;
+      $$->expr = $2;
+    }
   | K_negedge expression
-    { delete $2; }
+    { $$ = new PTimingCheck::event_t;
+      $$->edge = PTimingCheck::EDGE_NEG;
+      $$->expr = $2;
+    }
   | K_posedge expr_primary K_TAND expression
-    { delete $2;
-      delete $4;
+    { $$ = new PTimingCheck::event_t;
+      $$->edge = PTimingCheck::EDGE_POS;
+      $$->expr = $2;
+      $$->condition = $4;
     }
   | K_negedge expr_primary K_TAND expression
-    { delete $2;
-      delete $4;
+    { $$ = new PTimingCheck::event_t;
+      $$->edge = PTimingCheck::EDGE_NEG;
+      $$->expr = $2;
+      $$->condition = $4;
     }
   | K_edge '[' edge_descriptor_list ']' expr_primary
-    { delete $5; }
+    { $$ = new PTimingCheck::event_t;
+      $$->edge = $3;
+      $$->expr = $5;
+    }
   | K_edge '[' edge_descriptor_list ']' expr_primary K_TAND expression
-    { delete $5;
-      delete $7;
+    { $$ = new PTimingCheck::event_t;
+      $$->edge = $3;
+      $$->expr = $5;
+      $$->condition = $7;
     }
   | expr_primary K_TAND expression
-    { delete $1;
-      delete $3;
+    { $$ = new PTimingCheck::event_t;
+      $$->expr = $1;
+      $$->condition = $3;
     }
   | expr_primary
-    { delete $1; }
+    { $$ = new PTimingCheck::event_t;
+      $$->expr = $1;
+    }
   ;
 
   /* The edge_descriptor is detected by the lexor as the various
-     2-letter edge sequences that are supported here. For now, we
-     don't care what they are, because we do not yet support specify
-     edge events. */
+     2-letter edge sequences that are supported here. The lexor
+     returns each as its PTimingCheck edge mask, and the list is the
+     union of the masks. */
 edge_descriptor_list
   : edge_descriptor_list ',' K_edge_descriptor
+    { $$ = $1 | $3; }
   | K_edge_descriptor
+    { $$ = $1; }
   ;
 
 spec_notifier_opt
 	: /* empty */
-		{  }
+		{ $$ = 0; }
 	| spec_notifier
-		{  }
+		{ $$ = $1; }
 	;
 spec_notifier
 	: ','
-		{ args_after_notifier = 0; }
+		{ args_after_notifier = 0; $$ = 0; }
 	| ','  hierarchy_identifier
-		{ args_after_notifier = 0; delete $2; }
+		{ args_after_notifier = 0; $$ = $2; }
 	| spec_notifier ','
-		{  args_after_notifier += 1; }
+		{  args_after_notifier += 1; $$ = $1; }
 	| spec_notifier ',' hierarchy_identifier
 		{ args_after_notifier += 1;
 		  if (args_after_notifier >= 3)  {
-                    cerr << @3 << ": warning: timing checks are not supported "
-		                  "and delayed signal \"" << *$3
+                    cerr << @3 << ": warning: delayed timing check "
+		                  "signals are not supported and delayed "
+		                  "signal \"" << *$3
 		         << "\" will not be driven." << endl;
 		  }
-                  delete $3; }
+                  delete $3;
+		  $$ = $1;
+		}
   /* How do we match this path? */
 	| IDENTIFIER
-		{ args_after_notifier = 0; delete[]$1; }
+		{ args_after_notifier = 0; delete[]$1; $$ = 0; }
 	;
 
 
@@ -58,6 +58,14 @@ extern void pform_dump(std::ostream&out, const PTaskFunc*tf);
  */
 extern int pform_parse(const char*path);
 
+/*
+ * Open the input for a path the way pform_parse does, and close it
+ * again. pform_open_input prints a message and returns 0 if the file
+ * cannot be opened.
+ */
+extern FILE* pform_open_input(const char*path);
+extern void pform_close_input(FILE*fd);
+
 extern string vl_file;
 
 extern void pform_set_timescale(int units, int prec, const char*file,
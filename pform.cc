@@ -32,6 +32,7 @@
 # include  "PModport.h"
 # include  "PSpec.h"
 # include  "discipline.h"
+# include  "rebuild_cache.h"
 # include  <list>
 # include  <map>
 # include  <cassert>
@@ -3377,6 +3378,30 @@ extern void pform_module_specify_path(PSpecPath*obj)
       pform_cur_module.front()->specify_paths.push_back(obj);
 }
 
+extern void pform_module_timing_check(const struct vlltype&li,
+				      PTimingCheck::check_t type,
+				      PTimingCheck::event_t*ref,
+				      PTimingCheck::event_t*data,
+				      PExpr*limit1, PExpr*limit2,
+				      pform_name_t*notifier)
+{
+      perm_string notifier_name;
+      if (notifier) {
+	    if (notifier->size() != 1 || !notifier->back().index.empty()) {
+		  VLerror(li, "error: The notifier of a timing check must "
+			  "be a simple reg name.");
+	    } else {
+		  notifier_name = peek_tail_name(*notifier);
+	    }
+	    delete notifier;
+      }
+
+      PTimingCheck*tmp = new PTimingCheck(type, ref, data, limit1, limit2,
+					  notifier_name);
+      FILE_NAME(tmp, li);
+      pform_cur_module.front()->timing_checks.push_back(tmp);
+}
+
 
 static void pform_set_port_type(perm_string name, NetNet::PortType pt,
 				const char*file, unsigned lineno)
@@ -3729,11 +3754,11 @@ void pform_add_modport_port(const struct vlltype&loc,
 FILE*vl_input = 0;
 extern void reset_lexor();
 
-int pform_parse(const char*path)
+FILE* pform_open_input(const char*path)
 {
-      vl_file = path;
+      FILE*fd;
       if (strcmp(path, "-") == 0) {
-	    vl_input = stdin;
+	    fd = stdin;
       } else if (ivlpp_string) {
 	    char*cmdline = (char*)malloc(strlen(ivlpp_string) +
 					        strlen(path) + 4);
@@ -3745,24 +3770,48 @@ int pform_parse(const char*path)
 	    if (verbose_flag)
 		  cerr << "Executing: " << cmdline << endl<< flush;
 
-	    vl_input = popen(cmdline, "r");
-	    if (vl_input == 0) {
+	    fd = popen(cmdline, "r");
+	    free(cmdline);
+	    if (fd == 0) {
 		  cerr << "Unable to preprocess " << path << "." << endl;
-		  return 1;
+		  return 0;
 	    }
 
 	    if (verbose_flag)
 		  cerr << "...parsing output from preprocessor..." << endl << flush;
 
-	    free(cmdline);
       } else {
-	    vl_input = fopen(path, "r");
-	    if (vl_input == 0) {
+	    fd = fopen(path, "r");
+	    if (fd == 0) {
 		  cerr << "Unable to open " << path << "." << endl;
-		  return 1;
+		  return 0;
 	    }
       }
 
+      return fd;
+}
+
+void pform_close_input(FILE*fd)
+{
+      if (fd == stdin)
+	    return;
+
+      if (ivlpp_string)
+	    pclose(fd);
+      else
+	    fclose(fd);
+}
+
+int pform_parse(const char*path)
+{
+      vl_file = path;
+      if (rebuild_cache_enabled)
+	    vl_input = rebuild_cache_input(path);
+      else
+	    vl_input = pform_open_input(path);
+      if (vl_input == 0)
+	    return 1;
+
       if (pform_units.empty() || separate_compilation) {
 	    char unit_name[20];
 	    static unsigned nunits = 0;
@@ -3793,12 +3842,10 @@ int pform_parse(const char*path)
       warn_count = 0;
       int rc = VLparse();
 
-      if (vl_input != stdin) {
-	    if (ivlpp_string)
-		  pclose(vl_input);
-	    else
-		  fclose(vl_input);
-      }
+      if (rebuild_cache_enabled)
+	    fclose(vl_input);
+      else
+	    pform_close_input(vl_input);
 
       if (rc) {
 	    cerr << "I give up." << endl;
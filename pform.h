@@ -30,6 +30,7 @@
 # include  "PTask.h"
 # include  "PUdp.h"
 # include  "PWire.h"
+# include  "PSpec.h"
 # include  "verinum.h"
 # include  "discipline.h"
 # include  <iostream>
@@ -456,6 +457,13 @@ extern PSpecPath*pform_assign_path_delay(PSpecPath*obj, list<PExpr*>*delays);
 
 extern void pform_module_specify_path(PSpecPath*obj);
 
+extern void pform_module_timing_check(const struct vlltype&li,
+				      PTimingCheck::check_t type,
+				      PTimingCheck::event_t*ref,
+				      PTimingCheck::event_t*data,
+				      PExpr*limit1, PExpr*limit2,
+				      pform_name_t*notifier);
+
 /*
  * pform_make_behavior creates processes that are declared with always
  * or initial items.
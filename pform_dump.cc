@@ -1283,6 +1283,45 @@ void PSpecPath::dump(std::ostream&out, unsigned ind) const
       out << ");" << endl;
 }
 
+static void dump_tchk_event(ostream&out, const PTimingCheck::event_t*ev)
+{
+      switch (ev->edge) {
+	  case PTimingCheck::EDGE_ANY:
+	    break;
+	  case PTimingCheck::EDGE_POS:
+	    out << "posedge ";
+	    break;
+	  case PTimingCheck::EDGE_NEG:
+	    out << "negedge ";
+	    break;
+	  default:
+	    out << "edge[0x" << hex << ev->edge << dec << "] ";
+	    break;
+      }
+      out << *ev->expr;
+      if (ev->condition)
+	    out << " &&& " << *ev->condition;
+}
+
+void PTimingCheck::dump(std::ostream&out, unsigned ind) const
+{
+      static const char*names[] = { "$setup", "$hold", "$setuphold",
+				    "$recovery", "$width", "$period" };
+
+      out << setw(ind) << "" << "timing check " << names[type] << "(ref=";
+      dump_tchk_event(out, ref);
+      if (data) {
+	    out << ", data=";
+	    dump_tchk_event(out, data);
+      }
+      out << ", " << *limit1;
+      if (limit2)
+	    out << ", " << *limit2;
+      if (! notifier.nil())
+	    out << ", notifier=" << notifier;
+      out << ");" << endl;
+}
+
 void PGenerate::dump(ostream&out, unsigned indent) const
 {
       out << setw(indent) << "" << "generate(" << id_number << ")";
@@ -1669,6 +1708,12 @@ void Module::dump(ostream&out) const
 	    (*spec)->dump(out, 4);
       }
 
+      for (list<PTimingCheck*>::const_iterator tchk = timing_checks.begin()
+		 ; tchk != timing_checks.end() ; ++ tchk ) {
+
+	    (*tchk)->dump(out, 4);
+      }
+
       out << "endmodule" << endl;
 }
 
@@ -0,0 +1,600 @@
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include "config.h"
+# include "version_base.h"
+# include "version_tag.h"
+
+# include  "rebuild_cache.h"
+# include  "parse_api.h"
+# include  "compiler.h"
+# include  <iostream>
+# include  <streambuf>
+# include  <list>
+# include  <cstring>
+# include  <cerrno>
+# include  <inttypes.h>
+# include  <unistd.h>
+# include  <sys/stat.h>
+// MinGW only supports mkdir() with a path.
+#if defined(__MINGW32__)
+# include <io.h>
+# define mkdir(path, mode) mkdir(path)
+#endif
+
+using namespace std;
+
+bool rebuild_cache_enabled = false;
+
+/*
+ * The entries are named by a 64bit FNV-1a hash of the key. The hash
+ * only finds the entry. The full key text is saved with the entry and
+ * compared, so two compiles whose keys happen to hash the same never
+ * get each other's output.
+ */
+static const uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+static const uint64_t FNV_PRIME  = 0x00000100000001b3ULL;
+
+static uint64_t fnv_update(uint64_t hash, const char*data, size_t len)
+{
+      for (size_t idx = 0 ; idx < len ; idx += 1) {
+	    hash ^= (unsigned char)data[idx];
+	    hash *= FNV_PRIME;
+      }
+      return hash;
+}
+
+static uint64_t cache_key = FNV_OFFSET;
+static string cache_key_text;
+
+/*
+ * Add a piece to the key. Each piece has its length in front of it,
+ * so that "ab"+"c" and "a"+"bc" make different keys.
+ */
+static void key_add(const char*data, size_t len)
+{
+      char head[32];
+      snprintf(head, sizeof head, "%lu:", (unsigned long)len);
+      cache_key_text += head;
+      cache_key_text.append(data, len);
+      cache_key = fnv_update(cache_key, head, strlen(head));
+      cache_key = fnv_update(cache_key, data, len);
+}
+
+static void key_add(const string&text)
+{
+      key_add(text.data(), text.size());
+}
+static string cache_dir;
+static bool cache_failed = false;
+
+struct cache_source_s {
+      perm_string path;
+      bool ok;
+      string text;
+};
+
+struct cache_dep_s {
+      string path;
+      string text;
+};
+
+static list<cache_source_s> cache_sources;
+static list<cache_dep_s> cache_deps;
+
+/*
+ * The messages of the compile are saved with the entry, so that a hit
+ * prints the same warnings as the compile did. The compiler writes
+ * its messages to cerr, and this stream buffer passes them on to the
+ * real cerr buffer and keeps a copy.
+ */
+class cache_tee_buf : public streambuf {
+    public:
+      explicit cache_tee_buf(streambuf*out) : out_(out), hold_(false) { }
+
+      streambuf*out() const { return out_; }
+      const string&text() const { return text_; }
+	// Stop (or start again) keeping a copy.
+      void hold(bool flag) { hold_ = flag; }
+      void append(const string&text) { text_ += text; }
+
+    protected:
+      int overflow(int ch)
+      {
+	    if (ch == EOF)
+		  return out_->pubsync() == 0? 0 : EOF;
+	    if (! hold_)
+		  text_ += (char)ch;
+	    return out_->sputc((char)ch);
+      }
+
+      streamsize xsputn(const char*data, streamsize len)
+      {
+	    if (! hold_)
+		  text_.append(data, len);
+	    return out_->sputn(data, len);
+      }
+
+      int sync() { return out_->pubsync(); }
+
+    private:
+      streambuf*out_;
+      bool hold_;
+      string text_;
+};
+
+static cache_tee_buf*cache_tee = 0;
+static int target_saved_fd = -1;
+static FILE*target_file = 0;
+
+/*
+ * The configuration lines that name temporary or output files change
+ * from one run to the next, but not the result of the compile. The
+ * ivlpp command line is also skipped, because the preprocessed text
+ * is in the key.
+ */
+void rebuild_cache_config(const char*path)
+{
+      char buf[8*1024];
+
+      FILE*ifile = fopen(path, "r");
+      if (ifile == 0)
+	    return;
+
+      while (fgets(buf, sizeof buf, ifile) != 0) {
+	    if (strncmp(buf, "out:", 4) == 0)
+		  continue;
+	    if (strncmp(buf, "ivlpp:", 6) == 0)
+		  continue;
+	    if (strncmp(buf, "depfile:", 8) == 0)
+		  continue;
+	    if (strncmp(buf, "depmode:", 8) == 0)
+		  continue;
+	    key_add(buf, strlen(buf));
+      }
+
+      fclose(ifile);
+}
+
+/*
+ * Read the whole (preprocessed) text of an input file.
+ */
+static bool read_input(const char*path, string&text)
+{
+      char buf[16*1024];
+
+      FILE*fd = pform_open_input(path);
+      if (fd == 0)
+	    return false;
+
+      size_t cnt;
+      while ((cnt = fread(buf, 1, sizeof buf, fd)) > 0)
+	    text.append(buf, cnt);
+
+      pform_close_input(fd);
+      return true;
+}
+
+static bool read_file(const char*path, string&text)
+{
+      char buf[16*1024];
+
+      FILE*fd = fopen(path, "rb");
+      if (fd == 0)
+	    return false;
+
+      size_t cnt;
+      while ((cnt = fread(buf, 1, sizeof buf, fd)) > 0)
+	    text.append(buf, cnt);
+
+      bool ok = ferror(fd) == 0;
+      fclose(fd);
+      return ok;
+}
+
+/*
+ * Add the code generator module to the key, so that a new build of
+ * the target does not get the output of the old one. The module is
+ * found the way dll_target::start_design() loads it.
+ */
+static bool hash_target(const char*name)
+{
+      string text;
+      bool ok = false;
+
+      if (strchr(name, '/'))
+	    ok = read_file(name, text);
+      if (! ok && name[0] != '/') {
+	    string path = string(basedir) + "/" + name;
+	    ok = read_file(path.c_str(), text);
+      }
+
+      if (! ok) {
+	    cerr << "warning: Unable to read code generator " << name
+		 << ", not using the rebuild cache." << endl;
+	    return false;
+      }
+
+      key_add(text);
+      return true;
+}
+
+static FILE* text_stream(const string&text)
+{
+      FILE*fd = tmpfile();
+      if (fd == 0) {
+	    cerr << "error: Unable to create a temporary file: "
+		 << strerror(errno) << endl;
+	    return 0;
+      }
+
+      fwrite(text.data(), 1, text.size(), fd);
+      rewind(fd);
+      return fd;
+}
+
+static string key_path(const char*suffix)
+{
+      char key[32];
+      snprintf(key, sizeof key, "%016" PRIx64, cache_key);
+      return cache_dir + "/" + key + suffix;
+}
+
+bool rebuild_cache_open(const char*dir, const map<string,const char*>&flags,
+			const vector<perm_string>&sources)
+{
+      for (size_t idx = 0 ; idx < sources.size() ; idx += 1) {
+	    if (strcmp(sources[idx], "-") == 0)
+		  return false;
+      }
+
+      if (mkdir(dir, 0777) < 0 && errno != EEXIST) {
+	    cerr << "warning: Unable to create cache directory " << dir
+		 << ": " << strerror(errno) << endl;
+	    return false;
+      }
+
+      struct stat sb;
+      if (stat(dir, &sb) < 0 || !S_ISDIR(sb.st_mode)) {
+	    cerr << "warning: Cache path " << dir
+		 << " is not a directory." << endl;
+	    return false;
+      }
+
+      cache_dir = dir;
+
+      key_add(VERSION " (" VERSION_TAG ")");
+      for (map<string,const char*>::const_iterator cur = flags.begin()
+		 ; cur != flags.end() ; ++ cur ) {
+	    if (cur->first == "-o" || cur->first == "CACHE_DIR")
+		  continue;
+	    key_add(cur->first);
+	    key_add(cur->second? cur->second : "");
+      }
+
+      map<string,const char*>::const_iterator dll = flags.find("DLL");
+      if (dll != flags.end() && dll->second && ! hash_target(dll->second))
+	    return false;
+
+      for (size_t idx = 0 ; idx < sources.size() ; idx += 1) {
+	    cache_source_s item;
+	    item.path = sources[idx];
+	    cache_sources.push_back(item);
+
+	    cache_source_s&cur = cache_sources.back();
+	    cur.ok = read_input(cur.path, cur.text);
+	    if (! cur.ok) {
+		  cache_failed = true;
+		  continue;
+	    }
+
+	    key_add(cur.path.str());
+	    key_add(cur.text);
+      }
+
+	// The preprocessor has run, so from here on cerr only gets
+	// the messages of the compile itself.
+      cache_tee = new cache_tee_buf(cerr.rdbuf());
+      cerr.rdbuf(cache_tee);
+
+      rebuild_cache_enabled = true;
+      return true;
+}
+
+/*
+ * The code generator writes to the stderr file descriptor, so collect
+ * its output in a temporary file and pass it on when it is done. The
+ * cerr messages of that time go to the same file, so the tee stops
+ * keeping its own copy until then.
+ */
+void rebuild_cache_target_begin(void)
+{
+      if (cache_tee == 0)
+	    return;
+
+      cerr.flush();
+      fflush(stderr);
+
+      target_file = tmpfile();
+      if (target_file == 0)
+	    return;
+
+      target_saved_fd = dup(fileno(stderr));
+      if (target_saved_fd < 0
+	  || dup2(fileno(target_file), fileno(stderr)) < 0) {
+	    if (target_saved_fd >= 0)
+		  close(target_saved_fd);
+	    target_saved_fd = -1;
+	    fclose(target_file);
+	    target_file = 0;
+	    return;
+      }
+
+      cache_tee->hold(true);
+}
+
+void rebuild_cache_target_end(void)
+{
+      if (target_file == 0)
+	    return;
+
+      cerr.flush();
+      fflush(stderr);
+      dup2(target_saved_fd, fileno(stderr));
+      close(target_saved_fd);
+      target_saved_fd = -1;
+
+      string text;
+      char buf[16*1024];
+      size_t cnt;
+      rewind(target_file);
+      while ((cnt = fread(buf, 1, sizeof buf, target_file)) > 0)
+	    text.append(buf, cnt);
+      fclose(target_file);
+      target_file = 0;
+
+      fwrite(text.data(), 1, text.size(), stderr);
+      fflush(stderr);
+
+      cache_tee->hold(false);
+      cache_tee->append(text);
+}
+
+FILE* rebuild_cache_input(const char*path)
+{
+	// The source files are parsed in the order that they were
+	// preprocessed.
+      if (! cache_sources.empty()
+	  && strcmp(cache_sources.front().path, path) == 0) {
+	    cache_source_s&cur = cache_sources.front();
+	    FILE*fd = cur.ok? text_stream(cur.text) : 0;
+	    cache_sources.pop_front();
+	    return fd;
+      }
+
+	// Anything else is a library file that the elaborator went
+	// looking for. Remember it, so that the next compile can
+	// check that it has not changed.
+      string text;
+      if (! read_input(path, text)) {
+	    cache_failed = true;
+	    return 0;
+      }
+
+      cache_dep_s dep;
+      dep.path = path;
+      dep.text = text;
+      cache_deps.push_back(dep);
+
+      return text_stream(text);
+}
+
+static bool copy_file(const char*src, const char*dst)
+{
+      char buf[16*1024];
+
+      struct stat sb;
+      if (stat(src, &sb) < 0 || !S_ISREG(sb.st_mode))
+	    return false;
+
+      FILE*ifd = fopen(src, "rb");
+      if (ifd == 0)
+	    return false;
+
+      FILE*ofd = fopen(dst, "wb");
+      if (ofd == 0) {
+	    fclose(ifd);
+	    return false;
+      }
+
+      bool ok = true;
+      size_t cnt;
+      while ((cnt = fread(buf, 1, sizeof buf, ifd)) > 0) {
+	    if (fwrite(buf, 1, cnt, ofd) != cnt) {
+		  ok = false;
+		  break;
+	    }
+      }
+
+      if (ferror(ifd))
+	    ok = false;
+      fclose(ifd);
+      if (fclose(ofd) != 0)
+	    ok = false;
+
+      chmod(dst, sb.st_mode & 0777);
+      return ok;
+}
+
+/*
+ * Check the library files listed in the dependency file of the
+ * entry. Each file is a line with the length of its text and its
+ * path, followed by the (preprocessed) text that the compile used.
+ */
+static bool check_deps(const string&dep_path)
+{
+      char buf[8*1024];
+
+      FILE*fd = fopen(dep_path.c_str(), "rb");
+      if (fd == 0)
+	    return false;
+
+      bool ok = true;
+      while (ok && fgets(buf, sizeof buf, fd) != 0) {
+	    char*ep = buf + strlen(buf);
+	    while (ep > buf && (ep[-1] == '\n' || ep[-1] == '\r'))
+		  *--ep = 0;
+
+	    char*cp = strchr(buf, ' ');
+	    if (cp == 0) {
+		  ok = false;
+		  break;
+	    }
+	    *cp++ = 0;
+
+	    size_t len = strtoul(buf, 0, 10);
+	    string saved (len, 0);
+	    if (len > 0 && fread(&saved[0], 1, len, fd) != len) {
+		  ok = false;
+		  break;
+	    }
+
+	    string text;
+	    if (! read_input(cp, text) || text != saved)
+		  ok = false;
+      }
+
+      fclose(fd);
+      return ok;
+}
+
+bool rebuild_cache_lookup(const char*out_path)
+{
+      if (cache_failed || out_path == 0 || strcmp(out_path, "-") == 0)
+	    return false;
+
+      string out_entry = key_path(".out");
+      string msg_entry = key_path(".msg");
+      string key_entry = key_path(".key");
+      string dep_entry = key_path(".dep");
+
+      if (access(out_entry.c_str(), R_OK) != 0)
+	    return false;
+
+	// The hash only names the entry, so check that it is really
+	// the entry for this key.
+      string key_text;
+      if (! read_file(key_entry.c_str(), key_text) || key_text != cache_key_text)
+	    return false;
+      if (! check_deps(dep_entry))
+	    return false;
+
+      string messages;
+      if (! read_file(msg_entry.c_str(), messages))
+	    return false;
+      if (! copy_file(out_entry.c_str(), out_path))
+	    return false;
+
+	// Print the messages of the original compile, but do not
+	// keep them again.
+      if (cache_tee) {
+	    cerr.rdbuf(cache_tee->out());
+	    delete cache_tee;
+	    cache_tee = 0;
+      }
+      cerr << messages << flush;
+
+      if (verbose_flag)
+	    cout << "Using cached output " << out_entry << endl;
+
+      return true;
+}
+
+/*
+ * Write a whole string to a new file.
+ */
+static bool write_file(const string&path, const string&text)
+{
+      FILE*fd = fopen(path.c_str(), "wb");
+      if (fd == 0)
+	    return false;
+
+      bool ok = fwrite(text.data(), 1, text.size(), fd) == text.size();
+      if (fclose(fd) != 0)
+	    ok = false;
+      return ok;
+}
+
+/*
+ * The entry is written to temporary files first and renamed into
+ * place, so that another compile that shares the cache never sees a
+ * partial entry. An old entry of the same name loses its dependency
+ * list first, then the output, messages and key go in before the new
+ * dependency list, and an entry without a dependency list is never
+ * used.
+ */
+void rebuild_cache_store(const char*out_path)
+{
+      if (cache_failed || out_path == 0 || strcmp(out_path, "-") == 0)
+	    return;
+
+      char tmp_suffix[32];
+      snprintf(tmp_suffix, sizeof tmp_suffix, ".tmp%ld", (long)getpid());
+
+      string out_entry = key_path(".out");
+      string msg_entry = key_path(".msg");
+      string key_entry = key_path(".key");
+      string dep_entry = key_path(".dep");
+      string out_tmp = out_entry + tmp_suffix;
+      string msg_tmp = msg_entry + tmp_suffix;
+      string key_tmp = key_entry + tmp_suffix;
+      string dep_tmp = dep_entry + tmp_suffix;
+
+      string deps;
+      for (list<cache_dep_s>::const_iterator cur = cache_deps.begin()
+		 ; cur != cache_deps.end() ; ++ cur ) {
+	    char head[32];
+	    snprintf(head, sizeof head, "%lu ", (unsigned long)cur->text.size());
+	    deps += head;
+	    deps += cur->path;
+	    deps += "\n";
+	    deps += cur->text;
+      }
+
+      const string&messages = cache_tee? cache_tee->text() : string();
+
+      if (! copy_file(out_path, out_tmp.c_str())
+	  || ! write_file(msg_tmp, messages)
+	  || ! write_file(key_tmp, cache_key_text)
+	  || ! write_file(dep_tmp, deps)
+	  || (remove(dep_entry.c_str()) != 0 && errno != ENOENT)
+	  || rename(out_tmp.c_str(), out_entry.c_str()) != 0
+	  || rename(msg_tmp.c_str(), msg_entry.c_str()) != 0
+	  || rename(key_tmp.c_str(), key_entry.c_str()) != 0
+	  || rename(dep_tmp.c_str(), dep_entry.c_str()) != 0) {
+	    remove(out_tmp.c_str());
+	    remove(msg_tmp.c_str());
+	    remove(key_tmp.c_str());
+	    remove(dep_tmp.c_str());
+	    return;
+      }
+
+      if (verbose_flag)
+	    cout << "Saved output in cache " << out_entry << endl;
+}
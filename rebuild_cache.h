@@ -0,0 +1,81 @@
+#ifndef IVL_rebuild_cache_H
+#define IVL_rebuild_cache_H
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  <cstdio>
+# include  <map>
+# include  <string>
+# include  <vector>
+# include  "StringHeap.h"
+
+/*
+ * The rebuild cache skips a compile that has nothing new to do. It
+ * keeps the output of previous compiles in the directory given with
+ * the CACHE_DIR flag (iverilog -pCACHE_DIR=dir). The key of a cache
+ * entry is the preprocessed source files, the configuration, the
+ * compiler version and the code generator module. The entry is found
+ * by a hash of the key, and the full key is saved with the entry and
+ * compared before it is used. The files that are parsed on demand
+ * (library modules) are saved with the entry too, and are compared
+ * again before the entry is used.
+ *
+ * If the key and the library files match, the cached output is copied
+ * to the output file, the warnings of the original compile are
+ * printed again, and the parse, elaboration and code generation are
+ * skipped.
+ *
+ * This is not incremental compilation. A change to any source file
+ * makes a new key, and the whole design is compiled again. Only the
+ * compiles that repeat exactly, such as the reruns of a regression,
+ * are saved.
+ */
+extern bool rebuild_cache_enabled;
+
+  /* Add the contents of a configuration file to the key. */
+extern void rebuild_cache_config(const char*path);
+
+  /* Open the cache and make the key. The source files are
+     preprocessed here, and the parser later reads the saved
+     text. This returns false if the cache cannot be used. */
+extern bool rebuild_cache_open(const char*dir,
+			       const std::map<std::string,const char*>&flags,
+			       const std::vector<perm_string>&sources);
+
+  /* Return the input stream for the parser. This is the saved text of
+     a source file, or for a library file a fresh copy that is recorded
+     in the list of dependencies. The caller closes the stream with
+     fclose. This returns 0 if the file cannot be read. */
+extern FILE* rebuild_cache_input(const char*path);
+
+  /* Look for the key in the cache, and if found copy the output to
+     the output path and print the saved messages. Return true on a
+     hit. */
+extern bool rebuild_cache_lookup(const char*out_path);
+
+  /* The messages of the compiler go to cerr, and are saved with the
+     entry. The code generator writes to stderr, so its messages are
+     collected between these calls. */
+extern void rebuild_cache_target_begin(void);
+extern void rebuild_cache_target_end(void);
+
+  /* Save the output and the messages of a successful compile. */
+extern void rebuild_cache_store(const char*out_path);
+
+#endif /* IVL_rebuild_cache_H */
@@ -366,6 +366,20 @@ extern "C" ivl_nexus_t ivl_event_any(ivl_event_t net, unsigned idx)
       return net->pins[idx];
 }
 
+extern "C" unsigned ivl_event_any_base(ivl_event_t net, unsigned idx)
+{
+      assert(net);
+      assert(idx < net->nany);
+      return net->any_base? net->any_base[idx] : 0;
+}
+
+extern "C" unsigned ivl_event_any_width(ivl_event_t net, unsigned idx)
+{
+      assert(net);
+      assert(idx < net->nany);
+      return net->any_wid? net->any_wid[idx] : 0;
+}
+
 extern "C" unsigned ivl_event_nneg(ivl_event_t net)
 {
       assert(net);
@@ -1966,6 +1980,79 @@ extern int ivl_path_source_negedge(ivl_delaypath_t net)
       return net->negedge ? 1 : 0;
 }
 
+extern "C" ivl_scope_t ivl_tchk_scope(ivl_tchk_t net)
+{
+      assert(net);
+      return net->scope;
+}
+
+extern "C" ivl_tchk_type_t ivl_tchk_type(ivl_tchk_t net)
+{
+      assert(net);
+      return net->type;
+}
+
+extern "C" const char* ivl_tchk_file(ivl_tchk_t net)
+{
+      assert(net);
+      return net->file.str();
+}
+
+extern "C" unsigned ivl_tchk_lineno(ivl_tchk_t net)
+{
+      assert(net);
+      return net->lineno;
+}
+
+extern "C" ivl_nexus_t ivl_tchk_ref(ivl_tchk_t net)
+{
+      assert(net);
+      return net->ref;
+}
+
+extern "C" unsigned ivl_tchk_ref_edge(ivl_tchk_t net)
+{
+      assert(net);
+      return net->ref_edge;
+}
+
+extern "C" ivl_nexus_t ivl_tchk_ref_cond(ivl_tchk_t net)
+{
+      assert(net);
+      return net->ref_cond;
+}
+
+extern "C" ivl_nexus_t ivl_tchk_data(ivl_tchk_t net)
+{
+      assert(net);
+      return net->data;
+}
+
+extern "C" unsigned ivl_tchk_data_edge(ivl_tchk_t net)
+{
+      assert(net);
+      return net->data_edge;
+}
+
+extern "C" ivl_nexus_t ivl_tchk_data_cond(ivl_tchk_t net)
+{
+      assert(net);
+      return net->data_cond;
+}
+
+extern "C" uint64_t ivl_tchk_limit(ivl_tchk_t net, unsigned idx)
+{
+      assert(net);
+      assert(idx < 2);
+      return net->limit[idx];
+}
+
+extern "C" ivl_signal_t ivl_tchk_notifier(ivl_tchk_t net)
+{
+      assert(net);
+      return net->notifier;
+}
+
 extern "C" const char*ivl_process_file(ivl_process_t net)
 {
       assert(net);
@@ -1999,6 +2086,10 @@ extern "C" ivl_scope_t ivl_process_scope(ivl_process_t net)
 extern "C" ivl_statement_t ivl_process_stmt(ivl_process_t net)
 {
       assert(net);
+      if (net->stmt_ == 0 && net->lazy_stmt_) {
+	    net->stmt_ = dll_target_obj.lazy_statement(net->lazy_stmt_);
+	    net->lazy_stmt_ = 0;
+      }
       return net->stmt_;
 }
 
@@ -2081,6 +2172,10 @@ extern "C" unsigned ivl_scope_classes(ivl_scope_t net)
 extern "C" ivl_statement_t ivl_scope_def(ivl_scope_t net)
 {
       assert(net);
+      if (net->def == 0 && net->lazy_def) {
+	    net->def = dll_target_obj.lazy_statement(net->lazy_def);
+	    net->lazy_def = 0;
+      }
       return net->def;
 }
 
@@ -2347,6 +2442,19 @@ extern "C" ivl_switch_t ivl_scope_switch(ivl_scope_t net, unsigned idx)
       return net->switches[idx];
 }
 
+extern "C" unsigned ivl_scope_tchks(ivl_scope_t net)
+{
+      assert(net);
+      return net->tchks.size();
+}
+
+extern "C" ivl_tchk_t ivl_scope_tchk(ivl_scope_t net, unsigned idx)
+{
+      assert(net);
+      assert(idx < net->tchks.size());
+      return net->tchks[idx];
+}
+
 extern "C" int ivl_scope_time_precision(ivl_scope_t net)
 {
       assert(net);
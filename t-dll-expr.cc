@@ -230,8 +230,7 @@ void dll_target::expr_concat(const NetEConcat*net)
 {
       assert(expr_ == 0);
 
-      ivl_expr_t cur = new struct ivl_expr_s;
-      assert(cur);
+      ivl_expr_t cur = (ivl_expr_t)calloc(1, sizeof(struct ivl_expr_s));
 
       cur->type_  = IVL_EX_CONCAT;
       cur->value_ = net->expr_type();
@@ -346,7 +345,7 @@ void dll_target::expr_creal(const NetECReal*net)
 void dll_target::expr_last(const NetELast*net)
 {
       assert(expr_ == 0);
-      ivl_expr_t expr = new struct ivl_expr_s;
+      ivl_expr_t expr = (ivl_expr_t)calloc(1, sizeof(struct ivl_expr_s));
       expr->type_   = IVL_EX_SFUNC;
       expr->value_  = IVL_VT_LOGIC;
       expr->width_  = 32;
@@ -359,7 +358,7 @@ void dll_target::expr_last(const NetELast*net)
 
       ivl_signal_t sig = find_signal(des_, net->sig());
 
-      ivl_expr_t esig = new struct ivl_expr_s;
+      ivl_expr_t esig = (ivl_expr_t)calloc(1, sizeof(struct ivl_expr_s));
       esig->type_   = IVL_EX_SIGNAL;
       esig->value_  = IVL_VT_DARRAY;
       esig->net_type= sig->net_type;
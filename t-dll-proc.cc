@@ -32,6 +32,22 @@
 # include  "ivl_alloc.h"
 # include  "ivl_assert.h"
 
+/*
+ * Copy the watched part of an any edge probe pin to the event.
+ */
+static void event_any_part(ivl_event_t ev, unsigned idx,
+			   const NetEvProbe*pr, unsigned pin)
+{
+      assert(idx < ev->nany);
+      if (ev->any_wid == 0) {
+	    ev->any_base = (unsigned*)calloc(ev->nany, sizeof(unsigned));
+	    ev->any_wid = (unsigned*)calloc(ev->nany, sizeof(unsigned));
+      }
+
+      ev->any_base[idx] = pr->part_base(pin);
+      ev->any_wid[idx] = pr->part_wid(pin);
+}
+
 bool dll_target::process(const NetProcTop*net)
 {
       bool rc_flag = true;
@@ -50,6 +66,16 @@ bool dll_target::process(const NetProcTop*net)
       obj->nattr = net->attr_cnt();
       obj->attr = fill_in_attributes(net);
 
+	/* If the target asked for lazy statements, leave the
+	   statement to the ivl_process_stmt accessor, or to
+	   end_design if the target does not ask for it. */
+      if (lazy_target_statements) {
+	    obj->lazy_stmt_ = net->statement();
+	    obj->next_ = des_.threads_;
+	    des_.threads_ = obj;
+	    return true;
+      }
+
 	/* This little bit causes the process to be completely
 	   generated so that it can be passed to the DLL. The
 	   stmt_cur_ member is used to hold a pointer to the current
@@ -75,6 +101,294 @@ bool dll_target::process(const NetProcTop*net)
       return rc_flag;
 }
 
+/*
+ * Convert a statement that was left unconverted because of the
+ * lazy_target_statements flag. This is called by the ivl_target
+ * accessors while the target_design function runs, and by end_design
+ * for the statements that the target did not ask for. The errors are
+ * collected and added to the target result by end_design.
+ */
+ivl_statement_t dll_target::lazy_statement(const NetProc*net)
+{
+      assert(stmt_cur_ == 0);
+      stmt_cur_ = (struct ivl_statement_s*)calloc(1, sizeof*stmt_cur_);
+      if (! net->emit_proc(this))
+	    lazy_errors_ += 1;
+
+      assert(stmt_cur_);
+      ivl_statement_t res = stmt_cur_;
+      stmt_cur_ = 0;
+      return res;
+}
+
+/*
+ * In lazy mode the wait statements may never be converted, so connect
+ * the pins of all the events before the target runs. The ivl_event_t
+ * objects then have their nexus pins as they do without the flag.
+ */
+void dll_target::lazy_connect_events_(void)
+{
+      for (size_t idx = 0 ;  idx < lazy_events_.size() ;  idx += 1)
+	    event_pins_(lazy_events_[idx].second, lazy_events_[idx].first);
+      lazy_events_.clear();
+}
+
+/*
+ * Free an expression made by the expr_scan methods. The expression
+ * of a real parameter is the value of the parameter itself, so it is
+ * left alone. The signals, scopes and events that an expression
+ * refers to belong to the design and are not touched.
+ */
+static void expr_cleanup(ivl_expr_t expr)
+{
+      if (expr == 0)
+	    return;
+
+      switch (expr->type_) {
+	  case IVL_EX_ARRAY_PATTERN:
+	    for (size_t idx = 0 ;  idx < expr->u_.array_pattern_.parms ;  idx += 1)
+		  expr_cleanup(expr->u_.array_pattern_.parm[idx]);
+	    delete[]expr->u_.array_pattern_.parm;
+	    break;
+	  case IVL_EX_BINARY:
+	    expr_cleanup(expr->u_.binary_.lef_);
+	    expr_cleanup(expr->u_.binary_.rig_);
+	    break;
+	  case IVL_EX_CONCAT:
+	    for (unsigned idx = 0 ;  idx < expr->u_.concat_.parms ;  idx += 1)
+		  expr_cleanup(expr->u_.concat_.parm[idx]);
+	    delete[]expr->u_.concat_.parm;
+	    break;
+	  case IVL_EX_NEW:
+	    expr_cleanup(expr->u_.new_.size);
+	    expr_cleanup(expr->u_.new_.init_val);
+	    break;
+	  case IVL_EX_NUMBER:
+	    free(expr->u_.number_.bits_);
+	    break;
+	  case IVL_EX_PROPERTY:
+	    expr_cleanup(expr->u_.property_.index);
+	    break;
+	  case IVL_EX_REALNUM:
+	    if (expr->u_.real_.parameter
+		&& expr->u_.real_.parameter->value == expr)
+		  return;
+	    break;
+	  case IVL_EX_SELECT:
+	    expr_cleanup(expr->u_.select_.expr_);
+	    expr_cleanup(expr->u_.select_.base_);
+	    break;
+	  case IVL_EX_SFUNC:
+	    for (unsigned idx = 0 ;  idx < expr->u_.sfunc_.parms ;  idx += 1)
+		  expr_cleanup(expr->u_.sfunc_.parm[idx]);
+	    delete[]expr->u_.sfunc_.parm;
+	    break;
+	  case IVL_EX_SHALLOWCOPY:
+	    expr_cleanup(expr->u_.shallow_.dest);
+	    expr_cleanup(expr->u_.shallow_.src);
+	    break;
+	  case IVL_EX_ARRAY:
+	  case IVL_EX_SIGNAL:
+	    expr_cleanup(expr->u_.signal_.word);
+	    break;
+	  case IVL_EX_STRING:
+	    free(expr->u_.string_.value_);
+	    break;
+	  case IVL_EX_TERNARY:
+	    expr_cleanup(expr->u_.ternary_.cond);
+	    expr_cleanup(expr->u_.ternary_.true_e);
+	    expr_cleanup(expr->u_.ternary_.false_e);
+	    break;
+	  case IVL_EX_UFUNC:
+	    for (unsigned idx = 0 ;  idx < expr->u_.ufunc_.parms ;  idx += 1)
+		  expr_cleanup(expr->u_.ufunc_.parm[idx]);
+	    delete[]expr->u_.ufunc_.parm;
+	    break;
+	  case IVL_EX_UNARY:
+	    expr_cleanup(expr->u_.unary_.sub_);
+	    break;
+	  default:
+	    break;
+      }
+
+      free(expr);
+}
+
+static void lval_cleanup(struct ivl_lval_s*lval)
+{
+      expr_cleanup(lval->loff);
+      expr_cleanup(lval->idx);
+      if (lval->type_ == IVL_LVAL_LVAL) {
+	    lval_cleanup(lval->n.nest);
+	    delete lval->n.nest;
+      }
+}
+
+/*
+ * Free the parts of a statement made by the proc_* methods. The
+ * statement itself may be an element of an array, so it is left to
+ * the caller.
+ */
+static void stmt_cleanup(ivl_statement_t stmt)
+{
+      switch (stmt->type_) {
+	  case IVL_ST_ASSIGN:
+	  case IVL_ST_ASSIGN_NB:
+	  case IVL_ST_CASSIGN:
+	  case IVL_ST_DEASSIGN:
+	  case IVL_ST_FORCE:
+	  case IVL_ST_RELEASE:
+	    for (unsigned idx = 0 ;  idx < stmt->u_.assign_.lvals_ ;  idx += 1)
+		  lval_cleanup(stmt->u_.assign_.lval_ + idx);
+	    delete[]stmt->u_.assign_.lval_;
+	    expr_cleanup(stmt->u_.assign_.delay);
+	    if (stmt->type_ == IVL_ST_DEASSIGN || stmt->type_ == IVL_ST_RELEASE)
+		  break;
+	    expr_cleanup(stmt->u_.assign_.rval_);
+	    if (stmt->type_ != IVL_ST_ASSIGN_NB)
+		  break;
+	    expr_cleanup(stmt->u_.assign_.count);
+	    if (stmt->u_.assign_.nevent > 1)
+		  free(stmt->u_.assign_.events);
+	    break;
+	  case IVL_ST_BLOCK:
+	  case IVL_ST_FORK:
+	  case IVL_ST_FORK_JOIN_ANY:
+	  case IVL_ST_FORK_JOIN_NONE:
+	    for (unsigned idx = 0 ;  idx < stmt->u_.block_.nstmt_ ;  idx += 1)
+		  stmt_cleanup(stmt->u_.block_.stmt_ + idx);
+	    free(stmt->u_.block_.stmt_);
+	    break;
+	  case IVL_ST_CASE:
+	  case IVL_ST_CASER:
+	  case IVL_ST_CASEX:
+	  case IVL_ST_CASEZ:
+	    expr_cleanup(stmt->u_.case_.cond);
+	    for (unsigned idx = 0 ;  idx < stmt->u_.case_.ncase ;  idx += 1) {
+		  expr_cleanup(stmt->u_.case_.case_ex[idx]);
+		  stmt_cleanup(stmt->u_.case_.case_st + idx);
+	    }
+	    delete[]stmt->u_.case_.case_ex;
+	    free(stmt->u_.case_.case_st);
+	    break;
+	  case IVL_ST_CONDIT:
+	    expr_cleanup(stmt->u_.condit_.cond_);
+	    stmt_cleanup(stmt->u_.condit_.stmt_ + 0);
+	    stmt_cleanup(stmt->u_.condit_.stmt_ + 1);
+	    free(stmt->u_.condit_.stmt_);
+	    break;
+	  case IVL_ST_CONTRIB:
+	    expr_cleanup(stmt->u_.contrib_.lval);
+	    expr_cleanup(stmt->u_.contrib_.rval);
+	    break;
+	  case IVL_ST_DELAY:
+	    stmt_cleanup(stmt->u_.delay_.stmt_);
+	    free(stmt->u_.delay_.stmt_);
+	    break;
+	  case IVL_ST_DELAYX:
+	    expr_cleanup(stmt->u_.delayx_.expr);
+	    stmt_cleanup(stmt->u_.delayx_.stmt_);
+	    free(stmt->u_.delayx_.stmt_);
+	    break;
+	  case IVL_ST_FOREVER:
+	    stmt_cleanup(stmt->u_.forever_.stmt_);
+	    free(stmt->u_.forever_.stmt_);
+	    break;
+	  case IVL_ST_STASK:
+	    for (unsigned idx = 0 ;  idx < stmt->u_.stask_.nparm_ ;  idx += 1)
+		  expr_cleanup(stmt->u_.stask_.parms_[idx]);
+	    free(stmt->u_.stask_.parms_);
+	    break;
+	  case IVL_ST_WAIT:
+	    if (stmt->u_.wait_.nevent > 1)
+		  free(stmt->u_.wait_.events);
+	    stmt_cleanup(stmt->u_.wait_.stmt_);
+	    free(stmt->u_.wait_.stmt_);
+	    break;
+	  case IVL_ST_DO_WHILE:
+	  case IVL_ST_REPEAT:
+	  case IVL_ST_WHILE:
+	    expr_cleanup(stmt->u_.while_.cond_);
+	    stmt_cleanup(stmt->u_.while_.stmt_);
+	    free(stmt->u_.while_.stmt_);
+	    break;
+	  default:
+	    break;
+      }
+}
+
+/*
+ * Convert the statements that the target did not ask for. This is
+ * only done to find their errors, so each statement is freed again
+ * as soon as it is converted, and the process or scope is left
+ * without one.
+ */
+void dll_target::lazy_convert_rest_(void)
+{
+      for (ivl_process_t cur = des_.threads_ ;  cur ;  cur = cur->next_) {
+	    if (cur->stmt_ == 0 && cur->lazy_stmt_) {
+		  ivl_statement_t tmp = lazy_statement(cur->lazy_stmt_);
+		  cur->lazy_stmt_ = 0;
+		  stmt_cleanup(tmp);
+		  free(tmp);
+	    }
+      }
+
+      for (size_t idx = 0 ;  idx < lazy_scopes_.size() ;  idx += 1) {
+	    ivl_scope_t cur = lazy_scopes_[idx];
+	    if (cur->def == 0 && cur->lazy_def) {
+		  ivl_statement_t tmp = lazy_statement(cur->lazy_def);
+		  cur->lazy_def = 0;
+		  stmt_cleanup(tmp);
+		  free(tmp);
+	    }
+      }
+      lazy_scopes_.clear();
+}
+
+/*
+ * Connect the probe pins of an event. This is not done by the ::event
+ * method because the signals are not scanned yet at that time.
+ */
+void dll_target::event_pins_(ivl_event_t ev_tmp, const NetEvent*ev)
+{
+      if (ev->nprobe() == 0)
+	    return;
+
+      unsigned iany = 0;
+      unsigned ineg = ev_tmp->nany;
+      unsigned ipos = ineg + ev_tmp->nneg;
+
+      for (unsigned idx = 0 ;  idx < ev->nprobe() ;  idx += 1) {
+	    const NetEvProbe*pr = ev->probe(idx);
+	    unsigned base = 0;
+
+	    switch (pr->edge()) {
+		case NetEvProbe::ANYEDGE:
+		  base = iany;
+		  iany += pr->pin_count();
+		  break;
+		case NetEvProbe::NEGEDGE:
+		  base = ineg;
+		  ineg += pr->pin_count();
+		  break;
+		case NetEvProbe::POSEDGE:
+		  base = ipos;
+		  ipos += pr->pin_count();
+		  break;
+	    }
+
+	    for (unsigned bit = 0 ;  bit < pr->pin_count() ;  bit += 1) {
+		  ivl_nexus_t nex = (ivl_nexus_t)
+			pr->pin(bit).nexus()->t_cookie();
+		  assert(nex);
+		  ev_tmp->pins[base+bit] = nex;
+		  if (pr->part_wid(bit))
+			event_any_part(ev_tmp, base+bit, pr, bit);
+	    }
+      }
+}
+
 void dll_target::task_def(const NetScope*net)
 {
       ivl_scope_t scop = lookup_scope_(net);
@@ -82,13 +396,18 @@ void dll_target::task_def(const NetScope*net)
 
       assert(def);
       assert(def->proc());
-      assert(stmt_cur_ == 0);
-      stmt_cur_ = (struct ivl_statement_s*)calloc(1, sizeof*stmt_cur_);
-      def->proc()->emit_proc(this);
+      if (lazy_target_statements) {
+	    scop->lazy_def = def->proc();
+	    lazy_scopes_.push_back(scop);
+      } else {
+	    assert(stmt_cur_ == 0);
+	    stmt_cur_ = (struct ivl_statement_s*)calloc(1, sizeof*stmt_cur_);
+	    def->proc()->emit_proc(this);
 
-      assert(stmt_cur_);
-      scop->def = stmt_cur_;
-      stmt_cur_ = 0;
+	    assert(stmt_cur_);
+	    scop->def = stmt_cur_;
+	    stmt_cur_ = 0;
+      }
 
       scop->ports = def->port_count();
       if (scop->ports > 0) {
@@ -106,13 +425,18 @@ bool dll_target::func_def(const NetScope*net)
 
       assert(def);
       assert(def->proc());
-      assert(stmt_cur_ == 0);
-      stmt_cur_ = (struct ivl_statement_s*)calloc(1, sizeof*stmt_cur_);
-      def->proc()->emit_proc(this);
+      if (lazy_target_statements) {
+	    scop->lazy_def = def->proc();
+	    lazy_scopes_.push_back(scop);
+      } else {
+	    assert(stmt_cur_ == 0);
+	    stmt_cur_ = (struct ivl_statement_s*)calloc(1, sizeof*stmt_cur_);
+	    def->proc()->emit_proc(this);
 
-      assert(stmt_cur_);
-      scop->def = stmt_cur_;
-      stmt_cur_ = 0;
+	    assert(stmt_cur_);
+	    scop->def = stmt_cur_;
+	    stmt_cur_ = 0;
+      }
 
       scop->ports = def->port_count() + 1;
       if (scop->ports > 0) {
@@ -299,7 +623,7 @@ void dll_target::proc_assign_nb(const NetAssignNB*net)
 	/* Process a delay if it exists. */
       if (const NetEConst*delay_num = dynamic_cast<const NetEConst*>(delay_exp)) {
 	    verinum val = delay_num->value();
-	    ivl_expr_t de = new struct ivl_expr_s;
+	    ivl_expr_t de = (ivl_expr_t)calloc(1, sizeof(struct ivl_expr_s));
 	    de->type_ = IVL_EX_DELAY;
 	    de->width_  = 8 * sizeof(uint64_t);
 	    de->signed_ = 0;
@@ -315,7 +639,7 @@ void dll_target::proc_assign_nb(const NetAssignNB*net)
 	/* Process a count if it exists. */
       if (const NetEConst*cnt_num = dynamic_cast<const NetEConst*>(cnt_exp)) {
 	    verinum val = cnt_num->value();
-	    ivl_expr_t cnt = new struct ivl_expr_s;
+	    ivl_expr_t cnt = (ivl_expr_t)calloc(1, sizeof(struct ivl_expr_s));
 	    cnt->type_ = IVL_EX_ULONG;
 	    cnt->width_  = 8 * sizeof(unsigned long);
 	    cnt->signed_ = 0;
@@ -363,42 +687,8 @@ void dll_target::proc_assign_nb(const NetAssignNB*net)
 			stmt_cur_->u_.assign_.events[edx] = ev_tmp;
 
 		    /* If this is an event with a probe, then connect up the
-		       pins. This wasn't done during the ::event method because
-		       the signals weren't scanned yet. */
-
-		  if (ev->nprobe() >= 1) {
-			unsigned iany = 0;
-			unsigned ineg = ev_tmp->nany;
-			unsigned ipos = ineg + ev_tmp->nneg;
-
-			for (unsigned idx = 0;  idx < ev->nprobe();  idx += 1) {
-			      const NetEvProbe*pr = ev->probe(idx);
-			      unsigned base = 0;
-
-			      switch (pr->edge()) {
-				  case NetEvProbe::ANYEDGE:
-				    base = iany;
-				    iany += pr->pin_count();
-				    break;
-				  case NetEvProbe::NEGEDGE:
-				    base = ineg;
-				    ineg += pr->pin_count();
-				    break;
-				  case NetEvProbe::POSEDGE:
-				    base = ipos;
-				    ipos += pr->pin_count();
-				    break;
-			      }
-
-			      for (unsigned bit = 0; bit < pr->pin_count();
-				   bit += 1) {
-				    ivl_nexus_t nex = (ivl_nexus_t)
-				          pr->pin(bit).nexus()->t_cookie();
-				    assert(nex);
-				    ev_tmp->pins[base+bit] = nex;
-			      }
-			}
-		  }
+		       pins. */
+		  event_pins_(ev_tmp, ev);
 	    }
       }
 }
@@ -513,7 +803,8 @@ void dll_target::proc_case(const NetCase*net)
       stmt_cur_->u_.case_.ncase = ncase;
 
       stmt_cur_->u_.case_.case_ex = new ivl_expr_t[ncase];
-      stmt_cur_->u_.case_.case_st = new struct ivl_statement_s[ncase];
+      stmt_cur_->u_.case_.case_st = (struct ivl_statement_s*)
+	    calloc(ncase, sizeof(struct ivl_statement_s));
 
       ivl_statement_t save_cur = stmt_cur_;
 
@@ -888,43 +1179,8 @@ bool dll_target::proc_wait(const NetEvWait*net)
 		  stmt_cur_->u_.wait_.events[edx] = ev_tmp;
 
 	      /* If this is an event with a probe, then connect up the
-		 pins. This wasn't done during the ::event method because
-		 the signals weren't scanned yet. */
-
-	    if (ev->nprobe() >= 1) {
-		  unsigned iany = 0;
-		  unsigned ineg = ev_tmp->nany;
-		  unsigned ipos = ineg + ev_tmp->nneg;
-
-		  for (unsigned idx = 0 ;  idx < ev->nprobe() ;  idx += 1) {
-			const NetEvProbe*pr = ev->probe(idx);
-			unsigned base = 0;
-
-			switch (pr->edge()) {
-			    case NetEvProbe::ANYEDGE:
-			      base = iany;
-			      iany += pr->pin_count();
-			      break;
-			    case NetEvProbe::NEGEDGE:
-			      base = ineg;
-			      ineg += pr->pin_count();
-			      break;
-			    case NetEvProbe::POSEDGE:
-			      base = ipos;
-			      ipos += pr->pin_count();
-			      break;
-			}
-
-			for (unsigned bit = 0
-				   ; bit < pr->pin_count()
-				   ; bit += 1) {
-			      ivl_nexus_t nex = (ivl_nexus_t)
-				    pr->pin(bit).nexus()->t_cookie();
-			      assert(nex);
-			      ev_tmp->pins[base+bit] = nex;
-			}
-		  }
-	    }
+		 pins. */
+	    event_pins_(ev_tmp, ev);
       }
 
 	/* The ivl_statement_t for the wait statement is not complete
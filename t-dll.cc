@@ -615,6 +615,7 @@ void dll_target::add_root(const NetScope *s)
       root_->nlpm_ = 0;
       root_->lpm_ = 0;
       root_->def = 0;
+      root_->lazy_def = 0;
       make_scope_parameters(root_, s);
       root_->tname_ = root_->name_;
       root_->time_precision = s->time_precision();
@@ -683,6 +684,7 @@ bool dll_target::start_design(const Design*des)
       }
 
       stmt_cur_ = 0;
+      lazy_errors_ = 0;
 
 	// Initialize the design object.
       des_.self = des;
@@ -733,7 +735,19 @@ int dll_target::end_design(const Design*)
 		  cout << " ... invoking target_design" << endl;
 	    }
 
+	    if (lazy_target_statements)
+		  lazy_connect_events_();
+
 	    rc = (target_)(&des_);
+
+	      /* Convert the statements that the target did not ask
+		 for, so that their errors are still found. Report the
+		 errors of all the late conversions like the other
+		 emit errors. */
+	    if (lazy_target_statements) {
+		  lazy_convert_rest_();
+		  rc += lazy_errors_;
+	    }
       } else {
 	    if (verbose_flag) {
 		  cout << " ... skipping target_design due to errors." << endl;
@@ -946,6 +960,13 @@ void dll_target::event(const NetEvent*net)
 	    obj->pins  = 0;
       }
 
+      obj->any_base = 0;
+      obj->any_wid = 0;
+
+	/* The signals are not scanned yet, so the pins are connected
+	   by the wait statements, or in lazy mode by end_design. */
+      if (lazy_target_statements && net->nprobe() >= 1)
+	    lazy_events_.push_back(make_pair(net, obj));
 }
 
 void dll_target::logic(const NetLogic*net)
@@ -2488,6 +2509,7 @@ void dll_target::scope(const NetScope*net)
 	    scop->nlpm_ = 0;
 	    scop->lpm_ = 0;
 	    scop->def = 0;
+	    scop->lazy_def = 0;
 	    make_scope_parameters(scop, net);
 	    scop->time_precision = net->time_precision();
 	    scop->time_units = net->time_unit();
@@ -2750,6 +2772,7 @@ void dll_target::signal(const NetNet*net)
 		  }
 	    } else {
 		  ivl_nexus_t tmp = nexus_sig_make(obj, idx);
+		  tmp->ptrs_.reserve(nex->link_count());
 		  tmp->nexus_ = nex;
 		  tmp->name_ = 0;
 		  nex->t_cookie(tmp);
@@ -2822,6 +2845,45 @@ bool dll_target::signal_paths(const NetNet*net)
       return true;
 }
 
+bool dll_target::timing_check(const NetTimingCheck*net)
+{
+      ivl_tchk_t obj = new struct ivl_tchk_s;
+      obj->type = net->type();
+      obj->scope = lookup_scope_(net->scope());
+      obj->file = net->get_file();
+      obj->lineno = net->get_lineno();
+
+      obj->ref = net->ref_pin().nexus()->t_cookie();
+      assert(obj->ref);
+      obj->ref_edge = net->ref_edge();
+      obj->ref_cond = 0;
+      if (net->has_ref_cond())
+	    obj->ref_cond = net->ref_cond_pin().nexus()->t_cookie();
+
+      obj->data = 0;
+      obj->data_edge = 0;
+      obj->data_cond = 0;
+      if (net->has_data()) {
+	    obj->data = net->data_pin().nexus()->t_cookie();
+	    assert(obj->data);
+	    obj->data_edge = net->data_edge();
+	    if (net->has_data_cond())
+		  obj->data_cond = net->data_cond_pin().nexus()->t_cookie();
+      }
+
+      obj->limit[0] = net->limit(0);
+      obj->limit[1] = net->limit(1);
+
+      obj->notifier = 0;
+      if (const NetNet*sig = net->notifier()) {
+	    obj->notifier = find_signal(des_, sig);
+	    assert(obj->notifier);
+      }
+
+      obj->scope->tchks.push_back(obj);
+      return true;
+}
+
 
 void dll_target::test_version(const char*target_name)
 {
@@ -99,6 +99,7 @@ struct dll_target  : public target_t, public expr_scan_t {
       void convert_module_ports(const NetScope*);
       void signal(const NetNet*);
       bool signal_paths(const NetNet*);
+      bool timing_check(const NetTimingCheck*);
       ivl_dll_t dll_;
 
       ivl_design_s des_;
@@ -135,6 +136,21 @@ struct dll_target  : public target_t, public expr_scan_t {
       bool func_def(const NetScope*);
       void task_def(const NetScope*);
 
+	/* With lazy_target_statements, the process and definition
+	   statements are made by the ivl_process_stmt and
+	   ivl_scope_def accessors through this method. */
+      ivl_statement_t lazy_statement(const NetProc*net);
+      unsigned lazy_errors_;
+	/* The events and definition scopes that are finished by
+	   end_design in lazy mode. */
+      std::vector<std::pair<const NetEvent*,ivl_event_t> > lazy_events_;
+      std::vector<ivl_scope_t> lazy_scopes_;
+      void lazy_connect_events_(void);
+      void lazy_convert_rest_(void);
+
+	/* Connect the probe pins of the event. */
+      void event_pins_(ivl_event_t ev_tmp, const NetEvent*ev);
+
       struct ivl_expr_s*expr_;
       void expr_access_func(const NetEAccess*);
       void expr_array_pattern(const NetEArrayPattern*);
@@ -212,6 +228,21 @@ struct ivl_delaypath_s {
       uint64_t delay[12];
 };
 
+struct ivl_tchk_s {
+      ivl_tchk_type_t type;
+      ivl_scope_t scope;
+      perm_string file;
+      unsigned lineno;
+      ivl_nexus_t ref;
+      ivl_nexus_t ref_cond;
+      ivl_nexus_t data;
+      ivl_nexus_t data_cond;
+      unsigned ref_edge;
+      unsigned data_edge;
+      uint64_t limit[2];
+      ivl_signal_t notifier;
+};
+
 struct ivl_event_s {
       perm_string name;
       ivl_scope_t scope;
@@ -219,6 +250,10 @@ struct ivl_event_s {
       unsigned lineno;
       unsigned nany, nneg, npos;
       ivl_nexus_t*pins;
+	// The watched part of each any edge pin, or nil if all of
+	// the pins watch the whole vector.
+      unsigned*any_base;
+      unsigned*any_wid;
 };
 
 /*
@@ -650,6 +685,7 @@ struct ivl_process_s {
       unsigned int analog_flag : 1;
       ivl_scope_t scope_;
       ivl_statement_t stmt_;
+      const NetProc*lazy_stmt_;
       perm_string file;
       unsigned lineno;
 
@@ -700,6 +736,7 @@ struct ivl_scope_s {
 
 	/* Scopes that are tasks/functions have a definition. */
       ivl_statement_t def;
+      const NetProc*lazy_def;
       unsigned is_auto;
       ivl_variable_type_t func_type;
       bool func_signed;
@@ -719,6 +756,7 @@ struct ivl_scope_s {
       } u_;
 
       std::vector<ivl_switch_t>switches;
+      std::vector<ivl_tchk_t>tchks;
 
       signed int time_precision :8;
       signed int time_units :8;
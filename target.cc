@@ -67,6 +67,11 @@ bool target_t::signal_paths(const NetNet*)
 {
       return true;
 }
+
+bool target_t::timing_check(const NetTimingCheck*)
+{
+      return true;
+}
 bool target_t::func_def(const NetScope*)
 {
       cerr << "target (" << typeid(*this).name() <<  "): "
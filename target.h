@@ -76,6 +76,10 @@ struct target_t {
       virtual void signal(const NetNet*) =0;
       virtual bool signal_paths(const NetNet*);
 
+	/* Output a specify block timing check. This is called after
+	   all the signals of the scope are done. */
+      virtual bool timing_check(const NetTimingCheck*);
+
         /* Analog branches */
       virtual bool branch(const NetBranch*);
 
@@ -730,6 +730,12 @@ static void draw_net_input_x(ivl_nexus_t nex,
 	   TRI type nexus. */
       if (ndrivers == 1 && res == IVL_SIT_TRI) {
 	    ivl_signal_t path_sig = find_modpath(nex);
+	    ivl_signal_t part_sig = 0;
+	    unsigned part_drv = 0, part_nrcv = 0;
+	    unsigned*part_rcv = 0;
+	    if (path_sig == 0)
+		  part_sig = find_partition_boundary(nex, drivers[0], &part_drv,
+						     &part_rcv, &part_nrcv);
 	    if (path_sig) {
 		  char*nex_str = draw_net_input_drive(nex, drivers[0]);
 		  char modpath_label[64];
@@ -738,6 +744,17 @@ static void draw_net_input_x(ivl_nexus_t nex,
 		  nex_private = strdup(modpath_label);
 		  draw_modpath(path_sig, nex_str, 0);
 
+	    } else if (part_sig) {
+		    /* A net that crosses a partition boundary goes
+		       through a .boundary functor. */
+		  char*nex_str = draw_net_input_drive(nex, drivers[0]);
+		  char boundary_label[64];
+		  snprintf(boundary_label, sizeof boundary_label,
+			   "B_%p", part_sig);
+		  nex_private = strdup(boundary_label);
+		  draw_boundary(part_sig, drivers[0], nex_str, part_drv,
+				part_rcv, part_nrcv);
+
 	    } else {
 		  nex_private = draw_net_input_drive(nex, drivers[0]);
 	    }
@@ -287,7 +287,12 @@ static void draw_sfunc_real(ivl_expr_t expr)
       switch (ivl_expr_value(expr)) {
 
 	  case IVL_VT_REAL:
-	    if (ivl_expr_parms(expr) == 0) {
+	    if (ivl_expr_parms(expr) == 0
+		&& strcmp(ivl_expr_name(expr), "$realtime") == 0) {
+		    /* vvp implements $realtime as an instruction. */
+		  fprintf(vvp_out, "    %%sys/realtime;\n");
+
+	    } else if (ivl_expr_parms(expr) == 0) {
 		  fprintf(vvp_out, "    %%vpi_func/r %u %u \"%s\" {0 0 0};\n",
 			  ivl_file_table_index(ivl_expr_file(expr)),
 			  ivl_expr_lineno(expr), ivl_expr_name(expr));
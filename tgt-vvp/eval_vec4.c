@@ -108,6 +108,16 @@ void draw_immediate_vec4(ivl_expr_t re, const char*opcode)
       fprintf(vvp_out, "    %s %lu, %lu, %u;\n", opcode, val0, valx, wid);
 }
 
+/*
+ * Return true if both operands are 2-state, so that the 2-state
+ * version of an arithmetic or compare instruction can be used.
+ */
+static int vec4_two_state(ivl_expr_t le, ivl_expr_t re)
+{
+      return ivl_expr_value(le) == IVL_VT_BOOL
+	    && ivl_expr_value(re) == IVL_VT_BOOL;
+}
+
 static void draw_binary_vec4_arith(ivl_expr_t expr)
 {
       ivl_expr_t le = ivl_expr_oper1(expr);
@@ -125,6 +135,10 @@ static void draw_binary_vec4_arith(ivl_expr_t expr)
       int signed_flag = (ivl_expr_signed(le) || is_power_op) && ivl_expr_signed(re) ? 1 : 0;
       const char*signed_string = signed_flag? "/s" : "";
 
+	/* If both operands are 2-state, then use the 2-state version
+	   of the instruction, which does not check for X or Z bits. */
+      const char*two_string = vec4_two_state(le, re)? "/2" : "";
+
 	/* All the arithmetic operations handled here (except for the power
 	   operation) require that the operands (and the result) be the same
 	   width. We further assume that the core has not given us an operand
@@ -161,19 +175,19 @@ static void draw_binary_vec4_arith(ivl_expr_t expr)
 
       switch (ivl_expr_opcode(expr)) {
 	  case '+':
-	    fprintf(vvp_out, "    %%add;\n");
+	    fprintf(vvp_out, "    %%add%s;\n", two_string);
 	    break;
 	  case '-':
-	    fprintf(vvp_out, "    %%sub;\n");
+	    fprintf(vvp_out, "    %%sub%s;\n", two_string);
 	    break;
 	  case '*':
-	    fprintf(vvp_out, "    %%mul;\n");
+	    fprintf(vvp_out, "    %%mul%s;\n", two_string);
 	    break;
 	  case '/':
-	    fprintf(vvp_out, "    %%div%s;\n", signed_string);
+	    fprintf(vvp_out, "    %%div%s%s;\n", two_string, signed_string);
 	    break;
 	  case '%':
-	    fprintf(vvp_out, "    %%mod%s;\n", signed_string);
+	    fprintf(vvp_out, "    %%mod%s%s;\n", two_string, signed_string);
 	    break;
 	  case 'p':
 	    fprintf(vvp_out, "    %%pow%s;\n", signed_string);
@@ -614,7 +628,10 @@ static void draw_binary_vec4_le(ivl_expr_t expr)
 	    draw_eval_vec4(re);
 	    resize_vec4_wid(re, use_wid);
 
-	    fprintf(vvp_out, "    %%cmp/%c;\n", s_flag);
+	    if (vec4_two_state(le, re))
+		  fprintf(vvp_out, "    %%cmp/2/%c;\n", s_flag);
+	    else
+		  fprintf(vvp_out, "    %%cmp/%c;\n", s_flag);
       }
 
       switch (use_opcode) {
@@ -1012,10 +1029,149 @@ static void draw_darray_pop(ivl_expr_t expr)
                        ivl_expr_width(expr));
 }
 
+/*
+ * vhdlpp lowers the VHDL 'event attribute and the rising_edge() and
+ * falling_edge() functions to calls to $ivlh_attribute_event et
+ * al. If the argument is a simple static signal, then draw a ".event
+ * vhdl" functor that watches the signal and use the %evtest
+ * instruction to test it. This avoids the VPI call and value change
+ * callback on every edge of the signal. Return 0 if the argument
+ * cannot be handled this way, so that the caller falls back to the
+ * VPI implementation.
+ */
+static int draw_vhdl_edge_test(ivl_expr_t expr)
+{
+      static unsigned vhdl_edge_counter = 0;
+      const char*name = ivl_expr_name(expr);
+      unsigned type;
+
+      if (strcmp(name, "$ivlh_attribute_event") == 0)
+	    type = 0;
+      else if (strcmp(name, "$ivlh_rising_edge") == 0)
+	    type = 1;
+      else if (strcmp(name, "$ivlh_falling_edge") == 0)
+	    type = 2;
+      else
+	    return 0;
+
+      if (ivl_expr_parms(expr) != 1)
+	    return 0;
+
+      ivl_expr_t arg = ivl_expr_parm(expr, 0);
+      if (ivl_expr_type(arg) != IVL_EX_SIGNAL)
+	    return 0;
+
+      ivl_signal_t sig = ivl_expr_signal(arg);
+      if (ivl_signal_dimensions(sig) != 0)
+	    return 0;
+      if (signal_is_return_value(sig))
+	    return 0;
+      if (ivl_scope_is_auto(ivl_signal_scope(sig)))
+	    return 0;
+
+      fprintf(vvp_out, "Evhdl_%u .event vhdl, v%p_0;\n",
+	      vhdl_edge_counter, sig);
+      fprintf(vvp_out, "    %%evtest Evhdl_%u, %u;\n",
+	      vhdl_edge_counter, type);
+      vhdl_edge_counter += 1;
+
+      if (ivl_expr_width(expr) > 1)
+	    fprintf(vvp_out, "    %%pad/u %u;\n", ivl_expr_width(expr));
+
+      return 1;
+}
+
+static int is_vec4_value(ivl_expr_t expr)
+{
+      switch (ivl_expr_value(expr)) {
+	  case IVL_VT_LOGIC:
+	  case IVL_VT_BOOL:
+	    return ivl_expr_width(expr) > 0;
+	  default:
+	    return 0;
+      }
+}
+
+/*
+ * Some of the built-in system functions are called so often that vvp
+ * implements them as thread instructions instead of going through a
+ * VPI call. Draw those (when the call has the usual arguments and
+ * result width) and return true. Otherwise return false and let the
+ * caller draw the %vpi_func.
+ */
+static int draw_sfunc_intrinsic_vec4(ivl_expr_t expr)
+{
+      const char*name = ivl_expr_name(expr);
+      unsigned parm_count = ivl_expr_parms(expr);
+      unsigned wid = ivl_expr_width(expr);
+      const char*mnem = 0;
+      ivl_expr_t arg;
+      unsigned idx;
+
+      if (parm_count == 0) {
+	    if (strcmp(name, "$time") == 0 && wid == 64)
+		  mnem = "%sys/time";
+	    else if (strcmp(name, "$random") == 0 && wid == 32)
+		  mnem = "%sys/random";
+	    else if (strcmp(name, "$urandom") == 0 && wid == 32)
+		  mnem = "%sys/urandom";
+	    else
+		  return 0;
+
+	    fprintf(vvp_out, "    %s;\n", mnem);
+	    return 1;
+      }
+
+      if (strcmp(name, "$urandom_range") == 0) {
+	    if (wid != 32 || parm_count > 2)
+		  return 0;
+	    for (idx = 0 ; idx < parm_count ; idx += 1) {
+		  arg = ivl_expr_parm(expr, idx);
+		  if (arg == 0 || !is_vec4_value(arg))
+			return 0;
+	    }
+	      /* The arguments are converted to 32 bit integers, just
+		 like the vpiIntVal conversion of the VPI version. */
+	    for (idx = 0 ; idx < parm_count ; idx += 1) {
+		  arg = ivl_expr_parm(expr, idx);
+		  draw_eval_vec4(arg);
+		  fprintf(vvp_out, "    %%pad/%c 32;\n",
+			  ivl_expr_signed(arg)? 's' : 'u');
+	    }
+	    fprintf(vvp_out, "    %%sys/urandom_range %u;\n", parm_count);
+	    return 1;
+      }
+
+      if (parm_count != 1)
+	    return 0;
+
+      arg = ivl_expr_parm(expr, 0);
+      if (arg == 0 || !is_vec4_value(arg))
+	    return 0;
+
+      if (strcmp(name, "$countones") == 0 && wid == 32)
+	    mnem = "%sys/countones";
+      else if (strcmp(name, "$onehot") == 0 && wid == 1)
+	    mnem = "%sys/onehot 0";
+      else if (strcmp(name, "$onehot0") == 0 && wid == 1)
+	    mnem = "%sys/onehot 1";
+      else if (strcmp(name, "$isunknown") == 0 && wid == 1)
+	    mnem = "%sys/isunknown";
+      else
+	    return 0;
+
+      draw_eval_vec4(arg);
+      fprintf(vvp_out, "    %s;\n", mnem);
+      return 1;
+}
+
 static void draw_sfunc_vec4(ivl_expr_t expr)
 {
       unsigned parm_count = ivl_expr_parms(expr);
 
+      if (draw_sfunc_intrinsic_vec4(expr))
+	    return;
+
 	/* Special case: If there are no arguments to print, then the
 	   %vpi_call statement is easy to draw. */
       if (parm_count == 0) {
@@ -1038,6 +1194,9 @@ static void draw_sfunc_vec4(ivl_expr_t expr)
 	    return;
       }
 
+      if (draw_vhdl_edge_test(expr))
+	    return;
+
       draw_vpi_func_call(expr);
 }
 
@@ -157,3 +157,84 @@ void cleanup_modpath(void)
 	    free(cur);
       }
 }
+
+/*
+ * Find the signal in the scope of the timing check that the check
+ * terminal nexus connects to. Prefer a port, because that is the name
+ * that SDF annotation uses to match the check.
+ */
+static ivl_signal_t find_tchk_term(ivl_nexus_t nex, ivl_scope_t scope)
+{
+      unsigned idx;
+      ivl_signal_t res = 0;
+
+      for (idx = 0 ;  idx < ivl_nexus_ptrs(nex) ;  idx += 1) {
+	    ivl_nexus_ptr_t ptr = ivl_nexus_ptr(nex, idx);
+	    ivl_signal_t sig = ivl_nexus_ptr_sig(ptr);
+	    if (sig == 0)
+		  continue;
+	    if (ivl_signal_scope(sig) != scope)
+		  continue;
+	    if (ivl_signal_port(sig) != IVL_SIP_NONE)
+		  return sig;
+	    if (res == 0 && !ivl_signal_local(sig))
+		  res = sig;
+      }
+
+      return res;
+}
+
+/*
+ * Draw a .tchk record for a timing check. The record is drawn within
+ * the scope of the check, so the current scope is already right.
+ *
+ *   <label> .tchk <type> <file> <line>, <ref_edge>, <data_edge>,
+ *         <limit0>, <limit1>, <ref> ...;
+ *
+ * The symbols at the end are the input, the terminal signal and the
+ * condition for the reference and then for the data event, followed
+ * by the notifier if there is one. The $width and $period checks have
+ * no data symbols.
+ */
+void draw_tchk_in_scope(ivl_tchk_t tchk)
+{
+      ivl_scope_t scope = ivl_tchk_scope(tchk);
+      ivl_nexus_t ref = ivl_tchk_ref(tchk);
+      ivl_nexus_t ref_cond = ivl_tchk_ref_cond(tchk);
+      ivl_nexus_t data = ivl_tchk_data(tchk);
+      ivl_nexus_t data_cond = ivl_tchk_data_cond(tchk);
+      ivl_signal_t notifier = ivl_tchk_notifier(tchk);
+      ivl_signal_t ref_sig = find_tchk_term(ref, scope);
+      ivl_signal_t data_sig = data ? find_tchk_term(data, scope) : 0;
+
+      if (ref_sig == 0 || (data && data_sig == 0)) {
+	    fprintf(stderr, "%s:%u: tgt-vvp sorry: Unable to find the "
+		    "signals of this timing check.\n",
+		    ivl_tchk_file(tchk), ivl_tchk_lineno(tchk));
+	    vvp_errors += 1;
+	    return;
+      }
+
+      fprintf(vvp_out, "L_%p .tchk %d %u %u, %u, %u, %" PRIu64 ", %" PRIu64,
+	      tchk, ivl_tchk_type(tchk),
+	      ivl_file_table_index(ivl_tchk_file(tchk)),
+	      ivl_tchk_lineno(tchk),
+	      ivl_tchk_ref_edge(tchk), ivl_tchk_data_edge(tchk),
+	      ivl_tchk_limit(tchk, 0), ivl_tchk_limit(tchk, 1));
+
+      fprintf(vvp_out, ", %s", draw_net_input(ref));
+      fprintf(vvp_out, ", v%p_0", ref_sig);
+      fprintf(vvp_out, ", %s", ref_cond ? draw_net_input(ref_cond) : "C4<1>");
+
+      if (data) {
+	    fprintf(vvp_out, ", %s", draw_net_input(data));
+	    fprintf(vvp_out, ", v%p_0", data_sig);
+	    fprintf(vvp_out, ", %s",
+		    data_cond ? draw_net_input(data_cond) : "C4<1>");
+      }
+
+      if (notifier)
+	    fprintf(vvp_out, ", v%p_0", notifier);
+
+      fprintf(vvp_out, ";\n");
+}
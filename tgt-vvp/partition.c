@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "vvp_priv.h"
+# include  <string.h>
+# include  <stdlib.h>
+# include  <assert.h>
+# include  "ivl_alloc.h"
+
+/*
+ * A design is split into partitions at module instances. An instance
+ * starts a new partition if it has the ivl_partition attribute, like
+ * this:
+ *
+ *    (* ivl_partition = 1 *) cpu u_cpu (...);
+ *
+ * or if its full name is listed in the partition file given with the
+ * -ppartition=<file> flag. Each line of the file has the instance
+ * name and the partition number:
+ *
+ *    top.u_cpu 1
+ *
+ * The scopes inside the instance are in the same partition unless
+ * they start one of their own. The ports of the instance are the
+ * boundaries of the partition. The partitions advance in windows as
+ * long as the smallest boundary delay, so every net that crosses a
+ * boundary must be driven by a gate or continuous assignment with a
+ * constant, non-zero delay. The boundary takes that delay over from
+ * the driver, and never adds one that is not in the design.
+ */
+struct partition_map_s {
+      char*name;
+      unsigned part;
+      struct partition_map_s*next;
+};
+
+static struct partition_map_s*partition_map = 0;
+
+int load_partition_file(const char*path)
+{
+      char line[1024];
+      unsigned lineno = 0;
+      int errors = 0;
+
+      FILE*fd = fopen(path, "r");
+      if (fd == 0) {
+	    fprintf(stderr, "vvp.tgt error: Unable to open partition "
+		    "file %s.\n", path);
+	    return 1;
+      }
+
+      while (fgets(line, sizeof line, fd)) {
+	    char name[1024];
+	    unsigned part;
+	    char extra[2];
+	    int cnt;
+
+	    lineno += 1;
+	    if (line[0] == '#')
+		  continue;
+
+	    cnt = sscanf(line, "%1023s %u %1s", name, &part, extra);
+	    if (cnt == EOF || cnt == 0)
+		  continue;
+	    if (cnt != 2) {
+		  fprintf(stderr, "%s:%u: vvp.tgt error: Expecting an "
+			  "instance name and a partition number.\n",
+			  path, lineno);
+		  errors += 1;
+		  continue;
+	    }
+
+	    struct partition_map_s*cur = calloc(1, sizeof(struct partition_map_s));
+	    cur->name = strdup(name);
+	    cur->part = part;
+	    cur->next = partition_map;
+	    partition_map = cur;
+      }
+
+      fclose(fd);
+      return errors;
+}
+
+/*
+ * Return true if the scope starts a partition, and get the partition
+ * number.
+ */
+static int scope_partition_root(ivl_scope_t scope, unsigned*part)
+{
+      unsigned idx;
+      struct partition_map_s*cur;
+
+      if (ivl_scope_type(scope) != IVL_SCT_MODULE)
+	    return 0;
+
+      for (idx = 0 ;  idx < ivl_scope_attr_cnt(scope) ;  idx += 1) {
+	    ivl_attribute_t attr = ivl_scope_attr_val(scope, idx);
+	    if (attr->type != IVL_ATT_NUM)
+		  continue;
+	    if (strcmp(attr->key, "ivl_partition") == 0) {
+		  *part = attr->val.num;
+		  return 1;
+	    }
+      }
+
+      for (cur = partition_map ;  cur ;  cur = cur->next) {
+	    if (strcmp(cur->name, ivl_scope_name(scope)) != 0)
+		  continue;
+	    *part = cur->part;
+	    return 1;
+      }
+
+      return 0;
+}
+
+static unsigned scope_partition(ivl_scope_t scope)
+{
+      unsigned part;
+
+      for ( ; scope ; scope = ivl_scope_parent(scope)) {
+	    if (scope_partition_root(scope, &part))
+		  return part;
+      }
+
+      return 0;
+}
+
+/*
+ * Draw the .partition directive for a scope that starts a partition.
+ * This is called right after the .scope record.
+ */
+void draw_partition_in_scope(ivl_scope_t scope)
+{
+      unsigned part;
+
+      if (! scope_partition_root(scope, &part))
+	    return;
+
+      if (part == scope_partition(ivl_scope_parent(scope)))
+	    return;
+
+      fprintf(vvp_out, " .partition %u;\n", part);
+}
+
+/*
+ * Get the partition of the object that drives a nexus.
+ */
+static unsigned driver_partition(ivl_nexus_ptr_t nptr)
+{
+      ivl_scope_t scope = 0;
+
+      if (ivl_nexus_ptr_log(nptr))
+	    scope = ivl_logic_scope(ivl_nexus_ptr_log(nptr));
+      else if (ivl_nexus_ptr_con(nptr))
+	    scope = ivl_const_scope(ivl_nexus_ptr_con(nptr));
+      else if (ivl_nexus_ptr_lpm(nptr))
+	    scope = ivl_lpm_scope(ivl_nexus_ptr_lpm(nptr));
+      else if (ivl_nexus_ptr_sig(nptr))
+	    scope = ivl_signal_scope(ivl_nexus_ptr_sig(nptr));
+
+      return scope_partition(scope);
+}
+
+/*
+ * Find the port signal of a partition root on this nexus, if there
+ * is one. The nexus is driven by nptr. The partition of the driver is
+ * returned, and so are the other partitions that have a signal on the
+ * nexus, which are the partitions that read it. The receiver list is
+ * malloc'ed. Only vector nets can cross a boundary.
+ */
+ivl_signal_t find_partition_boundary(ivl_nexus_t nex, ivl_nexus_ptr_t nptr,
+				     unsigned*driver, unsigned**receivers,
+				     unsigned*nreceivers)
+{
+      ivl_signal_t port_sig = 0;
+      unsigned idx;
+
+      for (idx = 0 ;  idx < ivl_nexus_ptrs(nex) ;  idx += 1) {
+	    ivl_nexus_ptr_t ptr = ivl_nexus_ptr(nex, idx);
+	    ivl_signal_t sig = ivl_nexus_ptr_sig(ptr);
+	    ivl_scope_t scope;
+	    unsigned part;
+
+	    if (sig == 0)
+		  continue;
+	    if (ivl_signal_data_type(sig) == IVL_VT_REAL)
+		  return 0;
+
+	    scope = ivl_signal_scope(sig);
+	    if (! scope_partition_root(scope, &part))
+		  continue;
+
+	    if (scope_partition(ivl_scope_parent(scope)) == part)
+		  continue;
+
+	    switch (ivl_signal_port(sig)) {
+		case IVL_SIP_INPUT:
+		case IVL_SIP_OUTPUT:
+		  if (port_sig == 0)
+			port_sig = sig;
+		  break;
+		case IVL_SIP_INOUT:
+		  fprintf(stderr, "%s:%u: vvp.tgt sorry: inout port %s "
+			  "cannot be a partition boundary.\n",
+			  ivl_signal_file(sig), ivl_signal_lineno(sig),
+			  ivl_signal_basename(sig));
+		  return 0;
+		default:
+		  break;
+	    }
+      }
+
+      if (port_sig == 0)
+	    return 0;
+
+      *driver = driver_partition(nptr);
+      *receivers = 0;
+      *nreceivers = 0;
+
+	/* A net that is read in more than one other partition is sent
+	   to each of them. */
+      for (idx = 0 ;  idx < ivl_nexus_ptrs(nex) ;  idx += 1) {
+	    ivl_signal_t sig = ivl_nexus_ptr_sig(ivl_nexus_ptr(nex, idx));
+	    unsigned part, rdx;
+
+	    if (sig == 0)
+		  continue;
+
+	    part = scope_partition(ivl_signal_scope(sig));
+	    if (part == *driver)
+		  continue;
+	    for (rdx = 0 ;  rdx < *nreceivers ;  rdx += 1) {
+		  if ((*receivers)[rdx] == part)
+			break;
+	    }
+	    if (rdx < *nreceivers)
+		  continue;
+
+	    *receivers = realloc(*receivers, (*nreceivers+1) * sizeof(unsigned));
+	    (*receivers)[*nreceivers] = part;
+	    *nreceivers += 1;
+      }
+
+      if (*nreceivers == 0)
+	    return 0;
+
+      return port_sig;
+}
+
+/*
+ * Get the delays of the driver of a boundary net, and the label of
+ * the value before the .delay node of the driver. Return false if the
+ * driver does not have a delay the boundary can take over.
+ */
+static int boundary_driver_delay(ivl_nexus_ptr_t nptr, uint64_t delay[3],
+				 char*label, size_t nlabel)
+{
+      ivl_expr_t dly[3];
+      const void*obj;
+      unsigned idx;
+
+      if (ivl_nexus_ptr_log(nptr)) {
+	    ivl_net_logic_t lptr = ivl_nexus_ptr_log(nptr);
+	    for (idx = 0 ;  idx < 3 ;  idx += 1)
+		  dly[idx] = ivl_logic_delay(lptr, idx);
+	    obj = lptr;
+      } else if (ivl_nexus_ptr_con(nptr)) {
+	    ivl_net_const_t cptr = ivl_nexus_ptr_con(nptr);
+	    for (idx = 0 ;  idx < 3 ;  idx += 1)
+		  dly[idx] = ivl_const_delay(cptr, idx);
+	    obj = cptr;
+      } else if (ivl_nexus_ptr_lpm(nptr)) {
+	    ivl_lpm_t lpm = ivl_nexus_ptr_lpm(nptr);
+	    for (idx = 0 ;  idx < 3 ;  idx += 1)
+		  dly[idx] = ivl_lpm_delay(lpm, idx);
+	    obj = lpm;
+      } else {
+	    return 0;
+      }
+
+      for (idx = 0 ;  idx < 3 ;  idx += 1) {
+	    if (dly[idx] == 0 || ! number_is_immediate(dly[idx], 64, 0))
+		  return 0;
+	    if (number_is_unknown(dly[idx]))
+		  return 0;
+	    delay[idx] = get_number_immediate64(dly[idx]);
+	    if (delay[idx] == 0)
+		  return 0;
+      }
+
+      snprintf(label, nlabel, "L_%p/d", obj);
+      return 1;
+}
+
+/*
+ * The .boundary records are drawn at the end, like the .modpath
+ * records, because the nexus input may be figured out while another
+ * record is being drawn.
+ */
+struct boundary_item {
+      ivl_signal_t sig;
+      char*drive_label;
+      char*source_label;
+      unsigned driver;
+      unsigned*receivers;
+      unsigned nreceivers;
+      uint64_t delay[3];
+      struct boundary_item*next;
+};
+
+static struct boundary_item*boundary_list = 0;
+static struct boundary_item*boundary_tail = 0;
+
+void draw_boundary(ivl_signal_t sig, ivl_nexus_ptr_t nptr, char*drive_label,
+		   unsigned driver, unsigned*receivers, unsigned nreceivers)
+{
+      struct boundary_item*cur;
+      char source_label[64];
+
+      cur = calloc(1, sizeof(struct boundary_item));
+      cur->sig = sig;
+      cur->drive_label = drive_label;
+      cur->driver = driver;
+      cur->receivers = receivers;
+      cur->nreceivers = nreceivers;
+
+	/* The delay of the driver is the lookahead of the partitions.
+	   Without one the partitions cannot advance apart, and making
+	   one up would change the timing of the design. */
+      if (! boundary_driver_delay(nptr, cur->delay, source_label,
+				  sizeof source_label)) {
+	    fprintf(stderr, "%s:%u: vvp.tgt error: The partition boundary "
+		    "%s must be driven by a gate or continuous assignment "
+		    "with a constant, non-zero delay.\n",
+		    ivl_signal_file(sig), ivl_signal_lineno(sig),
+		    ivl_signal_basename(sig));
+	    vvp_errors += 1;
+	    strcpy(source_label, drive_label);
+      }
+      cur->source_label = strdup(source_label);
+
+	/* Keep the records in order, so that the output is stable. */
+      if (boundary_tail)
+	    boundary_tail->next = cur;
+      else
+	    boundary_list = cur;
+      boundary_tail = cur;
+}
+
+void cleanup_boundary(void)
+{
+      while (boundary_list) {
+	    struct boundary_item*cur = boundary_list;
+	    unsigned idx;
+	    boundary_list = cur->next;
+
+	    fprintf(vvp_out, "B_%p .boundary %u [", cur->sig, cur->driver);
+	    for (idx = 0 ;  idx < cur->nreceivers ;  idx += 1)
+		  fprintf(vvp_out, "%s%u", idx? "," : "", cur->receivers[idx]);
+	    fprintf(vvp_out, "] (%"PRIu64",%"PRIu64",%"PRIu64"), %s, %s;\n",
+		    cur->delay[0], cur->delay[1], cur->delay[2],
+		    cur->drive_label, cur->source_label);
+	    free(cur->receivers);
+	    free(cur->drive_label);
+	    free(cur->source_label);
+	    free(cur);
+      }
+      boundary_tail = 0;
+}
@@ -164,6 +164,9 @@ int target_design(ivl_design_t des)
       const char*fileline = ivl_design_flag(des, "fileline");
 
       const char*debug_flags = ivl_design_flag(des, "debug_flags");
+	/* Use -ppartition=<file> to name the instances that start a
+	 * partition of a distributed simulation. */
+      const char*partition_file = ivl_design_flag(des, "partition");
       process_debug_string(debug_flags);
 
       assert(path);
@@ -194,6 +197,11 @@ int target_design(ivl_design_t des)
             show_file_line = fl_value > 0;
       }
 
+      if (strcmp(partition_file, "") != 0) {
+	    if (load_partition_file(partition_file) > 0)
+		  return 1;
+      }
+
 #ifdef HAVE_FOPEN64
       vvp_out = fopen64(path, "w");
 #else
@@ -229,6 +237,7 @@ int target_design(ivl_design_t des)
 
         /* Finish up any modpaths that are not yet emitted. */
       cleanup_modpath();
+      cleanup_boundary();
 
       rc = ivl_design_process(des, draw_process, 0);
 
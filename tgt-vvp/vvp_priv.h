@@ -123,6 +123,42 @@ extern char* process_octal_codes(const char*txt, unsigned wid);
 extern void draw_modpath(ivl_signal_t path_sig, char*drive_label, unsigned drive_index);
 extern void cleanup_modpath(void);
 
+/*
+ * partition.c symbols.
+ *
+ * load_partition_file reads the instance names and partition numbers
+ * from the file given with the -ppartition flag.
+ *
+ * draw_partition_in_scope draws the .partition directive of a scope
+ * that starts a partition.
+ *
+ * find_partition_boundary returns the partition port signal of a
+ * nexus that crosses from one partition to another, or nil. It also
+ * gets the partition of the driver and the list of partitions that
+ * read the nexus.
+ *
+ * draw_boundary arranges for a .boundary record to be written out
+ * for the net driven by nptr, and cleanup_boundary writes out the
+ * pending records. The drive_label must be malloc'ed by the caller.
+ */
+extern int load_partition_file(const char*path);
+extern void draw_partition_in_scope(ivl_scope_t scope);
+extern ivl_signal_t find_partition_boundary(ivl_nexus_t nex,
+					    ivl_nexus_ptr_t nptr,
+					    unsigned*driver,
+					    unsigned**receivers,
+					    unsigned*nreceivers);
+extern void draw_boundary(ivl_signal_t sig, ivl_nexus_ptr_t nptr,
+			  char*drive_label, unsigned driver,
+			  unsigned*receivers, unsigned nreceivers);
+extern void cleanup_boundary(void);
+
+/*
+ * draw_tchk_in_scope draws the .tchk record of a specify block timing
+ * check. It is called while drawing the scope of the check.
+ */
+extern void draw_tchk_in_scope(ivl_tchk_t tchk);
+
 /*
  * This function draws the execution of a vpi_call statement, along
  * with the tricky handling of arguments. If this is called with a
@@ -1144,6 +1144,32 @@ static void draw_logic_in_scope(ivl_net_logic_t lptr)
       if (need_delay_flag) draw_logic_delay(lptr);
 }
 
+/*
+ * An any edge input may watch only part of its vector. If any of the
+ * inputs [idx, top) do, draw the base and width of each of them. A
+ * zero width watches the whole vector.
+ */
+static void draw_event_any_parts(ivl_event_t obj, unsigned idx, unsigned top)
+{
+      unsigned sub;
+
+      for (sub = idx ;  sub < top ;  sub += 1) {
+	    if (ivl_event_any_width(obj, sub) != 0)
+		  break;
+      }
+
+      if (sub == top)
+	    return;
+
+      fprintf(vvp_out, " [");
+      for (sub = idx ;  sub < top ;  sub += 1) {
+	    fprintf(vvp_out, "%s%u,%u", sub == idx? "" : ",",
+		    ivl_event_any_base(obj, sub),
+		    ivl_event_any_width(obj, sub));
+      }
+      fprintf(vvp_out, "]");
+}
+
 static void draw_event_in_scope(ivl_event_t obj)
 {
       char tmp[4][32];
@@ -1190,6 +1216,7 @@ static void draw_event_in_scope(ivl_event_t obj)
 		  }
 
 		  fprintf(vvp_out, "E_%p/%u .event edge", obj, ecnt);
+		  draw_event_any_parts(obj, idx, top);
 		  for (sub = idx ;  sub < top ;  sub += 1)
 			fprintf(vvp_out, ", %s", tmp[sub-idx]);
 
@@ -1278,6 +1305,8 @@ static void draw_event_in_scope(ivl_event_t obj)
 	    }
 
 	    fprintf(vvp_out, "E_%p .event %s", obj, edge);
+	    if (nany > 0)
+		  draw_event_any_parts(obj, 0, nany);
 	    for (idx = 0 ;  idx < num_input_strings ;  idx += 1) {
 		  fprintf(vvp_out, ", %s", tmp[idx]);
 	    }
@@ -2332,6 +2361,7 @@ int draw_scope(ivl_scope_t net, ivl_scope_t parent)
 
       fprintf(vvp_out, " .timescale %d %d;\n", ivl_scope_time_units(net),
                                                ivl_scope_time_precision(net));
+      draw_partition_in_scope(net);
 
       if( ivl_scope_type(net) == IVL_SCT_MODULE ) {
 
@@ -2448,6 +2478,11 @@ int draw_scope(ivl_scope_t net, ivl_scope_t parent)
 	    draw_switch_in_scope(sw);
       }
 
+      for (idx = 0 ; idx < ivl_scope_tchks(net) ; idx += 1) {
+	    ivl_tchk_t tchk = ivl_scope_tchk(net, idx);
+	    draw_tchk_in_scope(tchk);
+      }
+
       if (ivl_scope_type(net) == IVL_SCT_TASK)
 	    draw_task_definition(net);
 
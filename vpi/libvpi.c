@@ -284,6 +284,26 @@ void vpip_set_return_value(int value)
       assert(vpip_routines);
       vpip_routines->set_return_value(value);
 }
+long* vpip_random_seed(void)
+{
+      assert(vpip_routines);
+      return vpip_routines->random_seed();
+}
+long* vpip_urandom_seed(void)
+{
+      assert(vpip_routines);
+      return vpip_routines->urandom_seed();
+}
+double vpip_random_uniform(long*seed, long start, long end)
+{
+      assert(vpip_routines);
+      return vpip_routines->random_uniform(seed, start, end);
+}
+long vpip_dist_uniform(long*seed, long start, long end)
+{
+      assert(vpip_routines);
+      return vpip_routines->dist_uniform(seed, start, end);
+}
 
 DLLEXPORT PLI_UINT32 vpip_set_callback(vpip_routines_s*routines, PLI_UINT32 version)
 {
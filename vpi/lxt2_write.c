@@ -26,6 +26,7 @@
 
 #include <config.h>
 #include "lxt2_write.h"
+#include <pthread.h>
 
 
 static char *lxt2_wr_vcd_truncate_bitvec(char *s)
@@ -335,6 +336,242 @@ return(rc);
 }
 
 
+/*
+ * partial zip sections are independent gzip members, so with
+ * compression threads each section is collected in memory as a
+ * job, compressed by the thread pool with the same deflate settings
+ * and flush points that gzwrite() would use, and then written to
+ * the file in section order.  the file is byte for byte the same
+ * as without threads.
+ */
+struct lxt2_wr_zjob
+{
+struct lxt2_wr_zjob *next;		/* pool work list */
+struct lxt2_wr_zjob *pend_next;		/* sections in file order */
+
+unsigned char *src;
+size_t srclen, srcalloc;
+size_t *flushes;			/* Z_SYNC_FLUSH points in src */
+unsigned int numflushes, flushalloc;
+
+unsigned char *dst;
+size_t dstlen;
+
+int level;
+unsigned int hdr_len;			/* section header: uncompressed size */
+unsigned int hdr_iter;			/* section header: begin iter */
+int done;
+};
+
+struct lxt2_wr_zpool
+{
+pthread_t *threads;
+unsigned int numthreads;
+
+pthread_mutex_t mutex;
+pthread_cond_t work_sig;
+pthread_cond_t done_sig;
+int shutdown;
+
+struct lxt2_wr_zjob *work_head, *work_tail;
+struct lxt2_wr_zjob *pend_head, *pend_tail;
+};
+
+
+static void lxt2_wr_zjob_append(struct lxt2_wr_zjob *job, const unsigned char *buf, size_t len)
+{
+if(job->srclen + len > job->srcalloc)
+	{
+	while(job->srclen + len > job->srcalloc)
+		{
+		job->srcalloc = job->srcalloc ? job->srcalloc * 2 : 64 * 1024;
+		}
+	job->src = realloc(job->src, job->srcalloc);
+	}
+
+memcpy(job->src + job->srclen, buf, len);
+job->srclen += len;
+}
+
+static void lxt2_wr_zjob_mark_flush(struct lxt2_wr_zjob *job)
+{
+if(job->numflushes == job->flushalloc)
+	{
+	job->flushalloc = job->flushalloc ? job->flushalloc * 2 : 8;
+	job->flushes = realloc(job->flushes, job->flushalloc * sizeof(size_t));
+	}
+
+job->flushes[job->numflushes++] = job->srclen;
+}
+
+static void lxt2_wr_zjob_compress(struct lxt2_wr_zjob *job)
+{
+z_stream strm;
+size_t pos = 0, alloc;
+unsigned int f;
+
+memset(&strm, 0, sizeof(strm));
+deflateInit2(&strm, job->level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+
+alloc = deflateBound(&strm, job->srclen) + 16 * (job->numflushes + 1);
+job->dst = malloc(alloc);
+strm.next_out = job->dst;
+strm.avail_out = alloc;
+
+for(f=0;f<=job->numflushes;f++)
+	{
+	size_t end = (f < job->numflushes) ? job->flushes[f] : job->srclen;
+	int flush = (f < job->numflushes) ? Z_SYNC_FLUSH : Z_FINISH;
+	int rc;
+
+	strm.next_in = job->src + pos;
+	strm.avail_in = end - pos;
+
+	do	{
+		if(!strm.avail_out)
+			{
+			alloc *= 2;
+			job->dst = realloc(job->dst, alloc);
+			strm.next_out = job->dst + strm.total_out;
+			strm.avail_out = alloc - strm.total_out;
+			}
+
+		rc = deflate(&strm, flush);
+		} while((flush == Z_FINISH) ? (rc != Z_STREAM_END) : (!strm.avail_out));
+
+	pos = end;
+	}
+
+job->dstlen = strm.total_out;
+deflateEnd(&strm);
+
+free(job->src); job->src = NULL;
+free(job->flushes); job->flushes = NULL;
+}
+
+static void *lxt2_wr_zpool_worker(void *arg)
+{
+struct lxt2_wr_zpool *zp = (struct lxt2_wr_zpool *)arg;
+
+for(;;)
+	{
+	struct lxt2_wr_zjob *job;
+
+	pthread_mutex_lock(&zp->mutex);
+	while((!zp->work_head)&&(!zp->shutdown))
+		{
+		pthread_cond_wait(&zp->work_sig, &zp->mutex);
+		}
+
+	job = zp->work_head;
+	if(!job)
+		{
+		pthread_mutex_unlock(&zp->mutex);
+		break;
+		}
+
+	zp->work_head = job->next;
+	if(!zp->work_head) zp->work_tail = NULL;
+	pthread_mutex_unlock(&zp->mutex);
+
+	lxt2_wr_zjob_compress(job);
+
+	pthread_mutex_lock(&zp->mutex);
+	job->done = 1;
+	pthread_cond_broadcast(&zp->done_sig);
+	pthread_mutex_unlock(&zp->mutex);
+	}
+
+return(NULL);
+}
+
+static void lxt2_wr_zjob_begin(struct lxt2_wr_trace *lt, unsigned int hdr_len, unsigned int hdr_iter)
+{
+struct lxt2_wr_zjob *job = (struct lxt2_wr_zjob *)calloc(1, sizeof(struct lxt2_wr_zjob));
+
+job->level = lt->zmode[2] - '0';
+job->hdr_len = hdr_len;
+job->hdr_iter = hdr_iter;
+lt->zjob = job;
+}
+
+static void lxt2_wr_zjob_submit(struct lxt2_wr_trace *lt)
+{
+struct lxt2_wr_zpool *zp = lt->zpool;
+struct lxt2_wr_zjob *job = lt->zjob;
+
+lt->zjob = NULL;
+
+pthread_mutex_lock(&zp->mutex);
+if(zp->work_tail) zp->work_tail->next = job; else zp->work_head = job;
+zp->work_tail = job;
+pthread_cond_signal(&zp->work_sig);
+pthread_mutex_unlock(&zp->mutex);
+
+/* only this thread touches the pending list */
+if(zp->pend_tail) zp->pend_tail->pend_next = job; else zp->pend_head = job;
+zp->pend_tail = job;
+}
+
+/*
+ * write out the submitted sections in order.  while waiting for
+ * a section, this thread helps with the compression.
+ */
+static void lxt2_wr_zpool_drain(struct lxt2_wr_trace *lt)
+{
+struct lxt2_wr_zpool *zp = lt->zpool;
+
+while(zp->pend_head)
+	{
+	struct lxt2_wr_zjob *job = zp->pend_head;
+	off_t current_iter_pos;
+
+	pthread_mutex_lock(&zp->mutex);
+	while(!job->done)
+		{
+		struct lxt2_wr_zjob *help = zp->work_head;
+
+		if(help)
+			{
+			zp->work_head = help->next;
+			if(!zp->work_head) zp->work_tail = NULL;
+			pthread_mutex_unlock(&zp->mutex);
+
+			lxt2_wr_zjob_compress(help);
+
+			pthread_mutex_lock(&zp->mutex);
+			help->done = 1;
+			pthread_cond_broadcast(&zp->done_sig);
+			}
+			else
+			{
+			pthread_cond_wait(&zp->done_sig, &zp->mutex);
+			}
+		}
+	pthread_mutex_unlock(&zp->mutex);
+
+	zp->pend_head = job->pend_next;
+	if(!zp->pend_head) zp->pend_tail = NULL;
+
+	/* same file operations as the gzdopen() path */
+	fseeko(lt->handle, 0L, SEEK_END);
+	current_iter_pos = ftello(lt->handle);
+	lxt2_wr_emit_u32(lt, 0);
+	lxt2_wr_emit_u32(lt, job->hdr_len);
+	lxt2_wr_emit_u32(lt, job->hdr_iter);
+	fwrite(job->dst, 1, job->dstlen, lt->handle);
+
+	fseeko(lt->handle, 0L, SEEK_END);
+	lt->position=ftello(lt->handle);
+	fseeko(lt->handle, current_iter_pos, SEEK_SET);
+	lxt2_wr_emit_u32(lt, job->dstlen);
+
+	free(job->dst);
+	free(job);
+	}
+}
+
+
 /*
  * gzfunctions which emit various big endian
  * data to a file.  (lt->position needs to be
@@ -347,8 +584,15 @@ int rc = 1;
 
 if(lt->gzbufpnt > LXT2_WR_GZWRITE_BUFFER)
 	{
-	rc = gzwrite(lt->zhandle, lt->gzdest, lt->gzbufpnt);
-	rc = rc ? 1 : 0;
+	if(lt->zjob)
+		{
+		lxt2_wr_zjob_append(lt->zjob, lt->gzdest, lt->gzbufpnt);
+		}
+		else
+		{
+		rc = gzwrite(lt->zhandle, lt->gzdest, lt->gzbufpnt);
+		rc = rc ? 1 : 0;
+		}
 	lt->gzbufpnt = 0;
 	}
 
@@ -357,6 +601,25 @@ return(rc);
 
 static void gzflush_buffered(struct lxt2_wr_trace *lt, int doclose)
 {
+if(lt->zjob)
+	{
+	if(lt->gzbufpnt)
+		{
+		lxt2_wr_zjob_append(lt->zjob, lt->gzdest, lt->gzbufpnt);
+		lt->gzbufpnt = 0;
+		if(!doclose)
+			{
+			lxt2_wr_zjob_mark_flush(lt->zjob);
+			}
+		}
+
+	if(doclose)
+		{
+		lxt2_wr_zjob_submit(lt);
+		}
+	return;
+	}
+
 if(lt->gzbufpnt)
 	{
 	gzwrite(lt->zhandle, lt->gzdest, lt->gzbufpnt);
@@ -1213,7 +1476,12 @@ if(using_partial)
 
 	partial_length += total_chgs; 		/* actual changes */
 
-	if(using_partial_zip)
+	if(using_partial_zip && lt->zpool)
+		{
+		lxt2_wr_zjob_begin(lt, partial_length+9, iter);
+		lt->zpackcount = 0;
+		}
+	else if(using_partial_zip)
 		{
 		fseeko(lt->handle, 0L, SEEK_END);
 		current_iter_pos = ftello(lt->handle);
@@ -1283,7 +1551,12 @@ for(j=iter;j<iter_hi;j++)
 	s->chgpos = 0;
 	}
 
-if(using_partial_zip)
+if(using_partial_zip && lt->zpool)
+	{
+	gzflush_buffered(lt, 1);	/* hands the section to the pool */
+	lt->zpackcount_cumulative+=lt->zpackcount;
+	}
+else if(using_partial_zip)
 	{
 	off_t clen;
 
@@ -1304,6 +1577,10 @@ if(using_partial_zip)
 	}
 } /* ...for(iter) */
 
+if(lt->zpool)
+	{
+	lxt2_wr_zpool_drain(lt);
+	}
 
 lt->timepos = 0;
 lt->timegranule++;
@@ -2174,6 +2451,8 @@ if(lt)
 		lt->symchain=NULL;
 		}
 
+	lxt2_wr_set_compression_threads(lt, 0);
+
 	free(lt->lxtname);
 	free(lt->sorted_facs);
 	fclose(lt->handle);
@@ -2182,6 +2461,59 @@ if(lt)
 
 }
 
+
+/*
+ * set the number of threads that compress partial zip sections,
+ * 0 or 1 compresses in the calling thread
+ */
+void lxt2_wr_set_compression_threads(struct lxt2_wr_trace *lt, unsigned int numthreads)
+{
+struct lxt2_wr_zpool *zp;
+unsigned int i;
+
+if(!lt) return;
+
+if((zp = lt->zpool))
+	{
+	lxt2_wr_zpool_drain(lt);
+
+	pthread_mutex_lock(&zp->mutex);
+	zp->shutdown = 1;
+	pthread_cond_broadcast(&zp->work_sig);
+	pthread_mutex_unlock(&zp->mutex);
+
+	for(i=0;i<zp->numthreads;i++)
+		{
+		pthread_join(zp->threads[i], NULL);
+		}
+
+	pthread_mutex_destroy(&zp->mutex);
+	pthread_cond_destroy(&zp->work_sig);
+	pthread_cond_destroy(&zp->done_sig);
+	free(zp->threads);
+	free(zp);
+	lt->zpool = NULL;
+	}
+
+if(numthreads > 1)
+	{
+	zp = (struct lxt2_wr_zpool *)calloc(1, sizeof(struct lxt2_wr_zpool));
+	pthread_mutex_init(&zp->mutex, NULL);
+	pthread_cond_init(&zp->work_sig, NULL);
+	pthread_cond_init(&zp->done_sig, NULL);
+
+	/* the calling thread also compresses while it waits */
+	zp->threads = (pthread_t *)calloc(numthreads - 1, sizeof(pthread_t));
+	for(i=0;i<numthreads-1;i++)
+		{
+		if(pthread_create(&zp->threads[i], NULL, lxt2_wr_zpool_worker, zp)) break;
+		}
+	zp->numthreads = i;
+
+	lt->zpool = zp;
+	}
+}
+
 /*
  * set compression depth
  */
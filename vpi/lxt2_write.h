@@ -144,6 +144,9 @@ struct lxt2_wr_trace
 FILE *handle;
 gzFile zhandle;
 
+struct lxt2_wr_zpool *zpool;	/* threads for partial zip compression */
+struct lxt2_wr_zjob *zjob;	/* partial zip section being collected */
+
 lxt2_wr_dslxt_Tree *dict;	/* dictionary manipulation */
 unsigned int num_dict_entries;
 unsigned int dict_string_mem_required;
@@ -272,6 +275,9 @@ void 			lxt2_wr_set_break_size(struct lxt2_wr_trace *lt, off_t siz);
 			/* 0 = no compression, 9 = best compression, 4 = default */
 void			lxt2_wr_set_compression_depth(struct lxt2_wr_trace *lt, unsigned int depth);
 
+			/* 0 or 1 = compress in the writer, more threads compress partial zip sections in parallel with identical output */
+void			lxt2_wr_set_compression_threads(struct lxt2_wr_trace *lt, unsigned int numthreads);
+
 			/* default is partial off, turning on makes for faster trace reads, nonzero zipmode causes vertical compression */
 void			lxt2_wr_set_partial_off(struct lxt2_wr_trace *lt);
 void			lxt2_wr_set_partial_on(struct lxt2_wr_trace *lt, int zipmode);
@@ -68,8 +68,8 @@ char sdf_use_hchar = '.';
 %type <real_val> signed_real_number
 %type <delay> delval rvalue_opt rvalue rtriple signed_real_number_opt
 
-%type <int_val> edge_identifier
-%type <port_with_edge> port_edge port_spec
+%type <int_val> edge_identifier cond_edge_identifier cond_edge_start
+%type <port_with_edge> port_edge port_spec port_tchk
 
 %type <delval_list> delval_list
 
@@ -318,47 +318,113 @@ tchk_def_list
   | tchk_def
   ;
 
-  /* Timing checks are ignored. */
+  /* The SETUP, HOLD, SETUPHOLD, RECOVERY, WIDTH and PERIOD checks set
+     the limits of the matching timing checks of the cell. RECREM and
+     REMOVAL are not supported. */
 tchk_def
   : '(' K_SETUP port_tchk port_tchk rvalue ')'
+      { struct sdf_delval_list_s tmp;
+	tmp.count = 1;
+	tmp.val[0] = $5;
+	sdf_tchk_limits(vpiSetup, $4.vpi_edge, $4.string_val,
+			$3.vpi_edge, $3.string_val, &tmp);
+	free($3.string_val);
+	free($4.string_val);
+      }
   | '(' K_HOLD port_tchk port_tchk rvalue ')'
+      { struct sdf_delval_list_s tmp;
+	tmp.count = 1;
+	tmp.val[0] = $5;
+	sdf_tchk_limits(vpiHold, $4.vpi_edge, $4.string_val,
+			$3.vpi_edge, $3.string_val, &tmp);
+	free($3.string_val);
+	free($4.string_val);
+      }
   | '(' K_SETUPHOLD port_tchk port_tchk rvalue rvalue ')'
+      { struct sdf_delval_list_s tmp;
+	tmp.count = 2;
+	tmp.val[0] = $5;
+	tmp.val[1] = $6;
+	sdf_tchk_limits(vpiSetupHold, $4.vpi_edge, $4.string_val,
+			$3.vpi_edge, $3.string_val, &tmp);
+	free($3.string_val);
+	free($4.string_val);
+      }
   | '(' K_RECOVERY port_tchk port_tchk rvalue ')'
+      { struct sdf_delval_list_s tmp;
+	tmp.count = 1;
+	tmp.val[0] = $5;
+	sdf_tchk_limits(vpiRecovery, $3.vpi_edge, $3.string_val,
+			$4.vpi_edge, $4.string_val, &tmp);
+	free($3.string_val);
+	free($4.string_val);
+      }
   | '(' K_RECREM port_tchk port_tchk rvalue rvalue ')'
+      { if (sdf_flag_warning) vpi_printf("%s:%d: SDF WARNING: "
+					 "RECREM not supported.\n",
+					 sdf_parse_path, @2.first_line);
+	free($3.string_val);
+	free($4.string_val);
+      }
   | '(' K_REMOVAL port_tchk port_tchk rvalue ')'
+      { if (sdf_flag_warning) vpi_printf("%s:%d: SDF WARNING: "
+					 "REMOVAL not supported.\n",
+					 sdf_parse_path, @2.first_line);
+	free($3.string_val);
+	free($4.string_val);
+      }
   | '(' K_WIDTH port_tchk rvalue ')'
+      { struct sdf_delval_list_s tmp;
+	tmp.count = 1;
+	tmp.val[0] = $4;
+	sdf_tchk_limits(vpiWidth, $3.vpi_edge, $3.string_val,
+			vpiNoEdge, 0, &tmp);
+	free($3.string_val);
+      }
   | '(' K_PERIOD port_tchk rvalue ')'
+      { struct sdf_delval_list_s tmp;
+	tmp.count = 1;
+	tmp.val[0] = $4;
+	sdf_tchk_limits(vpiPeriod, $3.vpi_edge, $3.string_val,
+			vpiNoEdge, 0, &tmp);
+	free($3.string_val);
+      }
   ;
 
+  /* The SETUP, HOLD and SETUPHOLD checks list the data port first and
+     the reference port second. The RECOVERY check lists the reference
+     port first, like the Verilog $recovery. The COND of a port is not
+     used to match the timing check. */
 port_tchk
   : port_instance
-      { free($1); }
+      { $$.vpi_edge = vpiNoEdge; $$.string_val = $1; }
   /* This must only be an edge. For now we just accept everything. */
   | cond_edge_start port_instance ')'
-      { free($2); }
+      { $$.vpi_edge = $1; $$.string_val = $2; }
   /* These must only be a cond. For now we just accept everything. */
   | cond_edge_start timing_check_condition port_spec ')'
-      { free($3.string_val); }
+      { $$ = $3; }
   | cond_edge_start QSTRING timing_check_condition port_spec ')'
       { free($2);
-	free($4.string_val);
+	$$ = $4;
       }
   ;
 
 cond_edge_start
   : '(' { start_edge_id(1); } cond_edge_identifier { stop_edge_id(); }
+      { $$ = $3; }
   ;
 
 cond_edge_identifier
-  : K_POSEDGE
-  | K_NEGEDGE
-  | K_01
-  | K_10
-  | K_0Z
-  | K_Z1
-  | K_1Z
-  | K_Z0
-  | K_COND
+  : K_POSEDGE { $$ = vpiPosedge; }
+  | K_NEGEDGE { $$ = vpiNegedge; }
+  | K_01      { $$ = vpiEdge01; }
+  | K_10      { $$ = vpiEdge10; }
+  | K_0Z      { $$ = vpiEdge0x; }
+  | K_Z1      { $$ = vpiEdgex1; }
+  | K_1Z      { $$ = vpiEdge1x; }
+  | K_Z0      { $$ = vpiEdgex0; }
+  | K_COND    { $$ = vpiNoEdge; }
   ;
 
 timing_check_condition
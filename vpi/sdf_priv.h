@@ -51,5 +51,10 @@ struct sdf_delval_list_s {
 extern void sdf_select_instance(const char*celltype, const char*inst);
 extern void sdf_iopath_delays(int vpi_edge, const char*src, const char*dst,
 			      const struct sdf_delval_list_s*delval);
+  /* The tchk_type is the vpiTchkType of the SDF timing check. The
+     data port is nil for WIDTH and PERIOD. */
+extern void sdf_tchk_limits(int tchk_type, int ref_edge, const char*ref,
+			    int data_edge, const char*data,
+			    const struct sdf_delval_list_s*delval);
 
 #endif /* IVL_sdf_priv_h */
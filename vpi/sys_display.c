@@ -2085,6 +2085,10 @@ static PLI_INT32 sys_severity_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
             }
       }
 
+      /* Note that an error was reported. */
+      if ((strcmp(name, "$error") == 0) || (strncmp(name, "$fatal", 6) == 0))
+	    sys_error_count += 1;
+
       /* convert name to upper and drop $ to get severity string */
       sstr = strdup(name) + 1;
       for (t=sstr; *t; t+=1) *t = toupper((int)*t);
@@ -2124,6 +2128,10 @@ static PLI_INT32 sys_severity_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
       free(info.items);
       free(dstr);
 
+      if (sys_error_hook && ((strcmp(name, "$error") == 0) ||
+                             (strncmp(name, "$fatal", 6) == 0)))
+	    sys_error_hook();
+
       if (strncmp(name,"$fatal",6) == 0) {
 	      /* Set the exit code from vvp as an error code. */
 	    vpip_set_return_value(1);
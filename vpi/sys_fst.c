@@ -111,11 +111,11 @@ static void show_this_item_x(struct vcd_info*info)
 
 
 /*
- * managed qsorted list of scope names/variables for duplicates bsearching
+ * managed hash tables of scope names/variables for duplicate detection
  */
 
-struct vcd_names_list_s fst_tab = { 0, 0, 0, 0 };
-struct vcd_names_list_s fst_var = { 0, 0, 0, 0 };
+struct vcd_names_list_s fst_tab = { 0, 0, 0, 0, 0 };
+struct vcd_names_list_s fst_var = { 0, 0, 0, 0, 0 };
 
 
 static int dumpvars_status = 0; /* 0:fresh 1:cb installed, 2:callback done */
@@ -197,6 +197,32 @@ static PLI_INT32 variable_cb_1(p_cb_data cause)
       return 0;
 }
 
+static void register_variable_cb(struct vcd_info*info)
+{
+      vcd_value_cb_on(&info->cb, info->item, &info->time,
+		      variable_cb_1, info);
+}
+
+static void vcd_callbacks_on(void)
+{
+      struct vcd_info*cur;
+
+      for (cur = vcd_list ;  cur ;  cur = cur->next)
+	    register_variable_cb(cur);
+}
+
+static void vcd_callbacks_off(void)
+{
+      struct vcd_info*cur;
+
+      for (cur = vcd_list ;  cur ;  cur = cur->next)
+	    vcd_value_cb_off(&cur->cb);
+}
+
+static void dump_on(void);
+static void dump_off(void);
+static struct vcd_dump_switch_s dump_switch = { 0, 0, dump_on, dump_off };
+
 static PLI_INT32 dumpvars_cb(p_cb_data cause)
 {
       if (dumpvars_status != 1) return 0;
@@ -215,6 +241,8 @@ static PLI_INT32 dumpvars_cb(p_cb_data cause)
 	    /* ...nothing to do for $end */
       }
 
+      vcd_dumpctl_start_windows(&dump_switch);
+
       return 0;
 }
 
@@ -278,19 +306,18 @@ __inline__ static int install_dumpvars_callback(void)
       return 0;
 }
 
-static PLI_INT32 sys_dumpoff_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+static void dump_off(void)
 {
       s_vpi_time now;
       PLI_UINT64 now64;
 
-      (void)name; /* Parameter is not used. */
-
-      if (dump_is_off) return 0;
+      if (dump_is_off) return;
 
       dump_is_off = 1;
+      vcd_callbacks_off();
 
-      if (dump_file == 0) return 0;
-      if (dump_header_pending()) return 0;
+      if (dump_file == 0) return;
+      if (dump_header_pending()) return;
 
       now.type = vpiSimTime;
       vpi_get_time(0, &now);
@@ -303,23 +330,20 @@ static PLI_INT32 sys_dumpoff_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 
       fstWriterEmitDumpActive(dump_file, 0); /* $dumpoff */
       vcd_checkpoint_x();
-
-      return 0;
 }
 
-static PLI_INT32 sys_dumpon_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+static void dump_on(void)
 {
       s_vpi_time now;
       PLI_UINT64 now64;
 
-      (void)name; /* Parameter is not used. */
-
-      if (!dump_is_off) return 0;
+      if (!dump_is_off) return;
 
       dump_is_off = 0;
+      vcd_callbacks_on();
 
-      if (dump_file == 0) return 0;
-      if (dump_header_pending()) return 0;
+      if (dump_file == 0) return;
+      if (dump_header_pending()) return;
 
       now.type = vpiSimTime;
       vpi_get_time(0, &now);
@@ -332,7 +356,19 @@ static PLI_INT32 sys_dumpon_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 
       fstWriterEmitDumpActive(dump_file, 1); /* $dumpon */
       vcd_checkpoint();
+}
+
+static PLI_INT32 sys_dumpoff_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+      (void)name; /* Parameter is not used. */
+      vcd_dump_switch_user(&dump_switch, 0);
+      return 0;
+}
 
+static PLI_INT32 sys_dumpon_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+      (void)name; /* Parameter is not used. */
+      vcd_dump_switch_user(&dump_switch, 1);
       return 0;
 }
 
@@ -478,7 +514,6 @@ static PLI_INT32 sys_dumplimit_calltf(ICARUS_VPI_CONST PLI_BYTE8 *name)
 
 static void scan_item(unsigned depth, vpiHandle item, int skip)
 {
-      struct t_cb_data cb;
       struct vcd_info* info;
 
       enum fstVarType type = FST_VT_MAX;
@@ -564,8 +599,6 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
             }
       }
 
-      fullname = vpi_get_str(vpiFullName, item);
-
 	/* Generate the $var or $scope commands. */
       switch (item_type) {
 	  case vpiParameter:
@@ -591,7 +624,12 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 
 	      /* Skip this signal if it has already been included.
 	       * This can only happen for implicitly given signals. */
-	    if (vcd_names_search(&fst_var, fullname)) return;
+	    if (!vcd_names_empty(&fst_var) &&
+	        vcd_names_search(&fst_var, vpi_get_str(vpiFullName, item)))
+		  return;
+
+	      /* Skip this signal if the dump control file excludes it. */
+	    if (vcd_dumpctl_skip_signal(item)) return;
 
 	      /* Declare the variable in the FST file. */
 	    name = vpi_get_str(vpiName, item);
@@ -645,18 +683,12 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 		  info->handle = new_ident;
 		  info->scheduled = 0;
 
-		  cb.time      = &info->time;
-		  cb.user_data = (char*)info;
-		  cb.value     = NULL;
-		  cb.obj       = item;
-		  cb.reason    = cbValueChange;
-		  cb.cb_rtn    = variable_cb_1;
-
 		  info->dmp_next = 0;
 		  info->next  = vcd_list;
 		  vcd_list    = info;
 
-		  info->cb    = vpi_register_cb(&cb);
+		  info->cb    = 0;
+		  if (!dump_is_off) register_variable_cb(info);
 	    }
 
 	    break;
@@ -671,25 +703,16 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 	    if (depth > 0) {
 		  char *instname;
 		  char *defname = NULL;
-		  /* list of types to iterate upon */
-		  static int types[] = {
-			/* Value */
-			vpiNamedEvent,
-			vpiNet,
-			/* vpiParameter, */
-			vpiReg,
-			vpiVariables,
-			/* Scope */
-			vpiFunction,
-			vpiGenScope,
-			vpiModule,
-			vpiNamedBegin,
-			vpiNamedFork,
-			vpiTask,
-			-1
-		  };
-		  int i;
-		  int nskip = (vcd_names_search(&fst_tab, fullname) != 0);
+		  vpiHandle *items;
+		  unsigned count, idx;
+		  int nskip;
+
+		  fullname = vpi_get_str(vpiFullName, item);
+
+		    /* Skip this scope if the dump control file excludes it. */
+		  if (vcd_dumpctl_skip_scope(fullname)) break;
+
+		  nskip = (vcd_names_search(&fst_tab, fullname) != 0);
 
 		    /* We have to always scan the scope because the
 		     * depth could be different for this call. */
@@ -729,13 +752,10 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 		  fstWriterSetScope(dump_file, stype, name, defname);
 		  free(defname);
 
-		  for (i=0; types[i]>0; i++) {
-			vpiHandle hand;
-			vpiHandle argv = vpi_iterate(types[i], item);
-			while (argv && (hand = vpi_scan(argv))) {
-			      scan_item(depth-1, hand, nskip);
-			}
-		  }
+		  items = vcd_scope_items(item, &count);
+		  for (idx = 0 ; idx < count ; idx += 1)
+			scan_item(depth-1, items[idx], nskip);
+		  free(items);
 
 		    /* Sort any signals that we added above. */
 		  fstWriterSetUpscope(dump_file);
@@ -801,6 +821,8 @@ static PLI_INT32 sys_dumpvars_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 
       (void)name; /* Parameter is not used. */
 
+      vcd_dumpctl_init("FST");
+
       if (dump_file == 0) {
 	    open_dumpfile(callh);
 	    if (dump_file == 0) {
@@ -821,6 +843,7 @@ static PLI_INT32 sys_dumpvars_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 	    depth = value.value.integer;
       }
       if (!depth) depth = 10000;
+      depth = vcd_dumpctl_depth(depth);
 
         /* This dumps all the modules in the design if none are given. */
       if (!argv || !(item = vpi_scan(argv))) {
@@ -947,6 +970,15 @@ void sys_fst_register(void)
       res = vpi_register_systf(&tf_data);
       vpip_make_systf_system_defined(res);
 
+      tf_data.type      = vpiSysTask;
+      tf_data.tfname    = "$dumpflush_window";
+      tf_data.calltf    = sys_dumpflush_calltf;
+      tf_data.compiletf = sys_dumpflush_window_compiletf;
+      tf_data.sizetf    = 0;
+      tf_data.user_data = "$dumpflush_window";
+      res = vpi_register_systf(&tf_data);
+      vpip_make_systf_system_defined(res);
+
       tf_data.type      = vpiSysTask;
       tf_data.tfname    = "$dumplimit";
       tf_data.calltf    = sys_dumplimit_calltf;
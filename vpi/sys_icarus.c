@@ -18,6 +18,9 @@
 
 #include "sys_priv.h"
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ivl_alloc.h"
 
 static PLI_INT32 finish_and_return_calltf(ICARUS_VPI_CONST PLI_BYTE8* name)
 {
@@ -67,6 +70,61 @@ static PLI_INT32 missing_optional_compiletf(ICARUS_VPI_CONST PLI_BYTE8* name)
       return 0;
 }
 
+/*
+ * $ivl_perf_counters("name") returns the current value of one of the
+ * vvp runtime performance counters (events, delta_cycles, time_steps,
+ * thread_runs, ...). The counters are found through the IVL private
+ * _vpiPerfCounter object type, so VPI applications can read them the
+ * same way.
+ */
+static PLI_INT32 perf_counters_sizetf(ICARUS_VPI_CONST PLI_BYTE8* name)
+{
+      (void) name;  /* Not used! */
+      return 64;
+}
+
+static PLI_INT32 perf_counters_calltf(ICARUS_VPI_CONST PLI_BYTE8* name)
+{
+      vpiHandle callh = vpi_handle(vpiSysTfCall, 0);
+      vpiHandle argv = vpi_iterate(vpiArgument, callh);
+      vpiHandle arg = vpi_scan(argv);
+      vpiHandle iter, cnt;
+      s_vpi_value val;
+      char *key;
+
+      vpi_free_object(argv);
+
+      val.format = vpiStringVal;
+      vpi_get_value(arg, &val);
+      key = strdup(val.value.str);
+
+      iter = vpi_iterate(_vpiPerfCounter, 0);
+      cnt = 0;
+      if (iter) while ((cnt = vpi_scan(iter))) {
+	    if (strcmp(vpi_get_str(vpiName, cnt), key) == 0) {
+		  vpi_free_object(iter);
+		  break;
+	    }
+      }
+
+      if (cnt) {
+	    val.format = vpiVectorVal;
+	    vpi_get_value(cnt, &val);
+      } else {
+	    static s_vpi_vecval zero[2] = { {0, 0}, {0, 0} };
+	    vpi_printf("WARNING: %s:%d: ", vpi_get_str(vpiFile, callh),
+	               (int)vpi_get(vpiLineNo, callh));
+	    vpi_printf("%s() unknown counter \"%s\", returning 0.\n",
+	               name, key);
+	    val.format = vpiVectorVal;
+	    val.value.vector = zero;
+      }
+
+      vpi_put_value(callh, &val, 0, vpiNoDelay);
+      free(key);
+      return 0;
+}
+
 /*
  * Register the function with Verilog.
  */
@@ -310,4 +368,15 @@ void sys_special_register(void)
       tf_data.user_data   = "$scale";
       res = vpi_register_systf(&tf_data);
       vpip_make_systf_system_defined(res);
+
+	/* Runtime performance counters. */
+      tf_data.type        = vpiSysFunc;
+      tf_data.sysfunctype = vpiSizedFunc;
+      tf_data.calltf      = perf_counters_calltf;
+      tf_data.compiletf   = sys_one_string_arg_compiletf;
+      tf_data.sizetf      = perf_counters_sizetf;
+      tf_data.tfname      = "$ivl_perf_counters";
+      tf_data.user_data   = "$ivl_perf_counters";
+      res = vpi_register_systf(&tf_data);
+      vpip_make_systf_system_defined(res);
 }
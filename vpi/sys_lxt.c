@@ -191,7 +191,7 @@ static void show_this_item_x(struct vcd_info*info)
 
 
 /*
- * managed qsorted list of scope names for duplicates bsearching
+ * managed hash table of scope names for duplicate detection
  */
 
 struct vcd_names_list_s lxt_tab;
@@ -661,24 +661,8 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 
 	    if (depth > 0) {
 		  const char* fullname = vpi_get_str(vpiFullName, item);
-		  /* list of types to iterate upon */
-		  static int types[] = {
-			/* Value */
-			/* vpiNamedEvent, */
-			vpiNet,
-			/* vpiParameter, */
-			vpiReg,
-			vpiVariables,
-			/* Scope */
-			vpiFunction,
-			vpiGenScope,
-			vpiModule,
-			vpiNamedBegin,
-			vpiNamedFork,
-			vpiTask,
-			-1
-		  };
-		  int i;
+		  vpiHandle *items;
+		  unsigned count, idx;
 		  int nskip = (vcd_names_search(&lxt_tab, fullname) != 0);
 
 #if 0
@@ -697,13 +681,14 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 
                   push_scope(name);
 
-		  for (i=0; types[i]>0; i++) {
-			vpiHandle hand;
-			vpiHandle argv = vpi_iterate(types[i], item);
-			while (argv && (hand = vpi_scan(argv))) {
-			      scan_item(depth-1, hand, nskip);
-			}
+		  items = vcd_scope_items(item, &count);
+		  for (idx = 0 ; idx < count ; idx += 1) {
+			  /* Named events are not dumped. */
+			if (vpi_get(vpiType, items[idx]) == vpiNamedEvent)
+			      continue;
+			scan_item(depth-1, items[idx], nskip);
 		  }
+		  free(items);
 
                   pop_scope();
 	    }
@@ -840,6 +825,15 @@ void sys_lxt_register(void)
       res = vpi_register_systf(&tf_data);
       vpip_make_systf_system_defined(res);
 
+      tf_data.type      = vpiSysTask;
+      tf_data.tfname    = "$dumpflush_window";
+      tf_data.calltf    = sys_dumpflush_calltf;
+      tf_data.compiletf = sys_dumpflush_window_compiletf;
+      tf_data.sizetf    = 0;
+      tf_data.user_data = "$dumpflush_window";
+      res = vpi_register_systf(&tf_data);
+      vpip_make_systf_system_defined(res);
+
       tf_data.type      = vpiSysTask;
       tf_data.tfname    = "$dumplimit";
       tf_data.calltf    = sys_dumplimit_calltf;
@@ -123,6 +123,21 @@ static enum lxm_optimum_mode_e {
 
 static off_t lxt2_file_size_limit = 0x40000000UL;
 
+/* Threads that compress the partial zip sections, 0 is automatic. */
+static unsigned lxt2_compress_threads = 0;
+
+static unsigned default_compress_threads(void)
+{
+#if defined(_SC_NPROCESSORS_ONLN)
+      long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+      if (cpus < 1) return 1;
+      if (cpus > 4) return 4;
+      return (unsigned) cpus;
+#else
+      return 1;
+#endif
+}
+
 /*
  * The lxt_scope head and current pointers are used to keep a scope
  * stack that can be accessed from the bottom. The lxt_scope_head
@@ -316,6 +331,20 @@ static PLI_INT32 variable_cb_1(p_cb_data cause)
       return 0;
 }
 
+static void register_variable_cb(struct vcd_info*info)
+{
+      vcd_value_cb_on(&info->cb, info->item, 0, variable_cb_1, info);
+}
+
+static void callback_off(struct vcd_info*info)
+{
+      vcd_value_cb_off(&info->cb);
+}
+
+static void dump_on(void);
+static void dump_off(void);
+static struct vcd_dump_switch_s dump_switch = { 0, 0, dump_on, dump_off };
+
 static PLI_INT32 dumpvars_cb(p_cb_data cause)
 {
       if (dumpvars_status != 1) return 0;
@@ -330,6 +359,8 @@ static PLI_INT32 dumpvars_cb(p_cb_data cause)
 	    vcd_checkpoint();
       }
 
+      vcd_dumpctl_start_windows(&dump_switch);
+
       return 0;
 }
 
@@ -385,19 +416,18 @@ __inline__ static int install_dumpvars_callback(void)
       return 0;
 }
 
-static PLI_INT32 sys_dumpoff_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+static void dump_off(void)
 {
       s_vpi_time now;
       PLI_UINT64 now64;
 
-      (void)name; /* Parameter is not used. */
-
-      if (dump_is_off) return 0;
+      if (dump_is_off) return;
 
       dump_is_off = 1;
+      functor_all_vcd_info( callback_off );
 
-      if (dump_file == 0) return 0;
-      if (dump_header_pending()) return 0;
+      if (dump_file == 0) return;
+      if (dump_header_pending()) return;
 
       now.type = vpiSimTime;
       vpi_get_time(0, &now);
@@ -410,23 +440,20 @@ static PLI_INT32 sys_dumpoff_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 
       vcd_work_dumpoff();
       vcd_checkpoint_x();
-
-      return 0;
 }
 
-static PLI_INT32 sys_dumpon_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+static void dump_on(void)
 {
       s_vpi_time now;
       PLI_UINT64 now64;
 
-      (void)name; /* Parameter is not used. */
-
-      if (!dump_is_off) return 0;
+      if (!dump_is_off) return;
 
       dump_is_off = 0;
+      functor_all_vcd_info( register_variable_cb );
 
-      if (dump_file == 0) return 0;
-      if (dump_header_pending()) return 0;
+      if (dump_file == 0) return;
+      if (dump_header_pending()) return;
 
       now.type = vpiSimTime;
       vpi_get_time(0, &now);
@@ -439,7 +466,19 @@ static PLI_INT32 sys_dumpon_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 
       vcd_work_dumpon();
       vcd_checkpoint();
+}
 
+static PLI_INT32 sys_dumpoff_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+      (void)name; /* Parameter is not used. */
+      vcd_dump_switch_user(&dump_switch, 0);
+      return 0;
+}
+
+static PLI_INT32 sys_dumpon_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+      (void)name; /* Parameter is not used. */
+      vcd_dump_switch_user(&dump_switch, 1);
       return 0;
 }
 
@@ -517,6 +556,10 @@ static void open_dumpfile(vpiHandle callh)
 	    lxt2_wr_set_compression_depth(dump_file, 4);
 	    lxt2_wr_set_partial_on(dump_file, 1);
 	    lxt2_wr_set_break_size(dump_file, use_file_size_limit);
+	    lxt2_wr_set_compression_threads(dump_file,
+	                                    lxt2_compress_threads ?
+	                                    lxt2_compress_threads :
+	                                    default_compress_threads());
 
 	    vcd_work_start(lxt2_thread, 0);
             atexit((void(*)(void))close_dumpfile);
@@ -593,7 +636,6 @@ static PLI_INT32 sys_dumplimit_calltf(ICARUS_VPI_CONST PLI_BYTE8 *name)
 
 static void scan_item(unsigned depth, vpiHandle item, int skip)
 {
-      struct t_cb_data cb;
       struct vcd_info* info;
 
       const char* name;
@@ -632,6 +674,9 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 
             if (skip || vpi_get(vpiAutomatic, item)) break;
 
+	      /* Skip this signal if the dump control file excludes it. */
+	    if (vcd_dumpctl_skip_signal(item)) break;
+
 	    name = vpi_get_str(vpiName, item);
 	    nexus_id = vpi_get(_vpiNexusId, item);
 	    if (nexus_id) {
@@ -657,14 +702,8 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 		                                   LXT2_WR_SYM_F_BITS);
 		  info->dmp_next = 0;
 
-		  cb.time      = 0;
-		  cb.user_data = (char*)info;
-		  cb.value     = NULL;
-		  cb.obj       = item;
-		  cb.reason    = cbValueChange;
-		  cb.cb_rtn    = variable_cb_1;
-
-		  info->cb    = vpi_register_cb(&cb);
+		  info->cb    = 0;
+		  if (!dump_is_off) register_variable_cb(info);
 
 	    } else {
 		  char *n = create_full_name(name);
@@ -679,6 +718,9 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 
             if (skip || vpi_get(vpiAutomatic, item)) break;
 
+	      /* Skip this signal if the dump control file excludes it. */
+	    if (vcd_dumpctl_skip_signal(item)) break;
+
 	    name = vpi_get_str(vpiName, item);
 	    { char*tmp = create_full_name(name);
 	      ident = strdup_sh(&name_heap, tmp);
@@ -693,14 +735,8 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 	                                    0, LXT2_WR_SYM_F_DOUBLE);
 	    info->dmp_next = 0;
 
-	    cb.time      = 0;
-	    cb.user_data = (char*)info;
-	    cb.value     = NULL;
-	    cb.obj       = item;
-	    cb.reason    = cbValueChange;
-	    cb.cb_rtn    = variable_cb_1;
-
-	    info->cb    = vpi_register_cb(&cb);
+	    info->cb    = 0;
+	    if (!dump_is_off) register_variable_cb(info);
 
 	    break;
 
@@ -713,25 +749,14 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 
 	    if (depth > 0) {
 		  const char* fullname = vpi_get_str(vpiFullName, item);
-		  /* list of types to iterate upon */
-		  static int types[] = {
-			/* Value */
-			/* vpiNamedEvent, */
-			vpiNet,
-			/* vpiParameter, */
-			vpiReg,
-			vpiVariables,
-			/* Scope */
-			vpiFunction,
-			vpiGenScope,
-			vpiModule,
-			vpiNamedBegin,
-			vpiNamedFork,
-			vpiTask,
-			-1
-		  };
-		  int i;
-		  int nskip = vcd_scope_names_test(fullname);
+		  vpiHandle *items;
+		  unsigned count, idx;
+		  int nskip;
+
+		    /* Skip this scope if the dump control file excludes it. */
+		  if (vcd_dumpctl_skip_scope(fullname)) break;
+
+		  nskip = vcd_scope_names_test(fullname);
 
 #if 0
 		  vpi_printf("LXT2 info: scanning scope %s, %u levels\n",
@@ -749,13 +774,14 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 
                   push_scope(name);
 
-		  for (i=0; types[i]>0; i++) {
-			vpiHandle hand;
-			vpiHandle argv = vpi_iterate(types[i], item);
-			while (argv && (hand = vpi_scan(argv))) {
-			      scan_item(depth-1, hand, nskip);
-			}
+		  items = vcd_scope_items(item, &count);
+		  for (idx = 0 ; idx < count ; idx += 1) {
+			  /* Named events are not dumped. */
+			if (vpi_get(vpiType, items[idx]) == vpiNamedEvent)
+			      continue;
+			scan_item(depth-1, items[idx], nskip);
 		  }
+		  free(items);
 
                   pop_scope();
 	    }
@@ -794,6 +820,8 @@ static PLI_INT32 sys_dumpvars_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 
       (void)name; /* Parameter is not used. */
 
+      vcd_dumpctl_init("LXT2");
+
       if (dump_file == 0) {
 	    open_dumpfile(callh);
 	    if (dump_file == 0) {
@@ -814,6 +842,7 @@ static PLI_INT32 sys_dumpvars_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 	    depth = value.value.integer;
       }
       if (!depth) depth = 10000;
+      depth = vcd_dumpctl_depth(depth);
 
         /* This dumps all the modules in the design if none are given. */
       if (!argv || !(item = vpi_scan(argv))) {
@@ -912,6 +941,12 @@ void sys_lxt2_register(void)
 	    } else if (strcmp(vlog_info.argv[idx],"-lx2-speed") == 0) {
 		  lxm_optimum_mode = LXM_SPEED;
 
+	    } else if (strncmp(vlog_info.argv[idx],"-lxt2-threads=",14) == 0) {
+		  lxt2_compress_threads = atoi(vlog_info.argv[idx]+14);
+
+	    } else if (strncmp(vlog_info.argv[idx],"-lx2-threads=",13) == 0) {
+		  lxt2_compress_threads = atoi(vlog_info.argv[idx]+13);
+
 	    }
       }
 
@@ -944,6 +979,15 @@ void sys_lxt2_register(void)
       res = vpi_register_systf(&tf_data);
       vpip_make_systf_system_defined(res);
 
+      tf_data.type      = vpiSysTask;
+      tf_data.tfname    = "$dumpflush_window";
+      tf_data.calltf    = sys_dumpflush_calltf;
+      tf_data.compiletf = sys_dumpflush_window_compiletf;
+      tf_data.sizetf    = 0;
+      tf_data.user_data = "$dumpflush_window";
+      res = vpi_register_systf(&tf_data);
+      vpip_make_systf_system_defined(res);
+
       tf_data.type      = vpiSysTask;
       tf_data.tfname    = "$dumplimit";
       tf_data.calltf    = sys_dumplimit_calltf;
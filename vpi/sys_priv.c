@@ -25,6 +25,9 @@
 #include <string.h>
 #include "ivl_alloc.h"
 
+unsigned sys_error_count = 0;
+void (*sys_error_hook)(void) = 0;
+
 PLI_UINT64 timerec_to_time64(const struct t_vpi_time*timerec)
 {
       PLI_UINT64 tmp;
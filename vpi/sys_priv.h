@@ -37,6 +37,19 @@ extern unsigned long genrand(struct context_s *context);
 
 extern PLI_UINT64 timerec_to_time64(const struct t_vpi_time*timerec);
 
+/*
+ * This counts the calls to $error and $fatal, so that other tasks
+ * (e.g. the flight recorder dumper) can tell that an error was reported.
+ */
+extern unsigned sys_error_count;
+
+/*
+ * If set, this is called by $error and $fatal after the message is
+ * printed, and before $fatal finishes the simulation. The flight
+ * recorder dumper uses it to write its window when the error happens.
+ */
+extern void (*sys_error_hook)(void);
+
 extern char *as_escaped(char *arg);
 extern char *get_filename(vpiHandle callh, const char *name, vpiHandle file);
 extern char *get_filename_with_suffix(vpiHandle callh, const char*name,
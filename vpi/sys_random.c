@@ -25,15 +25,6 @@
 # include  <math.h>
 # include  <limits.h>
 
-#if ULONG_MAX > 4294967295UL
-# define UNIFORM_MAX INT_MAX
-# define UNIFORM_MIN INT_MIN
-#else
-# define UNIFORM_MAX LONG_MAX
-# define UNIFORM_MIN LONG_MIN
-#endif
-
-static double uniform(long *seed, long start, long end);
 static double normal(long *seed, long mean, long deviation);
 static double exponential(long *seed, long mean);
 static long poisson(long *seed, long mean);
@@ -165,121 +156,14 @@ static long rtl_dist_t(long *seed, long df)
       return i;
 }
 
-/* copied from IEEE1364-2001, with slight modifications for 64bit machines. */
-static long rtl_dist_uniform(long *seed, long start, long end)
-{
-      double r;
-      long i;
-
-      if (start >= end) return(start);
-
-      /* NOTE: The cast of r to i can overflow and generate strange
-         values, so cast to unsigned long first. This eliminates
-         the underflow and gets the twos complement value. That in
-         turn can be cast to the long value that is expected. */
-
-      if (end != UNIFORM_MAX) {
-            end++;
-            r = uniform(seed, start, end);
-            if (r >= 0) {
-                  i = (unsigned long) r;
-            } else {
-	          i = - ( (unsigned long) (-(r - 1)) );
-            }
-            if (i < start) i = start;
-            if (i >= end) i = end - 1;
-      } else if (start != UNIFORM_MIN) {
-            start--;
-            r = uniform( seed, start, end) + 1.0;
-            if (r >= 0) {
-                  i = (unsigned long) r;
-            } else {
-	          i = - ( (unsigned long) (-(r - 1)) );
-            }
-            if (i <= start) i = start + 1;
-            if (i > end) i = end;
-      } else {
-            r = (uniform(seed, start, end) + 2147483648.0) / 4294967295.0;
-            r = r * 4294967296.0 - 2147483648.0;
-
-            if (r >= 0) {
-                  i = (unsigned long) r;
-            } else {
-	            /* At least some compilers will notice that (r-1)
-		       is <0 when castling to unsigned long and
-		       replace the result with a zero. This causes
-		       much wrongness, so do the casting to the
-		       positive version and invert it back. */
-	          i = - ( (unsigned long) (-(r - 1)) );
-            }
-      }
-
-      return i;
-}
-
-static double uniform(long *seed, long start, long end )
-{
-      double d = 0.00000011920928955078125;
-      double a, b, c;
-      unsigned long oldseed, newseed;
-
-      oldseed = *seed;
-      if (oldseed == 0)
-            oldseed = 259341593;
-
-      if (start >= end) {
-            a = 0.0;
-            b = 2147483647.0;
-      } else {
-            a = (double)start;
-            b = (double)end;
-      }
-
-      /* Original routine used signed arithmetic, and the (frequent)
-       * overflows trigger "Undefined Behavior" according to the
-       * C standard (both c89 and c99).  Using unsigned arithmetic
-       * forces a conforming C implementation to get the result
-       * that the IEEE-1364-2001 committee wants.
-       */
-      newseed = 69069 * oldseed + 1;
-
-      /* Emulate a 32-bit unsigned long, even if the native machine
-       * uses wider words.
-       */
-#if ULONG_MAX > 4294967295UL
-      newseed = newseed & 4294967295UL;
-#endif
-      *seed = newseed;
-
-
-#if 0
-      /* Cadence-donated conversion from unsigned int to double */
-      {
-            union { float s; unsigned stemp; } u;
-            u.stemp = (newseed >> 9) | 0x3f800000;
-            c = (double) u.s;
-      }
-#else
-      /* Equivalent conversion without assuming IEEE 32-bit float */
-      /* constant is 2^(-23) */
-      c = 1.0 + (newseed >> 9) * 0.00000011920928955078125;
-#endif
-
-
-      c = c + (c*d);
-      c = ((b - a) * (c - 1.0)) + a;
-
-      return c;
-}
-
 static double normal(long *seed, long mean, long deviation)
 {
       double v1, v2, s;
 
       s = 1.0;
       while ((s >= 1.0) || (s == 0.0)) {
-            v1 = uniform(seed, -1, 1);
-            v2 = uniform(seed, -1, 1);
+            v1 = vpip_random_uniform(seed, -1, 1);
+            v2 = vpip_random_uniform(seed, -1, 1);
             s = v1 * v1 + v2 * v2;
       }
       s = v1 * sqrt(-2.0 * log(s) / s);
@@ -293,7 +177,7 @@ static double exponential(long *seed, long mean)
 {
       double n;
 
-      n = uniform(seed, 0, 1);
+      n = vpip_random_uniform(seed, 0, 1);
       if (n != 0.0) {
             n = -log(n) * mean;
       }
@@ -309,10 +193,10 @@ static long poisson(long *seed, long mean)
       n = 0;
       q = -(double) mean;
       p = exp(q);
-      q = uniform(seed, 0, 1);
+      q = vpip_random_uniform(seed, 0, 1);
       while (p < q) {
             n++;
-            q = uniform(seed, 0, 1) * q;
+            q = vpip_random_uniform(seed, 0, 1) * q;
       }
 
       return n;
@@ -355,7 +239,7 @@ static double erlangian(long *seed, long k, long mean)
 
       x = 1.0;
       for (i = 1; i <= k; i++) {
-            x = x * uniform(seed, 0, 1);
+            x = x * vpip_random_uniform(seed, 0, 1);
       }
       a = (double) mean;
       b = (double) k;
@@ -524,7 +408,7 @@ static PLI_INT32 sys_random_calltf(ICARUS_VPI_CONST PLI_BYTE8 *name)
 {
       vpiHandle callh, argv, seed = 0;
       s_vpi_value val;
-      static long i_seed = 0;
+      long*i_seed = vpip_random_seed();
       long a_seed;
 
       (void)name; /* Parameter is not used. */
@@ -539,17 +423,17 @@ static PLI_INT32 sys_random_calltf(ICARUS_VPI_CONST PLI_BYTE8 *name)
             vpi_free_object(argv);
             vpi_get_value(seed, &val);
             a_seed = val.value.integer;
-      } else a_seed = i_seed;
+      } else a_seed = *i_seed;
 
       /* Calculate and return the result. */
-      val.value.integer = rtl_dist_uniform(&a_seed, INT_MIN, INT_MAX);
+      val.value.integer = vpip_dist_uniform(&a_seed, INT_MIN, INT_MAX);
       vpi_put_value(callh, &val, 0, vpiNoDelay);
 
       /* If it exists send the updated seed back to seed parameter. */
       if (seed) {
             val.value.integer = a_seed;
             vpi_put_value(seed, &val, 0, vpiNoDelay);
-      } else i_seed = a_seed;
+      } else *i_seed = a_seed;
 
       return 0;
 }
@@ -590,15 +474,15 @@ static PLI_INT32 sys_urandom_range_compiletf(ICARUS_VPI_CONST PLI_BYTE8 *name)
 /* From SystemVerilog. */
 static unsigned long urandom(long *seed, unsigned long max, unsigned long min)
 {
-      static long i_seed = 0;
+      long*i_seed = vpip_urandom_seed();
       unsigned long result;
       long max_i, min_i;
 
       max_i =  max + INT_MIN;
       min_i =  min + INT_MIN;
-      if (seed != 0) i_seed = *seed;
-      result = rtl_dist_uniform(&i_seed, min_i, max_i) - INT_MIN;
-      if (seed != 0) *seed = i_seed;
+      if (seed != 0) *i_seed = *seed;
+      result = vpip_dist_uniform(i_seed, min_i, max_i) - INT_MIN;
+      if (seed != 0) *seed = *i_seed;
       return result;
 }
 
@@ -707,7 +591,7 @@ static PLI_INT32 sys_dist_uniform_calltf(ICARUS_VPI_CONST PLI_BYTE8 *name)
       i_end = val.value.integer;
 
       /* Calculate and return the result. */
-      val.value.integer = rtl_dist_uniform(&i_seed, i_start, i_end);
+      val.value.integer = vpip_dist_uniform(&i_seed, i_start, i_end);
       vpi_put_value(callh, &val, 0, vpiNoDelay);
 
       /* Return the seed. */
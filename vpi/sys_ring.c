@@ -0,0 +1,581 @@
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include "sys_priv.h"
+# include "vcd_priv.h"
+# include "fastlz.h"
+
+/*
+ * This file contains the implementation of the flight recorder
+ * dumper. It records value changes in VCD format, but instead of
+ * writing them to a file it keeps them in a bounded in-memory ring of
+ * compressed blocks. A VCD file holding the recorded window is only
+ * written when $dumpflush_window is called, or when $error or $fatal
+ * is called. The $dumplimit task sets the amount of memory (in bytes)
+ * the ring may use. The window is always written in VCD format, there
+ * is no FST or LXT version of the ring.
+ *
+ * Each block starts with a $dumpall checkpoint of all the dumped
+ * values, so when the oldest blocks are dropped the remaining window
+ * still describes the complete state at its first time step.
+ *
+ * The signals and the VCD text are handled by the writer in
+ * vcd_text.c, which the VCD dumper uses as well.
+ */
+
+# include  <stdio.h>
+# include  <stdlib.h>
+# include  <string.h>
+# include  <stdarg.h>
+# include  <assert.h>
+# include  "ivl_alloc.h"
+
+/* The size of an uncompressed block before it is compressed. */
+# define RING_BLOCK_SIZE (256*1024)
+
+/* The default amount of memory used by the compressed ring. */
+# define RING_DEFAULT_LIMIT (64*1024*1024)
+
+static char *dump_path = NULL;
+static unsigned window_count = 0;
+
+/*
+ * A growable text buffer. The header and the block that is currently
+ * being recorded are kept in these.
+ */
+struct ring_text {
+      char *text;
+      size_t len;
+      size_t alloc;
+};
+
+/*
+ * A sealed block of recorded changes. The data is compressed with
+ * fastlz and raw_len is the length of the uncompressed text.
+ */
+struct ring_block {
+      PLI_UINT64 start_time;
+      int raw_len;
+      int comp_len;
+      unsigned char *data;
+      struct ring_block *next;
+};
+
+static struct ring_text ring_header = { 0, 0, 0 };
+static struct ring_text ring_current = { 0, 0, 0 };
+static PLI_UINT64 ring_current_start = 0;
+
+static struct ring_block *ring_first = NULL;
+static struct ring_block *ring_last = NULL;
+static size_t ring_bytes = 0;
+static long ring_limit = RING_DEFAULT_LIMIT;
+
+static int finish_status = 0;
+
+/* The time of the last window written for an error. */
+static int error_window_written = 0;
+static PLI_UINT64 error_window_time = 0;
+
+
+static void ring_vprintf(struct ring_text*buf, const char*fmt, va_list ap)
+{
+      int rc;
+
+      for (;;) {
+	    size_t room = buf->alloc - buf->len;
+	    va_list tmp;
+	    va_copy(tmp, ap);
+	    rc = vsnprintf(buf->text + buf->len, room, fmt, tmp);
+	    va_end(tmp);
+	    assert(rc >= 0);
+	    if ((size_t)rc < room) break;
+
+	    buf->alloc = buf->alloc ? 2*buf->alloc : 4096;
+	    while (buf->alloc - buf->len <= (size_t)rc) buf->alloc *= 2;
+	    buf->text = realloc(buf->text, buf->alloc);
+      }
+
+      buf->len += rc;
+}
+
+static void ring_printf(struct ring_text*buf, const char*fmt, ...)
+{
+      va_list ap;
+      va_start(ap, fmt);
+      ring_vprintf(buf, fmt, ap);
+      va_end(ap);
+}
+
+static void ring_print_header(const char*fmt, va_list ap)
+{
+      ring_vprintf(&ring_header, fmt, ap);
+}
+
+static void ring_print_change(const char*fmt, va_list ap)
+{
+      ring_vprintf(&ring_current, fmt, ap);
+}
+
+static void ring_text_delete(struct ring_text*buf)
+{
+      free(buf->text);
+      buf->text = 0;
+      buf->len = 0;
+      buf->alloc = 0;
+}
+
+/*
+ * Start a new block at the given time. The block begins with a
+ * checkpoint of all the values so that it can stand on its own when
+ * the blocks before it have been dropped from the ring.
+ */
+static void ring_start_block(PLI_UINT64 now, const char*command)
+{
+      ring_current.len = 0;
+      ring_current_start = now;
+      vcd_text_set_time(now);
+
+      ring_printf(&ring_current, "#%" PLI_UINT64_FMT "\n", now);
+      if (vcd_text_is_off()) {
+	    ring_printf(&ring_current, "$dumpoff\n");
+	    vcd_text_checkpoint(1);
+      } else {
+	    ring_printf(&ring_current, "%s\n", command);
+	    vcd_text_checkpoint(0);
+      }
+      ring_printf(&ring_current, "$end\n");
+}
+
+/*
+ * Drop the oldest blocks until the ring fits in the memory limit. The
+ * newest sealed block is always kept.
+ */
+static void ring_trim(void)
+{
+      while (ring_first && ring_first != ring_last
+             && ring_bytes > (size_t)ring_limit) {
+	    struct ring_block*blk = ring_first;
+	    ring_first = blk->next;
+	    ring_bytes -= blk->comp_len;
+	    free(blk->data);
+	    free(blk);
+      }
+}
+
+/*
+ * Compress the current block into the ring, then start a new block.
+ */
+static void ring_seal_block(PLI_UINT64 now)
+{
+      struct ring_block*blk = malloc(sizeof(struct ring_block));
+	/* fastlz needs at least 5% more space for incompressible data. */
+      unsigned char*tmp = malloc(ring_current.len + ring_current.len/16 + 66);
+
+      blk->start_time = ring_current_start;
+      blk->raw_len = ring_current.len;
+      blk->comp_len = fastlz_compress_level(1, ring_current.text,
+                                            ring_current.len, tmp);
+      blk->data = realloc(tmp, blk->comp_len);
+      blk->next = 0;
+
+      if (ring_last) ring_last->next = blk;
+      else ring_first = blk;
+      ring_last = blk;
+      ring_bytes += blk->comp_len;
+
+      ring_trim();
+      ring_start_block(now, "$dumpall");
+}
+
+/*
+ * A full block is sealed at the next time step. The new block already
+ * holds the current value of everything, so the changes are not
+ * written again.
+ */
+static int ring_new_time(PLI_UINT64 now)
+{
+      if (ring_current.len < RING_BLOCK_SIZE) return 0;
+
+      ring_seal_block(now);
+      return 1;
+}
+
+static const struct vcd_text_ops_s ring_ops = {
+      ring_print_header,
+      ring_print_change,
+      ring_new_time,
+      0,
+      0
+};
+
+/*
+ * Write the recorded window to the given file. The ring is left
+ * intact so that later triggers can write it again.
+ */
+static void write_window(const char*path, PLI_UINT64 now)
+{
+      struct ring_block*blk;
+      char*raw = 0;
+      int raw_alloc = 0;
+      FILE*fd;
+
+      if (vcd_text_header_pending()) {
+	    vpi_printf("VCD warning: no waveform window has been "
+	               "recorded yet.\n");
+	    return;
+      }
+
+      fd = fopen(path, "w");
+      if (fd == 0) {
+	    vpi_printf("VCD Error: Unable to open %s for output.\n", path);
+	    return;
+      }
+
+      vcd_text_preamble(fd);
+      fwrite(ring_header.text, 1, ring_header.len, fd);
+      fprintf(fd, "$enddefinitions $end\n");
+
+      for (blk = ring_first ; blk ; blk = blk->next) {
+	    int len;
+	    if (blk->raw_len > raw_alloc) {
+		  raw_alloc = blk->raw_len;
+		  raw = realloc(raw, raw_alloc);
+	    }
+	    len = fastlz_decompress(blk->data, blk->comp_len, raw,
+	                            blk->raw_len);
+	    assert(len == blk->raw_len);
+	    fwrite(raw, 1, len, fd);
+      }
+      free(raw);
+
+      fwrite(ring_current.text, 1, ring_current.len, fd);
+      if (now != vcd_text_cur_time())
+	    fprintf(fd, "#%" PLI_UINT64_FMT "\n", now);
+
+      fclose(fd);
+
+      vpi_printf("VCD info: waveform window from time %" PLI_UINT64_FMT
+                 " written to %s.\n",
+                 ring_first ? ring_first->start_time : ring_current_start,
+                 path);
+}
+
+/*
+ * Return the name for the next window written to the default file.
+ * The first window gets the $dumpfile name, later windows get a
+ * sequence number added to it.
+ */
+static char* next_window_path(void)
+{
+      const char*base = dump_path ? dump_path : "dump.vcd";
+      char*path;
+
+      if (window_count == 0) {
+	    path = strdup(base);
+      } else {
+	    size_t len = strlen(base) + 16;
+	    path = malloc(len);
+	    snprintf(path, len, "%s.%u", base, window_count);
+      }
+      window_count += 1;
+
+      return path;
+}
+
+static PLI_UINT64 get_now(void)
+{
+      s_vpi_time now;
+
+      now.type = vpiSimTime;
+      vpi_get_time(0, &now);
+      return timerec_to_time64(&now);
+}
+
+/*
+ * $error and $fatal write the window at the time they are called.
+ * Only the first error of a time step writes a window, so a burst of
+ * errors does not write the same window over and over.
+ */
+static void error_hook(void)
+{
+      PLI_UINT64 now;
+      char*path;
+
+      if (finish_status != 0 || vcd_text_header_pending()) return;
+
+      now = get_now();
+      if (error_window_written && error_window_time == now) return;
+      error_window_written = 1;
+      error_window_time = now;
+
+      path = next_window_path();
+      write_window(path, now);
+      free(path);
+}
+
+static PLI_INT32 dumpvars_cb(p_cb_data cause)
+{
+      PLI_UINT64 now;
+
+      if (! vcd_text_header_pending()) return 0;
+
+      now = timerec_to_time64(cause->time);
+      vcd_text_dumpvars_done(now);
+      ring_start_block(now, "$dumpvars");
+
+      return 0;
+}
+
+static PLI_INT32 finish_cb(p_cb_data cause)
+{
+      struct ring_block *blk;
+
+      if (finish_status != 0) return 0;
+
+      finish_status = 1;
+
+	/* An error that was reported before anything was recorded did
+	   not write a window, so write it now. */
+      if (sys_error_count && !error_window_written
+	  && !vcd_text_header_pending()) {
+	    char*path = next_window_path();
+	    write_window(path, timerec_to_time64(cause->time));
+	    free(path);
+      }
+      sys_error_hook = 0;
+
+      vcd_text_delete();
+      while (ring_first) {
+	    blk = ring_first;
+	    ring_first = blk->next;
+	    free(blk->data);
+	    free(blk);
+      }
+      ring_last = 0;
+      ring_bytes = 0;
+      ring_text_delete(&ring_header);
+      ring_text_delete(&ring_current);
+      free(dump_path);
+      dump_path = 0;
+
+      return 0;
+}
+
+static PLI_INT32 sys_dumpoff_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+      (void)name; /* Parameter is not used. */
+      vcd_text_dumpoff();
+      return 0;
+}
+
+static PLI_INT32 sys_dumpon_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+      (void)name; /* Parameter is not used. */
+      vcd_text_dumpon();
+      return 0;
+}
+
+static PLI_INT32 sys_dumpall_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+      (void)name; /* Parameter is not used. */
+      vcd_text_dumpall();
+      return 0;
+}
+
+static PLI_INT32 sys_dumpfile_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+      vpiHandle callh = vpi_handle(vpiSysTfCall, 0);
+      vpiHandle argv = vpi_iterate(vpiArgument, callh);
+      char *path;
+
+      path = get_filename_with_suffix(callh, name, vpi_scan(argv), "vcd");
+      vpi_free_object(argv);
+      if (! path) return 0;
+
+      if (dump_path) {
+	    vpi_printf("VCD warning: %s:%d: ", vpi_get_str(vpiFile, callh),
+	               (int)vpi_get(vpiLineNo, callh));
+	    vpi_printf("Overriding dump file %s with %s.\n", dump_path, path);
+	    free(dump_path);
+      }
+      dump_path = path;
+
+      return 0;
+}
+
+/*
+ * Write the recorded window. The optional argument is the file name,
+ * otherwise the $dumpfile name is used. Later windows written to the
+ * default file get a sequence number added to the name.
+ */
+static PLI_INT32 sys_dumpflush_window_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+      vpiHandle callh = vpi_handle(vpiSysTfCall, 0);
+      vpiHandle argv = vpi_iterate(vpiArgument, callh);
+      char *path = 0;
+
+      if (argv) {
+	    path = get_filename_with_suffix(callh, name, vpi_scan(argv),
+	                                    "vcd");
+	    vpi_free_object(argv);
+	    if (! path) return 0;
+      } else {
+	    path = next_window_path();
+      }
+
+      write_window(path, get_now());
+      free(path);
+
+      return 0;
+}
+
+static PLI_INT32 sys_dumpflush_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+      (void)name; /* Parameter is not used. */
+      return 0;
+}
+
+/*
+ * For the flight recorder the dump limit is the memory limit of the
+ * compressed ring.
+ */
+static PLI_INT32 sys_dumplimit_calltf(ICARUS_VPI_CONST PLI_BYTE8 *name)
+{
+      vpiHandle callh = vpi_handle(vpiSysTfCall, 0);
+      vpiHandle argv = vpi_iterate(vpiArgument, callh);
+      s_vpi_value val;
+
+      (void)name; /* Parameter is not used. */
+
+      /* Get the value and set the ring limit. */
+      val.format = vpiIntVal;
+      vpi_get_value(vpi_scan(argv), &val);
+      ring_limit = val.value.integer;
+      if (ring_limit <= 0) ring_limit = RING_DEFAULT_LIMIT;
+      ring_trim();
+
+      vpi_free_object(argv);
+      return 0;
+}
+
+static PLI_INT32 sys_dumpvars_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+      vpiHandle callh = vpi_handle(vpiSysTfCall, 0);
+      vpiHandle argv = vpi_iterate(vpiArgument, callh);
+
+      (void)name; /* Parameter is not used. */
+
+      if (! vcd_text_dumpvars_started()) {
+	    vpi_printf("VCD info: recording waveform window (%ld bytes)"
+	               " for %s.\n", ring_limit,
+	               dump_path ? dump_path : "dump.vcd");
+      }
+
+      if (vcd_text_install_dumpvars(dumpvars_cb, finish_cb)) {
+	    if (argv) vpi_free_object(argv);
+	    return 0;
+      }
+
+      vcd_text_dumpvars(callh, argv);
+
+      return 0;
+}
+
+void sys_ring_register(void)
+{
+      s_vpi_systf_data tf_data;
+      vpiHandle res;
+
+      vcd_text_init(&ring_ops);
+      sys_error_hook = error_hook;
+
+      /* All the compiletf routines are located in vcd_priv.c. */
+
+      tf_data.type      = vpiSysTask;
+      tf_data.tfname    = "$dumpall";
+      tf_data.calltf    = sys_dumpall_calltf;
+      tf_data.compiletf = sys_no_arg_compiletf;
+      tf_data.sizetf    = 0;
+      tf_data.user_data = "$dumpall";
+      res = vpi_register_systf(&tf_data);
+      vpip_make_systf_system_defined(res);
+
+      tf_data.type      = vpiSysTask;
+      tf_data.tfname    = "$dumpfile";
+      tf_data.calltf    = sys_dumpfile_calltf;
+      tf_data.compiletf = sys_one_string_arg_compiletf;
+      tf_data.sizetf    = 0;
+      tf_data.user_data = "$dumpfile";
+      res = vpi_register_systf(&tf_data);
+      vpip_make_systf_system_defined(res);
+
+      tf_data.type      = vpiSysTask;
+      tf_data.tfname    = "$dumpflush";
+      tf_data.calltf    = sys_dumpflush_calltf;
+      tf_data.compiletf = sys_no_arg_compiletf;
+      tf_data.sizetf    = 0;
+      tf_data.user_data = "$dumpflush";
+      res = vpi_register_systf(&tf_data);
+      vpip_make_systf_system_defined(res);
+
+      tf_data.type      = vpiSysTask;
+      tf_data.tfname    = "$dumpflush_window";
+      tf_data.calltf    = sys_dumpflush_window_calltf;
+      tf_data.compiletf = sys_dumpflush_window_compiletf;
+      tf_data.sizetf    = 0;
+      tf_data.user_data = "$dumpflush_window";
+      res = vpi_register_systf(&tf_data);
+      vpip_make_systf_system_defined(res);
+
+      tf_data.type      = vpiSysTask;
+      tf_data.tfname    = "$dumplimit";
+      tf_data.calltf    = sys_dumplimit_calltf;
+      tf_data.compiletf = sys_one_numeric_arg_compiletf;
+      tf_data.sizetf    = 0;
+      tf_data.user_data = "$dumplimit";
+      res = vpi_register_systf(&tf_data);
+      vpip_make_systf_system_defined(res);
+
+      tf_data.type      = vpiSysTask;
+      tf_data.tfname    = "$dumpoff";
+      tf_data.calltf    = sys_dumpoff_calltf;
+      tf_data.compiletf = sys_no_arg_compiletf;
+      tf_data.sizetf    = 0;
+      tf_data.user_data = "$dumpoff";
+      res = vpi_register_systf(&tf_data);
+      vpip_make_systf_system_defined(res);
+
+      tf_data.type      = vpiSysTask;
+      tf_data.tfname    = "$dumpon";
+      tf_data.calltf    = sys_dumpon_calltf;
+      tf_data.compiletf = sys_no_arg_compiletf;
+      tf_data.sizetf    = 0;
+      tf_data.user_data = "$dumpon";
+      res = vpi_register_systf(&tf_data);
+      vpip_make_systf_system_defined(res);
+
+      tf_data.type      = vpiSysTask;
+      tf_data.tfname    = "$dumpvars";
+      tf_data.calltf    = sys_dumpvars_calltf;
+      tf_data.compiletf = sys_dumpvars_compiletf;
+      tf_data.sizetf    = 0;
+      tf_data.user_data = "$dumpvars";
+      res = vpi_register_systf(&tf_data);
+      vpip_make_systf_system_defined(res);
+}
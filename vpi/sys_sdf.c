@@ -209,6 +209,142 @@ void sdf_iopath_delays(int vpi_edge, const char*src, const char*dst,
       }
 }
 
+static const char*tchk_str(int tchk_type)
+{
+      switch (tchk_type) {
+	  case vpiSetup:
+	    return "SETUP";
+	  case vpiHold:
+	    return "HOLD";
+	  case vpiSetupHold:
+	    return "SETUPHOLD";
+	  case vpiRecovery:
+	    return "RECOVERY";
+	  case vpiWidth:
+	    return "WIDTH";
+	  case vpiPeriod:
+	    return "PERIOD";
+	  default:
+	    return "timing check";
+      }
+}
+
+/*
+ * A timing check term matches an SDF port if the names match. An SDF
+ * port without an edge matches all the edges of the term.
+ */
+static int tchk_term_match(vpiHandle term, int vpi_edge, const char*name)
+{
+      vpiHandle expr;
+
+      if (term == 0)
+	    return 0;
+
+      expr = vpi_handle(vpiExpr, term);
+      if (expr == 0)
+	    return 0;
+
+      if (strcmp(name, vpi_get_str(vpiName, expr)) != 0)
+	    return 0;
+
+      if (vpi_edge != vpiNoEdge && vpi_get(vpiEdge, term) != vpi_edge)
+	    return 0;
+
+      return 1;
+}
+
+void sdf_tchk_limits(int tchk_type, int ref_edge, const char*ref,
+		     int data_edge, const char*data,
+		     const struct sdf_delval_list_s*delval_list)
+{
+      vpiHandle iter, tchk;
+      int match_count = 0;
+
+      if (sdf_cur_cell == 0)
+	    return;
+
+      iter = vpi_iterate(vpiTchk, sdf_cur_cell);
+
+      if (iter) while ( (tchk = vpi_scan(iter)) ) {
+	    s_vpi_delay delays;
+	    struct t_vpi_time limit_vals[2];
+	    int type = vpi_get(vpiTchkType, tchk);
+	    int idx;
+
+	      /* This is the SDF value for each limit of the check, or
+	         -1 to leave the limit alone. A SETUP or HOLD entry
+	         annotates half of a $setuphold, and a SETUPHOLD entry
+	         annotates a $setup or $hold. */
+	    int use_val[2] = { -1, -1 };
+	    switch (tchk_type) {
+		case vpiSetup:
+		  if (type == vpiSetup || type == vpiSetupHold)
+			use_val[0] = 0;
+		  break;
+		case vpiHold:
+		  if (type == vpiHold)
+			use_val[0] = 0;
+		  if (type == vpiSetupHold)
+			use_val[1] = 0;
+		  break;
+		case vpiSetupHold:
+		  if (type == vpiSetupHold || type == vpiSetup)
+			use_val[0] = 0;
+		  if (type == vpiSetupHold)
+			use_val[1] = 1;
+		  if (type == vpiHold)
+			use_val[0] = 1;
+		  break;
+		default:
+		  if (type == tchk_type)
+			use_val[0] = 0;
+		  break;
+	    }
+
+	    if (use_val[0] < 0 && use_val[1] < 0)
+		  continue;
+
+	    if (! tchk_term_match(vpi_handle(vpiTchkRefTerm, tchk),
+				  ref_edge, ref))
+		  continue;
+
+	    if (data && ! tchk_term_match(vpi_handle(vpiTchkDataTerm, tchk),
+					  data_edge, data))
+		  continue;
+
+	      /* Ah, this must be a match! */
+	    delays.da = limit_vals;
+	    delays.no_of_delays = (type == vpiSetupHold || type == vpiWidth)
+		  ? 2 : 1;
+	    delays.time_type = vpiScaledRealTime;
+	    delays.mtm_flag = 0;
+	    delays.append_flag = 0;
+	    delays.pulsere_flag = 0;
+	    vpi_get_delays(tchk, &delays);
+
+	    for (idx = 0 ; idx < delays.no_of_delays ; idx += 1) {
+		  int val = use_val[idx];
+		  limit_vals[idx].type = vpiScaledRealTime;
+		  if (val >= 0 && val < delval_list->count
+		      && delval_list->val[val].defined)
+			limit_vals[idx].real = delval_list->val[val].value;
+	    }
+
+	    vpi_put_delays(tchk, &delays);
+	    match_count += 1;
+      }
+
+      if (match_count == 0) {
+	    vpi_printf("SDF WARNING: %s:%d: ", vpi_get_str(vpiFile, sdf_callh),
+	               (int)vpi_get(vpiLineNo, sdf_callh));
+	    vpi_printf("Unable to match %s %s%s", tchk_str(tchk_type),
+		       edge_str(ref_edge), ref);
+	    if (data)
+		  vpi_printf(", %s%s", edge_str(data_edge), data);
+	    vpi_printf(" in %s\n", vpi_get_str(vpiFullName, sdf_cur_cell));
+      }
+}
+
 static void check_command_line_args(void)
 {
       struct t_vpi_vlog_info vlog_info;
@@ -35,6 +35,7 @@ extern void sys_queue_register(void);
 extern void sys_random_register(void);
 extern void sys_random_mti_register(void);
 extern void sys_readmem_register(void);
+extern void sys_ring_register(void);
 extern void sys_scanf_register(void);
 extern void sys_sdf_register(void);
 extern void sys_time_register(void);
@@ -137,6 +138,9 @@ static void sys_lxt_or_vcd_register(void)
 	    } else if (strcmp(vlog_info.argv[idx],"-lx2-none") == 0) {
 		  dumper = "none";
 
+	    } else if (strcmp(vlog_info.argv[idx],"-ring") == 0) {
+		  dumper = "ring";
+
 	    } else if (strcmp(vlog_info.argv[idx],"-vcd") == 0) {
 		  dumper = "vcd";
 
@@ -182,6 +186,12 @@ static void sys_lxt_or_vcd_register(void)
       else if (strcmp(dumper, "LX2") == 0)
 	    sys_lxt2_register();
 
+      else if (strcmp(dumper, "ring") == 0)
+	    sys_ring_register();
+
+      else if (strcmp(dumper, "RING") == 0)
+	    sys_ring_register();
+
       else if (strcmp(dumper, "none") == 0)
 	    sys_vcdoff_register();
 
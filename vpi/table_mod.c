@@ -44,6 +44,16 @@ static PLI_INT32 cleanup_table_mod(p_cb_data cause)
       (void)cause; /* Parameter is not used. */
 
       for (idx = 0; idx < table_count; idx += 1) {
+	    if (tables[idx]->dim) {
+		  unsigned dim;
+		  for (dim = 0; dim < tables[idx]->dims; dim += 1) {
+			free(tables[idx]->dim[dim].coord);
+			free(tables[idx]->dim[dim].denom);
+		  }
+		  free(tables[idx]->dim);
+	    }
+	    free(tables[idx]->points);
+	    free(tables[idx]->data);
 	    free(tables[idx]->indep);
 	    free(tables[idx]->indep_val);
 	    if (tables[idx]->have_fname) free(tables[idx]->file.name);
@@ -79,8 +89,13 @@ static p_table_mod create_table(void)
 	/* Initialize and return the table object. */
       obj->indep = 0;
       obj->indep_val = 0;
+      obj->points = 0;
+      obj->npoints = 0;
+      obj->dim = 0;
+      obj->data = 0;
       obj->have_fname = 0;
       obj->have_ctl = 0;
+      obj->init_failed = 0;
       obj->control.arg = 0;
       obj->depend = 0;
       obj->dims = 0;
@@ -554,6 +569,186 @@ static void dump_diag_info(vpiHandle callh, p_table_mod table)
               (int) strlen(msg), " ", table->fields+table->depend);
 }
 
+static int compare_double(const void *a, const void *b)
+{
+      double lval = *(const double *)a;
+      double rval = *(const double *)b;
+      if (lval < rval) return -1;
+      if (lval > rval) return 1;
+      return 0;
+}
+
+/*
+ * Return the index of the given coordinate in the dimension grid. The
+ * coordinate must be in the grid.
+ */
+static unsigned find_coord(p_table_dim dim, double val)
+{
+      double *res = bsearch(&val, dim->coord, dim->count, sizeof(double),
+                            compare_double);
+      assert(res);
+      return res - dim->coord;
+}
+
+/*
+ * Convert the points read from the data file into a dense grid. Each
+ * dimension gets a sorted array of its unique coordinates, and the
+ * dependent values are stored in a row major array indexed by the
+ * coordinate numbers. The Lagrange denominators for every possible
+ * interpolation window are calculated here, so an evaluation only
+ * needs a few multiplies for each dimension.
+ */
+static unsigned build_table_grid(vpiHandle callh, const char *name,
+                                 p_table_mod table)
+{
+      unsigned dims = table->dims;
+      unsigned width = dims + 1;
+      unsigned long nodes, node;
+      unsigned char *have;
+      unsigned idx, dim, field;
+
+      if (table->npoints == 0) {
+	    vpi_printf("ERROR: %s:%d: ", vpi_get_str(vpiFile, callh),
+	               (int)vpi_get(vpiLineNo, callh));
+	    vpi_printf("%s() file \"%s\" has no data points.\n",
+	               name, table->file.name);
+	    return 1;
+      }
+
+      table->dim = (p_table_dim) calloc(dims ? dims : 1, sizeof(s_table_dim));
+      assert(table->dim);
+
+	/* Copy the control codes for the used (not ignored) fields. */
+      dim = 0;
+      for (field = 0; field < table->fields; field += 1) {
+	    if (table->control.info.interp[field] == IVL_IGNORE_COLUMN)
+		  continue;
+	    assert(dim < dims);
+	    table->dim[dim].interp = table->control.info.interp[field];
+	    table->dim[dim].extrap_low = table->control.info.extrap_low[field];
+	    table->dim[dim].extrap_high = table->control.info.extrap_high[field];
+	    dim += 1;
+      }
+      assert(dim == dims);
+
+	/* Find the sorted, unique coordinates for each dimension. A
+	 * complete grid cannot have more nodes than there are points. */
+      nodes = 1;
+      for (dim = 0; dim < dims; dim += 1) {
+	    p_table_dim cur = table->dim + dim;
+	    double *coord = (double *) malloc(sizeof(double)*table->npoints);
+	    unsigned count = 1;
+	    assert(coord);
+
+	    for (idx = 0; idx < table->npoints; idx += 1)
+		  coord[idx] = table->points[idx*width + dim];
+	    qsort(coord, table->npoints, sizeof(double), compare_double);
+	    for (idx = 1; idx < table->npoints; idx += 1) {
+		  if (coord[idx] != coord[count-1]) coord[count++] = coord[idx];
+	    }
+	    cur->coord = (double *) realloc(coord, sizeof(double)*count);
+	    assert(cur->coord);
+	    cur->count = count;
+	    cur->last = 0;
+
+	    nodes *= count;
+	    if (nodes > table->npoints) {
+		  vpi_printf("ERROR: %s:%d: ", vpi_get_str(vpiFile, callh),
+		             (int)vpi_get(vpiLineNo, callh));
+		  vpi_printf("%s() file \"%s\" does not define a complete "
+		             "grid of points.\n", name, table->file.name);
+		  return 1;
+	    }
+      }
+
+	/* The last dimension changes fastest in the data array. */
+      for (dim = dims; dim > 0; dim -= 1) {
+	    if (dim == dims) table->dim[dim-1].stride = 1;
+	    else table->dim[dim-1].stride = table->dim[dim].stride *
+	                                    table->dim[dim].count;
+      }
+
+	/* Place the dependent values in the grid. If a point is given
+	 * more than once the last value is used. */
+      table->data = (double *) malloc(sizeof(double)*nodes);
+      assert(table->data);
+      have = (unsigned char *) calloc(nodes, 1);
+      assert(have);
+      for (idx = 0; idx < table->npoints; idx += 1) {
+	    double *pt = table->points + idx*width;
+	    node = 0;
+	    for (dim = 0; dim < dims; dim += 1) {
+		  node += (unsigned long) find_coord(table->dim + dim, pt[dim]) *
+		          table->dim[dim].stride;
+	    }
+	    table->data[node] = pt[dims];
+	    have[node] = 1;
+      }
+      for (node = 0; node < nodes; node += 1) {
+	    if (! have[node]) break;
+      }
+      free(have);
+      if (node < nodes) {
+	    vpi_printf("ERROR: %s:%d: ", vpi_get_str(vpiFile, callh),
+	               (int)vpi_get(vpiLineNo, callh));
+	    vpi_printf("%s() file \"%s\" is missing the point (",
+	               name, table->file.name);
+	    for (dim = 0; dim < dims; dim += 1) {
+		  p_table_dim cur = table->dim + dim;
+		  vpi_printf("%s%#g", dim ? ", " : "",
+		             cur->coord[(node / cur->stride) % cur->count]);
+	    }
+	    vpi_printf(").\n");
+	    return 1;
+      }
+
+	/* The points are no longer needed. */
+      free(table->points);
+      table->points = 0;
+
+	/* Calculate the interpolation window size and the Lagrange
+	 * denominators 1/prod(x[j]-x[m]) for each window start. */
+      for (dim = 0; dim < dims; dim += 1) {
+	    p_table_dim cur = table->dim + dim;
+	    unsigned win, nwin, jdx, mdx;
+
+	    switch (cur->interp) {
+	      case IVL_CLOSEST_POINT:    cur->order = 1; break;
+	      case IVL_QUADRATIC_INTERP: cur->order = 3; break;
+	      case IVL_CUBIC_INTERP:     cur->order = 4; break;
+	      default:                   cur->order = 2; break;
+	    }
+	    if (cur->order > cur->count) cur->order = cur->count;
+	    if (cur->order < 2) continue;
+
+	    nwin = cur->count - cur->order + 1;
+	    cur->denom = (double *) malloc(sizeof(double)*nwin*cur->order);
+	    assert(cur->denom);
+	    for (win = 0; win < nwin; win += 1) {
+		  double *x = cur->coord + win;
+		  for (jdx = 0; jdx < cur->order; jdx += 1) {
+			double prod = 1.0;
+			for (mdx = 0; mdx < cur->order; mdx += 1) {
+			      if (mdx != jdx) prod *= x[jdx] - x[mdx];
+			}
+			cur->denom[win*cur->order + jdx] = 1.0 / prod;
+		  }
+	    }
+      }
+
+      if (table_model_debug) {
+	    fprintf(stderr, "DEBUG: %s:%d: Table \"%s\" has a ",
+	            vpi_get_str(vpiFile, callh),
+	            (int)vpi_get(vpiLineNo, callh), table->file.name);
+	    for (dim = 0; dim < dims; dim += 1) {
+		  fprintf(stderr, "%s%u", dim ? "x" : "", table->dim[dim].count);
+	    }
+	    fprintf(stderr, " grid (%lu points).\n", nodes);
+      }
+
+      return 0;
+}
+
 /*
  * Initialize the table model data structure.
  *
@@ -609,8 +804,6 @@ static unsigned initialize_table_model(vpiHandle callh, const char *name,
 	 * need to have columns for each control string field and for the
 	 * dependent data. */
       if (parse_table_model(fp, callh, table)) return 1;
-// HERE: once we are done with the control string should we build a table
-//       of function pointer for the interp/extrap?
 
 	/* Close the file now that we have loaded all the data. */
       if (fclose(fp)) {
@@ -621,6 +814,9 @@ static unsigned initialize_table_model(vpiHandle callh, const char *name,
 	    return 1;
       }
 
+	/* Build the grid and the interpolation coefficients. */
+      if (build_table_grid(callh, name, table)) return 1;
+
 	/* Allocate space for the current argument values. */
       table->indep_val = (double*) malloc(sizeof(double)*table->dims);
       assert(table->indep_val);
@@ -628,21 +824,173 @@ static unsigned initialize_table_model(vpiHandle callh, const char *name,
       return 0;
 }
 
+/*
+ * Find the interval i where coord[i] <= val < coord[i+1], clamped to
+ * the first and last interval. The inputs usually change only a little
+ * between calls, so the last interval and its neighbors are checked
+ * before falling back to a binary search.
+ */
+static unsigned find_interval(p_table_dim dim, double val)
+{
+      const double *x = dim->coord;
+      unsigned last = dim->last;
+      unsigned lo, hi;
+
+      assert(dim->count >= 2);
+
+      if (val >= x[last]) {
+	    if (val < x[last+1]) return last;
+	    if ((last+2 < dim->count) && (val < x[last+2]))
+		  return dim->last = last + 1;
+      } else if ((last > 0) && (val >= x[last-1])) {
+	    return dim->last = last - 1;
+      }
+
+      hi = dim->count - 1;
+      if (val < x[0]) return dim->last = 0;
+      if (val >= x[hi]) return dim->last = hi - 1;
+
+      lo = 0;
+      while (hi - lo > 1) {
+	    unsigned mid = (lo + hi) / 2;
+	    if (val < x[mid]) hi = mid;
+	    else lo = mid;
+      }
+      return dim->last = lo;
+}
+
+/*
+ * Calculate the grid nodes and weights needed to interpolate or
+ * extrapolate the given value along one dimension. The nodes and
+ * weights are left in the dimension structure.
+ */
+static void dim_weights(vpiHandle callh, p_table_dim dim, unsigned dnum,
+                        double val)
+{
+      const double *x = dim->coord;
+      const double *den;
+      unsigned count = dim->count;
+      unsigned start, idx, jdx, mdx;
+      int extrap = -1;
+
+      dim->pos = 0;
+
+	/* A single point is a constant. */
+      if (count == 1) {
+	    dim->node[0] = 0;
+	    dim->weight[0] = 1.0;
+	    dim->nodes = 1;
+	    return;
+      }
+
+      if (val < x[0]) extrap = dim->extrap_low;
+      else if (val > x[count-1]) extrap = dim->extrap_high;
+
+      if (extrap >= 0) {
+	    unsigned end = (val < x[0]) ? 0 : count - 1;
+	    double frac;
+	    switch (extrap) {
+	      case IVL_ERROR_EXTRAP:
+		  vpi_printf("ERROR: %s:%d: ", vpi_get_str(vpiFile, callh),
+		             (int)vpi_get(vpiLineNo, callh));
+		  vpi_printf("$table_model() value %#g is outside the table "
+		             "range [%#g, %#g] for dimension %u.\n", val, x[0],
+		             x[count-1], dnum+1);
+		  vpi_control(vpiFinish, 1);
+		    /* fall through */
+	      case IVL_CONSTANT_EXTRAP:
+		  dim->node[0] = end;
+		  dim->weight[0] = 1.0;
+		  dim->nodes = 1;
+		  return;
+	      default:
+		    /* Extend the line through the last two points. */
+		  start = end ? count - 2 : 0;
+		  frac = (val - x[start]) / (x[start+1] - x[start]);
+		  dim->node[0] = start;
+		  dim->node[1] = start + 1;
+		  dim->weight[0] = 1.0 - frac;
+		  dim->weight[1] = frac;
+		  dim->nodes = 2;
+		  return;
+	    }
+      }
+
+      idx = find_interval(dim, val);
+
+	/* Use the closest grid point. */
+      if (dim->order == 1) {
+	    dim->node[0] = (val - x[idx] < x[idx+1] - val) ? idx : idx + 1;
+	    dim->weight[0] = 1.0;
+	    dim->nodes = 1;
+	    return;
+      }
+
+	/* Pick the window of grid points centered on the value. */
+      switch (dim->order) {
+	case 2:
+	    start = idx;
+	    break;
+	case 3:
+	    start = ((idx > 0) && (val - x[idx] < x[idx+1] - val)) ? idx - 1 :
+	                                                              idx;
+	    break;
+	default:
+	    start = (idx > 0) ? idx - 1 : 0;
+	    break;
+      }
+      if (start + dim->order > count) start = count - dim->order;
+
+	/* The Lagrange weight for node j is the product of (val-x[m])
+	 * for the other nodes divided by the precalculated denominator. */
+      den = dim->denom + start*dim->order;
+      for (jdx = 0; jdx < dim->order; jdx += 1) {
+	    double prod = den[jdx];
+	    for (mdx = 0; mdx < dim->order; mdx += 1) {
+		  if (mdx != jdx) prod *= val - x[start+mdx];
+	    }
+	    dim->node[jdx] = start + jdx;
+	    dim->weight[jdx] = prod;
+      }
+      dim->nodes = dim->order;
+}
+
 /*
  * Routine to evaluate the table model using the current input values.
+ * The result is the weighted sum of the grid values over every
+ * combination of the nodes selected for each dimension.
  */
 static double eval_table_model(vpiHandle callh, p_table_mod table)
 {
-      unsigned idx;
+      unsigned dims = table->dims;
+      unsigned dim;
+      double result = 0.0;
 
-      (void)callh; /* Parameter is not used. */
-fprintf(stderr, "Evaluating table \"%s\" with %u variables\n",
-        table->file.name, table->dims);
-      for (idx = 0; idx < table->dims; idx += 1) {
-fprintf(stderr, "  Arg %u: %#g\n", idx, table->indep_val[idx]);
+      for (dim = 0; dim < dims; dim += 1) {
+	    dim_weights(callh, table->dim + dim, dim, table->indep_val[dim]);
+      }
+
+      for (;;) {
+	    double weight = 1.0;
+	    unsigned long node = 0;
+	    for (dim = 0; dim < dims; dim += 1) {
+		  p_table_dim cur = table->dim + dim;
+		  weight *= cur->weight[cur->pos];
+		  node += (unsigned long) cur->node[cur->pos] * cur->stride;
+	    }
+	    result += weight * table->data[node];
+
+	      /* Advance to the next combination of nodes. */
+	    for (dim = dims; dim > 0; dim -= 1) {
+		  p_table_dim cur = table->dim + dim - 1;
+		  cur->pos += 1;
+		  if (cur->pos < cur->nodes) break;
+		  cur->pos = 0;
+	    }
+	    if (dim == 0) break;
       }
 
-      return 0.0;
+      return result;
 }
 
 /*
@@ -662,19 +1010,27 @@ static PLI_INT32 sys_table_model_calltf(ICARUS_VPI_CONST PLI_BYTE8 *name)
 	/* If this is the first call then build the data structure. */
       if ((table->have_fname == 0) &&
           initialize_table_model(callh, name, table)) {
+	    table->init_failed = 1;
 	    vpi_control(vpiFinish, 1);
-	    return 0;
       }
 
-	/* Load the current argument values into the table structure. */
-      for (idx = 0; idx < table->dims; idx += 1) {
-	    val.format = vpiRealVal;
-	    vpi_get_value(table->indep[idx], &val);
-	    table->indep_val[idx] = val.value.real;
-      }
+	/* A table that could not be built is only partly filled in, so
+	 * it must not be evaluated. The calls that happen before the
+	 * $finish takes effect just return 0.0. */
+      if (table->init_failed) {
+	    result = 0.0;
+      } else {
+	      /* Load the current argument values into the table. */
+	    for (idx = 0; idx < table->dims; idx += 1) {
+		  val.format = vpiRealVal;
+		  vpi_get_value(table->indep[idx], &val);
+		  table->indep_val[idx] = val.value.real;
+	    }
 
-	/* Interpolate/extrapolate the data structure to find the value. */
-      result = eval_table_model(callh, table);
+	      /* Interpolate/extrapolate the data structure to find the
+	       * value. */
+	    result = eval_table_model(callh, table);
+      }
 
 	/* Return the calculated value. */
       val.format = vpiRealVal;
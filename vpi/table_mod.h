@@ -62,6 +62,27 @@ typedef struct t_build {
       unsigned count;
 } s_build, *p_build;
 
+/*
+ * The evaluation grid for one used (not ignored) dimension. The data
+ * file must define a value at every combination of the coordinates
+ * found for each dimension.
+ */
+typedef struct t_table_dim {
+      double *coord;        /* The sorted, unique grid coordinates. */
+      unsigned count;       /* The number of coordinates. */
+      unsigned stride;      /* The data distance between neighbors. */
+      unsigned last;        /* The interval found by the last search. */
+      unsigned order;       /* Nodes in an interpolation window (1-4). */
+      double *denom;        /* Lagrange denominators for each window. */
+      unsigned node[4];     /* The nodes and weights used for the */
+      double weight[4];     /* current evaluation. */
+      unsigned nodes;
+      unsigned pos;
+      char interp;
+      char extrap_low;
+      char extrap_high;
+} s_table_dim, *p_table_dim;
+
 /*
  * This structure is saved for each table model instance.
  */
@@ -80,12 +101,16 @@ typedef struct t_table_mod {
 	    } info;
 	    vpiHandle arg;
       } control;
-// HERE need a pointer to the dependent data and the final table.
+      double *points;       /* The points read from the data file. */
+      unsigned npoints;     /* Each point is dims+1 values. */
+      p_table_dim dim;      /* The grid for each dimension. */
+      double *data;         /* The dependent value at each grid node. */
       unsigned dims;        /* The number of independent variables. */
       unsigned fields;      /* The number of control fields. */
       unsigned depend;      /* Where the dependent column is located. */
       char have_fname;      /* Has the file name been allocated? */
       char have_ctl;        /* Has the file name been allocated? */
+      char init_failed;     /* Could the table not be built? */
 } s_table_mod, *p_table_mod;
 
 /*
@@ -21,6 +21,8 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "table_mod.h"
 #include "ivl_alloc.h"
 
@@ -90,17 +92,31 @@ static p_table_mod table_def;
 extern int tblmodlex(void);
 static void yyerror(const char *fmt, ...);
 
+/*
+ * The number of points the table point array has room for.
+ */
+static unsigned point_space;
+
+/*
+ * Save the point in the table. The grid is built from these after the
+ * whole file has been read.
+ */
 static void process_point(void)
 {
+      unsigned width = indep_values + 1;
       assert(cur_value == indep_values);
-  #if 0
-      unsigned idx;
-      fprintf(stderr, "%#g", values[0]);
-      for (idx = 1; idx < indep_values; idx += 1) {
-	    fprintf(stderr, ", %#g", values[idx]);
+
+      if (table_def->npoints == point_space) {
+	    point_space = point_space ? 2*point_space : 64;
+	    table_def->points = (double *) realloc(table_def->points,
+	                                           sizeof(double)*width*
+	                                           point_space);
+	    assert(table_def->points);
       }
-      fprintf(stderr, " => %#g\n", values[indep_values]);
-  #endif
+
+      memcpy(table_def->points + width*table_def->npoints, values,
+             sizeof(double)*width);
+      table_def->npoints += 1;
 }
 
 %}
@@ -201,6 +217,11 @@ unsigned parse_table_model(FILE *fp, vpiHandle callh, p_table_mod table)
       indep_columns = table->fields;
       minimum_columns = table->fields + table->depend;
       dep_column = minimum_columns - 1;
+      errors = 0;
+      number_of_columns = 0;
+      point_space = 0;
+      table->points = 0;
+      table->npoints = 0;
       values = malloc(sizeof(double)*(indep_values+1));
       assert(values);
       in_file_name = table->file.name;
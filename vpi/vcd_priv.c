@@ -54,6 +54,54 @@ struct vcd_names_s {
       struct vcd_names_s *next;
 };
 
+/*
+ * The names that have been committed with vcd_names_sort() are kept
+ * in an open addressed hash table so that the duplicate checks stay
+ * constant time, even for designs with millions of signals and for
+ * test benches that call $dumpvars once per signal.
+ */
+static unsigned vcd_names_hash(const char *name)
+{
+      unsigned hash = 2166136261u;
+      while (*name) {
+	    hash ^= (unsigned char) *name++;
+	    hash *= 16777619u;
+      }
+      return hash;
+}
+
+static void vcd_names_insert(struct vcd_names_list_s*tab, const char *name)
+{
+      unsigned mask = tab->hash_size - 1;
+      unsigned idx = vcd_names_hash(name) & mask;
+      while (tab->vcd_names_hash[idx]) {
+	    if (strcmp(tab->vcd_names_hash[idx], name) == 0) return;
+	    idx = (idx + 1) & mask;
+      }
+      tab->vcd_names_hash[idx] = name;
+      tab->hashed_names += 1;
+}
+
+static void vcd_names_grow(struct vcd_names_list_s*tab, unsigned need)
+{
+      const char **old = tab->vcd_names_hash;
+      unsigned old_size = tab->hash_size;
+      unsigned idx;
+
+      if (2*need < tab->hash_size) return;
+
+      if (tab->hash_size == 0) tab->hash_size = 256;
+      while (2*need >= tab->hash_size) tab->hash_size *= 2;
+
+      tab->vcd_names_hash = (const char **)
+	    calloc(tab->hash_size, sizeof(const char *));
+      tab->hashed_names = 0;
+      for (idx = 0 ; idx < old_size ; idx += 1) {
+	    if (old[idx]) vcd_names_insert(tab, old[idx]);
+      }
+      free(old);
+}
+
 void vcd_names_add(struct vcd_names_list_s*tab, const char *name)
 {
       struct vcd_names_s *nl = (struct vcd_names_s *)
@@ -73,46 +121,42 @@ void vcd_names_delete(struct vcd_names_list_s*tab)
       }
       tab->vcd_names_list = 0;
       tab->listed_names = 0;
-      free(tab->vcd_names_sorted);
-      tab->vcd_names_sorted = 0;
-      tab->sorted_names = 0;
+      free(tab->vcd_names_hash);
+      tab->vcd_names_hash = 0;
+      tab->hashed_names = 0;
+      tab->hash_size = 0;
       string_heap_delete(&name_heap);
 }
 
-static int vcd_names_compare(const void *s1, const void *s2)
-{
-      const char *v1 = *(const char * const *) s1;
-      const char *v2 = *(const char * const *) s2;
-
-      return strcmp(v1, v2);
-}
-
 const char *vcd_names_search(struct vcd_names_list_s*tab, const char *key)
 {
-      const char **v;
+      unsigned mask, idx;
 
-      if (tab->vcd_names_sorted == 0)
+      if (tab->hashed_names == 0)
 	    return 0;
 
-      v = (const char **) bsearch(&key,
-				  tab->vcd_names_sorted, tab->sorted_names,
-				  sizeof(const char *), vcd_names_compare );
+      mask = tab->hash_size - 1;
+      idx = vcd_names_hash(key) & mask;
+      while (tab->vcd_names_hash[idx]) {
+	    if (strcmp(tab->vcd_names_hash[idx], key) == 0)
+		  return tab->vcd_names_hash[idx];
+	    idx = (idx + 1) & mask;
+      }
 
-      return(v ? *v : NULL);
+      return 0;
 }
 
+/*
+ * Names added with vcd_names_add() are not visible to searches until
+ * they are committed with this function. (It used to sort a table
+ * for binary searches, hence the name.)
+ */
 void vcd_names_sort(struct vcd_names_list_s*tab)
 {
       if (tab->listed_names) {
 	    struct vcd_names_s *r;
-	    const char **l;
 
-	    tab->sorted_names += tab->listed_names;
-	    tab->vcd_names_sorted = (const char **)
-		  realloc(tab->vcd_names_sorted,
-			  tab->sorted_names*(sizeof(const char *)));
-
-	    l = tab->vcd_names_sorted + tab->sorted_names - tab->listed_names;
+	    vcd_names_grow(tab, tab->hashed_names + tab->listed_names);
 	    tab->listed_names = 0;
 
 	    r = tab->vcd_names_list;
@@ -121,13 +165,424 @@ void vcd_names_sort(struct vcd_names_list_s*tab)
 	    while (r) {
 		  struct vcd_names_s *rr = r;
 		  r = rr->next;
-		  *(l++) = rr->name;
+		  vcd_names_insert(tab, rr->name);
 		  free(rr);
 	    }
+      }
+}
+
+int vcd_names_empty(const struct vcd_names_list_s*tab)
+{
+      return tab->hashed_names == 0;
+}
+
+/*
+ * The dumpers list the items of a scope grouped by type: first the
+ * signals and then the sub-scopes. Rather than iterate the scope
+ * once for each type, use the vvp vpiScope iterator to get all the
+ * items in one pass and bucket them by type here. This keeps the
+ * $dumpvars header generation linear in the number of items.
+ */
+static int vcd_item_bucket(PLI_INT32 type)
+{
+      switch (type) {
+	  case vpiNamedEvent:  return 0;
+	  case vpiNet:         return 1;
+	  case vpiReg:         return 2;
+	  case vpiIntegerVar:
+	  case vpiBitVar:
+	  case vpiByteVar:
+	  case vpiShortIntVar:
+	  case vpiIntVar:
+	  case vpiLongIntVar:
+	  case vpiTimeVar:
+	  case vpiRealVar:     return 3;
+	  case vpiFunction:    return 4;
+	  case vpiGenScope:    return 5;
+	  case vpiModule:      return 6;
+	  case vpiNamedBegin:  return 7;
+	  case vpiNamedFork:   return 8;
+	  case vpiTask:        return 9;
+	  default:             return -1;
+      }
+}
+
+#define VCD_ITEM_BUCKETS 10
 
-	    qsort(tab->vcd_names_sorted, tab->sorted_names,
-		  sizeof(const char **), vcd_names_compare);
+vpiHandle *vcd_scope_items(vpiHandle scope, unsigned *count)
+{
+      unsigned fill[VCD_ITEM_BUCKETS+1];
+      vpiHandle *all = 0, *res;
+      char *kind = 0;
+      unsigned nall = 0, nmax = 0, idx;
+      int bucket;
+      vpiHandle hand;
+      vpiHandle argv = vpi_iterate(vpiScope, scope);
+
+      *count = 0;
+      if (argv == 0) return 0;
+
+      memset(fill, 0, sizeof fill);
+      while ((hand = vpi_scan(argv))) {
+	    bucket = vcd_item_bucket(vpi_get(vpiType, hand));
+	    if (bucket < 0) continue;
+	    if (nall == nmax) {
+		  nmax = nmax ? 2*nmax : 64;
+		  all = (vpiHandle *) realloc(all, nmax*sizeof(vpiHandle));
+		  kind = (char *) realloc(kind, nmax);
+	    }
+	    all[nall] = hand;
+	    kind[nall] = bucket;
+	    nall += 1;
+	      /* Count the items in each bucket. */
+	    fill[bucket+1] += 1;
       }
+
+      if (nall == 0) return 0;
+
+	/* Turn the counts into the starting position of each bucket
+	 * and then distribute the items, keeping their scope order. */
+      for (bucket = 1 ; bucket <= VCD_ITEM_BUCKETS ; bucket += 1)
+	    fill[bucket] += fill[bucket-1];
+
+      res = (vpiHandle *) malloc(nall*sizeof(vpiHandle));
+      for (idx = 0 ; idx < nall ; idx += 1)
+	    res[fill[(int)kind[idx]]++] = all[idx];
+      free(all);
+      free(kind);
+
+      *count = nall;
+      return res;
+}
+
+/*
+ * Dump control file support. The file is named with the
+ * +dumpctl=<file> plusarg and is read the first time $dumpvars is
+ * called. Each line holds one command, and '#' starts a comment:
+ *
+ *    include <pattern>      Only dump signals that match a pattern.
+ *    exclude <pattern>      Do not dump signals or scopes that match.
+ *    depth <n>              Limit the depth of every $dumpvars call.
+ *    window <start> [<end>] Only dump during this time window.
+ *
+ * The patterns are matched against the full hierarchical name, where
+ * '*' matches any string (including '.') and '?' matches any single
+ * character. The window times are in simulation precision units
+ * unless they carry one of the s, ms, us, ns, ps or fs suffixes.
+ * Outside of all the windows the dump is turned off as if $dumpoff
+ * were called, so the dumper removes its value change callbacks.
+ */
+struct dumpctl_window_s {
+      PLI_UINT64 start, end;
+      int has_end;
+};
+
+static int dumpctl_loaded = 0;
+static char **dumpctl_include = 0;
+static unsigned dumpctl_ninclude = 0;
+static char **dumpctl_exclude = 0;
+static unsigned dumpctl_nexclude = 0;
+static unsigned dumpctl_depth_limit = 0;
+static struct dumpctl_window_s *dumpctl_windows = 0;
+static unsigned dumpctl_nwindows = 0;
+static struct vcd_dump_switch_s *dumpctl_switch = 0;
+
+static int dumpctl_glob(const char *pat, const char *str)
+{
+      const char *star = 0, *back = 0;
+
+      while (*str) {
+	    if (*pat == '*') {
+		  star = pat++;
+		  back = str;
+	    } else if (*pat == '?' || *pat == *str) {
+		  pat += 1;
+		  str += 1;
+	    } else if (star) {
+		  pat = star + 1;
+		  str = ++back;
+	    } else {
+		  return 0;
+	    }
+      }
+
+      while (*pat == '*') pat += 1;
+      return *pat == 0;
+}
+
+static int dumpctl_match_list(char **list, unsigned count, const char *name)
+{
+      unsigned idx;
+      for (idx = 0 ; idx < count ; idx += 1) {
+	    if (dumpctl_glob(list[idx], name)) return 1;
+      }
+      return 0;
+}
+
+static int dumpctl_parse_time(const char *text, PLI_UINT64 *res)
+{
+      static const struct { const char *suffix; int exp; } units[] = {
+	    { "s", 0 }, { "ms", -3 }, { "us", -6 },
+	    { "ns", -9 }, { "ps", -12 }, { "fs", -15 }, { 0, 0 }
+      };
+      char *end;
+      PLI_UINT64 val = strtoull(text, &end, 10);
+      int prec, exp, idx;
+
+      if (end == text) return 0;
+      if (*end == 0) {
+	    *res = val;
+	    return 1;
+      }
+
+      for (idx = 0 ; units[idx].suffix ; idx += 1) {
+	    if (strcmp(end, units[idx].suffix) == 0) break;
+      }
+      if (units[idx].suffix == 0) return 0;
+
+      prec = vpi_get(vpiTimePrecision, 0);
+      for (exp = units[idx].exp ; exp > prec ; exp -= 1) val *= 10;
+      for ( ; exp < prec ; exp += 1) val /= 10;
+
+      *res = val;
+      return 1;
+}
+
+static int dumpctl_window_compare(const void *a, const void *b)
+{
+      const struct dumpctl_window_s *wa = (const struct dumpctl_window_s *)a;
+      const struct dumpctl_window_s *wb = (const struct dumpctl_window_s *)b;
+
+      if (wa->start < wb->start) return -1;
+      if (wa->start > wb->start) return 1;
+      return 0;
+}
+
+  /* Sort the windows and merge any that overlap or touch, so that a
+   * window never opens at the same time another one closes. */
+static void dumpctl_merge_windows(void)
+{
+      unsigned idx, out = 0;
+
+      if (dumpctl_nwindows == 0) return;
+
+      qsort(dumpctl_windows, dumpctl_nwindows,
+	    sizeof(struct dumpctl_window_s), dumpctl_window_compare);
+
+      for (idx = 1 ; idx < dumpctl_nwindows ; idx += 1) {
+	    struct dumpctl_window_s *cur = dumpctl_windows + out;
+	    struct dumpctl_window_s *nxt = dumpctl_windows + idx;
+	    if (!cur->has_end) break;
+	    if (nxt->start <= cur->end) {
+		  if (!nxt->has_end) cur->has_end = 0;
+		  else if (nxt->end > cur->end) cur->end = nxt->end;
+	    } else {
+		  out += 1;
+		  dumpctl_windows[out] = *nxt;
+	    }
+      }
+      dumpctl_nwindows = out + 1;
+}
+
+static void dumpctl_add_pattern(char ***list, unsigned *count,
+				const char *pat)
+{
+      *list = (char **) realloc(*list, (*count+1)*sizeof(char *));
+      (*list)[*count] = strdup(pat);
+      *count += 1;
+}
+
+static void dumpctl_read(const char *dumper, const char *path)
+{
+      char line[4096];
+      unsigned lineno = 0;
+      FILE *fd = fopen(path, "r");
+
+      if (fd == 0) {
+	    vpi_printf("%s warning: Unable to open dump control file "
+	               "\"%s\".\n", dumper, path);
+	    return;
+      }
+
+      while (fgets(line, sizeof line, fd)) {
+	    char *cmd, *arg1, *arg2, *extra;
+	    char *cp = strchr(line, '#');
+	    if (cp) *cp = 0;
+	    lineno += 1;
+
+	    cmd = strtok(line, " \t\r\n");
+	    if (cmd == 0) continue;
+	    arg1 = strtok(0, " \t\r\n");
+	    arg2 = strtok(0, " \t\r\n");
+	    extra = strtok(0, " \t\r\n");
+
+	    if (strcmp(cmd, "include") == 0 && arg1 && !arg2) {
+		  dumpctl_add_pattern(&dumpctl_include, &dumpctl_ninclude, arg1);
+
+	    } else if (strcmp(cmd, "exclude") == 0 && arg1 && !arg2) {
+		  dumpctl_add_pattern(&dumpctl_exclude, &dumpctl_nexclude, arg1);
+
+	    } else if (strcmp(cmd, "depth") == 0 && arg1 && !arg2 &&
+	               atoi(arg1) > 0) {
+		  dumpctl_depth_limit = atoi(arg1);
+
+	    } else if (strcmp(cmd, "window") == 0 && arg1 && !extra) {
+		  struct dumpctl_window_s win;
+		  win.has_end = arg2 != 0;
+		  win.end = 0;
+		  if (!dumpctl_parse_time(arg1, &win.start) ||
+		      (arg2 && !dumpctl_parse_time(arg2, &win.end)) ||
+		      (arg2 && win.end <= win.start)) {
+			vpi_printf("%s warning: %s:%u: Invalid dump "
+			           "window.\n", dumper, path, lineno);
+			continue;
+		  }
+		  dumpctl_windows = (struct dumpctl_window_s *)
+			realloc(dumpctl_windows, (dumpctl_nwindows+1) *
+			        sizeof(struct dumpctl_window_s));
+		  dumpctl_windows[dumpctl_nwindows++] = win;
+
+	    } else {
+		  vpi_printf("%s warning: %s:%u: Invalid dump control "
+		             "command \"%s\".\n", dumper, path, lineno, cmd);
+	    }
+      }
+
+      fclose(fd);
+      dumpctl_merge_windows();
+}
+
+void vcd_dumpctl_init(const char *dumper)
+{
+      struct t_vpi_vlog_info vlog_info;
+      int idx;
+
+      if (dumpctl_loaded) return;
+      dumpctl_loaded = 1;
+
+      vpi_get_vlog_info(&vlog_info);
+      for (idx = 0 ; idx < vlog_info.argc ; idx += 1) {
+	    if (strncmp(vlog_info.argv[idx], "+dumpctl=", 9) == 0)
+		  dumpctl_read(dumper, vlog_info.argv[idx] + 9);
+      }
+}
+
+unsigned vcd_dumpctl_depth(unsigned depth)
+{
+      if (dumpctl_depth_limit && depth > dumpctl_depth_limit)
+	    return dumpctl_depth_limit;
+      return depth;
+}
+
+int vcd_dumpctl_skip_scope(const char *fullname)
+{
+      return dumpctl_match_list(dumpctl_exclude, dumpctl_nexclude, fullname);
+}
+
+int vcd_dumpctl_skip_signal(vpiHandle item)
+{
+      const char *fullname;
+
+      if (dumpctl_ninclude == 0 && dumpctl_nexclude == 0) return 0;
+
+      fullname = vpi_get_str(vpiFullName, item);
+      if (dumpctl_ninclude &&
+          !dumpctl_match_list(dumpctl_include, dumpctl_ninclude, fullname))
+	    return 1;
+      return dumpctl_match_list(dumpctl_exclude, dumpctl_nexclude, fullname);
+}
+
+static void dump_switch_update(struct vcd_dump_switch_s *sw)
+{
+      if (sw->user_off || sw->window_off) sw->dump_off();
+      else sw->dump_on();
+}
+
+void vcd_dump_switch_user(struct vcd_dump_switch_s *sw, int on)
+{
+      sw->user_off = !on;
+      dump_switch_update(sw);
+}
+
+static void dump_switch_window(struct vcd_dump_switch_s *sw, int on)
+{
+      sw->window_off = !on;
+      dump_switch_update(sw);
+}
+
+static PLI_INT32 dumpctl_window_cb(p_cb_data cause)
+{
+      dump_switch_window(dumpctl_switch, cause->user_data != 0);
+      return 0;
+}
+
+static void dumpctl_schedule(PLI_UINT64 when, int on)
+{
+      struct t_cb_data cb;
+      struct t_vpi_time time;
+
+      time.type = vpiSimTime;
+      time.high = (PLI_UINT32)(when >> 32);
+      time.low  = (PLI_UINT32)when;
+
+      cb.reason = cbAtStartOfSimTime;
+      cb.cb_rtn = dumpctl_window_cb;
+      cb.time = &time;
+      cb.obj = 0;
+      cb.value = 0;
+      cb.user_data = on ? (PLI_BYTE8 *)"on" : 0;
+      vpi_register_cb(&cb);
+}
+
+void vcd_dumpctl_start_windows(struct vcd_dump_switch_s *sw)
+{
+      struct t_vpi_time time;
+      PLI_UINT64 now;
+      int active = 0;
+      unsigned idx;
+
+      if (dumpctl_nwindows == 0) return;
+      dumpctl_switch = sw;
+
+      time.type = vpiSimTime;
+      vpi_get_time(0, &time);
+      now = timerec_to_time64(&time);
+
+      for (idx = 0 ; idx < dumpctl_nwindows ; idx += 1) {
+	    struct dumpctl_window_s *cur = dumpctl_windows + idx;
+	    if (cur->start <= now && (!cur->has_end || now < cur->end))
+		  active = 1;
+	    if (cur->start > now)
+		  dumpctl_schedule(cur->start, 1);
+	    if (cur->has_end && cur->end > now)
+		  dumpctl_schedule(cur->end, 0);
+      }
+
+      if (!active) dump_switch_window(sw, 0);
+}
+
+void vcd_value_cb_on(vpiHandle *cb, vpiHandle item, struct t_vpi_time *time,
+		     PLI_INT32 (*fun)(p_cb_data), void *data)
+{
+      struct t_cb_data cbd;
+
+      if (*cb) return;
+
+      cbd.time      = time;
+      cbd.user_data = (PLI_BYTE8 *)data;
+      cbd.value     = NULL;
+      cbd.obj       = item;
+      cbd.reason    = cbValueChange;
+      cbd.cb_rtn    = fun;
+
+      *cb = vpi_register_cb(&cbd);
+}
+
+void vcd_value_cb_off(vpiHandle *cb)
+{
+      if (*cb == 0) return;
+      vpi_remove_cb(*cb);
+      *cb = 0;
 }
 
 /*
@@ -217,3 +672,25 @@ PLI_INT32 sys_dumpvars_compiletf(ICARUS_VPI_CONST PLI_BYTE8 *name)
 
       return 0;
 }
+
+/* $dumpflush_window takes an optional file name. */
+PLI_INT32 sys_dumpflush_window_compiletf(ICARUS_VPI_CONST PLI_BYTE8 *name)
+{
+      vpiHandle callh = vpi_handle(vpiSysTfCall, 0);
+      vpiHandle argv = vpi_iterate(vpiArgument, callh);
+
+      /* No argument is OK, use the dump file name. */
+      if (argv == 0) return 0;
+
+      if (! is_string_obj(vpi_scan(argv))) {
+            vpi_printf("ERROR: %s:%d: ", vpi_get_str(vpiFile, callh),
+                       (int)vpi_get(vpiLineNo, callh));
+            vpi_printf("%s's argument must be a string.\n", name);
+            vpi_control(vpiFinish, 1);
+      }
+
+      /* Make sure there are no extra arguments. */
+      check_for_extra_args(argv, callh, name, "one string argument", 1);
+
+      return 0;
+}
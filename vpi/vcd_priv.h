@@ -20,6 +20,8 @@
  */
 
 #include "vpi_user.h"
+#include <stdarg.h>
+#include <stdio.h>
 
 #ifdef __cplusplus
 # define EXTERN extern "C"
@@ -34,8 +36,9 @@ EXTERN struct stringheap_s name_heap;
 
 struct vcd_names_list_s {
       struct vcd_names_s *vcd_names_list;
-      const char **vcd_names_sorted;
-      int listed_names, sorted_names;
+      const char **vcd_names_hash;
+      int listed_names, hashed_names;
+      unsigned hash_size;
 };
 
 EXTERN void vcd_names_add(struct vcd_names_list_s*tab, const char *name);
@@ -47,6 +50,15 @@ EXTERN void vcd_names_sort(struct vcd_names_list_s*tab);
 
 EXTERN void vcd_names_delete(struct vcd_names_list_s*tab);
 
+EXTERN int vcd_names_empty(const struct vcd_names_list_s*tab);
+
+/*
+ * Return a malloc'ed array of the signals and sub-scopes of a scope,
+ * in the order that they are listed in the dump file header. The
+ * caller must free the array.
+ */
+EXTERN vpiHandle *vcd_scope_items(vpiHandle scope, unsigned *count);
+
 /*
  * Keep a map of nexus ident's to help with alias detection.
  */
@@ -62,6 +74,104 @@ EXTERN void vcd_scope_names_add(const char*name);
 EXTERN int  vcd_scope_names_test(const char*name);
 EXTERN void vcd_scope_names_delete(void);
 
+/*
+ * Support for the +dumpctl=<file> dump control file. The patterns,
+ * depth limit and time windows it holds are shared by the dumpers.
+ */
+EXTERN void vcd_dumpctl_init(const char *dumper);
+EXTERN unsigned vcd_dumpctl_depth(unsigned depth);
+EXTERN int vcd_dumpctl_skip_scope(const char *fullname);
+EXTERN int vcd_dumpctl_skip_signal(vpiHandle item);
+
+/*
+ * The dump is off if the user turned it off with $dumpoff or if the
+ * dump control windows have it closed. Each dumper keeps one of these
+ * and gives the functions that turn its dump on and off. They are
+ * only called when the combined state changes.
+ */
+struct vcd_dump_switch_s {
+      int user_off;
+      int window_off;
+      void (*dump_on)(void);
+      void (*dump_off)(void);
+};
+
+/* $dumpon (on is true) and $dumpoff (on is false). */
+EXTERN void vcd_dump_switch_user(struct vcd_dump_switch_s *sw, int on);
+
+/*
+ * Start the time windows (if any) once the dump header is done. The
+ * windows then open and close the dump through the switch.
+ */
+EXTERN void vcd_dumpctl_start_windows(struct vcd_dump_switch_s *sw);
+
+/*
+ * While the dump is off the value change callbacks of the dumped
+ * signals are removed, so the signals do not pay anything for being
+ * dumped. These add the callback for a signal if it is not there and
+ * remove it if it is. The *cb is the handle of the callback, or 0.
+ */
+EXTERN void vcd_value_cb_on(vpiHandle *cb, vpiHandle item,
+			    struct t_vpi_time *time,
+			    PLI_INT32 (*fun)(p_cb_data), void *data);
+EXTERN void vcd_value_cb_off(vpiHandle *cb);
+
+/*
+ * The VCD text writer in vcd_text.c is shared by the VCD dumper and
+ * the flight recorder. It keeps the list of dumped signals, scans the
+ * $dumpvars arguments, watches the signals and formats the values.
+ * The dumper says where the text goes with these functions:
+ *
+ *    print_header: the $scope, $var and $upscope lines.
+ *    print_change: the time steps and the values.
+ *    new_time:     (optional) called before the changes of a new time
+ *                  step are written. If it returns true the changes
+ *                  are not written, because the dumper wrote all the
+ *                  values another way (i.e. with a checkpoint).
+ *    drop_change:  (optional) called before a change is queued. If it
+ *                  returns true the change is dropped.
+ *    dumpctl:      true if the dump control file applies.
+ */
+struct vcd_text_ops_s {
+      void (*print_header)(const char *fmt, va_list ap);
+      void (*print_change)(const char *fmt, va_list ap);
+      int (*new_time)(PLI_UINT64 now);
+      int (*drop_change)(void);
+      int dumpctl;
+};
+
+EXTERN void vcd_text_init(const struct vcd_text_ops_s *ops);
+EXTERN void vcd_text_preamble(FILE *fd);
+
+/*
+ * Install the $dumpvars and end of simulation callbacks of the dumper
+ * the first time $dumpvars is called. Return true if $dumpvars was
+ * already done and must be ignored. The dumpvars callback calls
+ * vcd_text_dumpvars_done when it writes the first values.
+ */
+EXTERN int vcd_text_install_dumpvars(PLI_INT32 (*dumpvars_cb)(p_cb_data),
+				     PLI_INT32 (*finish_cb)(p_cb_data));
+EXTERN void vcd_text_dumpvars(vpiHandle callh, vpiHandle argv);
+EXTERN void vcd_text_dumpvars_done(PLI_UINT64 now);
+EXTERN int vcd_text_dumpvars_started(void);
+EXTERN int vcd_text_header_pending(void);
+
+EXTERN PLI_UINT64 vcd_text_cur_time(void);
+EXTERN void vcd_text_set_time(PLI_UINT64 now);
+/* Write the time step if it is past the current time. */
+EXTERN void vcd_text_time(PLI_UINT64 now);
+/* Write all the values, or x for all of them if x_flag is true. */
+EXTERN void vcd_text_checkpoint(int x_flag);
+
+EXTERN int vcd_text_is_off(void);
+EXTERN void vcd_text_dumpoff(void);
+EXTERN void vcd_text_dumpon(void);
+/* Start the dump control windows for the text dump. */
+EXTERN void vcd_text_start_windows(void);
+EXTERN void vcd_text_dumpall(void);
+
+EXTERN void vcd_text_delete(void);
+
 /*
  * Implement a work queue that can be used to send commands to a
  * dumper thread.
@@ -128,6 +238,7 @@ EXTERN void vcd_work_emit_bits(struct lxt2_wr_symbol*sym, const char*bits);
 
 /* The compiletf routines are common for the VCD, LXT and LXT2 dumpers. */
 EXTERN PLI_INT32 sys_dumpvars_compiletf(ICARUS_VPI_CONST PLI_BYTE8 *name);
+EXTERN PLI_INT32 sys_dumpflush_window_compiletf(ICARUS_VPI_CONST PLI_BYTE8 *name);
 
 #undef EXTERN
 
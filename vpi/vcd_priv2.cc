@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010-2011 Stephen Williams (steve@icarus.com)
+ * Copyright (c) 2010-2026 Stephen Williams (steve@icarus.com)
  *
  *    This source code is free software; you can redistribute it
  *    and/or modify it in source code form under the terms of the GNU
@@ -18,9 +18,6 @@
  */
 
 # include  "vcd_priv.h"
-# include  <map>
-# include  <set>
-# include  <string>
 # include  <pthread.h>
 # include  <cstdlib>
 # include  <cstring>
@@ -41,46 +38,104 @@
    The _vpiNexusId is a private (int) property of IVL simulators.
 */
 
-static std::map<int,const char*> nexus_ident_map;
+static int*nexus_ident_keys = 0;
+static const char**nexus_ident_vals = 0;
+static unsigned nexus_ident_size = 0;
+static unsigned nexus_ident_count = 0;
+
+  /* The nexus ids are unique (and non-zero) so a simple open
+     addressed hash table does the job. A zero key marks a free
+     slot. */
+static inline unsigned nexus_ident_hash(int nex)
+{
+      unsigned tmp = (unsigned)nex;
+      tmp ^= tmp >> 16;
+      tmp *= 0x45d9f3bu;
+      tmp ^= tmp >> 16;
+      return tmp & (nexus_ident_size - 1);
+}
+
+static void nexus_ident_grow(void)
+{
+      int*old_keys = nexus_ident_keys;
+      const char**old_vals = nexus_ident_vals;
+      unsigned old_size = nexus_ident_size;
+
+      nexus_ident_size = old_size? 2*old_size : 1024;
+      nexus_ident_keys = (int*)calloc(nexus_ident_size, sizeof(int));
+      nexus_ident_vals = (const char**)calloc(nexus_ident_size,
+					      sizeof(const char*));
+
+      for (unsigned idx = 0 ; idx < old_size ; idx += 1) {
+	    if (old_keys[idx] == 0) continue;
+	    unsigned pos = nexus_ident_hash(old_keys[idx]);
+	    while (nexus_ident_keys[pos])
+		  pos = (pos + 1) & (nexus_ident_size - 1);
+	    nexus_ident_keys[pos] = old_keys[idx];
+	    nexus_ident_vals[pos] = old_vals[idx];
+      }
+
+      free(old_keys);
+      free(old_vals);
+}
 
 extern "C" const char*find_nexus_ident(int nex)
 {
-      std::map<int,const char*>::const_iterator cur = nexus_ident_map.find(nex);
-      if (cur == nexus_ident_map.end())
+      if (nexus_ident_count == 0)
 	    return 0;
-      else
-	    return cur->second;
+
+      unsigned pos = nexus_ident_hash(nex);
+      while (nexus_ident_keys[pos]) {
+	    if (nexus_ident_keys[pos] == nex)
+		  return nexus_ident_vals[pos];
+	    pos = (pos + 1) & (nexus_ident_size - 1);
+      }
+      return 0;
 }
 
 extern "C" void set_nexus_ident(int nex, const char*id)
 {
-      nexus_ident_map[nex] = id;
+      assert(nex != 0);
+      if (2*(nexus_ident_count+1) >= nexus_ident_size)
+	    nexus_ident_grow();
+
+      unsigned pos = nexus_ident_hash(nex);
+      while (nexus_ident_keys[pos] && nexus_ident_keys[pos] != nex)
+	    pos = (pos + 1) & (nexus_ident_size - 1);
+
+      if (nexus_ident_keys[pos] == 0)
+	    nexus_ident_count += 1;
+      nexus_ident_keys[pos] = nex;
+      nexus_ident_vals[pos] = id;
 }
 
 extern "C" void nexus_ident_delete()
 {
-      nexus_ident_map.clear();
+      free(nexus_ident_keys);
+      free(nexus_ident_vals);
+      nexus_ident_keys = 0;
+      nexus_ident_vals = 0;
+      nexus_ident_size = 0;
+      nexus_ident_count = 0;
 }
 
 
-static std::set<std::string> vcd_scope_names_set;
+static struct vcd_names_list_s vcd_scope_names_tab = { 0, 0, 0, 0, 0 };
 
 extern "C" void vcd_scope_names_add(const char*name)
 {
-      vcd_scope_names_set .insert(name);
+      vcd_names_add(&vcd_scope_names_tab, name);
+      vcd_names_sort(&vcd_scope_names_tab);
 }
 
 extern "C" int vcd_scope_names_test(const char*name)
 {
-      if (vcd_scope_names_set.find(name) == vcd_scope_names_set.end())
-	    return 0;
-      else
-	    return 1;
+      return vcd_names_search(&vcd_scope_names_tab, name) != 0;
 }
 
 extern "C" void vcd_scope_names_delete(void)
 {
-      vcd_scope_names_set.clear();
+      vcd_names_delete(&vcd_scope_names_tab);
 }
 
 static pthread_t work_thread;
@@ -89,101 +144,119 @@ static const unsigned WORK_QUEUE_SIZE = 128*1024;
 static const unsigned WORK_QUEUE_BATCH_MIN = 4*1024;
 static const unsigned WORK_QUEUE_BATCH_MAX = 32*1024;
 
+/*
+ * The work queue is a ring with exactly one producer (the simulation
+ * thread) and one consumer (the work thread). The producer owns the
+ * tail index and the consumer owns the head index. The indices count
+ * up without wrapping to the queue size, so the fill is always
+ * tail-head. Each side only reads the index of the other side, so the
+ * queue needs no lock as long as neither side has to wait.
+ *
+ * A side that must wait (the consumer for an item, the producer for
+ * free space or for an empty queue) sets its waiting flag and sleeps
+ * on its condition under the mutex. The other side checks the flag
+ * after it moves its index, and only then takes the mutex to wake
+ * the sleeper. The full barriers make sure that either the sleeper
+ * sees the new index, or the other side sees the flag.
+ */
 static struct vcd_work_item_s work_queue[WORK_QUEUE_SIZE];
-static volatile unsigned work_queue_next = 0;
-static volatile unsigned work_queue_fill = 0;
+static volatile unsigned work_queue_head = 0;
+static volatile unsigned work_queue_tail = 0;
+static volatile int work_queue_consumer_waiting = 0;
+static volatile int work_queue_producer_waiting = 0;
 
 static pthread_mutex_t work_queue_mutex = PTHREAD_MUTEX_INITIALIZER;
-static pthread_cond_t  work_queue_is_empty_sig = PTHREAD_COND_INITIALIZER;
-static pthread_cond_t  work_queue_notempty_sig = PTHREAD_COND_INITIALIZER;
-static pthread_cond_t  work_queue_minfree_sig = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  work_queue_consumer_sig = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  work_queue_producer_sig = PTHREAD_COND_INITIALIZER;
 
+static inline unsigned work_queue_fill(void)
+{
+      return work_queue_tail - work_queue_head;
+}
 
 extern "C" struct vcd_work_item_s* vcd_work_thread_peek(void)
 {
-	// There must always only be 1 vcd work thread, and only the
-	// work thread decreases the fill, so if the work_queue_fill
-	// is non-zero, I can reliably assume that there is at least
-	// one item that I can peek at. I only need to lock if I must
-	// wait for the work_queue_fill to become non-zero.
-      if (work_queue_fill == 0) {
+      if (work_queue_fill() == 0) {
 	    pthread_mutex_lock(&work_queue_mutex);
-	    while (work_queue_fill == 0)
-		  pthread_cond_wait(&work_queue_notempty_sig, &work_queue_mutex);
+	    work_queue_consumer_waiting = 1;
+	    __sync_synchronize();
+	    while (work_queue_fill() == 0)
+		  pthread_cond_wait(&work_queue_consumer_sig, &work_queue_mutex);
+	    work_queue_consumer_waiting = 0;
 	    pthread_mutex_unlock(&work_queue_mutex);
       }
 
-      return work_queue + work_queue_next;
+	// Do not read the item before the fill that covers it.
+      __sync_synchronize();
+      return work_queue + work_queue_head % WORK_QUEUE_SIZE;
 }
 
 extern "C" void vcd_work_thread_pop(void)
 {
-      pthread_mutex_lock(&work_queue_mutex);
-
-      unsigned use_fill = work_queue_fill - 1;
-      work_queue_fill = use_fill;
-
-      unsigned use_next = work_queue_next;
-
-      struct vcd_work_item_s*cell = work_queue + use_next;
+      struct vcd_work_item_s*cell = work_queue + work_queue_head % WORK_QUEUE_SIZE;
       if (cell->type == WT_EMIT_BITS) {
 	    free(cell->op_.val_char);
       }
 
-      use_next += 1;
-      if (use_next >= WORK_QUEUE_SIZE)
-	    use_next = 0;
-      work_queue_next = use_next;
-
-      if (use_fill == WORK_QUEUE_SIZE-WORK_QUEUE_BATCH_MIN)
-	    pthread_cond_signal(&work_queue_minfree_sig);
-      else if (use_fill == 0)
-	    pthread_cond_signal(&work_queue_is_empty_sig);
-
-      pthread_mutex_unlock(&work_queue_mutex);
+	// Finish with the item before the producer can reuse it.
+      __sync_synchronize();
+      work_queue_head = work_queue_head + 1;
+      __sync_synchronize();
+
+	// The producer waits for a batch worth of free space, or for
+	// the queue to drain completely. Only wake it for those.
+      if (work_queue_producer_waiting) {
+	    unsigned use_fill = work_queue_fill();
+	    if (use_fill == 0 || use_fill == WORK_QUEUE_SIZE-WORK_QUEUE_BATCH_MIN) {
+		  pthread_mutex_lock(&work_queue_mutex);
+		  pthread_cond_signal(&work_queue_producer_sig);
+		  pthread_mutex_unlock(&work_queue_mutex);
+	    }
+      }
 }
 
 /*
  * Work queue items are created in batches to reduce thread
- * bouncing. When the producer gets a free work item, it actually
- * locks the queue in order to produce a batch. The queue stays locked
- * until the batch is complete. Then the releases the whole lot to the
- * consumer.
+ * bouncing. The producer fills in a batch of items past the tail, and
+ * then releases the whole lot to the consumer by moving the tail.
  */
 static uint64_t work_queue_next_time = 0;
 static unsigned current_batch_cnt = 0;
 static unsigned current_batch_alloc = 0;
-static unsigned current_batch_base = 0;
 
 extern "C" void vcd_work_start( void* (*fun) (void*), void*arg )
 {
       pthread_create(&work_thread, 0, fun, arg);
 }
 
-static struct vcd_work_item_s* grab_item(void)
+static void producer_wait(unsigned max_fill)
 {
-      if (current_batch_alloc == 0) {
-	     pthread_mutex_lock(&work_queue_mutex);
-	     while ((WORK_QUEUE_SIZE-work_queue_fill) < WORK_QUEUE_BATCH_MIN)
-		  pthread_cond_wait(&work_queue_minfree_sig, &work_queue_mutex);
+      if (work_queue_fill() <= max_fill)
+	    return;
 
-	     current_batch_base = work_queue_next + work_queue_fill;
-	     current_batch_alloc = WORK_QUEUE_SIZE - work_queue_fill;
+      pthread_mutex_lock(&work_queue_mutex);
+      work_queue_producer_waiting = 1;
+      __sync_synchronize();
+      while (work_queue_fill() > max_fill)
+	    pthread_cond_wait(&work_queue_producer_sig, &work_queue_mutex);
+      work_queue_producer_waiting = 0;
+      pthread_mutex_unlock(&work_queue_mutex);
+}
 
-	     pthread_mutex_unlock(&work_queue_mutex);
+static struct vcd_work_item_s* grab_item(void)
+{
+      if (current_batch_alloc == 0) {
+	    producer_wait(WORK_QUEUE_SIZE-WORK_QUEUE_BATCH_MIN);
 
-	     if (current_batch_base >= WORK_QUEUE_SIZE)
-		   current_batch_base -= WORK_QUEUE_SIZE;
-	     if (current_batch_alloc > WORK_QUEUE_BATCH_MAX)
-		   current_batch_alloc = WORK_QUEUE_BATCH_MAX;
-	     current_batch_cnt = 0;
+	    current_batch_alloc = WORK_QUEUE_SIZE - work_queue_fill();
+	    if (current_batch_alloc > WORK_QUEUE_BATCH_MAX)
+		  current_batch_alloc = WORK_QUEUE_BATCH_MAX;
+	    current_batch_cnt = 0;
       }
 
       assert(current_batch_cnt < current_batch_alloc);
 
-      unsigned cur = current_batch_base + current_batch_cnt;
-      if (cur >= WORK_QUEUE_SIZE)
-	    cur -= WORK_QUEUE_SIZE;
+      unsigned cur = (work_queue_tail + current_batch_cnt) % WORK_QUEUE_SIZE;
 
 	// Write the new timestamp into the work item.
       struct vcd_work_item_s*cell = work_queue + cur;
@@ -193,21 +266,23 @@ static struct vcd_work_item_s* grab_item(void)
 
 static void end_batch(void)
 {
-      pthread_mutex_lock(&work_queue_mutex);
-
-      unsigned use_fill = work_queue_fill;
-      bool was_empty_flag = (use_fill==0) && (current_batch_cnt > 0);
-
-      use_fill += current_batch_cnt;
-      work_queue_fill = use_fill;
-
+      unsigned use_cnt = current_batch_cnt;
       current_batch_alloc = 0;
       current_batch_cnt = 0;
 
-      if (was_empty_flag)
-	    pthread_cond_signal(&work_queue_notempty_sig);
+      if (use_cnt == 0)
+	    return;
 
-      pthread_mutex_unlock(&work_queue_mutex);
+	// The items must be complete before the consumer can see them.
+      __sync_synchronize();
+      work_queue_tail = work_queue_tail + use_cnt;
+      __sync_synchronize();
+
+      if (work_queue_consumer_waiting) {
+	    pthread_mutex_lock(&work_queue_mutex);
+	    pthread_cond_signal(&work_queue_consumer_sig);
+	    pthread_mutex_unlock(&work_queue_mutex);
+      }
 }
 
 static inline void unlock_item(bool flush_batch =false)
@@ -222,12 +297,7 @@ extern "C" void vcd_work_sync(void)
       if (current_batch_alloc > 0)
 	    end_batch();
 
-      if (work_queue_fill > 0) {
-	    pthread_mutex_lock(&work_queue_mutex);
-	    while (work_queue_fill > 0)
-		  pthread_cond_wait(&work_queue_is_empty_sig, &work_queue_mutex);
-	    pthread_mutex_unlock(&work_queue_mutex);
-      }
+      producer_wait(0);
 }
 
 extern "C" void vcd_work_flush(void)
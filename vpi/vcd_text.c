@@ -0,0 +1,777 @@
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include "sys_priv.h"
+# include "vcd_priv.h"
+
+/*
+ * This file contains the VCD text writer that the VCD dumper and the
+ * flight recorder share. It keeps the list of dumped signals, does
+ * the $dumpvars scan, watches the signals and formats their values.
+ * The dumper gives the functions that place the text, see the
+ * vcd_text_ops_s structure.
+ */
+
+# include  <stdio.h>
+# include  <stdlib.h>
+# include  <string.h>
+# include  <stdarg.h>
+# include  <assert.h>
+# include  <time.h>
+# include  "ivl_alloc.h"
+
+static const struct vcd_text_ops_s *ops = 0;
+
+static struct t_vpi_time zero_delay = { vpiSimTime, 0, 0, 0.0 };
+
+struct vcd_info {
+      vpiHandle item;
+      vpiHandle cb;
+      struct t_vpi_time time;
+      const char *ident;
+      struct vcd_info *next;
+      struct vcd_info *dmp_next;
+      int scheduled;
+};
+
+
+static struct vcd_info *vcd_list = NULL;
+static struct vcd_info *vcd_dmp_list = NULL;
+static PLI_UINT64 vcd_cur_time = 0;
+static int dump_is_off = 0;
+
+
+static const char*units_names[] = {
+      "s",
+      "ms",
+      "us",
+      "ns",
+      "ps",
+      "fs"
+};
+
+static char vcdid[8] = "!";
+
+static void gen_new_vcd_id(void)
+{
+      static unsigned value = 0;
+      unsigned v = ++value;
+      unsigned int i;
+
+      for (i=0; i < sizeof(vcdid)-1; i++) {
+           vcdid[i] = (char)((v%94)+33); /* for range 33..126 */
+           v /= 94;
+           if(!v) {
+                 vcdid[i+1] = '\0';
+                 return;
+           }
+      }
+	// This should never happen since 94**7 is a lot if identifiers!
+      assert(0);
+}
+
+static void print_header(const char*fmt, ...)
+{
+      va_list ap;
+      va_start(ap, fmt);
+      ops->print_header(fmt, ap);
+      va_end(ap);
+}
+
+static void print_change(const char*fmt, ...)
+{
+      va_list ap;
+      va_start(ap, fmt);
+      ops->print_change(fmt, ap);
+      va_end(ap);
+}
+
+static char *truncate_bitvec(char *s)
+{
+      char r;
+
+      r=*s;
+      if(r=='1') return s;
+      else s += 1;
+
+      for(;;s++) {
+	    char l;
+	    l=r; r=*s;
+	    if(!r) return (s-1);
+	    if(l!=r) return(((l=='0')&&(r=='1'))?s:s-1);
+      }
+}
+
+static void show_this_item(struct vcd_info*info)
+{
+      s_vpi_value value;
+      PLI_INT32 type = vpi_get(vpiType, info->item);
+
+      if (type == vpiRealVar) {
+	    value.format = vpiRealVal;
+	    vpi_get_value(info->item, &value);
+	    print_change("r%.16g %s\n", value.value.real, info->ident);
+      } else if (type == vpiNamedEvent) {
+	    print_change("1%s\n", info->ident);
+      } else if (vpi_get(vpiSize, info->item) == 1) {
+	    value.format = vpiBinStrVal;
+	    vpi_get_value(info->item, &value);
+	    print_change("%s%s\n", value.value.str, info->ident);
+      } else {
+	    value.format = vpiBinStrVal;
+	    vpi_get_value(info->item, &value);
+	    print_change("b%s %s\n", truncate_bitvec(value.value.str),
+			 info->ident);
+      }
+}
+
+/* Dump values for a $dumpoff. */
+static void show_this_item_x(struct vcd_info*info)
+{
+      PLI_INT32 type = vpi_get(vpiType, info->item);
+
+      if (type == vpiRealVar) {
+	      /* Some tools dump nothing here...? */
+	    print_change("rNaN %s\n", info->ident);
+      } else if (type == vpiNamedEvent) {
+	    /* Do nothing for named events. */
+      } else if (vpi_get(vpiSize, info->item) == 1) {
+	    print_change("x%s\n", info->ident);
+      } else {
+	    print_change("bx %s\n", info->ident);
+      }
+}
+
+
+/*
+ * managed hash tables of scope names/variables for duplicate detection
+ */
+
+static struct vcd_names_list_s vcd_tab = { 0, 0, 0, 0, 0 };
+static struct vcd_names_list_s vcd_var = { 0, 0, 0, 0, 0 };
+
+
+static int dumpvars_status = 0; /* 0:fresh 1:cb installed, 2:callback done */
+static PLI_UINT64 dumpvars_time;
+
+int vcd_text_header_pending(void)
+{
+      return dumpvars_status != 2;
+}
+
+int vcd_text_dumpvars_started(void)
+{
+      return dumpvars_status != 0;
+}
+
+int vcd_text_is_off(void)
+{
+      return dump_is_off;
+}
+
+PLI_UINT64 vcd_text_cur_time(void)
+{
+      return vcd_cur_time;
+}
+
+void vcd_text_set_time(PLI_UINT64 now)
+{
+      vcd_cur_time = now;
+}
+
+void vcd_text_time(PLI_UINT64 now)
+{
+      if (now > vcd_cur_time) {
+	    print_change("#%" PLI_UINT64_FMT "\n", now);
+	    vcd_cur_time = now;
+      }
+}
+
+/*
+ * This function writes out all the traced variables, whether they
+ * changed or not. If x_flag is true the values are all written as x,
+ * which is what $dumpoff does.
+ */
+void vcd_text_checkpoint(int x_flag)
+{
+      struct vcd_info*cur;
+
+      for (cur = vcd_list ;  cur ;  cur = cur->next) {
+	    if (x_flag) show_this_item_x(cur);
+	    else show_this_item(cur);
+      }
+}
+
+void vcd_text_preamble(FILE*fd)
+{
+      int prec = vpi_get(vpiTimePrecision, 0);
+      unsigned scale = 1;
+      unsigned udx = 0;
+      time_t walltime;
+
+      time(&walltime);
+
+      assert(prec >= -15);
+      while (prec < 0) {
+	    udx += 1;
+	    prec += 3;
+      }
+      while (prec > 0) {
+	    scale *= 10;
+	    prec -= 1;
+      }
+
+      fprintf(fd, "$date\n");
+      fprintf(fd, "\t%s",asctime(localtime(&walltime)));
+      fprintf(fd, "$end\n");
+      fprintf(fd, "$version\n");
+      fprintf(fd, "\tIcarus Verilog\n");
+      fprintf(fd, "$end\n");
+      fprintf(fd, "$timescale\n");
+      fprintf(fd, "\t%u%s\n", scale, units_names[udx]);
+      fprintf(fd, "$end\n");
+}
+
+static PLI_INT32 variable_cb_2(p_cb_data cause)
+{
+      struct vcd_info* info = vcd_dmp_list;
+      PLI_UINT64 now = timerec_to_time64(cause->time);
+
+      vcd_dmp_list = 0;
+
+      if (now != vcd_cur_time) {
+	      /* The dumper may have written the new values another
+	       * way, i.e. with a checkpoint. */
+	    if (ops->new_time && ops->new_time(now)) {
+		  do {
+			info->scheduled = 0;
+		  } while ((info = info->dmp_next) != 0);
+		  return 0;
+	    }
+
+	    print_change("#%" PLI_UINT64_FMT "\n", now);
+	    vcd_cur_time = now;
+      }
+
+      do {
+           show_this_item(info);
+           info->scheduled = 0;
+      } while ((info = info->dmp_next) != 0);
+
+      return 0;
+}
+
+static PLI_INT32 variable_cb_1(p_cb_data cause)
+{
+      struct t_cb_data cb;
+      struct vcd_info*info = (struct vcd_info*)cause->user_data;
+
+      if (dump_is_off) return 0;
+      if (vcd_text_header_pending()) return 0;
+      if (info->scheduled) return 0;
+      if (ops->drop_change && ops->drop_change()) return 0;
+
+      if (!vcd_dmp_list) {
+          cb = *cause;
+	  cb.time = &zero_delay;
+          cb.reason = cbReadOnlySynch;
+          cb.cb_rtn = variable_cb_2;
+          vpi_register_cb(&cb);
+      }
+
+      info->scheduled = 1;
+      info->dmp_next  = vcd_dmp_list;
+      vcd_dmp_list    = info;
+
+      return 0;
+}
+
+static void register_variable_cb(struct vcd_info*info)
+{
+      vcd_value_cb_on(&info->cb, info->item, &info->time,
+		      variable_cb_1, info);
+}
+
+static void vcd_callbacks_on(void)
+{
+      struct vcd_info*cur;
+
+      for (cur = vcd_list ;  cur ;  cur = cur->next)
+	    register_variable_cb(cur);
+}
+
+static void vcd_callbacks_off(void)
+{
+      struct vcd_info*cur;
+
+      for (cur = vcd_list ;  cur ;  cur = cur->next)
+	    vcd_value_cb_off(&cur->cb);
+}
+
+void vcd_text_init(const struct vcd_text_ops_s*use_ops)
+{
+      ops = use_ops;
+}
+
+int vcd_text_install_dumpvars(PLI_INT32 (*dumpvars_cb)(p_cb_data),
+			      PLI_INT32 (*finish_cb)(p_cb_data))
+{
+      struct t_cb_data cb;
+
+      if (dumpvars_status == 1) return 0;
+
+      if (dumpvars_status == 2) {
+	    vpi_printf("VCD warning: $dumpvars ignored, previously"
+	               " called at simtime %" PLI_UINT64_FMT "\n",
+	               dumpvars_time);
+	    return 1;
+      }
+
+      cb.time = &zero_delay;
+      cb.reason = cbReadOnlySynch;
+      cb.cb_rtn = dumpvars_cb;
+      cb.user_data = 0x0;
+      cb.obj = 0x0;
+
+      vpi_register_cb(&cb);
+
+      cb.reason = cbEndOfSimulation;
+      cb.cb_rtn = finish_cb;
+
+      vpi_register_cb(&cb);
+
+      dumpvars_status = 1;
+      return 0;
+}
+
+void vcd_text_dumpvars_done(PLI_UINT64 now)
+{
+      assert(dumpvars_status == 1);
+      dumpvars_status = 2;
+      dumpvars_time = now;
+      vcd_cur_time = now;
+}
+
+void vcd_text_delete(void)
+{
+      struct vcd_info *cur, *next;
+
+      for (cur = vcd_list ;  cur ;  cur = next) {
+	    next = cur->next;
+	    free((char *)cur->ident);
+	    free(cur);
+      }
+      vcd_list = 0;
+      vcd_names_delete(&vcd_tab);
+      vcd_names_delete(&vcd_var);
+      nexus_ident_delete();
+}
+
+static PLI_UINT64 get_now(void)
+{
+      s_vpi_time now;
+
+      now.type = vpiSimTime;
+      vpi_get_time(0, &now);
+      return timerec_to_time64(&now);
+}
+
+static void dump_off(void)
+{
+      if (dump_is_off) return;
+
+      dump_is_off = 1;
+      vcd_callbacks_off();
+
+      if (vcd_text_header_pending()) return;
+
+      vcd_text_time(get_now());
+      print_change("$dumpoff\n");
+      vcd_text_checkpoint(1);
+      print_change("$end\n");
+}
+
+static void dump_on(void)
+{
+      if (!dump_is_off) return;
+
+      dump_is_off = 0;
+      vcd_callbacks_on();
+
+      if (vcd_text_header_pending()) return;
+
+      vcd_text_time(get_now());
+      print_change("$dumpon\n");
+      vcd_text_checkpoint(0);
+      print_change("$end\n");
+}
+
+static struct vcd_dump_switch_s dump_switch = { 0, 0, dump_on, dump_off };
+
+void vcd_text_dumpoff(void)
+{
+      vcd_dump_switch_user(&dump_switch, 0);
+}
+
+void vcd_text_dumpon(void)
+{
+      vcd_dump_switch_user(&dump_switch, 1);
+}
+
+void vcd_text_start_windows(void)
+{
+      vcd_dumpctl_start_windows(&dump_switch);
+}
+
+void vcd_text_dumpall(void)
+{
+      if (dump_is_off) return;
+      if (vcd_text_header_pending()) return;
+
+      vcd_text_time(get_now());
+      print_change("$dumpall\n");
+      vcd_text_checkpoint(0);
+      print_change("$end\n");
+}
+
+static void scan_item(unsigned depth, vpiHandle item, int skip)
+{
+      struct vcd_info* info;
+
+      const char *type;
+      const char *name;
+      const char *fullname;
+      const char *prefix;
+      const char *ident;
+      int nexus_id;
+      unsigned size;
+      PLI_INT32 item_type;
+
+	/* Get the displayed type for the various $var and $scope types. */
+	/* Not all of these are supported now, but they should be in a
+	 * future development version. */
+      item_type = vpi_get(vpiType, item);
+      switch (item_type) {
+	  case vpiNamedEvent: type = "event"; break;
+	  case vpiIntVar:
+	  case vpiIntegerVar: type = "integer"; break;
+	  case vpiParameter:  type = "parameter"; break;
+	    /* Icarus converts realtime to real. */
+	  case vpiRealVar:    type = "real"; break;
+	  case vpiMemoryWord:
+	  case vpiBitVar:
+	  case vpiByteVar:
+	  case vpiShortIntVar:
+	  case vpiLongIntVar:
+	  case vpiReg:        type = "reg"; break;
+	    /* Icarus converts a time to a plain register. */
+	  case vpiTimeVar:    type = "time"; break;
+	  case vpiNet:
+	    switch (vpi_get(vpiNetType, item)) {
+		case vpiWand:    type = "wand"; break;
+		case vpiWor:     type = "wor"; break;
+		case vpiTri:     type = "tri"; break;
+		case vpiTri0:    type = "tri0"; break;
+		case vpiTri1:    type = "tri1"; break;
+		case vpiTriReg:  type = "trireg"; break;
+		case vpiTriAnd:  type = "triand"; break;
+		case vpiTriOr:   type = "trior"; break;
+		case vpiSupply1: type = "supply1"; break;
+		case vpiSupply0: type = "supply0"; break;
+		default:         type = "wire"; break;
+	    }
+	    break;
+
+	  case vpiNamedBegin: type = "begin"; break;
+	  case vpiGenScope:   type = "begin"; break;
+	  case vpiNamedFork:  type = "fork"; break;
+	  case vpiFunction:   type = "function"; break;
+	  case vpiModule:     type = "module"; break;
+	  case vpiTask:       type = "task"; break;
+
+	  default:
+	    vpi_printf("VCD warning: $dumpvars: Unsupported argument "
+	               "type (%s)\n", vpi_get_str(vpiType, item));
+	    return;
+      }
+
+	/* Do some special processing/checking on array words. Dumping
+	 * array words is an Icarus extension. */
+      if (item_type == vpiMemoryWord) {
+	      /* Turn a non-constant array word select into a constant
+	       * word select. */
+	    if (vpi_get(vpiConstantSelect, item) == 0) {
+		  vpiHandle array = vpi_handle(vpiParent, item);
+		  PLI_INT32 idx = vpi_get(vpiIndex, item);
+		  item = vpi_handle_by_index(array, idx);
+	    }
+
+	      /* An array word is implicitly escaped so look for an
+	       * escaped identifier that this could conflict with. */
+	      /* This does not work as expected since we always find at
+	       * least the array word. We likely need a custom routine. */
+            if (vpi_get(vpiType, item) == vpiMemoryWord &&
+                vpi_handle_by_name(vpi_get_str(vpiFullName, item), 0)) {
+		  vpi_printf("VCD warning: array word %s will conflict "
+		             "with an escaped identifier.\n",
+		             vpi_get_str(vpiFullName, item));
+            }
+      }
+
+	/* Generate the $var or $scope commands. */
+      switch (item_type) {
+	  case vpiParameter:
+	    vpi_printf("VCD sorry: $dumpvars: can not dump parameters.\n");
+	    break;
+
+	  case vpiNamedEvent:
+	  case vpiIntegerVar:
+	  case vpiBitVar:
+	  case vpiByteVar:
+	  case vpiShortIntVar:
+	  case vpiIntVar:
+	  case vpiLongIntVar:
+	  case vpiRealVar:
+	  case vpiMemoryWord:
+	  case vpiReg:
+	  case vpiTimeVar:
+	  case vpiNet:
+
+
+	      /* If we are skipping all signal or this is in an automatic
+	       * scope then just return. */
+            if (skip || vpi_get(vpiAutomatic, item)) return;
+
+	      /* Skip this signal if it has already been included.
+	       * This can only happen for implicitly given signals. */
+	    if (!vcd_names_empty(&vcd_var) &&
+	        vcd_names_search(&vcd_var, vpi_get_str(vpiFullName, item)))
+		  return;
+
+	      /* Skip this signal if the dump control file excludes it. */
+	    if (ops->dumpctl && vcd_dumpctl_skip_signal(item)) return;
+
+	      /* Declare the variable in the VCD file. */
+	    name = vpi_get_str(vpiName, item);
+	    prefix = is_escaped_id(name) ? "\\" : "";
+
+	      /* Some signals can have an alias so handle that. */
+	    nexus_id = vpi_get(_vpiNexusId, item);
+
+	    ident = 0;
+	    if (nexus_id) ident = find_nexus_ident(nexus_id);
+
+	    if (!ident) {
+		  ident = strdup(vcdid);
+		  gen_new_vcd_id();
+
+		  if (nexus_id) set_nexus_ident(nexus_id, ident);
+
+		    /* Add a callback for the signal. */
+		  info = malloc(sizeof(*info));
+
+		  info->time.type = vpiSimTime;
+		  info->item  = item;
+		  info->ident = ident;
+		  info->scheduled = 0;
+
+		  info->dmp_next = 0;
+		  info->next  = vcd_list;
+		  vcd_list    = info;
+
+		  info->cb    = 0;
+		  if (!dump_is_off) register_variable_cb(info);
+	    }
+
+	      /* Named events do not have a size, but other tools use
+	       * a size of 1 and some viewers do not accept a width of
+	       * zero so we will also use a width of one for events. */
+	    if (item_type == vpiNamedEvent) size = 1;
+	    else size = vpi_get(vpiSize, item);
+
+	    print_header("$var %s %u %s %s%s", type, size, ident, prefix, name);
+
+	      /* Add a range for vectored values. */
+	    if (size > 1 || vpi_get(vpiLeftRange, item) != 0) {
+		  print_header(" [%i:%i]",
+			       (int)vpi_get(vpiLeftRange, item),
+			       (int)vpi_get(vpiRightRange, item));
+	    }
+
+	    print_header(" $end\n");
+	    break;
+
+	  case vpiModule:
+	  case vpiGenScope:
+	  case vpiFunction:
+	  case vpiTask:
+	  case vpiNamedBegin:
+	  case vpiNamedFork:
+
+	    if (depth > 0) {
+		  vpiHandle *items;
+		  unsigned count, idx;
+		  int nskip;
+
+		  fullname = vpi_get_str(vpiFullName, item);
+
+		    /* Skip this scope if the dump control file excludes it. */
+		  if (ops->dumpctl && vcd_dumpctl_skip_scope(fullname)) break;
+
+		  nskip = (vcd_names_search(&vcd_tab, fullname) != 0);
+
+		    /* We have to always scan the scope because the
+		     * depth could be different for this call. */
+		  if (nskip) {
+			vpi_printf("VCD warning: ignoring signals in "
+			           "previously scanned scope %s.\n", fullname);
+		  } else {
+			vcd_names_add(&vcd_tab, fullname);
+		  }
+
+		  name = vpi_get_str(vpiName, item);
+		  print_header("$scope %s %s $end\n", type, name);
+
+		  items = vcd_scope_items(item, &count);
+		  for (idx = 0 ; idx < count ; idx += 1)
+			scan_item(depth-1, items[idx], nskip);
+		  free(items);
+
+		  print_header("$upscope $end\n");
+	    }
+	    break;
+      }
+}
+
+static int draw_scope(vpiHandle item, vpiHandle callh)
+{
+      int depth;
+      const char *name;
+      const char *type;
+
+      vpiHandle scope = vpi_handle(vpiScope, item);
+      if (!scope) return 0;
+
+      depth = 1 + draw_scope(scope, callh);
+      name = vpi_get_str(vpiName, scope);
+
+      switch (vpi_get(vpiType, scope)) {
+	  case vpiNamedBegin:  type = "begin";      break;
+	  case vpiGenScope:    type = "begin";      break;
+	  case vpiTask:        type = "task";       break;
+	  case vpiFunction:    type = "function";   break;
+	  case vpiNamedFork:   type = "fork";       break;
+	  case vpiModule:      type = "module";     break;
+	  default:
+	    type = "invalid";
+	    vpi_printf("VCD Error: %s:%d: $dumpvars: Unsupported scope "
+	               "type (%d)\n", vpi_get_str(vpiFile, callh),
+	               (int)vpi_get(vpiLineNo, callh),
+	               (int)vpi_get(vpiType, item));
+            assert(0);
+      }
+
+      print_header("$scope %s %s $end\n", type, name);
+
+      return depth;
+}
+
+void vcd_text_dumpvars(vpiHandle callh, vpiHandle argv)
+{
+      vpiHandle item;
+      s_vpi_value value;
+      unsigned depth = 0;
+
+        /* Get the depth if it exists. */
+      if (argv) {
+	    value.format = vpiIntVal;
+	    vpi_get_value(vpi_scan(argv), &value);
+	    depth = value.value.integer;
+      }
+      if (!depth) depth = 10000;
+      if (ops->dumpctl) depth = vcd_dumpctl_depth(depth);
+
+        /* This dumps all the modules in the design if none are given. */
+      if (!argv || !(item = vpi_scan(argv))) {
+	    argv = vpi_iterate(vpiModule, 0x0);
+	    assert(argv);  /* There must be at least one top level module. */
+	    item = vpi_scan(argv);
+      }
+
+      for ( ; item; item = vpi_scan(argv)) {
+	    char *scname;
+	    const char *fullname;
+	    int add_var = 0;
+	    int dep;
+	    PLI_INT32 item_type = vpi_get(vpiType, item);
+
+	      /* If this is a signal make sure it has not already
+	       * been included. */
+	    switch (item_type) {
+	        case vpiIntegerVar:
+		case vpiBitVar:
+		case vpiByteVar:
+		case vpiShortIntVar:
+		case vpiIntVar:
+		case vpiLongIntVar:
+	        case vpiMemoryWord:
+	        case vpiNamedEvent:
+	        case vpiNet:
+	        case vpiParameter:
+	        case vpiRealVar:
+	        case vpiReg:
+	        case vpiTimeVar:
+		    /* Warn if the variables scope (which includes the
+		     * variable) or the variable itself was already
+		     * included. A scope does not automatically include
+		     * memory words so do not check the scope for them.  */
+		  scname = strdup(vpi_get_str(vpiFullName,
+		                              vpi_handle(vpiScope, item)));
+		  fullname = vpi_get_str(vpiFullName, item);
+		  if (((item_type != vpiMemoryWord) &&
+		       vcd_names_search(&vcd_tab, scname)) ||
+		      vcd_names_search(&vcd_var, fullname)) {
+		        vpi_printf("VCD warning: skipping signal %s, "
+		                   "it was previously included.\n",
+		                   fullname);
+		        free(scname);
+		        continue;
+		  } else {
+		        add_var = 1;
+		  }
+		  free(scname);
+	    }
+
+	    dep = draw_scope(item, callh);
+
+	    scan_item(depth, item, 0);
+	      /* The scope list must be sorted after we scan an item.  */
+	    vcd_names_sort(&vcd_tab);
+
+	    while (dep--) print_header("$upscope $end\n");
+
+	      /* Add this signal to the variable list so we can verify it
+	       * is not included twice. This must be done after it has
+	       * been added */
+	    if (add_var) {
+		  vcd_names_add(&vcd_var, vpi_get_str(vpiFullName, item));
+		  vcd_names_sort(&vcd_var);
+	    }
+      }
+}
@@ -32,10 +32,16 @@
  *
  * $ivlh_{rising,falling}_edge implement the VHDL rising_edge() and
  * falling_edge() system functions.
+ *
+ * When the argument is a simple static signal, tgt-vvp generates a
+ * native ".event vhdl" functor and %evtest instruction instead, so
+ * these implementations are only used for the remaining cases.
  */
 struct monitor_data {
       struct t_vpi_time last_event;
       struct t_vpi_value last_value;
+	/* The value before the last change, the VHDL 'last_value. */
+      PLI_INT32 prev_scalar;
 };
 
 static struct monitor_data **mdata = 0;
@@ -86,6 +92,7 @@ static PLI_INT32 monitor_events(struct t_cb_data*cb)
       assert(cb->time->type == vpiSimTime);
 
       mon->last_event = *(cb->time);
+      mon->prev_scalar = mon->last_value.value.scalar;
       mon->last_value = *(cb->value);
 
       return 0;
@@ -116,7 +123,10 @@ static PLI_INT32 ivlh_attribute_event_compiletf(ICARUS_VPI_CONST PLI_BYTE8*data)
       arg = vpi_scan(argv);
       assert(arg);
 
-      mon = malloc(sizeof(struct monitor_data));
+      mon = calloc(1, sizeof(struct monitor_data));
+      mon->last_value.format = vpiScalarVal;
+      mon->last_value.value.scalar = vpiX;
+      mon->prev_scalar = vpiX;
 	/* Add this to the list of data. */
       mdata_count += 1;
       mdata = (struct monitor_data **) realloc(mdata,
@@ -176,10 +186,13 @@ static PLI_INT32 ivlh_attribute_event_calltf(ICARUS_VPI_CONST PLI_BYTE8*data)
 	    if (mon->last_event.low != tnow.low)
 		  rval.value.scalar = vpi0;
 
-	    // Determine the edge, if required
-	    if (type == RISING_EDGE && mon->last_value.value.scalar != vpi1)
+	    // Determine the edge, if required. Like the VHDL functions,
+	    // an edge needs both the old and the new value to be 0/1.
+	    if (type == RISING_EDGE && (mon->last_value.value.scalar != vpi1
+					|| mon->prev_scalar != vpi0))
 		  rval.value.scalar = vpi0;
-	    else if (type == FALLING_EDGE && mon->last_value.value.scalar != vpi0)
+	    else if (type == FALLING_EDGE && (mon->last_value.value.scalar != vpi0
+					      || mon->prev_scalar != vpi1))
 		  rval.value.scalar = vpi0;
       }
 
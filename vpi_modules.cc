@@ -124,6 +124,10 @@ void        vpip_format_strength(char*, s_vpi_value*, unsigned) { }
 void        vpip_make_systf_system_defined(vpiHandle) { }
 void        vpip_mcd_rawwrite(PLI_UINT32, const char*, size_t) { }
 void        vpip_set_return_value(int) { }
+long*       vpip_random_seed(void) { static long seed = 0; return &seed; }
+long*       vpip_urandom_seed(void) { static long seed = 0; return &seed; }
+double      vpip_random_uniform(long*, long, long) { return 0.0; }
+long        vpip_dist_uniform(long*, long start, long) { return start; }
 void        vpi_vcontrol(PLI_INT32, va_list) { }
 
 
@@ -225,6 +229,10 @@ vpip_routines_s vpi_routines = {
     .make_systf_system_defined  = vpip_make_systf_system_defined,
     .mcd_rawwrite               = vpip_mcd_rawwrite,
     .set_return_value           = vpip_set_return_value,
+    .random_seed                = vpip_random_seed,
+    .urandom_seed               = vpip_urandom_seed,
+    .random_uniform             = vpip_random_uniform,
+    .dist_uniform               = vpip_dist_uniform,
 };
 
 typedef PLI_UINT32 (*vpip_set_callback_t)(vpip_routines_s*, PLI_UINT32);
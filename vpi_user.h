@@ -297,10 +297,15 @@ typedef struct t_vpi_delay  {
 #define vpiSysFuncCall 56
 #define vpiSysTaskCall 57
 #define vpiTask        59
+#define vpiTchk        61
+#define vpiTchkTerm    62
 #define vpiTimeVar     63
 #define vpiUdpDefn     66
 #define vpiUserSystf   67
 #define vpiNetArray   114
+#define vpiTchkDataTerm 75
+#define vpiTchkNotifier 76
+#define vpiTchkRefTerm 77
 #define vpiIndex       78
 #define vpiLeftRange   79
 #define vpiParent      81
@@ -373,6 +378,19 @@ typedef struct t_vpi_delay  {
 #   define vpiPosedge      (vpiEdgex1|vpiEdge01|vpiEdge0x)
 #   define vpiNegedge      (vpiEdgex0|vpiEdge10|vpiEdge1x)
 #   define vpiAnyEdge      (vpiPosedge|vpiNegedge)
+#define vpiTchkType      38
+#   define vpiSetup        1
+#   define vpiHold         2
+#   define vpiPeriod       3
+#   define vpiWidth        4
+#   define vpiSkew         5
+#   define vpiRecovery     6
+#   define vpiNoChange     7
+#   define vpiSetupHold    8
+#   define vpiFullskew     9
+#   define vpiRecrem      10
+#   define vpiRemoval     11
+#   define vpiTimeskew    12
 #define vpiConstType 40
 #   define vpiDecConst    1
 #   define vpiRealConst   2
@@ -405,6 +423,8 @@ typedef struct t_vpi_delay  {
 #  define _vpiDelaySelMaximum 3
 /* used in vvp/vpi_priv.h  0x1000003 */
 /* used in vvp/vpi_priv.h  0x1000004 */
+/* IVL private object type, iterate with vpi_iterate(_vpiPerfCounter, 0) */
+#define _vpiPerfCounter    0x1000005
 
 /* DELAY MODES */
 #define vpiNoDelay            1
@@ -644,6 +664,21 @@ extern void vpip_set_return_value(int value);
 extern s_vpi_vecval vpip_calc_clog2(vpiHandle arg);
 extern void vpip_make_systf_system_defined(vpiHandle ref);
 
+  /* Return the generator state of the unseeded $random calls and of
+     the $urandom and $urandom_range calls. vvp uses the same state
+     for its native versions of these functions, so they all draw
+     from one stream. */
+extern long*vpip_random_seed(void);
+extern long*vpip_urandom_seed(void);
+
+  /* The IEEE1364-2001 uniform generator that $random, $urandom and
+     the $dist_* functions are built on. vpip_random_uniform returns
+     a real value in the range start..end, and vpip_dist_uniform is
+     the integer $dist_uniform algorithm. vvp uses the same routines
+     for its native versions of $random and $urandom. */
+extern double vpip_random_uniform(long*seed, long start, long end);
+extern long vpip_dist_uniform(long*seed, long start, long end);
+
   /* Perform fwrite to mcd files. This is used to write raw data,
      which may include nulls. */
 extern void vpip_mcd_rawwrite(PLI_UINT32 mcd, const char*buf, size_t count);
@@ -688,7 +723,7 @@ extern void vpip_count_drivers(vpiHandle ref, unsigned idx,
  */
 
 // Increment the version number any time vpip_routines_s is changed.
-static const PLI_UINT32 vpip_routines_version = 1;
+static const PLI_UINT32 vpip_routines_version = 2;
 
 typedef struct {
     vpiHandle   (*register_cb)(p_cb_data);
@@ -729,6 +764,10 @@ typedef struct {
     void        (*make_systf_system_defined)(vpiHandle);
     void        (*mcd_rawwrite)(PLI_UINT32, const char*, size_t);
     void        (*set_return_value)(int);
+    long*       (*random_seed)(void);
+    long*       (*urandom_seed)(void);
+    double      (*random_uniform)(long*, long, long);
+    long        (*dist_uniform)(long*, long, long);
 } vpip_routines_s;
 
 extern DLLEXPORT PLI_UINT32 vpip_set_callback(vpip_routines_s*routines, PLI_UINT32 version);
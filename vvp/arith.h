@@ -35,7 +35,8 @@
 class vvp_arith_  : public vvp_net_fun_t {
 
     public:
-      explicit vvp_arith_(unsigned wid);
+      explicit vvp_arith_(unsigned wid,
+			  vvp_send_memo::kind_t kind =vvp_send_memo::ARITH);
 
       void recv_vec4_pv(vvp_net_ptr_t ptr, const vvp_vector4_t&bit,
 			unsigned base, unsigned wid, unsigned vwid,
@@ -51,6 +52,8 @@ class vvp_arith_  : public vvp_net_fun_t {
       vvp_vector4_t op_b_;
 	// Precalculated X result for propagation.
       vvp_vector4_t x_val_;
+	// The last output sent.
+      vvp_send_memo memo_;
 };
 
 class vvp_arith_abs : public vvp_net_fun_t {
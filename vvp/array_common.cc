@@ -20,6 +20,50 @@
  */
 
 #include "array_common.h"
+#include "slab.h"
+#ifdef CHECK_WITH_VALGRIND
+#include "vvp_cleanup.h"
+#endif
+
+/*
+ * VPI code that walks arrays makes and frees an iterator for each
+ * walk, and an index iterator for each word, so keep them in slabs.
+ */
+static const size_t ARRAY_ITER_CHUNK_COUNT = 8192 / sizeof(struct __vpiArrayIterator);
+static slab_t<sizeof(__vpiArrayIterator),ARRAY_ITER_CHUNK_COUNT> array_iter_heap;
+
+void* __vpiArrayIterator::operator new(size_t size)
+{
+      assert(size == sizeof(__vpiArrayIterator));
+      return array_iter_heap.alloc_slab();
+}
+
+void __vpiArrayIterator::operator delete(void*ptr)
+{
+      array_iter_heap.free_slab(ptr);
+}
+
+static const size_t ARRAY_INDEX_CHUNK_COUNT = 8192 / sizeof(struct __vpiArrayIndex);
+static slab_t<sizeof(__vpiArrayIndex),ARRAY_INDEX_CHUNK_COUNT> array_index_heap;
+
+void* __vpiArrayIndex::operator new(size_t size)
+{
+      assert(size == sizeof(__vpiArrayIndex));
+      return array_index_heap.alloc_slab();
+}
+
+void __vpiArrayIndex::operator delete(void*ptr)
+{
+      array_index_heap.free_slab(ptr);
+}
+
+#ifdef CHECK_WITH_VALGRIND
+void array_iterator_pool_delete(void)
+{
+      array_iter_heap.delete_pool();
+      array_index_heap.delete_pool();
+}
+#endif
 
 vpiHandle __vpiArrayBase::vpi_array_base_iterate(int code)
 {
@@ -37,21 +81,73 @@ vpiHandle __vpiArrayBase::vpi_array_base_iterate(int code)
     return 0;
 }
 
-void __vpiArrayBase::make_vals_words()
+/*
+ * The word handles are made a page at a time, so that VPI code that
+ * looks at a few words of a large memory does not pay for a handle
+ * for every word. The page table can grow, because a dynamic array
+ * can, but the pages themselves never move, so a handle stays good.
+ */
+static const unsigned WORD_PAGE_SIZE = 256;
+
+vpiHandle __vpiArrayBase::get_word_handle(unsigned idx)
 {
-    assert(vals_words == 0);
-    vals_words = new struct __vpiArrayWord[get_size() + 1];
+	// A small static array gets a single page that just fits. A
+	// dynamic array or queue may grow, so it always gets full size
+	// pages, whatever its size when the first handle is made.
+      if (word_page_size_ == 0) {
+	    word_page_size_ = WORD_PAGE_SIZE;
+	    if (fixed_size() && get_size() < WORD_PAGE_SIZE)
+		  word_page_size_ = get_size();
+	    assert(word_page_size_ > 0);
+      }
 
-    // Make word[-1] point to the parent.
-    vals_words->parent = this;
-    // Now point to word-0
-    vals_words += 1;
+      unsigned page = idx / word_page_size_;
+      if (page >= word_page_count_) {
+	    unsigned count = (get_size() + word_page_size_ - 1) / word_page_size_;
+	    if (count <= page)
+		  count = page + 1;
 
-    struct __vpiArrayWord*words = vals_words;
-    for (unsigned idx = 0 ; idx < get_size() ; idx += 1) {
-            words[idx].word0 = words;
-    }
+	    struct __vpiArrayWord**tmp = new struct __vpiArrayWord*[count];
+	    for (unsigned pdx = 0 ; pdx < count ; pdx += 1)
+		  tmp[pdx] = pdx < word_page_count_? word_pages_[pdx] : 0;
+
+	    delete[]word_pages_;
+	    word_pages_ = tmp;
+	    word_page_count_ = count;
+      }
+
+      struct __vpiArrayWord*words = word_pages_[page];
+      if (words == 0) {
+	    words = new struct __vpiArrayWord[word_page_size_ + 2];
+
+	      // Make word[-2] hold the index of the page and word[-1]
+	      // point to the parent.
+	    words[0].page_base = page * word_page_size_;
+	    words[1].parent = this;
+	      // Now point to word-0
+	    words += 2;
+
+	    for (unsigned wdx = 0 ; wdx < word_page_size_ ; wdx += 1)
+		  words[wdx].word0 = words;
+
+	    word_pages_[page] = words;
+      }
+
+      return &(words[idx % word_page_size_].as_word);
+}
+
+#ifdef CHECK_WITH_VALGRIND
+void __vpiArrayBase::delete_word_handles(void)
+{
+      for (unsigned idx = 0 ; idx < word_page_count_ ; idx += 1) {
+	    if (word_pages_[idx])
+		  delete [] (word_pages_[idx]-2);
+      }
+      delete[]word_pages_;
+      word_pages_ = 0;
+      word_page_count_ = 0;
 }
+#endif
 
 vpiHandle __vpiArrayIterator::vpi_index(int)
 {
@@ -31,6 +31,9 @@ struct __vpiArrayIterator : public __vpiHandle {
       vpiHandle vpi_index(int idx);
       free_object_fun_t free_object_fun(void);
 
+      static void* operator new(size_t);
+      static void operator delete(void*);
+
       struct __vpiArrayBase*array;
       unsigned next;
 };
@@ -43,6 +46,9 @@ struct __vpiArrayIndex : public __vpiHandle {
       vpiHandle vpi_index(int idx);
       free_object_fun_t free_object_fun(void);
 
+      static void* operator new(size_t);
+      static void operator delete(void*);
+
       __vpiDecConst *index;
       unsigned done;
 };
@@ -54,11 +60,12 @@ struct __vpiArrayIndex : public __vpiHandle {
  * the vpi methods and to point to the parent.
  *
  * How the point to the parent works is tricky. The vpiArrayWord
- * objects for an array are themselves allocated as an array. All the
- * ArrayWord objects in the array have a word0 that points to the base
- * of the array. Thus, the position into the array (and the index into
- * the memory) is calculated by subtracting word0 from the ArrayWord
- * pointer.
+ * objects for an array are allocated in pages, each page itself an
+ * array, and a page is only made when VPI code first asks for one of
+ * its words. All the ArrayWord objects in a page have a word0 that
+ * points to the base of the page. Thus, the position into the page is
+ * calculated by subtracting word0 from the ArrayWord pointer, and the
+ * index into the memory is that plus word0[-2].page_base.
  *
  * To then get to the parent, use word0[-1].parent.
  *
@@ -86,9 +93,11 @@ struct __vpiArrayWord {
       union {
 	    struct __vpiArrayBase*parent;
 	    struct __vpiArrayWord*word0;
+	    unsigned page_base;
       };
 
-      inline unsigned get_index() const { return this - word0; }
+      inline unsigned get_index() const
+      { return (this - word0) + (word0 - 2)->page_base; }
       inline struct __vpiArrayBase*get_parent() const { return (word0 - 1)->parent; }
 };
 
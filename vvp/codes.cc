@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2001-2016 Stephen Williams (steve@icarus.com)
+ * Copyright (c) 2001-2026 Stephen Williams (steve@icarus.com)
  *
  *    This source code is free software; you can redistribute it
  *    and/or modify it in source code form under the terms of the GNU
@@ -25,6 +25,10 @@
 #endif
 # include  <cstring>
 # include  <cassert>
+# include  <cstddef>
+# include  <deque>
+# include  <map>
+# include  <vector>
 
 /*
  * The code space is broken into chunks, to make for efficient
@@ -60,6 +64,13 @@ void codespace_init(void)
       size_opcodes += code_chunk_size * sizeof (struct vvp_code_s);
 }
 
+#ifdef CHECK_WITH_VALGRIND
+  // codespace_delete() needs to see all the instructions.
+bool codespace_lazy = false;
+#else
+bool codespace_lazy = true;
+#endif
+
 vvp_code_t codespace_next(void)
 {
       if (current_within_chunk == (code_chunk_size-1)) {
@@ -96,6 +107,188 @@ vvp_code_t codespace_null(void)
       return first_chunk + 0;
 }
 
+/*
+ * While the design is compiled, the instructions of the blocks are
+ * kept in a deque so that they do not move. The linker still needs
+ * to write resolved pointers into them.
+ */
+struct lazy_block_s {
+      vvp_code_t stub;
+      size_t base;
+      size_t count;
+};
+
+static std::deque<vvp_code_s> lazy_staging;
+static std::vector<lazy_block_s> lazy_blocks;
+
+  /* The packed blocks refer to the opcode functions by index. */
+static std::vector<vvp_code_fun> lazy_opcodes;
+
+  /* The operands of an instruction are packed as 32bit words. */
+static const size_t operand_offset = offsetof(vvp_code_s, number);
+static const size_t operand_words = (sizeof(vvp_code_s) - operand_offset) / 4;
+
+static vvp_code_t lazy_new_block(void)
+{
+      vvp_code_t stub = codespace_allocate();
+      count_opcodes -= 1;
+      stub->opcode = &of_DECODE_BLOCK;
+
+      lazy_block_s blk;
+      blk.stub = stub;
+      blk.base = lazy_staging.size();
+      blk.count = 0;
+      lazy_blocks.push_back(blk);
+      count_code_blocks += 1;
+
+      return stub;
+}
+
+vvp_code_t codespace_label(void)
+{
+      if (! codespace_lazy)
+	    return codespace_next();
+
+	/* A label with no code before the next label is an alias. */
+      if (! lazy_blocks.empty() && lazy_blocks.back().count == 0)
+	    return lazy_blocks.back().stub;
+
+      return lazy_new_block();
+}
+
+vvp_code_t codespace_instr(void)
+{
+      if (! codespace_lazy)
+	    return codespace_allocate();
+
+      if (lazy_blocks.empty())
+	    lazy_new_block();
+
+      lazy_staging.push_back(vvp_code_s());
+      vvp_code_t res = &lazy_staging.back();
+      memset(res, 0, sizeof(*res));
+
+      lazy_blocks.back().count += 1;
+      count_opcodes += 1;
+
+      return res;
+}
+
+static void put_varint(std::vector<uint8_t>&buf, uint32_t val)
+{
+      while (val >= 0x80) {
+	    buf.push_back((val & 0x7f) | 0x80);
+	    val >>= 7;
+      }
+      buf.push_back(val);
+}
+
+static uint32_t get_varint(const uint8_t*&ptr)
+{
+      uint32_t val = 0;
+      unsigned shift = 0;
+      while (*ptr & 0x80) {
+	    val |= (uint32_t)(*ptr++ & 0x7f) << shift;
+	    shift += 7;
+      }
+      val |= (uint32_t)(*ptr++) << shift;
+      return val;
+}
+
+/*
+ * Pack each block as the instruction count followed by the opcode
+ * index and the operand words of each instruction. Small numbers and
+ * the zero upper halves of pointers take a byte each. The stub keeps
+ * the packed block and the address of the block that follows it.
+ */
+void codespace_pack(void)
+{
+      if (! codespace_lazy)
+	    return;
+
+      assert(operand_offset + 4*operand_words == sizeof(vvp_code_s));
+
+      std::map<vvp_code_fun,uint32_t> opcode_index;
+      std::vector<uint8_t> buf;
+
+      for (size_t idx = 0 ;  idx < lazy_blocks.size() ;  idx += 1) {
+	    lazy_block_s&blk = lazy_blocks[idx];
+
+	    buf.clear();
+	    put_varint(buf, blk.count);
+	    for (size_t cnt = 0 ;  cnt < blk.count ;  cnt += 1) {
+		  const vvp_code_s&code = lazy_staging[blk.base+cnt];
+
+		  std::map<vvp_code_fun,uint32_t>::iterator cur
+			= opcode_index.find(code.opcode);
+		  if (cur == opcode_index.end()) {
+			cur = opcode_index.insert(std::make_pair(code.opcode,
+						  (uint32_t)lazy_opcodes.size())).first;
+			lazy_opcodes.push_back(code.opcode);
+		  }
+		  put_varint(buf, cur->second);
+
+		  const char*raw = reinterpret_cast<const char*>(&code);
+		  for (size_t wrd = 0 ;  wrd < operand_words ;  wrd += 1) {
+			uint32_t tmp;
+			memcpy(&tmp, raw + operand_offset + 4*wrd, 4);
+			put_varint(buf, tmp);
+		  }
+	    }
+
+	    blk.stub->packed = new uint8_t[buf.size()];
+	    memcpy(blk.stub->packed, &buf[0], buf.size());
+	    size_opcodes_packed += buf.size();
+
+	    if (idx+1 < lazy_blocks.size())
+		  blk.stub->cptr2 = lazy_blocks[idx+1].stub;
+	    else
+		  blk.stub->cptr2 = codespace_null();
+      }
+
+      std::deque<vvp_code_s>().swap(lazy_staging);
+      std::vector<lazy_block_s>().swap(lazy_blocks);
+}
+
+void codespace_decode(vvp_code_t stub)
+{
+      assert(stub->opcode == &of_DECODE_BLOCK);
+
+      const uint8_t*ptr = stub->packed;
+      size_t count = get_varint(ptr);
+
+      vvp_code_t block = new struct vvp_code_s [count+1];
+      memset(block, 0, (count+1) * sizeof(struct vvp_code_s));
+
+      for (size_t cnt = 0 ;  cnt < count ;  cnt += 1) {
+	    block[cnt].opcode = lazy_opcodes[get_varint(ptr)];
+
+	    char*raw = reinterpret_cast<char*>(block+cnt);
+	    for (size_t wrd = 0 ;  wrd < operand_words ;  wrd += 1) {
+		  uint32_t tmp = get_varint(ptr);
+		  memcpy(raw + operand_offset + 4*wrd, &tmp, 4);
+	    }
+      }
+
+	/* Fall through to the next block. Skip its stub if that block
+	   is already decoded. */
+      vvp_code_t next = stub->cptr2;
+      if (next->opcode == &of_CHUNK_LINK)
+	    next = next->cptr;
+      block[count].opcode = &of_CHUNK_LINK;
+      block[count].cptr = next;
+
+      size_opcodes_packed -= ptr - stub->packed;
+      delete[] stub->packed;
+
+      stub->opcode = &of_CHUNK_LINK;
+      stub->cptr = block;
+
+      count_code_blocks_decoded += 1;
+      count_opcodes_decoded += count;
+      size_opcodes += (count+1) * sizeof(struct vvp_code_s);
+}
+
 #ifdef CHECK_WITH_VALGRIND
 void codespace_delete(void)
 {
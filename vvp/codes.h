@@ -1,7 +1,7 @@
 #ifndef IVL_codes_H
 #define IVL_codes_H
 /*
- * Copyright (c) 2001-2020 Stephen Williams (steve@icarus.com)
+ * Copyright (c) 2001-2026 Stephen Williams (steve@icarus.com)
  *
  *    This source code is free software; you can redistribute it
  *    and/or modify it in source code form under the terms of the GNU
@@ -33,6 +33,7 @@ typedef bool (*vvp_code_fun)(vthread_t thr, vvp_code_t code);
  */
 extern bool of_ABS_WR(vthread_t thr, vvp_code_t code);
 extern bool of_ADD(vthread_t thr, vvp_code_t code);
+extern bool of_ADD_2(vthread_t thr, vvp_code_t code);
 extern bool of_ADD_WR(vthread_t thr, vvp_code_t code);
 extern bool of_ADDI(vthread_t thr, vvp_code_t code);
 extern bool of_ALLOC(vthread_t thr, vvp_code_t code);
@@ -74,9 +75,11 @@ extern bool of_CMPIE(vthread_t thr, vvp_code_t code);
 extern bool of_CMPINE(vthread_t thr, vvp_code_t code);
 extern bool of_CMPNE(vthread_t thr, vvp_code_t code);
 extern bool of_CMPS(vthread_t thr, vvp_code_t code);
+extern bool of_CMPS_2(vthread_t thr, vvp_code_t code);
 extern bool of_CMPIS(vthread_t thr, vvp_code_t code);
 extern bool of_CMPSTR(vthread_t thr, vvp_code_t code);
 extern bool of_CMPU(vthread_t thr, vvp_code_t code);
+extern bool of_CMPU_2(vthread_t thr, vvp_code_t code);
 extern bool of_CMPIU(vthread_t thr, vvp_code_t code);
 extern bool of_CMPWE(vthread_t thr, vvp_code_t code);
 extern bool of_CMPWNE(vthread_t thr, vvp_code_t code);
@@ -105,6 +108,8 @@ extern bool of_DELETE_TAIL(vthread_t thr, vvp_code_t code);
 extern bool of_DISABLE(vthread_t thr, vvp_code_t code);
 extern bool of_DISABLE_FORK(vthread_t thr, vvp_code_t code);
 extern bool of_DIV(vthread_t thr, vvp_code_t code);
+extern bool of_DIV_2(vthread_t thr, vvp_code_t code);
+extern bool of_DIV_2_S(vthread_t thr, vvp_code_t code);
 extern bool of_DIV_S(vthread_t thr, vvp_code_t code);
 extern bool of_DIV_WR(vthread_t thr, vvp_code_t code);
 extern bool of_DUP_REAL(vthread_t thr, vvp_code_t code);
@@ -115,6 +120,7 @@ extern bool of_EVCTL(vthread_t thr, vvp_code_t code);
 extern bool of_EVCTLC(vthread_t thr, vvp_code_t code);
 extern bool of_EVCTLI(vthread_t thr, vvp_code_t code);
 extern bool of_EVCTLS(vthread_t thr, vvp_code_t code);
+extern bool of_EVTEST(vthread_t thr, vvp_code_t code);
 extern bool of_FILE_LINE(vthread_t thr, vvp_code_t code);
 extern bool of_FLAG_GET_VEC4(vthread_t thr, vvp_code_t code);
 extern bool of_FLAG_INV(vthread_t thr, vvp_code_t code);
@@ -144,6 +150,10 @@ extern bool of_JMP0(vthread_t thr, vvp_code_t code);
 extern bool of_JMP0XZ(vthread_t thr, vvp_code_t code);
 extern bool of_JMP1(vthread_t thr, vvp_code_t code);
 extern bool of_JMP1XZ(vthread_t thr, vvp_code_t code);
+extern bool of_JMP0_COV(vthread_t thr, vvp_code_t code);
+extern bool of_JMP0XZ_COV(vthread_t thr, vvp_code_t code);
+extern bool of_JMP1_COV(vthread_t thr, vvp_code_t code);
+extern bool of_JMP1XZ_COV(vthread_t thr, vvp_code_t code);
 extern bool of_JOIN(vthread_t thr, vvp_code_t code);
 extern bool of_JOIN_DETACH(vthread_t thr, vvp_code_t code);
 extern bool of_LOAD_AR(vthread_t thr, vvp_code_t code);
@@ -160,10 +170,13 @@ extern bool of_LOAD_VEC4A(vthread_t thr, vvp_code_t code);
 extern bool of_MAX_WR(vthread_t thr, vvp_code_t code);
 extern bool of_MIN_WR(vthread_t thr, vvp_code_t code);
 extern bool of_MOD(vthread_t thr, vvp_code_t code);
+extern bool of_MOD_2(vthread_t thr, vvp_code_t code);
+extern bool of_MOD_2_S(vthread_t thr, vvp_code_t code);
 extern bool of_MOD_S(vthread_t thr, vvp_code_t code);
 extern bool of_MOD_WR(vthread_t thr, vvp_code_t code);
 extern bool of_MOV_WU(vthread_t thr, vvp_code_t code);
 extern bool of_MUL(vthread_t thr, vvp_code_t code);
+extern bool of_MUL_2(vthread_t thr, vvp_code_t code);
 extern bool of_MULI(vthread_t thr, vvp_code_t code);
 extern bool of_MUL_WR(vthread_t thr, vvp_code_t code);
 extern bool of_NAND(vthread_t thr, vvp_code_t code);
@@ -254,10 +267,19 @@ extern bool of_STORE_STRA(vthread_t thr, vvp_code_t code);
 extern bool of_STORE_VEC4(vthread_t thr, vvp_code_t code);
 extern bool of_STORE_VEC4A(vthread_t thr, vvp_code_t code);
 extern bool of_SUB(vthread_t thr, vvp_code_t code);
+extern bool of_SUB_2(vthread_t thr, vvp_code_t code);
 extern bool of_SUBI(vthread_t thr, vvp_code_t code);
 extern bool of_SUB_WR(vthread_t thr, vvp_code_t code);
 extern bool of_SUBSTR(vthread_t thr, vvp_code_t code);
 extern bool of_SUBSTR_VEC4(vthread_t thr, vvp_code_t code);
+extern bool of_SYS_COUNTONES(vthread_t thr, vvp_code_t code);
+extern bool of_SYS_ISUNKNOWN(vthread_t thr, vvp_code_t code);
+extern bool of_SYS_ONEHOT(vthread_t thr, vvp_code_t code);
+extern bool of_SYS_RANDOM(vthread_t thr, vvp_code_t code);
+extern bool of_SYS_REALTIME(vthread_t thr, vvp_code_t code);
+extern bool of_SYS_TIME(vthread_t thr, vvp_code_t code);
+extern bool of_SYS_URANDOM(vthread_t thr, vvp_code_t code);
+extern bool of_SYS_URANDOM_RANGE(vthread_t thr, vvp_code_t code);
 extern bool of_TEST_NUL(vthread_t thr, vvp_code_t code);
 extern bool of_TEST_NUL_A(vthread_t thr, vvp_code_t code);
 extern bool of_TEST_NUL_OBJ(vthread_t thr, vvp_code_t code);
@@ -277,6 +299,7 @@ extern bool of_EXEC_UFUNC_VEC4(vthread_t thr, vvp_code_t code);
 extern bool of_REAP_UFUNC(vthread_t thr, vvp_code_t code);
 
 extern bool of_CHUNK_LINK(vthread_t thr, vvp_code_t code);
+extern bool of_DECODE_BLOCK(vthread_t thr, vvp_code_t code);
 
 /*
  * This is the format of a machine code instruction.
@@ -292,6 +315,7 @@ struct vvp_code_s {
 	    class __vpiHandle*handle;
 	    __vpiScope*scope;
 	    const char*text;
+	    uint8_t*packed;
       };
 
       union {
@@ -320,4 +344,23 @@ extern vvp_code_t codespace_allocate(void);
 extern vvp_code_t codespace_next(void);
 extern vvp_code_t codespace_null(void);
 
+/*
+ * The compiler places the thread code with these functions. When the
+ * code space is lazy (the default) each label starts a basic block,
+ * and the label address is a stub instruction for the block. After
+ * the code is linked, codespace_pack() packs the instructions of each
+ * block into a compact byte string and frees the full instructions.
+ * The first time a thread runs into the stub, codespace_decode()
+ * turns the block back into instructions, and the stub becomes a
+ * link to them. Code that never runs is never decoded.
+ *
+ * If codespace_lazy is false, these are the same as codespace_next()
+ * and codespace_allocate().
+ */
+extern bool codespace_lazy;
+extern vvp_code_t codespace_label(void);
+extern vvp_code_t codespace_instr(void);
+extern void codespace_pack(void);
+extern void codespace_decode(vvp_code_t stub);
+
 #endif /* IVL_codes_H */
@@ -31,6 +31,8 @@
 # include  "vpi_priv.h"
 # include  "parse_misc.h"
 # include  "statistics.h"
+# include  "coverage.h"
+# include  "partition.h"
 # include  "schedule.h"
 # include  <iostream>
 # include  <list>
@@ -87,6 +89,7 @@ struct opcode_table_s {
 static const struct opcode_table_s opcode_table[] = {
       { "%abs/wr", of_ABS_WR, 0,  {OA_NONE,     OA_NONE,     OA_NONE} },
       { "%add",    of_ADD,    0,  {OA_NONE,     OA_NONE,     OA_NONE} },
+      { "%add/2",  of_ADD_2,  0,  {OA_NONE,     OA_NONE,     OA_NONE} },
       { "%add/wr", of_ADD_WR, 0,  {OA_NONE,     OA_NONE,     OA_NONE} },
       { "%addi",   of_ADDI,   3,  {OA_BIT1,     OA_BIT2,     OA_NUMBER} },
       { "%alloc",  of_ALLOC,  1,  {OA_VPI_PTR,  OA_NONE,     OA_NONE} },
@@ -121,6 +124,8 @@ static const struct opcode_table_s opcode_table[] = {
       { "%cast/vec4/dar", of_CAST_VEC4_DAR, 1,  {OA_NUMBER,   OA_NONE,     OA_NONE} },
       { "%cast/vec4/str", of_CAST_VEC4_STR, 1,  {OA_NUMBER,   OA_NONE,     OA_NONE} },
       { "%cast2",   of_CAST2,  0,  {OA_NONE,     OA_NONE,     OA_NONE} },
+      { "%cmp/2/s", of_CMPS_2, 0,  {OA_NONE,     OA_NONE,     OA_NONE} },
+      { "%cmp/2/u", of_CMPU_2, 0,  {OA_NONE,     OA_NONE,     OA_NONE} },
       { "%cmp/e",   of_CMPE,   0,  {OA_NONE,     OA_NONE,     OA_NONE} },
       { "%cmp/ne",  of_CMPNE,  0,  {OA_NONE,     OA_NONE,     OA_NONE} },
       { "%cmp/s",   of_CMPS,   0,  {OA_NONE,     OA_NONE,     OA_NONE} },
@@ -157,6 +162,8 @@ static const struct opcode_table_s opcode_table[] = {
       { "%disable",  of_DISABLE, 1, {OA_VPI_PTR,OA_NONE,     OA_NONE} },
       { "%disable/fork",of_DISABLE_FORK,0,{OA_NONE,OA_NONE,  OA_NONE} },
       { "%div",      of_DIV,     0, {OA_NONE,   OA_NONE,     OA_NONE} },
+      { "%div/2",    of_DIV_2,   0, {OA_NONE,   OA_NONE,     OA_NONE} },
+      { "%div/2/s",  of_DIV_2_S, 0, {OA_NONE,   OA_NONE,     OA_NONE} },
       { "%div/s",    of_DIV_S,   0, {OA_NONE,   OA_NONE,     OA_NONE} },
       { "%div/wr",   of_DIV_WR,  0, {OA_NONE,   OA_NONE,     OA_NONE} },
       { "%dup/real", of_DUP_REAL,0, {OA_NONE,   OA_NONE,     OA_NONE} },
@@ -167,6 +174,7 @@ static const struct opcode_table_s opcode_table[] = {
       { "%evctl/i",of_EVCTLI, 2,  {OA_FUNC_PTR, OA_BIT1,     OA_NONE} },
       { "%evctl/s",of_EVCTLS, 2,  {OA_FUNC_PTR, OA_BIT1,     OA_NONE} },
       { "%event",  of_EVENT,  1,  {OA_FUNC_PTR, OA_NONE,     OA_NONE} },
+      { "%evtest", of_EVTEST, 2,  {OA_FUNC_PTR, OA_BIT1,     OA_NONE} },
       { "%flag_get/vec4", of_FLAG_GET_VEC4, 1, {OA_NUMBER, OA_NONE, OA_NONE} },
       { "%flag_inv",      of_FLAG_INV,      1, {OA_BIT1,   OA_NONE, OA_NONE} },
       { "%flag_mov",      of_FLAG_MOV,      2, {OA_BIT1,   OA_BIT2, OA_NONE} },
@@ -211,10 +219,13 @@ static const struct opcode_table_s opcode_table[] = {
       { "%max/wr", of_MAX_WR, 0,  {OA_NONE,     OA_NONE,     OA_NONE} },
       { "%min/wr", of_MIN_WR, 0,  {OA_NONE,     OA_NONE,     OA_NONE} },
       { "%mod",    of_MOD,    0,  {OA_NONE,     OA_NONE,     OA_NONE} },
+      { "%mod/2",  of_MOD_2,  0,  {OA_NONE,     OA_NONE,     OA_NONE} },
+      { "%mod/2/s",of_MOD_2_S,0,  {OA_NONE,     OA_NONE,     OA_NONE} },
       { "%mod/s",  of_MOD_S,  0,  {OA_NONE,     OA_NONE,     OA_NONE} },
       { "%mod/wr", of_MOD_WR, 0,  {OA_NONE,     OA_NONE,     OA_NONE} },
       { "%mov/wu", of_MOV_WU, 2,  {OA_BIT1,     OA_BIT2,     OA_NONE} },
       { "%mul",    of_MUL,    0,  {OA_NONE,     OA_NONE,     OA_NONE} },
+      { "%mul/2",  of_MUL_2,  0,  {OA_NONE,     OA_NONE,     OA_NONE} },
       { "%mul/wr", of_MUL_WR, 0,  {OA_NONE,     OA_NONE,     OA_NONE} },
       { "%muli",   of_MULI,   3,  {OA_BIT1,     OA_BIT2,     OA_NUMBER} },
       { "%nand",   of_NAND,   0,  {OA_NONE,     OA_NONE,     OA_NONE} },
@@ -304,10 +315,19 @@ static const struct opcode_table_s opcode_table[] = {
       { "%store/vec4",    of_STORE_VEC4,    3, {OA_FUNC_PTR,OA_BIT1, OA_BIT2} },
       { "%store/vec4a",   of_STORE_VEC4A,   3, {OA_ARR_PTR, OA_BIT1, OA_BIT2} },
       { "%sub",    of_SUB,    0,  {OA_NONE,     OA_NONE,     OA_NONE} },
+      { "%sub/2",  of_SUB_2,  0,  {OA_NONE,     OA_NONE,     OA_NONE} },
       { "%sub/wr", of_SUB_WR, 0,  {OA_NONE,     OA_NONE,     OA_NONE} },
       { "%subi",   of_SUBI,   3,  {OA_BIT1,     OA_BIT2,     OA_NUMBER} },
       { "%substr",     of_SUBSTR,     2,{OA_BIT1,    OA_BIT2, OA_NONE} },
       { "%substr/vec4",of_SUBSTR_VEC4,2,{OA_BIT1,    OA_BIT2, OA_NONE} },
+      { "%sys/countones",    of_SYS_COUNTONES,    0,{OA_NONE,  OA_NONE, OA_NONE} },
+      { "%sys/isunknown",    of_SYS_ISUNKNOWN,    0,{OA_NONE,  OA_NONE, OA_NONE} },
+      { "%sys/onehot",       of_SYS_ONEHOT,       1,{OA_NUMBER,OA_NONE, OA_NONE} },
+      { "%sys/random",       of_SYS_RANDOM,       0,{OA_NONE,  OA_NONE, OA_NONE} },
+      { "%sys/realtime",     of_SYS_REALTIME,     0,{OA_NONE,  OA_NONE, OA_NONE} },
+      { "%sys/time",         of_SYS_TIME,         0,{OA_NONE,  OA_NONE, OA_NONE} },
+      { "%sys/urandom",      of_SYS_URANDOM,      0,{OA_NONE,  OA_NONE, OA_NONE} },
+      { "%sys/urandom_range",of_SYS_URANDOM_RANGE,1,{OA_NUMBER,OA_NONE, OA_NONE} },
       { "%test_nul",     of_TEST_NUL,     1,{OA_FUNC_PTR,OA_NONE,    OA_NONE} },
       { "%test_nul/a",   of_TEST_NUL_A,   2,{OA_ARR_PTR, OA_BIT1,    OA_NONE} },
       { "%test_nul/obj", of_TEST_NUL_OBJ, 0,{OA_NONE,    OA_NONE,    OA_NONE} },
@@ -797,6 +817,10 @@ void compile_cleanup(void)
 
       compile_errors += nerrs;
 
+	/* All the code pointers are resolved, so the code blocks can
+	   be packed away until they are needed. */
+      codespace_pack();
+
       if (verbose_flag) {
 	    fprintf(stderr, " ... Removing symbol tables\n");
 	    fflush(stderr);
@@ -951,14 +975,14 @@ void input_connect(vvp_net_t*fdx, unsigned port, char*label)
 
 	    vvp_vector4_t tmp = c4string_to_vector4(label);
 
-	      // Inputs that are constants are schedule to execute as
-	      // soon at the simulation starts. In Verilog, constants
-	      // start propagating when the simulation starts, just
-	      // like any other signal value. But letting the
-	      // scheduler distribute the constant value has the
-	      // additional advantage that the constant is not
-	      // propagated until the network is fully linked.
-	    schedule_set_vector(ifdx, tmp);
+	      // Inputs that are constants are sent when the
+	      // simulation starts. In Verilog, constants start
+	      // propagating when the simulation starts, just like any
+	      // other signal value. But letting the scheduler
+	      // distribute the constant value has the additional
+	      // advantage that the constant is not propagated until
+	      // the network is fully linked.
+	    schedule_init_constant(ifdx, tmp);
 
 	    free(label);
 	    return;
@@ -968,7 +992,7 @@ void input_connect(vvp_net_t*fdx, unsigned port, char*label)
       if (c8string_test(label)) {
 
 	    vvp_vector8_t tmp = c8string_to_vector8(label);
-	    schedule_set_vector(ifdx, tmp);
+	    schedule_init_constant(ifdx, tmp);
 
 	    free(label);
 	    return;
@@ -980,7 +1004,7 @@ void input_connect(vvp_net_t*fdx, unsigned port, char*label)
 
 	    double tmp = crstring_to_double(label);
 
-	    schedule_set_vector(ifdx, tmp);
+	    schedule_init_constant(ifdx, tmp);
 	    free(label);
 	    return;
       }
@@ -1630,6 +1654,58 @@ void compile_modpath_src(struct __vpiModPath*dst, char edge,
       compile_vpi_lookup(&obj->path_term_in.expr, path_term_in.text);
 }
 
+/*
+ * A .tchk statement creates a timing check functor and its vpiTchk
+ * object in the current scope. The numbers are the reference edge,
+ * the data edge and the two limits. The symbols are the input, the
+ * terminal signal and the condition of the reference event, then the
+ * same for the data event (except for $width and $period), and then
+ * the notifier if there is one.
+ */
+void compile_tchk(char*label, unsigned type, unsigned file_idx,
+		  unsigned lineno, struct numbv_s&vals, struct symbv_s&argv)
+{
+      assert(type <= vvp_fun_tchk::PERIOD);
+      assert(vals.cnt == 4);
+
+      vvp_fun_tchk::type_t use_type = (vvp_fun_tchk::type_t) type;
+      bool has_data = use_type != vvp_fun_tchk::WIDTH
+	    && use_type != vvp_fun_tchk::PERIOD;
+      unsigned nterms = has_data ? 6 : 3;
+      assert(argv.cnt == nterms || argv.cnt == nterms+1);
+
+      vvp_fun_tchk*fun = new vvp_fun_tchk(use_type,
+					  vals.nvec[0], vals.nvec[1],
+					  vals.nvec[2], vals.nvec[3]);
+      numbv_clear(&vals);
+      fun->set_location(vpip_peek_current_scope(), file_idx, lineno);
+
+      vvp_net_t*net = new vvp_net_t;
+      net->fun = fun;
+      define_functor_symbol(label, net);
+      free(label);
+
+      __vpiTchk*obj = vpip_make_tchk(fun);
+
+      input_connect(net, 0, argv.vect[0].text);
+      compile_vpi_lookup(&obj->ref_term.expr, argv.vect[1].text);
+      input_connect(net, 2, argv.vect[2].text);
+
+      if (has_data) {
+	    input_connect(net, 1, argv.vect[3].text);
+	    compile_vpi_lookup(&obj->data_term.expr, argv.vect[4].text);
+	    input_connect(net, 3, argv.vect[5].text);
+      }
+
+      if (argv.cnt > nterms) {
+	    char*notifier = argv.vect[nterms].text;
+	    functor_ref_lookup(fun->notifier_ref(), strdup(notifier));
+	    compile_vpi_lookup(&obj->notifier, notifier);
+      }
+
+      free(argv.vect);
+}
+
 /*
  * A .shift/l statement creates an array of functors for the
  * width. The 0 input is the data vector to be shifted and the 1 input
@@ -1766,7 +1842,7 @@ void compile_code(char*label, char*mnem, comp_operands_t opa)
 
 	/* Build up the code from the information about the opcode and
 	   the information from the compiler. */
-      vvp_code_t code = codespace_allocate();
+      vvp_code_t code = codespace_instr();
       code->opcode = op->opcode;
 
       if (op->argc != (opa? opa->argc : 0)) {
@@ -1877,6 +1953,35 @@ void compile_code(char*label, char*mnem, comp_operands_t opa)
 	    }
       }
 
+	/* The intrinsic $time and $realtime work in the time units of
+	   the module that contains the code, just like the VPI
+	   versions, so bind that scope now. */
+      if (code->opcode == &of_SYS_TIME || code->opcode == &of_SYS_REALTIME) {
+	    __vpiScope*scope = vpip_peek_current_scope();
+	    while (scope->get_type_code() != vpiModule && scope->scope)
+		  scope = scope->scope;
+	    code->scope = scope;
+      }
+
+      coverage_add_code();
+
+	/* A conditional jump in a covered scope is a branch. Swap in
+	   the version of the instruction that counts the decisions. */
+      if (code->opcode == &of_JMP0 || code->opcode == &of_JMP0XZ
+	  || code->opcode == &of_JMP1 || code->opcode == &of_JMP1XZ) {
+	    if (unsigned cnt = coverage_add_branch()) {
+		  code->bit_idx[1] = cnt;
+		  if (code->opcode == &of_JMP0)
+			code->opcode = &of_JMP0_COV;
+		  else if (code->opcode == &of_JMP0XZ)
+			code->opcode = &of_JMP0XZ_COV;
+		  else if (code->opcode == &of_JMP1)
+			code->opcode = &of_JMP1_COV;
+		  else
+			code->opcode = &of_JMP1XZ_COV;
+	    }
+      }
+
       free(opa);
 
       free(mnem);
@@ -1885,7 +1990,7 @@ void compile_code(char*label, char*mnem, comp_operands_t opa)
 void compile_codelabel(char*label)
 {
       symbol_value_t val;
-      vvp_code_t ptr = codespace_next();
+      vvp_code_t ptr = codespace_label();
 
       val.ptr = ptr;
       sym_set_value(sym_codespace, label, val);
@@ -1899,13 +2004,16 @@ void compile_file_line(char*label, long file_idx, long lineno,
       if (label) compile_codelabel(label);
 
 	/* Create an instruction in the code space. */
-      vvp_code_t code = codespace_allocate();
+      vvp_code_t code = codespace_instr();
       code->opcode = &of_FILE_LINE;
 
 	/* Create a vpiHandle that contains the information. */
       code->handle = vpip_build_file_line(description, file_idx, lineno);
       assert(code->handle);
 
+	/* If this scope is covered, then count the statement. */
+      code->bit_idx[0] = coverage_add_line(file_idx, lineno);
+
 	/* Done with the lexor-allocated name string. */
       delete[] description;
 }
@@ -1920,7 +2028,7 @@ void compile_vpi_call(char*label, char*name,
 	    compile_codelabel(label);
 
 	/* Create an instruction in the code space. */
-      vvp_code_t code = codespace_allocate();
+      vvp_code_t code = codespace_instr();
       code->opcode = &of_VPI_CALL;
 
 	/* Create a vpiHandle that bundles the call information, and
@@ -1948,7 +2056,7 @@ void compile_vpi_func_call(char*label, char*name,
 	    compile_codelabel(label);
 
 	/* Create an instruction in the code space. */
-      vvp_code_t code = codespace_allocate();
+      vvp_code_t code = codespace_instr();
       code->opcode = &of_VPI_CALL;
 
 	/* Create a vpiHandle that bundles the call information, and
@@ -1985,8 +2093,15 @@ void compile_thread(char*start_sym, char*flag)
 
       vthread_t thr = vthread_new(pc, vpip_peek_current_scope());
 
+	/* In a distributed simulation the thread only runs in the
+	   process of its partition, and that is not known until the
+	   processes are started. The variable initializations run in
+	   every process. */
       if (flag && (strcmp(flag,"$init") == 0))
 	    schedule_init_vthread(thr);
+      else if (partition_enabled)
+	    partition_add_thread(thr, vpip_peek_current_scope(), push_flag,
+				 flag && (strcmp(flag,"$final") == 0));
       else if (flag && (strcmp(flag,"$final") == 0))
 	    schedule_final_vthread(thr);
       else
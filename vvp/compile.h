@@ -238,6 +238,16 @@ extern void compile_enum2_type(char*label, long width, bool signed_flag,
 extern void compile_enum4_type(char*label, long width, bool signed_flag,
 			      std::list<struct enum_name_s>*names);
 
+/*
+ * A .boundary carries a net from the driver partition to the receiver
+ * partitions. The input is the delayed output of the driver and the
+ * source is the value before the driver delay.
+ */
+extern void compile_boundary(char*label, unsigned driver,
+			     struct numbv_s receivers,
+			     vvp_delay_t*delay, struct symb_s input,
+			     struct symb_s source);
+
 struct __vpiModPath;
 extern __vpiModPath* compile_modpath(char*label,
                                      unsigned width,
@@ -257,6 +267,10 @@ extern void compile_modpath_src(__vpiModPath*dst,
 				const struct symb_s&path_term_in,
 				bool ifnone);
 
+extern void compile_tchk(char*label, unsigned type, unsigned file_idx,
+			 unsigned lineno, struct numbv_s&vals,
+			 struct symbv_s&argv);
+
 extern void compile_reduce_and(char*label, const struct symb_s&arg);
 extern void compile_reduce_or(char*label, const struct symb_s&arg);
 extern void compile_reduce_xor(char*label, const struct symb_s&arg);
@@ -280,6 +294,7 @@ extern void compile_shiftr(char*label, long width, bool signed_flag,
 			   unsigned argc, struct symb_s*argv);
 
 extern void compile_timescale(long units, long precision);
+extern void compile_partition(long part);
 
 extern void compile_vpi_symbol(const char*label, vpiHandle obj);
 extern void compile_vpi_lookup(vpiHandle *objref, char*label);
@@ -418,6 +433,8 @@ extern void compile_ufunc_vec4(char*label, char*code, unsigned wid,
  */
 extern void compile_event(char*label, char*type,
 			  unsigned argc, struct symb_s*argv);
+extern void compile_event_part(char*label, char*type, struct numbv_s parts,
+			       unsigned argc, struct symb_s*argv);
 extern void compile_named_event(char*label, char*type, bool local_flag=false);
 
 
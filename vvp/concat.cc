@@ -26,7 +26,7 @@
 
 vvp_fun_concat::vvp_fun_concat(unsigned w0, unsigned w1,
 			       unsigned w2, unsigned w3)
-: val_(w0+w1+w2+w3)
+: val_(w0+w1+w2+w3), memo_(vvp_send_memo::CONCAT)
 {
       wid_[0] = w0;
       wid_[1] = w1;
@@ -57,11 +57,10 @@ void vvp_fun_concat::recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
       for (unsigned idx = 0 ;  idx < pdx ;  idx += 1)
 	    off += wid_[idx];
 
-      for (unsigned idx = 0 ;  idx < wid_[pdx] ;  idx += 1) {
-	    val_.set_bit(off+idx, bit.value(idx));
-      }
+      bool diff = val_.set_vec(off, bit);
 
-      port.ptr()->send_vec4(val_, 0);
+      if (memo_.changed(diff))
+	    port.ptr()->send_vec4(val_, 0);
 }
 
 void vvp_fun_concat::recv_vec4_pv(vvp_net_ptr_t port, const vvp_vector4_t&bit,
@@ -86,12 +85,18 @@ void vvp_fun_concat::recv_vec4_pv(vvp_net_ptr_t port, const vvp_vector4_t&bit,
       unsigned limit = off + wid_[pdx];
 
       off += base;
+      bool diff = false;
       for (unsigned idx = 0 ;  idx < wid ;  idx += 1) {
             if (off+idx >= limit) break;
-	    val_.set_bit(off+idx, bit.value(idx));
+	    vvp_bit4_t val = bit.value(idx);
+	    if (val_.value(off+idx) == val)
+		  continue;
+	    val_.set_bit(off+idx, val);
+	    diff = true;
       }
 
-      port.ptr()->send_vec4(val_, 0);
+      if (memo_.changed(diff))
+	    port.ptr()->send_vec4(val_, 0);
 }
 
 void compile_concat(char*label, unsigned w0, unsigned w1,
@@ -0,0 +1,802 @@
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "coverage.h"
+# include  "compile.h"
+# include  "vpi_priv.h"
+# include  "vvp_net_sig.h"
+# include  <cassert>
+# include  <cerrno>
+# include  <cstdio>
+# include  <cstdlib>
+# include  <cstring>
+# include  <map>
+# include  <set>
+# include  <string>
+# include  <vector>
+# include  <fcntl.h>
+# include  <unistd.h>
+#if !defined(__MINGW32__)
+# include  <sys/file.h>
+#endif
+
+using namespace std;
+
+/*
+ * The coverage database is a compact binary file. All integers are
+ * unsigned and stored little-endian so that databases from different
+ * hosts can be merged.
+ *
+ *   "VVPCOV2\n"                    magic
+ *   u32 N                          number of toggle records
+ *   N x { u32 len, name[len],      hierarchical signal name
+ *         u32 wid, u64 toggles,    width and total bit toggles
+ *         rise[(wid+7)/8],         bits seen going 0->1
+ *         fall[(wid+7)/8] }        bits seen going 1->0
+ *   u32 M                          number of statement records
+ *   M x { u32 len, file[len],
+ *         u32 lineno, u64 hits }
+ *   B                              number of branch records
+ *   B x { u32 len, site[len],      "file:line" of the statement, or
+ *                                  the scope name without -pfileline
+ *         u32 ordinal,             which branch of the site
+ *         u64 taken, u64 not_taken }
+ *
+ * A "VVPCOV1\n" database is the same without the branch records.
+ *
+ * If the database file already exists, the new results are merged
+ * into it: the counts are summed and the masks are ORed together.
+ * Running a regression with the same -C file therefore accumulates
+ * the coverage of all the tests. The merge holds an flock() on the
+ * file "<database>.lock" and replaces the database by renaming a
+ * temporary file over it, so tests that finish together neither lose
+ * each other's counts nor see a half written database.
+ */
+static const char cov_magic[8] = { 'V','V','P','C','O','V','2','\n' };
+static const char cov_magic_v1[8] = { 'V','V','P','C','O','V','1','\n' };
+
+static vector<string> cov_scopes;
+static const char*cov_file = "vvp.cov";
+
+static vector<coverage_toggle_s*> cov_toggles;
+
+struct cov_line_s {
+      unsigned file_idx;
+      unsigned lineno;
+};
+static vector<cov_line_s> cov_lines;
+static vector<unsigned long> cov_line_vec;
+unsigned long*coverage_line_counts = 0;
+
+  /* A branch site is a statement, or a scope if the code has no
+     %file_line. The file names are only known at the end of the
+     compile, so the site name is made when the database is written. */
+struct cov_branch_s {
+      string scope;
+      unsigned file_idx;
+      unsigned lineno;
+      unsigned ordinal;
+};
+static vector<cov_branch_s> cov_branches;
+static vector<unsigned long> cov_branch_vec;
+unsigned long*coverage_branch_counts = 0;
+
+  /* The site that the next branch belongs to. This is the last
+     covered statement, or the scope if the code has no %file_line. */
+static __vpiScope*branch_scope = 0;
+static cov_branch_s branch_site;
+static unsigned branch_ordinal = 0;
+
+  /* The covered scopes that have code, and those that have at least
+     one %file_line, for the check in coverage_check_lines(). */
+static set<__vpiScope*> code_scopes;
+static set<__vpiScope*> line_scopes;
+
+void coverage_add_scope(const char*path)
+{
+      cov_scopes.push_back(path);
+}
+
+void coverage_set_file(const char*path)
+{
+      cov_file = path;
+}
+
+static bool scope_matches(const char*full)
+{
+      size_t flen = strlen(full);
+      for (unsigned idx = 0 ; idx < cov_scopes.size() ; idx += 1) {
+	    const string&pat = cov_scopes[idx];
+	    if (flen < pat.size())
+		  continue;
+	    if (strncmp(full, pat.c_str(), pat.size()) != 0)
+		  continue;
+	    if (full[pat.size()] == 0 || full[pat.size()] == '.')
+		  return true;
+      }
+      return false;
+}
+
+bool coverage_scope_p(__vpiScope*scope)
+{
+      static __vpiScope*last_scope = 0;
+      static bool last_result = false;
+
+      if (cov_scopes.empty() || scope == 0)
+	    return false;
+
+	// Signals and statements arrive grouped by scope, so a one
+	// entry cache saves nearly all the name lookups.
+      if (scope == last_scope)
+	    return last_result;
+
+      last_scope = scope;
+      last_result = scope_matches(scope->vpi_get_str(vpiFullName));
+      return last_result;
+}
+
+static coverage_toggle_s* make_toggle(__vpiScope*scope, const char*name,
+				      unsigned wid)
+{
+      string full = scope->vpi_get_str(vpiFullName);
+      full += ".";
+      full += name;
+
+      const unsigned bits_per_word = 8*sizeof(unsigned long);
+      unsigned words = (wid + bits_per_word - 1) / bits_per_word;
+      if (words == 0) words = 1;
+
+      coverage_toggle_s*cov = new coverage_toggle_s;
+      cov->name = strdup(full.c_str());
+      cov->wid = wid;
+      cov->toggles = 0;
+      cov->rise = new unsigned long[words];
+      cov->fall = new unsigned long[words];
+      memset(cov->rise, 0, words * sizeof(unsigned long));
+      memset(cov->fall, 0, words * sizeof(unsigned long));
+      cov_toggles.push_back(cov);
+      return cov;
+}
+
+vvp_wire_vec4* coverage_make_wire_vec4(__vpiScope*scope, const char*name,
+				       unsigned wid, vvp_bit4_t init)
+{
+      if (name == 0 || !coverage_scope_p(scope))
+	    return new vvp_wire_vec4(wid, init);
+
+      return new vvp_wire_vec4_cov(wid, init, make_toggle(scope, name, wid));
+}
+
+vvp_wire_vec4* coverage_make_wire_vec2(__vpiScope*scope, const char*name,
+				       unsigned wid)
+{
+      if (name == 0 || !coverage_scope_p(scope))
+	    return new vvp_wire_vec2(wid);
+
+      return new vvp_wire_vec2_cov(wid, make_toggle(scope, name, wid));
+}
+
+unsigned coverage_add_line(long file_idx, long lineno)
+{
+      if (!coverage_scope_p(vpip_peek_current_scope()))
+	    return 0;
+
+	// Counter 0 means "not covered", so never hand it out.
+      if (cov_line_vec.empty()) {
+	    cov_line_vec.push_back(0);
+	    cov_lines.push_back(cov_line_s());
+      }
+
+      cov_line_s tmp;
+      tmp.file_idx = file_idx;
+      tmp.lineno = lineno;
+      cov_lines.push_back(tmp);
+      cov_line_vec.push_back(0);
+      coverage_line_counts = &cov_line_vec[0];
+      line_scopes.insert(vpip_peek_current_scope());
+
+	// The branches that follow belong to this statement.
+      branch_scope = vpip_peek_current_scope();
+      branch_site.scope.clear();
+      branch_site.file_idx = file_idx;
+      branch_site.lineno = lineno;
+      branch_ordinal = 0;
+
+      return cov_line_vec.size() - 1;
+}
+
+unsigned coverage_add_branch(void)
+{
+      __vpiScope*scope = vpip_peek_current_scope();
+      if (!coverage_scope_p(scope))
+	    return 0;
+
+	// Branch 0 means "not covered", so never hand it out.
+      if (cov_branches.empty()) {
+	    cov_branches.push_back(cov_branch_s());
+	    cov_branch_vec.resize(2, 0);
+      }
+
+      if (scope != branch_scope) {
+	    branch_scope = scope;
+	    branch_site.scope = scope->vpi_get_str(vpiFullName);
+	    branch_ordinal = 0;
+      }
+
+      cov_branch_s tmp = branch_site;
+      tmp.ordinal = branch_ordinal++;
+      cov_branches.push_back(tmp);
+      cov_branch_vec.push_back(0);
+      cov_branch_vec.push_back(0);
+      coverage_branch_counts = &cov_branch_vec[0];
+
+      return cov_branches.size() - 1;
+}
+
+void coverage_add_code(void)
+{
+      __vpiScope*scope = vpip_peek_current_scope();
+      if (coverage_scope_p(scope))
+	    code_scopes.insert(scope);
+}
+
+void coverage_check_lines(void)
+{
+      unsigned missing = 0;
+      __vpiScope*first = 0;
+      for (set<__vpiScope*>::const_iterator cur = code_scopes.begin()
+		 ; cur != code_scopes.end() ; ++ cur ) {
+	    if (line_scopes.count(*cur))
+		  continue;
+	    if (missing == 0)
+		  first = *cur;
+	    missing += 1;
+      }
+
+      if (missing > 0) {
+	    vpi_mcd_printf(1, "Warning: %u covered scope(s), for example %s, "
+			   "have no %%file_line statements, so no statement "
+			   "coverage is collected for them. Compile the "
+			   "design with -pfileline=1.\n", missing,
+			   first->vpi_get_str(vpiFullName));
+      }
+
+      code_scopes.clear();
+      line_scopes.clear();
+}
+
+/*
+ * These are the merged records, keyed by the signal name or by the
+ * file name and line number.
+ */
+struct cov_toggle_rec {
+      cov_toggle_rec() : wid(0), toggles(0) { }
+      unsigned wid;
+      unsigned long long toggles;
+      vector<unsigned char> rise;
+      vector<unsigned char> fall;
+};
+
+typedef map<string,cov_toggle_rec> toggle_map_t;
+typedef map<pair<string,unsigned>,unsigned long long> line_map_t;
+
+struct cov_branch_rec {
+      cov_branch_rec() : taken(0), not_taken(0) { }
+      unsigned long long taken;
+      unsigned long long not_taken;
+};
+typedef map<pair<string,unsigned>,cov_branch_rec> branch_map_t;
+
+struct cov_database_s {
+      toggle_map_t toggles;
+      line_map_t lines;
+      branch_map_t branches;
+
+      void clear() { toggles.clear(); lines.clear(); branches.clear(); }
+};
+
+static void put_u32(FILE*fd, unsigned long val)
+{
+      for (unsigned idx = 0 ; idx < 4 ; idx += 1)
+	    fputc((val >> 8*idx) & 0xff, fd);
+}
+
+static void put_u64(FILE*fd, unsigned long long val)
+{
+      for (unsigned idx = 0 ; idx < 8 ; idx += 1)
+	    fputc((val >> 8*idx) & 0xff, fd);
+}
+
+static void put_str(FILE*fd, const string&str)
+{
+      put_u32(fd, str.size());
+      fwrite(str.data(), 1, str.size(), fd);
+}
+
+static bool get_u32(FILE*fd, unsigned long&val)
+{
+      val = 0;
+      for (unsigned idx = 0 ; idx < 4 ; idx += 1) {
+	    int ch = fgetc(fd);
+	    if (ch == EOF) return false;
+	    val |= (unsigned long)ch << 8*idx;
+      }
+      return true;
+}
+
+static bool get_u64(FILE*fd, unsigned long long&val)
+{
+      val = 0;
+      for (unsigned idx = 0 ; idx < 8 ; idx += 1) {
+	    int ch = fgetc(fd);
+	    if (ch == EOF) return false;
+	    val |= (unsigned long long)ch << 8*idx;
+      }
+      return true;
+}
+
+static bool get_str(FILE*fd, string&str)
+{
+      unsigned long len;
+      if (!get_u32(fd, len)) return false;
+      str.resize(len);
+      if (len == 0) return true;
+      return fread(&str[0], 1, len, fd) == len;
+}
+
+static bool get_bytes(FILE*fd, vector<unsigned char>&buf, unsigned cnt)
+{
+      buf.resize(cnt);
+      if (cnt == 0) return true;
+      return fread(&buf[0], 1, cnt, fd) == cnt;
+}
+
+  /* Merge a toggle record into dst. A signal that changed width
+     starts over with the new record. */
+static void merge_toggle(cov_toggle_rec&dst, const cov_toggle_rec&src)
+{
+      if (dst.wid != src.wid || dst.rise.size() != src.rise.size()) {
+	    dst = src;
+	    return;
+      }
+
+      dst.toggles += src.toggles;
+      for (unsigned idx = 0 ; idx < dst.rise.size() ; idx += 1) {
+	    dst.rise[idx] |= src.rise[idx];
+	    dst.fall[idx] |= src.fall[idx];
+      }
+}
+
+  /* Read a database and merge it into db. */
+static bool read_database(FILE*fd, cov_database_s&db)
+{
+      toggle_map_t&toggles = db.toggles;
+      line_map_t&lines = db.lines;
+      branch_map_t&branches = db.branches;
+
+      char magic[sizeof cov_magic];
+      if (fread(magic, 1, sizeof magic, fd) != sizeof magic)
+	    return false;
+
+      bool have_branches = true;
+      if (memcmp(magic, cov_magic_v1, sizeof magic) == 0)
+	    have_branches = false;
+      else if (memcmp(magic, cov_magic, sizeof magic) != 0)
+	    return false;
+
+      unsigned long count;
+      if (!get_u32(fd, count)) return false;
+      for (unsigned long idx = 0 ; idx < count ; idx += 1) {
+	    string name;
+	    unsigned long wid;
+	    cov_toggle_rec rec;
+	    if (!get_str(fd, name)) return false;
+	    if (!get_u32(fd, wid)) return false;
+	    if (!get_u64(fd, rec.toggles)) return false;
+	    rec.wid = wid;
+	    if (!get_bytes(fd, rec.rise, (wid+7)/8)) return false;
+	    if (!get_bytes(fd, rec.fall, (wid+7)/8)) return false;
+	    merge_toggle(toggles[name], rec);
+      }
+
+      if (!get_u32(fd, count)) return false;
+      for (unsigned long idx = 0 ; idx < count ; idx += 1) {
+	    string file;
+	    unsigned long lineno;
+	    unsigned long long hits;
+	    if (!get_str(fd, file)) return false;
+	    if (!get_u32(fd, lineno)) return false;
+	    if (!get_u64(fd, hits)) return false;
+	    lines[make_pair(file, (unsigned)lineno)] += hits;
+      }
+
+      if (!have_branches)
+	    return true;
+
+      if (!get_u32(fd, count)) return false;
+      for (unsigned long idx = 0 ; idx < count ; idx += 1) {
+	    string site;
+	    unsigned long ordinal;
+	    unsigned long long taken, not_taken;
+	    if (!get_str(fd, site)) return false;
+	    if (!get_u32(fd, ordinal)) return false;
+	    if (!get_u64(fd, taken)) return false;
+	    if (!get_u64(fd, not_taken)) return false;
+	    cov_branch_rec&rec = branches[make_pair(site, (unsigned)ordinal)];
+	    rec.taken += taken;
+	    rec.not_taken += not_taken;
+      }
+
+      return true;
+}
+
+static void merge_mask(vector<unsigned char>&dst, const unsigned long*src,
+		       unsigned wid)
+{
+      for (unsigned idx = 0 ; idx < (wid+7)/8 ; idx += 1) {
+	    unsigned long word = src[idx / sizeof(unsigned long)];
+	    dst[idx] |= (word >> 8*(idx % sizeof(unsigned long))) & 0xff;
+      }
+}
+
+/*
+ * Take an exclusive lock on the database. The lock is on a separate
+ * file because the database itself is replaced by rename(), and a
+ * lock on the old file would not stop a reader of the new one.
+ */
+static int lock_database(const string&lock_path)
+{
+#if defined(__MINGW32__)
+      (void)lock_path;
+      return -1;
+#else
+      int fd = open(lock_path.c_str(), O_RDWR|O_CREAT, 0666);
+      if (fd < 0)
+	    return -1;
+
+      while (flock(fd, LOCK_EX) != 0) {
+	    if (errno != EINTR) {
+		  close(fd);
+		  return -1;
+	    }
+      }
+
+      return fd;
+#endif
+}
+
+static void unlock_database(int fd)
+{
+#if !defined(__MINGW32__)
+      if (fd >= 0) {
+	    flock(fd, LOCK_UN);
+	    close(fd);
+      }
+#else
+      (void)fd;
+#endif
+}
+
+static bool write_database(FILE*fd, const cov_database_s&db)
+{
+      const toggle_map_t&toggles = db.toggles;
+      const line_map_t&lines = db.lines;
+      const branch_map_t&branches = db.branches;
+
+      fwrite(cov_magic, 1, sizeof cov_magic, fd);
+
+      put_u32(fd, toggles.size());
+      for (toggle_map_t::const_iterator cur = toggles.begin()
+		 ; cur != toggles.end() ; ++ cur ) {
+	    put_str(fd, cur->first);
+	    put_u32(fd, cur->second.wid);
+	    put_u64(fd, cur->second.toggles);
+	    if (cur->second.wid == 0)
+		  continue;
+	    fwrite(&cur->second.rise[0], 1, cur->second.rise.size(), fd);
+	    fwrite(&cur->second.fall[0], 1, cur->second.fall.size(), fd);
+      }
+
+      put_u32(fd, lines.size());
+      for (line_map_t::const_iterator cur = lines.begin()
+		 ; cur != lines.end() ; ++ cur ) {
+	    put_str(fd, cur->first.first);
+	    put_u32(fd, cur->first.second);
+	    put_u64(fd, cur->second);
+      }
+
+      put_u32(fd, branches.size());
+      for (branch_map_t::const_iterator cur = branches.begin()
+		 ; cur != branches.end() ; ++ cur ) {
+	    put_str(fd, cur->first.first);
+	    put_u32(fd, cur->first.second);
+	    put_u64(fd, cur->second.taken);
+	    put_u64(fd, cur->second.not_taken);
+      }
+
+      return ferror(fd) == 0;
+}
+
+  /* Read the database file into db. A file that does not exist is an
+     empty database. */
+static bool load_database(const char*path, cov_database_s&db)
+{
+      FILE*fd = fopen(path, "rb");
+      if (fd == 0)
+	    return errno == ENOENT;
+
+      bool ok = read_database(fd, db);
+      fclose(fd);
+      return ok;
+}
+
+  /* Write the merged database next to the old one, then move it into
+     place, so that the database is never seen half written. */
+static bool replace_database(const cov_database_s&db)
+{
+      char pid_buf[32];
+      snprintf(pid_buf, sizeof pid_buf, ".tmp%ld", (long)getpid());
+      string tmp_path = string(cov_file) + pid_buf;
+
+      FILE*fd = fopen(tmp_path.c_str(), "wb");
+      if (fd == 0) {
+	    vpi_mcd_printf(1, "Error: Unable to write coverage database "
+			   "\"%s\".\n", cov_file);
+	    return false;
+      }
+
+      bool ok = write_database(fd, db);
+      if (fclose(fd) != 0)
+	    ok = false;
+
+#if defined(__MINGW32__)
+	// rename() does not replace an existing file here.
+      if (ok) remove(cov_file);
+#endif
+      if (!ok || rename(tmp_path.c_str(), cov_file) != 0) {
+	    vpi_mcd_printf(1, "Error: Unable to write coverage database "
+			   "\"%s\".\n", cov_file);
+	    remove(tmp_path.c_str());
+	    return false;
+      }
+
+      return true;
+}
+
+static int open_database_lock(void)
+{
+      string lock_path = string(cov_file) + ".lock";
+      int lock_fd = lock_database(lock_path);
+#if !defined(__MINGW32__)
+      if (lock_fd < 0) {
+	    vpi_mcd_printf(1, "Error: Unable to lock coverage database "
+			   "\"%s\".\n", lock_path.c_str());
+      }
+#endif
+      return lock_fd;
+}
+
+void coverage_write(void)
+{
+      if (cov_toggles.empty() && cov_lines.empty() && cov_branches.empty())
+	    return;
+
+      int lock_fd = open_database_lock();
+#if !defined(__MINGW32__)
+      if (lock_fd < 0)
+	    return;
+#endif
+
+      cov_database_s db;
+
+      if (!load_database(cov_file, db)) {
+	    vpi_mcd_printf(1, "Warning: Ignoring invalid coverage "
+			   "database \"%s\".\n", cov_file);
+	    db.clear();
+      }
+
+      for (unsigned idx = 0 ; idx < cov_toggles.size() ; idx += 1) {
+	    coverage_toggle_s*cov = cov_toggles[idx];
+	    cov_toggle_rec&rec = db.toggles[cov->name];
+	      // A signal that changed width starts over.
+	    if (rec.wid != cov->wid || rec.rise.size() != (cov->wid+7)/8) {
+		  rec.wid = cov->wid;
+		  rec.toggles = 0;
+		  rec.rise.assign((cov->wid+7)/8, 0);
+		  rec.fall.assign((cov->wid+7)/8, 0);
+	    }
+	    rec.toggles += cov->toggles;
+	    merge_mask(rec.rise, cov->rise, cov->wid);
+	    merge_mask(rec.fall, cov->fall, cov->wid);
+      }
+
+      for (unsigned idx = 1 ; idx < cov_lines.size() ; idx += 1) {
+	    const cov_line_s&cur = cov_lines[idx];
+	    assert(cur.file_idx < file_names.size());
+	    db.lines[make_pair(string(file_names[cur.file_idx]), cur.lineno)]
+		  += cov_line_vec[idx];
+      }
+
+      for (unsigned idx = 1 ; idx < cov_branches.size() ; idx += 1) {
+	    const cov_branch_s&cur = cov_branches[idx];
+	    string site = cur.scope;
+	    if (site.empty()) {
+		  char buf[32];
+		  snprintf(buf, sizeof buf, ":%u", cur.lineno);
+		  assert(cur.file_idx < file_names.size());
+		  site = file_names[cur.file_idx];
+		  site += buf;
+	    }
+	    cov_branch_rec&rec = db.branches[make_pair(site, cur.ordinal)];
+	    rec.taken += cov_branch_vec[2*idx + 0];
+	    rec.not_taken += cov_branch_vec[2*idx + 1];
+      }
+
+      replace_database(db);
+      unlock_database(lock_fd);
+}
+
+static void print_total(const char*what, unsigned long hit,
+			unsigned long total, const char*unit)
+{
+      if (total == 0) {
+	    vpi_mcd_printf(1, "  %-10s no %s\n", what, unit);
+	    return;
+      }
+
+      vpi_mcd_printf(1, "  %-10s %lu of %lu %s (%.1f%%)\n", what, hit, total, unit,
+	     100.0 * hit / total);
+}
+
+static void print_report(const cov_database_s&db)
+{
+      unsigned long bits = 0, bits_hit = 0;
+      unsigned long lines_hit = 0;
+      unsigned long dirs_hit = 0;
+
+      for (toggle_map_t::const_iterator cur = db.toggles.begin()
+		 ; cur != db.toggles.end() ; ++ cur ) {
+	    const cov_toggle_rec&rec = cur->second;
+	    for (unsigned idx = 0 ; idx < rec.wid ; idx += 1) {
+		  unsigned char mask = 1 << (idx % 8);
+		  if ((rec.rise[idx/8] & mask) && (rec.fall[idx/8] & mask))
+			bits_hit += 1;
+	    }
+	    bits += rec.wid;
+      }
+
+      for (line_map_t::const_iterator cur = db.lines.begin()
+		 ; cur != db.lines.end() ; ++ cur ) {
+	    if (cur->second) lines_hit += 1;
+      }
+
+      for (branch_map_t::const_iterator cur = db.branches.begin()
+		 ; cur != db.branches.end() ; ++ cur ) {
+	    if (cur->second.taken) dirs_hit += 1;
+	    if (cur->second.not_taken) dirs_hit += 1;
+      }
+
+      vpi_mcd_printf(1, "Coverage database %s:\n", cov_file);
+      print_total("Toggle:", bits_hit, bits, "bits toggled both ways");
+      print_total("Statement:", lines_hit, db.lines.size(), "statements run");
+      print_total("Branch:", dirs_hit, 2*db.branches.size(),
+		  "branch directions taken");
+
+      if (bits_hit < bits) {
+	    vpi_mcd_printf(1, "Bits that did not toggle both ways:\n");
+	    for (toggle_map_t::const_iterator cur = db.toggles.begin()
+		       ; cur != db.toggles.end() ; ++ cur ) {
+		  const cov_toggle_rec&rec = cur->second;
+		  for (unsigned idx = 0 ; idx < rec.wid ; idx += 1) {
+			unsigned char mask = 1 << (idx % 8);
+			bool rise = rec.rise[idx/8] & mask;
+			bool fall = rec.fall[idx/8] & mask;
+			if (rise && fall)
+			      continue;
+			vpi_mcd_printf(1, "  %s bit %u:%s%s\n", cur->first.c_str(), idx,
+			       rise? "" : " no 0->1", fall? "" : " no 1->0");
+		  }
+	    }
+      }
+
+      if (lines_hit < db.lines.size()) {
+	    vpi_mcd_printf(1, "Statements that did not run:\n");
+	    for (line_map_t::const_iterator cur = db.lines.begin()
+		       ; cur != db.lines.end() ; ++ cur ) {
+		  if (cur->second == 0)
+			vpi_mcd_printf(1, "  %s:%u\n", cur->first.first.c_str(),
+			       cur->first.second);
+	    }
+      }
+
+      if (dirs_hit < 2*db.branches.size()) {
+	    vpi_mcd_printf(1, "Branches that did not go both ways:\n");
+	    for (branch_map_t::const_iterator cur = db.branches.begin()
+		       ; cur != db.branches.end() ; ++ cur ) {
+		  const cov_branch_rec&rec = cur->second;
+		  if (rec.taken && rec.not_taken)
+			continue;
+		  vpi_mcd_printf(1, "  %s branch %u:%s%s\n", cur->first.first.c_str(),
+			 cur->first.second, rec.taken? "" : " never taken",
+			 rec.not_taken? "" : " never fell through");
+	    }
+      }
+}
+
+int coverage_report(int argc, char*argv[])
+{
+      int lock_fd = open_database_lock();
+#if !defined(__MINGW32__)
+      if (lock_fd < 0)
+	    return 1;
+#endif
+
+      cov_database_s db;
+      if (!load_database(cov_file, db)) {
+	    vpi_mcd_printf(1, "Error: Invalid coverage database \"%s\".\n",
+		    cov_file);
+	    unlock_database(lock_fd);
+	    return 1;
+      }
+
+      for (int idx = 0 ; idx < argc ; idx += 1) {
+	    FILE*fd = fopen(argv[idx], "rb");
+	    if (fd == 0) {
+		  vpi_mcd_printf(1, "Error: Unable to open coverage database "
+			  "\"%s\".\n", argv[idx]);
+		  unlock_database(lock_fd);
+		  return 1;
+	    }
+
+	      // Read into a separate database, so that a bad file does
+	      // not leave half of its records in the merged result.
+	    cov_database_s tmp;
+	    bool ok = read_database(fd, tmp);
+	    fclose(fd);
+	    if (!ok) {
+		  vpi_mcd_printf(1, "Error: Invalid coverage database "
+			  "\"%s\".\n", argv[idx]);
+		  unlock_database(lock_fd);
+		  return 1;
+	    }
+
+	    for (toggle_map_t::const_iterator cur = tmp.toggles.begin()
+		       ; cur != tmp.toggles.end() ; ++ cur )
+		  merge_toggle(db.toggles[cur->first], cur->second);
+	    for (line_map_t::const_iterator cur = tmp.lines.begin()
+		       ; cur != tmp.lines.end() ; ++ cur )
+		  db.lines[cur->first] += cur->second;
+	    for (branch_map_t::const_iterator cur = tmp.branches.begin()
+		       ; cur != tmp.branches.end() ; ++ cur ) {
+		  cov_branch_rec&rec = db.branches[cur->first];
+		  rec.taken += cur->second.taken;
+		  rec.not_taken += cur->second.not_taken;
+	    }
+      }
+
+      if (argc > 0 && !replace_database(db)) {
+	    unlock_database(lock_fd);
+	    return 1;
+      }
+
+      unlock_database(lock_fd);
+
+      print_report(db);
+      return 0;
+}
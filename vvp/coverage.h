@@ -0,0 +1,107 @@
+#ifndef IVL_coverage_H
+#define IVL_coverage_H
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "vvp_net.h"
+
+class __vpiScope;
+class vvp_wire_vec4;
+
+/*
+ * Coverage collection is enabled per scope with the -c command line
+ * flag. Only the signals, statements and branches in the selected
+ * scopes (and the scopes below them) are instrumented, so a
+ * simulation without any -c flags runs exactly the same code as
+ * before.
+ *
+ * Toggle coverage is kept in a coverage_toggle_s for each covered
+ * signal. The rise and fall masks are arrays of words laid out like
+ * the vvp_vector4_t value, so that vvp_vector4_t::toggle_masks() can
+ * update them a word at a time.
+ */
+struct coverage_toggle_s {
+      char*name;
+      unsigned wid;
+      unsigned long toggles;
+      unsigned long*rise;
+      unsigned long*fall;
+};
+
+extern void coverage_add_scope(const char*path);
+extern void coverage_set_file(const char*path);
+
+  /* Return true if the scope is selected for coverage collection. */
+extern bool coverage_scope_p(__vpiScope*scope);
+
+  /* Make the filter for a vec4 net or variable. If the scope is
+     covered, then the filter also collects toggle coverage. */
+extern vvp_wire_vec4* coverage_make_wire_vec4(__vpiScope*scope,
+					      const char*name,
+					      unsigned wid, vvp_bit4_t init);
+
+  /* Make the filter for a 2-state variable. The filter keeps the
+     variable 2-state whether or not the scope is covered. */
+extern vvp_wire_vec4* coverage_make_wire_vec2(__vpiScope*scope,
+					      const char*name,
+					      unsigned wid);
+
+  /* Register a %file_line statement in the current scope. Return 0
+     if the scope is not covered, otherwise return the (non-zero)
+     counter number to be passed to coverage_line_hit(). */
+extern unsigned coverage_add_line(long file_idx, long lineno);
+
+extern unsigned long*coverage_line_counts;
+
+inline void coverage_line_hit(unsigned idx)
+{
+      coverage_line_counts[idx] += 1;
+}
+
+  /* Register a conditional jump in the current scope. Return 0 if
+     the scope is not covered, otherwise return the (non-zero)
+     counter number to be passed to coverage_branch_hit(). Each
+     branch has a pair of counters: taken and not taken. */
+extern unsigned coverage_add_branch(void);
+
+extern unsigned long*coverage_branch_counts;
+
+  /* Note an instruction in the current scope. After the compile,
+     coverage_check_lines() warns about covered scopes that have
+     code but no %file_line statements to count. */
+extern void coverage_add_code(void);
+extern void coverage_check_lines(void);
+
+inline void coverage_branch_hit(unsigned idx, bool taken)
+{
+      coverage_branch_counts[2*idx + (taken? 0 : 1)] += 1;
+}
+
+  /* Merge the collected coverage into the coverage database. The
+     database is locked while it is read, merged and replaced, so
+     simulations that share a database may finish at the same time. */
+extern void coverage_write(void);
+
+  /* Merge the database files in argv into the coverage database, and
+     print the toggle, statement and branch totals of the result and
+     the items that were not covered. This is the -R mode of vvp, which
+     runs no design. Return the exit code for vvp. */
+extern int coverage_report(int argc, char*argv[]);
+
+#endif /* IVL_coverage_H */
@@ -20,6 +20,8 @@
 #include "delay.h"
 #include "schedule.h"
 #include "vpi_priv.h"
+#include "compile.h"
+#include "vvp_net_sig.h"
 #include "config.h"
 #ifdef CHECK_WITH_VALGRIND
 #include "vvp_cleanup.h"
@@ -530,28 +532,83 @@ vvp_fun_modpath::~vvp_fun_modpath()
 
 void vvp_fun_modpath::add_modpath_src(vvp_fun_modpath_src*that, bool ifnone)
 {
-      assert(that->next_ == 0);
-      if (ifnone) {
-	    that->next_ = ifnone_list_;
-	    ifnone_list_ = that;
-      } else {
-	    that->next_ = src_list_;
-	    src_list_ = that;
-      }
+      assert(that->next_ == 0 && that->owner_ == 0);
+      vvp_fun_modpath_src*&list = ifnone? ifnone_list_ : src_list_;
+
+      that->owner_ = this;
+      that->ifnone_ = ifnone;
+      that->next_ = list;
+      if (list) list->prev_ = that;
+      list = that;
 }
 
-static vvp_time64_t delay_from_edge(vvp_bit4_t a, vvp_bit4_t b,
-                                           vvp_time64_t array[12])
+/*
+ * Move a source that just woke up to the front of its list. This
+ * keeps the list sorted by wake time, latest first.
+ */
+void vvp_fun_modpath::wake_src(vvp_fun_modpath_src*that)
 {
-      typedef delay_edge_t bit4_table4[4];
-      static const bit4_table4 edge_table[4] = {
-	    { DELAY_EDGE_01, DELAY_EDGE_01, DELAY_EDGE_0z, DELAY_EDGE_0x },
-	    { DELAY_EDGE_10, DELAY_EDGE_10, DELAY_EDGE_1z, DELAY_EDGE_1x },
-	    { DELAY_EDGE_z0, DELAY_EDGE_z1, DELAY_EDGE_z0, DELAY_EDGE_zx },
-	    { DELAY_EDGE_x0, DELAY_EDGE_x1, DELAY_EDGE_xz, DELAY_EDGE_x0 }
-      };
+      assert(that->owner_ == this);
+      vvp_fun_modpath_src*&list = that->ifnone_? ifnone_list_ : src_list_;
+
+      if (list == that)
+	    return;
+
+      assert(that->prev_);
+      that->prev_->next_ = that->next_;
+      if (that->next_) that->next_->prev_ = that->prev_;
 
-      return array[ edge_table[a][b] ];
+      that->prev_ = 0;
+      that->next_ = list;
+      list->prev_ = that;
+      list = that;
+}
+
+/*
+ * This table maps the transition of a bit to the index of the delay
+ * to use from the 12 delays of a path.
+ */
+static const delay_edge_t modpath_edge_table[4][4] = {
+      { DELAY_EDGE_01, DELAY_EDGE_01, DELAY_EDGE_0z, DELAY_EDGE_0x },
+      { DELAY_EDGE_10, DELAY_EDGE_10, DELAY_EDGE_1z, DELAY_EDGE_1x },
+      { DELAY_EDGE_z0, DELAY_EDGE_z1, DELAY_EDGE_z0, DELAY_EDGE_zx },
+      { DELAY_EDGE_x0, DELAY_EDGE_x1, DELAY_EDGE_xz, DELAY_EDGE_x0 }
+};
+
+/*
+ * Given the first candidate source in a sorted list, return the
+ * minimum delay for the edge from all the enabled sources that woke at
+ * the given wake time. The list is sorted, so the scan stops at the
+ * first source that woke earlier.
+ */
+vvp_time64_t vvp_fun_modpath::select_delay_(vvp_fun_modpath_src*first,
+					    vvp_time64_t wake_time,
+					    unsigned edge_idx,
+					    vvp_time64_t now) const
+{
+      vvp_time64_t res = 0;
+      bool res_flag = false;
+
+      for (vvp_fun_modpath_src*cur = first ; cur ; cur = cur->next_) {
+	    if (cur->wake_time_ < wake_time)
+		  break;
+	    if (cur->condition_flag_ == false && ! cur->ifnone_)
+		  continue;
+
+	    vvp_time64_t tmp = cur->wake_time_ + cur->delay_[edge_idx];
+	    if (tmp <= now)
+		  tmp = 0;
+	    else
+		  tmp -= now;
+
+	    if (!res_flag || tmp < res) {
+		  res = tmp;
+		  res_flag = true;
+	    }
+      }
+
+      assert(res_flag);
+      return res;
 }
 
 void vvp_fun_modpath::recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
@@ -564,106 +621,47 @@ void vvp_fun_modpath::recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
       if (cur_vec4_.eeq(bit))
 	    return;
 
-	/* Select a time delay source that applies. Notice that there
-	   may be multiple delay sources that apply, so collect all
-	   the candidates into a list first. */
-      list<vvp_fun_modpath_src*>candidate_list;
-      vvp_time64_t candidate_wake_time = 0;
-      for (vvp_fun_modpath_src*cur = src_list_ ;  cur ;  cur=cur->next_) {
-	      /* Skip paths that are disabled by conditions. */
-	    if (cur->condition_flag_ == false)
-		  continue;
+	/* Select the time delay sources that apply. The lists are
+	   sorted by wake time, so the first enabled normal source has
+	   the latest wake time of the normal sources, and the others
+	   that apply follow it. The ifnone paths are only used if
+	   they woke later or if there are no normal delays. */
+      vvp_fun_modpath_src*first = src_list_;
+      while (first && first->condition_flag_ == false)
+	    first = first->next_;
 
-	    if (candidate_list.empty()) {
-		  candidate_list.push_back(cur);
-		  candidate_wake_time = cur->wake_time_;
-	    } else if (cur->wake_time_ == candidate_wake_time) {
-		  candidate_list.push_back(cur);
-	    } else if (cur->wake_time_ > candidate_wake_time) {
-		  candidate_list.assign(1, cur);
-		  candidate_wake_time = cur->wake_time_;
-	    } else {
-		  continue; /* Skip this entry. */
-	    }
-      }
-
-	/* Only add the ifnone delay if it has a later wake_time_ or
-	 * if there are no normal delays. */
-      vvp_time64_t ifnone_wake_time = candidate_wake_time;
-      for (vvp_fun_modpath_src*cur = ifnone_list_ ;  cur ;  cur=cur->next_) {
-	    if (candidate_list.empty()) {
-		  candidate_list.push_back(cur);
-		  ifnone_wake_time = cur->wake_time_;
-	    } else if (cur->wake_time_ == ifnone_wake_time &&
-	               ifnone_wake_time > candidate_wake_time) {
-		  candidate_list.push_back(cur);
-	    } else if (cur->wake_time_ > ifnone_wake_time) {
-		  candidate_list.assign(1, cur);
-		  ifnone_wake_time = cur->wake_time_;
-	    } else {
-		  continue; /* Skip this entry. */
-	    }
-      }
+      vvp_fun_modpath_src*ifnone = ifnone_list_;
+      if (ifnone && (first == 0 || ifnone->wake_time_ > first->wake_time_))
+	    first = ifnone;
 
 	/* Handle the special case that there are no delays that
 	   match. This may happen, for example, if the set of
 	   conditional delays is incomplete, leaving some cases
 	   uncovered. In that case, just pass the data without delay */
-      if (candidate_list.empty()) {
+      if (first == 0) {
 	    cur_vec4_ = bit;
 	    schedule_generic(this, 0, false);
 	    return;
       }
 
-	/* Now given that we have a list of candidate delays, find for
-	   each if the 12 numbers the minimum from all the
-	   candidates. This minimum set becomes the chosen delay to
-	   use. */
-      vvp_time64_t out_at[12];
+	/* The delay is the minimum from all the candidates of the
+	   delay selected by the edge of the least bit. Only that one
+	   of the 12 delays needs to be computed. */
       vvp_time64_t now = schedule_simtime();
-
-      typedef list<vvp_fun_modpath_src*>::const_iterator iter_t;
-
-      iter_t cur = candidate_list.begin();
-      vvp_fun_modpath_src*src = *cur;
-
-      for (unsigned idx = 0 ;  idx < 12 ;  idx += 1) {
-	    out_at[idx] = src->wake_time_ + src->delay_[idx];
-	    if (out_at[idx] <= now)
-		  out_at[idx] = 0;
-	    else
-		  out_at[idx] -= now;
-      }
-
-      for (++ cur ; cur != candidate_list.end() ; ++ cur ) {
-	    src = *cur;
-	    for (unsigned idx = 0 ;  idx < 12 ;  idx += 1) {
-		  vvp_time64_t tmp = src->wake_time_ + src->delay_[idx];
-		  if (tmp <= now)
-			tmp = 0;
-		  else
-			tmp -= now;
-		  if (tmp < out_at[idx])
-			out_at[idx] = tmp;
-	    }
-      }
-
-	/* Given the scheduled output time, create an output event. */
-      vvp_time64_t use_delay = delay_from_edge(cur_vec4_.value(0),
-					       bit.value(0),
-					       out_at);
+      vvp_time64_t wake_time = first->wake_time_;
+      unsigned edge_idx = modpath_edge_table[cur_vec4_.value(0)][bit.value(0)];
+      vvp_time64_t use_delay = select_delay_(first, wake_time, edge_idx, now);
 
 	/* FIXME: This bases the edge delay on only the least
 	   bit. This is WRONG! I need to find all the possible delays,
 	   and schedule an event for each partial change. Hard! */
       for (unsigned idx = 1 ;  idx < bit.size() ;  idx += 1) {
-	    vvp_time64_t tmp = delay_from_edge(cur_vec4_.value(idx),
-					       bit.value(idx),
-					       out_at);
 	      /* If the current and new bit values match then no delay
 	       * is needed for this bit. */
 	    if (cur_vec4_.value(idx) == bit.value(idx)) continue;
-	    assert(tmp == use_delay);
+	    unsigned tmp_idx = modpath_edge_table[cur_vec4_.value(idx)][bit.value(idx)];
+	    if (tmp_idx == edge_idx) continue;
+	    assert(select_delay_(first, wake_time, tmp_idx, now) == use_delay);
       }
 
       cur_vec4_ = bit;
@@ -681,6 +679,9 @@ vvp_fun_modpath_src::vvp_fun_modpath_src(vvp_time64_t del[12])
 	    delay_[idx] = del[idx];
 
       next_ = 0;
+      prev_ = 0;
+      owner_ = 0;
+      ifnone_ = false;
       wake_time_ = 0;
       condition_flag_ = true;
 }
@@ -706,8 +707,10 @@ void vvp_fun_modpath_src::recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
 {
       if (port.port() == 0) {
 	      // The modpath input...
-	    if (test_vec4(bit))
+	    if (test_vec4(bit)) {
 		  wake_time_ = schedule_simtime();
+		  if (owner_) owner_->wake_src(this);
+	    }
 
       } else if (port.port() == 1) {
 	      // The modpath condition input...
@@ -744,6 +747,215 @@ bool vvp_fun_modpath_edge::test_vec4(const vvp_vector4_t&bit)
 }
 
 
+/*
+ * Return the vpiEdge mask of the transition from one value to
+ * another. A z is treated like an x, so there is no x/z edge.
+ */
+static unsigned tchk_edge_mask(vvp_bit4_t from, vvp_bit4_t to)
+{
+      if (from == BIT4_Z) from = BIT4_X;
+      if (to == BIT4_Z) to = BIT4_X;
+
+      switch (from) {
+	  case BIT4_0:
+	    if (to == BIT4_1) return vpiEdge01;
+	    if (to == BIT4_X) return vpiEdge0x;
+	    break;
+	  case BIT4_1:
+	    if (to == BIT4_0) return vpiEdge10;
+	    if (to == BIT4_X) return vpiEdge1x;
+	    break;
+	  case BIT4_X:
+	    if (to == BIT4_0) return vpiEdgex0;
+	    if (to == BIT4_1) return vpiEdgex1;
+	    break;
+	  default:
+	    break;
+      }
+
+      return vpiNoEdge;
+}
+
+/*
+ * The $width check measures from the reference edge to the opposite
+ * edge, so a posedge reference ends at the following negedge.
+ */
+static unsigned tchk_edge_opposite(unsigned mask)
+{
+      unsigned res = vpiNoEdge;
+      if (mask & vpiEdge01) res |= vpiEdge10;
+      if (mask & vpiEdge10) res |= vpiEdge01;
+      if (mask & vpiEdge0x) res |= vpiEdge1x;
+      if (mask & vpiEdge1x) res |= vpiEdge0x;
+      if (mask & vpiEdgex1) res |= vpiEdgex0;
+      if (mask & vpiEdgex0) res |= vpiEdgex1;
+      return res;
+}
+
+vvp_fun_tchk::vvp_fun_tchk(type_t type, unsigned ref_edge, unsigned data_edge,
+			   vvp_time64_t limit0, vvp_time64_t limit1)
+: type_(type), ref_edge_(ref_edge), data_edge_(data_edge),
+  ref_old_(BIT4_X), data_old_(BIT4_X), ref_cond_(true), data_cond_(true),
+  ref_seen_(false), data_seen_(false), ref_time_(0), data_time_(0),
+  notifier_(0), scope_(0), file_idx_(0), lineno_(0)
+{
+      limit_[0] = limit0;
+      limit_[1] = limit1;
+}
+
+vvp_fun_tchk::~vvp_fun_tchk()
+{
+}
+
+void vvp_fun_tchk::set_location(__vpiScope*scope, unsigned file_idx,
+				unsigned lineno)
+{
+      scope_ = scope;
+      file_idx_ = file_idx;
+      lineno_ = lineno;
+}
+
+vvp_time64_t vvp_fun_tchk::get_limit(unsigned idx) const
+{
+      assert(idx < 2);
+      return limit_[idx];
+}
+
+void vvp_fun_tchk::put_limit(unsigned idx, vvp_time64_t val)
+{
+      assert(idx < 2);
+      limit_[idx] = val;
+}
+
+void vvp_fun_tchk::recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
+			     vvp_context_t)
+{
+      if (schedule_settling_constants) {
+	    schedule_settled_edge(port, bit);
+	    return;
+      }
+
+      vvp_bit4_t val = bit.size() > 0 ? bit.value(0) : BIT4_X;
+      unsigned edge;
+
+      switch (port.port()) {
+	  case 0:
+	    edge = tchk_edge_mask(ref_old_, val);
+	    ref_old_ = val;
+	    if (edge != vpiNoEdge && ref_cond_)
+		  ref_event_(schedule_simtime(), edge);
+	    break;
+
+	  case 1:
+	    edge = tchk_edge_mask(data_old_, val);
+	    data_old_ = val;
+	    if ((edge & data_edge_) && data_cond_)
+		  data_event_(schedule_simtime());
+	    break;
+
+	  case 2:
+	    ref_cond_ = val != BIT4_0;
+	    break;
+
+	  case 3:
+	    data_cond_ = val != BIT4_0;
+	    break;
+      }
+}
+
+void vvp_fun_tchk::ref_event_(vvp_time64_t now, unsigned edge)
+{
+      if (type_ == WIDTH) {
+	    if (edge & ref_edge_) {
+		  ref_seen_ = true;
+		  ref_time_ = now;
+
+	    } else if (ref_seen_ && (edge & tchk_edge_opposite(ref_edge_))) {
+		    // Pulses no wider than the threshold are ignored.
+		  vvp_time64_t width = now - ref_time_;
+		  if (width < limit_[0] && width > limit_[1])
+			violation_(ref_time_, now, limit_[0]);
+		  ref_seen_ = false;
+	    }
+	    return;
+      }
+
+      if (! (edge & ref_edge_))
+	    return;
+
+      switch (type_) {
+	  case SETUP:
+	  case SETUPHOLD:
+	    if (data_seen_ && now - data_time_ < limit_[0])
+		  violation_(data_time_, now, limit_[0]);
+	    break;
+	  case PERIOD:
+	    if (ref_seen_ && now - ref_time_ < limit_[0])
+		  violation_(ref_time_, now, limit_[0]);
+	    break;
+	  default:
+	    break;
+      }
+
+      ref_seen_ = true;
+      ref_time_ = now;
+}
+
+void vvp_fun_tchk::data_event_(vvp_time64_t now)
+{
+      switch (type_) {
+	  case HOLD:
+	  case RECOVERY:
+	    if (ref_seen_ && now - ref_time_ < limit_[0])
+		  violation_(ref_time_, now, limit_[0]);
+	    break;
+	  case SETUPHOLD:
+	    if (ref_seen_ && now - ref_time_ < limit_[1])
+		  violation_(ref_time_, now, limit_[1]);
+	    break;
+	  default:
+	    break;
+      }
+
+      data_seen_ = true;
+      data_time_ = now;
+}
+
+/*
+ * Report a violation and toggle the notifier. The times are the time
+ * of the event that started the check and the event that failed it.
+ */
+void vvp_fun_tchk::violation_(vvp_time64_t stamp, vvp_time64_t check,
+			      vvp_time64_t limit)
+{
+      static const char*names[] = { "$setup", "$hold", "$setuphold",
+				    "$recovery", "$width", "$period" };
+
+      assert(file_idx_ < file_names.size());
+      vpi_mcd_printf(1, "%s:%u: %s timing violation in %s: events at "
+		     "%g and %g, limit %g.\n",
+		     file_names[file_idx_], lineno_, names[type_],
+		     scope_->vpi_get_str(vpiFullName),
+		     vpip_time_to_scaled_real(stamp, scope_),
+		     vpip_time_to_scaled_real(check, scope_),
+		     vpip_time_to_scaled_real(limit, scope_));
+
+      if (notifier_ == 0)
+	    return;
+
+	// The notifier goes from x to 0, then toggles between 0 and 1.
+	// A notifier that is z stays z.
+      vvp_signal_value*sig = dynamic_cast<vvp_signal_value*>(notifier_->fil);
+      assert(sig);
+      vvp_vector4_t val;
+      sig->vec4_value(val);
+      if (val.size() == 0 || val.value(0) == BIT4_Z)
+	    return;
+
+      val.set_bit(0, val.value(0) == BIT4_0 ? BIT4_1 : BIT4_0);
+      schedule_set_vector(vvp_net_ptr_t(notifier_, 0), val);
+}
+
 /*
  * All the below routines that begin with
  * modpath_src_* belong the internal function
@@ -1114,3 +1326,141 @@ struct __vpiModPathSrc* vpip_make_modpath_src(struct __vpiModPath*path,
 
       return obj;
 }
+
+/*
+ * The __vpiTchk object is what the VPI client sees as a vpiTchk. The
+ * limits of the check are read and written with vpi_get_delays and
+ * vpi_put_delays. Delay 0 is the limit (the setup limit of a
+ * $setuphold) and delay 1 is the hold limit of a $setuphold or the
+ * threshold of a $width.
+ */
+int __vpiTchkTerm::get_type_code(void) const
+{ return vpiTchkTerm; }
+
+int __vpiTchkTerm::vpi_get(int code)
+{
+      switch (code) {
+	  case vpiEdge:
+	    return edge;
+	  default:
+	    return 0;
+      }
+}
+
+vpiHandle __vpiTchkTerm::vpi_handle(int code)
+{
+      switch (code) {
+	  case vpiExpr:
+	    return expr;
+	  default:
+	    return 0;
+      }
+}
+
+__vpiTchk::__vpiTchk()
+: scope(0), fun(0), notifier(0)
+{
+      ref_term.expr = 0;
+      ref_term.edge = vpiNoEdge;
+      data_term.expr = 0;
+      data_term.edge = vpiNoEdge;
+}
+
+int __vpiTchk::get_type_code(void) const
+{ return vpiTchk; }
+
+int __vpiTchk::vpi_get(int code)
+{
+      static const int type_map[] = { vpiSetup, vpiHold, vpiSetupHold,
+				       vpiRecovery, vpiWidth, vpiPeriod };
+
+      switch (code) {
+	  case vpiTchkType:
+	    return type_map[fun->type()];
+	  case vpiLineNo:
+	    return fun->lineno();
+	  default:
+	    return vpiUndefined;
+      }
+}
+
+char* __vpiTchk::vpi_get_str(int code)
+{
+      if (code == vpiFile) {
+	    assert(fun->file_idx() < file_names.size());
+	    return simple_set_rbuf_str(file_names[fun->file_idx()]);
+      }
+
+      return 0;
+}
+
+vpiHandle __vpiTchk::vpi_handle(int code)
+{
+      switch (code) {
+	  case vpiTchkRefTerm:
+	    return &ref_term;
+	  case vpiTchkDataTerm:
+	    return data_term.expr ? &data_term : 0;
+	  case vpiTchkNotifier:
+	    return notifier;
+	  case vpiScope:
+	  case vpiModule:
+	    return scope;
+	  default:
+	    return 0;
+      }
+}
+
+static unsigned tchk_limit_count(const vvp_fun_tchk*fun)
+{
+      switch (fun->type()) {
+	  case vvp_fun_tchk::SETUPHOLD:
+	  case vvp_fun_tchk::WIDTH:
+	    return 2;
+	  default:
+	    return 1;
+      }
+}
+
+void __vpiTchk::vpi_get_delays(p_vpi_delay delays)
+{
+      unsigned cnt = tchk_limit_count(fun);
+      for (int idx = 0 ;  idx < delays->no_of_delays ;  idx += 1) {
+	    vvp_time64_t tmp = (unsigned)idx < cnt ? fun->get_limit(idx) : 0;
+	    if (delays->time_type == vpiSimTime)
+		  vpip_time_to_timestruct(delays->da+idx, tmp);
+	    else
+		  delays->da[idx].real = vpip_time_to_scaled_real(tmp, scope);
+      }
+}
+
+void __vpiTchk::vpi_put_delays(p_vpi_delay delays)
+{
+      unsigned cnt = tchk_limit_count(fun);
+      for (int idx = 0 ;  idx < delays->no_of_delays ;  idx += 1) {
+	    if ((unsigned)idx >= cnt)
+		  break;
+
+	    vvp_time64_t tmp;
+	    if (delays->time_type == vpiSimTime) {
+		  tmp = vpip_timestruct_to_time(delays->da+idx);
+	    } else {
+		    // A negative limit disables the check, like a 0 limit.
+		  double val = delays->da[idx].real;
+		  tmp = vpip_scaled_real_to_time64(val < 0.0 ? 0.0 : val,
+						   scope);
+	    }
+	    fun->put_limit(idx, tmp);
+      }
+}
+
+__vpiTchk* vpip_make_tchk(vvp_fun_tchk*fun)
+{
+      __vpiTchk*obj = new __vpiTchk;
+      obj->scope = vpip_peek_current_scope();
+      obj->fun = fun;
+      obj->ref_term.edge = fun->ref_edge();
+      obj->data_term.edge = fun->data_edge();
+      vpip_attach_to_current_scope(obj);
+      return obj;
+}
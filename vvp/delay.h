@@ -161,6 +161,13 @@ class vvp_fun_delay  : public vvp_net_fun_t, private vvp_gen_event_s {
 * inputs to enable delays, and the vvp_fun_modpath, when it's time to
 * schedule, looks at the associated modpath_src objects for which
 * paths are active.
+*
+* The vvp_fun_modpath keeps its sources in two doubly linked lists,
+* one for the normal paths and one for the ifnone paths. A source that
+* wakes up moves itself to the front of its list, and since the wake
+* time is always the current simulation time, the lists are always
+* sorted by wake time, latest first. The output only needs to look at
+* the front of the lists to find the active sources.
 */
 class vvp_fun_modpath;
 class vvp_fun_modpath_src;
@@ -176,9 +183,16 @@ class vvp_fun_modpath  : public vvp_net_fun_t, private vvp_gen_event_s {
       void recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
                      vvp_context_t);
 
+	// Called by a source when it wakes up.
+      void wake_src(vvp_fun_modpath_src*that);
+
     private:
       virtual void run_run();
 
+      vvp_time64_t select_delay_(vvp_fun_modpath_src*first,
+				 vvp_time64_t wake_time, unsigned edge_idx,
+				 vvp_time64_t now) const;
+
     private:
       vvp_net_t*net_;
 
@@ -214,6 +228,9 @@ class vvp_fun_modpath_src  : public vvp_net_fun_t {
       vvp_time64_t delay_[12];
 	// Used by vvp_fun_modpath to keep a list of modpath_src objects.
       vvp_fun_modpath_src*next_;
+      vvp_fun_modpath_src*prev_;
+      vvp_fun_modpath*owner_;
+      bool ifnone_;
 
       vvp_time64_t wake_time_;
       bool condition_flag_;
@@ -236,4 +253,82 @@ class vvp_fun_modpath_edge  : public vvp_fun_modpath_src {
       bool negedge_;
 };
 
+/*
+ * The vvp_fun_tchk functor implements a specify block timing check
+ * ($setup, $hold, $setuphold, $recovery, $width or $period). The
+ * inputs are:
+ *
+ *    port 0 -- The reference signal
+ *    port 1 -- The data signal
+ *    port 2 -- The &&& condition of the reference event
+ *    port 3 -- The &&& condition of the data event
+ *
+ * A condition that is 0 disables its event, any other value enables
+ * it. The functor remembers the time of the last enabled reference
+ * and data event, so every event is checked in constant time. The
+ * edges are vpiEdge masks, and the limits are in simulation ticks.
+ */
+class __vpiScope;
+
+class vvp_fun_tchk  : public vvp_net_fun_t {
+
+    public:
+	// These match the ivl_tchk_type_t values.
+      enum type_t { SETUP = 0, HOLD, SETUPHOLD, RECOVERY, WIDTH, PERIOD };
+
+      vvp_fun_tchk(type_t type, unsigned ref_edge, unsigned data_edge,
+		   vvp_time64_t limit0, vvp_time64_t limit1);
+      ~vvp_fun_tchk();
+
+      void recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
+                     vvp_context_t);
+
+      void set_location(__vpiScope*scope, unsigned file_idx, unsigned lineno);
+	// The notifier is bound when the compiler resolves its label.
+      vvp_net_t**notifier_ref() { return &notifier_; }
+
+      type_t type() const { return type_; }
+      unsigned ref_edge() const { return ref_edge_; }
+      unsigned data_edge() const { return data_edge_; }
+      __vpiScope*scope() const { return scope_; }
+      unsigned file_idx() const { return file_idx_; }
+      unsigned lineno() const { return lineno_; }
+
+      vvp_time64_t get_limit(unsigned idx) const;
+      void put_limit(unsigned idx, vvp_time64_t val);
+
+    private:
+      void ref_event_(vvp_time64_t now, unsigned edge);
+      void data_event_(vvp_time64_t now);
+      void violation_(vvp_time64_t stamp, vvp_time64_t check,
+		      vvp_time64_t limit);
+
+    private:
+      type_t type_;
+      unsigned ref_edge_;
+      unsigned data_edge_;
+      vvp_time64_t limit_[2];
+
+      vvp_bit4_t ref_old_;
+      vvp_bit4_t data_old_;
+      bool ref_cond_;
+      bool data_cond_;
+
+	// Times of the last reference and data events, if seen.
+      bool ref_seen_;
+      bool data_seen_;
+      vvp_time64_t ref_time_;
+      vvp_time64_t data_time_;
+
+      vvp_net_t*notifier_;
+
+      __vpiScope*scope_;
+      unsigned file_idx_;
+      unsigned lineno_;
+
+    private: // not implemented
+      vvp_fun_tchk(const vvp_fun_tchk&);
+      vvp_fun_tchk& operator= (const vvp_fun_tchk&);
+};
+
 #endif /* IVL_delay_H */
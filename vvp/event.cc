@@ -238,6 +238,15 @@ bool vvp_fun_edge::recv_vec4_(const vvp_vector4_t&bit,
       return false;
 }
 
+bool vvp_fun_edge::recv_vec4_part_(vthread_t&threads)
+{
+      if (edge_ == vvp_edge_none) {
+	    run_waiting_threads_(threads);
+	    return true;
+      }
+      return false;
+}
+
 vvp_fun_edge_sa::vvp_fun_edge_sa(edge_t e)
 : vvp_fun_edge(e), threads_(0)
 {
@@ -258,6 +267,10 @@ vthread_t vvp_fun_edge_sa::add_waiting_thread(vthread_t thread)
 void vvp_fun_edge_sa::recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
                                 vvp_context_t)
 {
+      if (schedule_settling_constants) {
+	    schedule_settled_edge(port, bit);
+	    return;
+      }
       if (recv_vec4_(bit, bits_[port.port()], threads_)) {
 	    vvp_net_t*net = port.ptr();
 	    net->send_vec4(bit, 0);
@@ -268,13 +281,95 @@ void vvp_fun_edge_sa::recv_vec4_pv(vvp_net_ptr_t port, const vvp_vector4_t&bit,
 				   unsigned base, unsigned wid, unsigned vwid,
 				   vvp_context_t)
 {
-      assert(base == 0);
-      if (recv_vec4_(bit, bits_[port.port()], threads_)) {
+      if (schedule_settling_constants) {
+	    schedule_settled_edge(port, bit, base, vwid);
+	    return;
+      }
+      bool flag = base == 0 ? recv_vec4_(bit, bits_[port.port()], threads_)
+			    : recv_vec4_part_(threads_);
+      if (flag) {
 	    vvp_net_t*net = port.ptr();
 	    net->send_vec4_pv(bit, base, wid, vwid, 0);
       }
 }
 
+vvp_fun_edge_vhdl::vvp_fun_edge_vhdl()
+: vvp_fun_edge_sa(vvp_edge_none), seen_(false), last_time_(0),
+  bit_seen_(false), bit_time_(0), last_bit_(BIT4_X), prev_bit_(BIT4_X)
+{
+}
+
+vvp_fun_edge_vhdl::~vvp_fun_edge_vhdl()
+{
+}
+
+void vvp_fun_edge_vhdl::note_event_(void)
+{
+      seen_ = true;
+      last_time_ = schedule_simtime();
+}
+
+void vvp_fun_edge_vhdl::note_bit_(const vvp_vector4_t&bit)
+{
+      vvp_bit4_t val = bit.size() > 0 ? bit.value(0) : BIT4_X;
+	/* A part that holds bit 0 may arrive with bit 0 unchanged. */
+      if (val == last_bit_)
+	    return;
+
+      bit_seen_ = true;
+      bit_time_ = schedule_simtime();
+      prev_bit_ = last_bit_;
+      last_bit_ = val;
+}
+
+void vvp_fun_edge_vhdl::recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
+                                  vvp_context_t context)
+{
+      if (schedule_settling_constants) {
+	    schedule_settled_edge(port, bit);
+	    return;
+      }
+	/* The signal filter only propagates real value changes, so
+	   every arrival here is a VHDL event on the signal. */
+      note_event_();
+      note_bit_(bit);
+      vvp_fun_edge_sa::recv_vec4(port, bit, context);
+}
+
+void vvp_fun_edge_vhdl::recv_vec4_pv(vvp_net_ptr_t port, const vvp_vector4_t&bit,
+				     unsigned base, unsigned wid, unsigned vwid,
+				     vvp_context_t context)
+{
+      if (schedule_settling_constants) {
+	    schedule_settled_edge(port, bit, base, vwid);
+	    return;
+      }
+	/* Any part is an event on the signal, but only a part that
+	   holds bit 0 says anything about the rising/falling tests. */
+      note_event_();
+      if (base == 0 && wid > 0)
+	    note_bit_(bit);
+      vvp_fun_edge_sa::recv_vec4_pv(port, bit, base, wid, vwid, context);
+}
+
+vvp_bit4_t vvp_fun_edge_vhdl::test(unsigned type) const
+{
+      vvp_time64_t now = schedule_simtime();
+
+      switch (type) {
+	  case 1:
+	    if (! bit_seen_ || bit_time_ != now)
+		  return BIT4_0;
+	    return (last_bit_ == BIT4_1 && prev_bit_ == BIT4_0) ? BIT4_1 : BIT4_0;
+	  case 2:
+	    if (! bit_seen_ || bit_time_ != now)
+		  return BIT4_0;
+	    return (last_bit_ == BIT4_0 && prev_bit_ == BIT4_1) ? BIT4_1 : BIT4_0;
+	  default:
+	    return (seen_ && last_time_ == now) ? BIT4_1 : BIT4_0;
+      }
+}
+
 vvp_fun_edge_aa::vvp_fun_edge_aa(edge_t e)
 : vvp_fun_edge(e)
 {
@@ -325,6 +420,10 @@ vthread_t vvp_fun_edge_aa::add_waiting_thread(vthread_t thread)
 void vvp_fun_edge_aa::recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
                                 vvp_context_t context)
 {
+      if (schedule_settling_constants) {
+	    schedule_settled_edge(port, bit);
+	    return;
+      }
       if (context) {
             vvp_fun_edge_state_s*state = static_cast<vvp_fun_edge_state_s*>
                   (vvp_get_context_item(context, context_idx_));
@@ -371,6 +470,16 @@ class anyedge_vec4_value : public anyedge_value {
       bool recv_vec4_pv(const vvp_vector4_t&bit, unsigned base,
 			unsigned wid, unsigned vwid);
 
+	// These compare only the part [pbase +: pwid] of the vector.
+      void set_part(const vvp_vector4_t&bit, unsigned pbase, unsigned pwid);
+
+      bool recv_vec4_part(const vvp_vector4_t&bit,
+			  unsigned pbase, unsigned pwid);
+
+      bool recv_vec4_pv_part(const vvp_vector4_t&bit, unsigned base,
+			     unsigned wid, unsigned vwid,
+			     unsigned pbase, unsigned pwid);
+
     private:
       vvp_vector4_t old_bits;
 };
@@ -462,8 +571,11 @@ struct vvp_fun_anyedge_state_s : public waitable_state_s {
 
 vvp_fun_anyedge::vvp_fun_anyedge()
 {
-      for (unsigned idx = 0 ;  idx < 4 ;  idx += 1)
+      for (unsigned idx = 0 ;  idx < 4 ;  idx += 1) {
 	    last_value_[idx] = 0;
+	    part_base_[idx] = 0;
+	    part_wid_[idx] = 0;
+      }
 }
 
 vvp_fun_anyedge::~vvp_fun_anyedge()
@@ -472,6 +584,13 @@ vvp_fun_anyedge::~vvp_fun_anyedge()
 	    delete last_value_[idx];
 }
 
+void vvp_fun_anyedge::set_part(unsigned port, unsigned base, unsigned wid)
+{
+      assert(port < 4);
+      part_base_[port] = base;
+      part_wid_[port] = wid;
+}
+
 void anyedge_vec4_value::duplicate(anyedge_value*&dup)
 {
       anyedge_vec4_value*dup_vec4 = get_vec4_value(dup);
@@ -529,6 +648,64 @@ bool anyedge_vec4_value::recv_vec4_pv(const vvp_vector4_t&bit, unsigned base,
       return recv_vec4(tmp);
 }
 
+void anyedge_vec4_value::set_part(const vvp_vector4_t&bit, unsigned pbase,
+				  unsigned pwid)
+{
+      if (pbase+pwid <= bit.size())
+	    old_bits = bit.subvalue(pbase, pwid);
+      else
+	    old_bits = bit;
+}
+
+/*
+ * An always_comb or always_latch process that only reads a constant
+ * select of a vector is only sensitive to those bits. Changes to the
+ * other bits are not compared at all. If the vector is too narrow for the part, then
+ * fall back to watching the whole vector.
+ */
+bool anyedge_vec4_value::recv_vec4_part(const vvp_vector4_t&bit,
+					unsigned pbase, unsigned pwid)
+{
+      if (pbase+pwid > bit.size())
+	    return recv_vec4(bit);
+
+      if (old_bits.size() == pwid) {
+	    bool flag = false;
+	    for (unsigned idx = 0 ;  idx < pwid ;  idx += 1) {
+		  if (old_bits.value(idx) != bit.value(pbase+idx)) {
+			flag = true;
+			break;
+		  }
+	    }
+	    if (! flag)
+		  return false;
+      }
+
+      return recv_vec4(bit.subvalue(pbase, pwid));
+}
+
+bool anyedge_vec4_value::recv_vec4_pv_part(const vvp_vector4_t&bit,
+					   unsigned base, unsigned wid,
+					   unsigned vwid,
+					   unsigned pbase, unsigned pwid)
+{
+      if (pbase+pwid > vwid)
+	    return recv_vec4_pv(bit, base, wid, vwid);
+
+      unsigned lo = base > pbase? base : pbase;
+      unsigned hi = (base+wid) < (pbase+pwid)? (base+wid) : (pbase+pwid);
+      if (lo >= hi)
+	    return false;
+
+      vvp_vector4_t tmp = old_bits;
+      if (tmp.size() != pwid)
+	    tmp = vvp_vector4_t(pwid, BIT4_Z);
+      for (unsigned idx = lo ;  idx < hi ;  idx += 1)
+	    tmp.set_bit(idx-pbase, bit.value(idx-base));
+
+      return recv_vec4(tmp);
+}
+
 void anyedge_real_value::duplicate(anyedge_value*&dup)
 {
       anyedge_real_value*dup_real = get_real_value(dup);
@@ -581,9 +758,17 @@ vthread_t vvp_fun_anyedge_sa::add_waiting_thread(vthread_t thread)
 void vvp_fun_anyedge_sa::recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
                                    vvp_context_t)
 {
-      anyedge_vec4_value*value = get_vec4_value(last_value_[port.port()]);
+      if (schedule_settling_constants) {
+	    schedule_settled_edge(port, bit);
+	    return;
+      }
+      unsigned pdx = port.port();
+      anyedge_vec4_value*value = get_vec4_value(last_value_[pdx]);
       assert(value);
-      if (value->recv_vec4(bit)) {
+      bool flag = part_wid_[pdx]
+	    ? value->recv_vec4_part(bit, part_base_[pdx], part_wid_[pdx])
+	    : value->recv_vec4(bit);
+      if (flag) {
 	    run_waiting_threads_(threads_);
 	    vvp_net_t*net = port.ptr();
 	    net->send_vec4(bit, 0);
@@ -594,9 +779,18 @@ void vvp_fun_anyedge_sa::recv_vec4_pv(vvp_net_ptr_t port, const vvp_vector4_t&bi
 				      unsigned base, unsigned wid, unsigned vwid,
 				      vvp_context_t)
 {
-      anyedge_vec4_value*value = get_vec4_value(last_value_[port.port()]);
+      if (schedule_settling_constants) {
+	    schedule_settled_edge(port, bit, base, vwid);
+	    return;
+      }
+      unsigned pdx = port.port();
+      anyedge_vec4_value*value = get_vec4_value(last_value_[pdx]);
       assert(value);
-      if (value->recv_vec4_pv(bit, base, wid, vwid)) {
+      bool flag = part_wid_[pdx]
+	    ? value->recv_vec4_pv_part(bit, base, wid, vwid,
+				       part_base_[pdx], part_wid_[pdx])
+	    : value->recv_vec4_pv(bit, base, wid, vwid);
+      if (flag) {
 	    run_waiting_threads_(threads_);
 	    vvp_net_t*net = port.ptr();
 	    net->send_vec4(bit, 0);
@@ -606,6 +800,10 @@ void vvp_fun_anyedge_sa::recv_vec4_pv(vvp_net_ptr_t port, const vvp_vector4_t&bi
 void vvp_fun_anyedge_sa::recv_real(vvp_net_ptr_t port, double bit,
                                    vvp_context_t)
 {
+      if (schedule_settling_constants) {
+	    schedule_settled_edge(port, bit);
+	    return;
+      }
       anyedge_real_value*value = get_real_value(last_value_[port.port()]);
       assert(value);
       if (value->recv_real(bit)) {
@@ -680,13 +878,21 @@ vthread_t vvp_fun_anyedge_aa::add_waiting_thread(vthread_t thread)
 void vvp_fun_anyedge_aa::recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
                                    vvp_context_t context)
 {
+      if (schedule_settling_constants) {
+	    schedule_settled_edge(port, bit);
+	    return;
+      }
       if (context) {
             vvp_fun_anyedge_state_s*state = static_cast<vvp_fun_anyedge_state_s*>
                   (vvp_get_context_item(context, context_idx_));
 
-            anyedge_vec4_value*value = get_vec4_value(state->last_value_[port.port()]);
+            unsigned pdx = port.port();
+            anyedge_vec4_value*value = get_vec4_value(state->last_value_[pdx]);
             assert(value);
-            if (value->recv_vec4(bit)) {
+            bool flag = part_wid_[pdx]
+                  ? value->recv_vec4_part(bit, part_base_[pdx], part_wid_[pdx])
+                  : value->recv_vec4(bit);
+            if (flag) {
                   run_waiting_threads_(state->threads);
                   vvp_net_t*net = port.ptr();
                   net->send_vec4(bit, context);
@@ -697,15 +903,23 @@ void vvp_fun_anyedge_aa::recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
                   recv_vec4(port, bit, context);
                   context = vvp_get_next_context(context);
             }
-            anyedge_vec4_value*value = get_vec4_value(last_value_[port.port()]);
+            unsigned pdx = port.port();
+            anyedge_vec4_value*value = get_vec4_value(last_value_[pdx]);
             assert(value);
-            value->set(bit);
+            if (part_wid_[pdx])
+                  value->set_part(bit, part_base_[pdx], part_wid_[pdx]);
+            else
+                  value->set(bit);
       }
 }
 
 void vvp_fun_anyedge_aa::recv_real(vvp_net_ptr_t port, double bit,
                                    vvp_context_t context)
 {
+      if (schedule_settling_constants) {
+	    schedule_settled_edge(port, bit);
+	    return;
+      }
       if (context) {
             vvp_fun_anyedge_state_s*state = static_cast<vvp_fun_anyedge_state_s*>
                   (vvp_get_context_item(context, context_idx_));
@@ -954,6 +1168,19 @@ void vvp_named_event_aa::recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
 
 static void compile_event_or(char*label, unsigned argc, struct symb_s*argv);
 
+static void compile_event_net(char*label, vvp_net_fun_t*fun,
+			      unsigned argc, struct symb_s*argv)
+{
+      vvp_net_t* ptr = new vvp_net_t;
+      ptr->fun = fun;
+
+      define_functor_symbol(label, ptr);
+      free(label);
+
+      inputs_connect(ptr, argc, argv);
+      free(argv);
+}
+
 void compile_event(char*label, char*type, unsigned argc, struct symb_s*argv)
 {
       vvp_net_fun_t*fun = 0;
@@ -973,6 +1200,14 @@ void compile_event(char*label, char*type, unsigned argc, struct symb_s*argv)
                   fun = new vvp_fun_anyedge_sa;
             }
 
+      } else if (strcmp(type,"vhdl") == 0) {
+
+	    free(type);
+	    assert(argc == 1);
+	      /* The VHDL edge detector only watches static signals,
+		 so it is never automatically allocated. */
+	    fun = new vvp_fun_edge_vhdl;
+
       } else {
 
 	    vvp_fun_edge::edge_t edge = vvp_edge_none;
@@ -993,14 +1228,39 @@ void compile_event(char*label, char*type, unsigned argc, struct symb_s*argv)
 
       }
 
-      vvp_net_t* ptr = new vvp_net_t;
-      ptr->fun = fun;
+      compile_event_net(label, fun, argc, argv);
+}
 
-      define_functor_symbol(label, ptr);
-      free(label);
+/*
+ * An "edge" event with a [base,wid, ...] list only watches a part of
+ * each input. The list has a base and width pair for each input,
+ * and a zero width watches the whole input.
+ */
+void compile_event_part(char*label, char*type, struct numbv_s parts,
+			unsigned argc, struct symb_s*argv)
+{
+      if (strcmp(type,"edge") != 0 || parts.cnt != 2*argc) {
+	    fprintf(stderr, "%s: Invalid part list for .event %s.\n",
+		    label, type);
+	    compile_errors += 1;
+	    numbv_clear(&parts);
+	    compile_event(label, type, argc, argv);
+	    return;
+      }
 
-      inputs_connect(ptr, argc, argv);
-      free(argv);
+      free(type);
+
+      vvp_fun_anyedge*fun;
+      if (vpip_peek_current_scope()->is_automatic())
+	    fun = new vvp_fun_anyedge_aa;
+      else
+	    fun = new vvp_fun_anyedge_sa;
+
+      for (unsigned idx = 0 ;  idx < argc ;  idx += 1)
+	    fun->set_part(idx, parts.nvec[2*idx+0], parts.nvec[2*idx+1]);
+      numbv_clear(&parts);
+
+      compile_event_net(label, fun, argc, argv);
 }
 
 static void compile_event_or(char*label, unsigned argc, struct symb_s*argv)
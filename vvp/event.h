@@ -159,6 +159,9 @@ class vvp_fun_edge : public vvp_net_fun_t, public waitable_hooks_s {
     protected:
       bool recv_vec4_(const vvp_vector4_t&bit,
                       vvp_bit4_t&old_bit, vthread_t&threads);
+	// A part that does not hold bit 0 cannot make an edge, so
+	// only an any edge functor wakes its threads for it.
+      bool recv_vec4_part_(vthread_t&threads);
 
       vvp_bit4_t bits_[4];
 
@@ -191,6 +194,46 @@ class vvp_fun_edge_sa : public vvp_fun_edge {
       vthread_t threads_;
 };
 
+/*
+ * The vvp_fun_edge_vhdl functor supports the VHDL 'event attribute and
+ * the rising_edge() and falling_edge() functions. It is attached to
+ * the output of a (static) signal and notes the simulation time and
+ * the LSB value of the most recent change. The %evtest instruction
+ * compares that against the current time, so no VPI callback or
+ * system function call is needed on each clock edge.
+ */
+class vvp_fun_edge_vhdl : public vvp_fun_edge_sa {
+
+    public:
+      explicit vvp_fun_edge_vhdl();
+      virtual ~vvp_fun_edge_vhdl();
+
+      void recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
+                     vvp_context_t context);
+      void recv_vec4_pv(vvp_net_ptr_t port, const vvp_vector4_t&bit,
+			unsigned base, unsigned wid, unsigned vwid,
+			vvp_context_t context);
+
+	// Return BIT4_1 if there was a change in this time step that
+	// matches the edge type (0 - any, 1 - rising, 2 - falling).
+      vvp_bit4_t test(unsigned type) const;
+
+    private:
+	// Note an event on any part of the signal.
+      void note_event_(void);
+	// Note a new value of bit 0, which the edge tests look at. Like
+	// the VHDL rising_edge() and falling_edge(), an edge needs the
+	// value before the change ('last_value) to be the opposite 0/1.
+      void note_bit_(const vvp_vector4_t&bit);
+
+      bool seen_;
+      vvp_time64_t last_time_;
+      bool bit_seen_;
+      vvp_time64_t bit_time_;
+      vvp_bit4_t last_bit_;
+      vvp_bit4_t prev_bit_;
+};
+
 /*
  * Automatically allocated vvp_fun_edge.
  */
@@ -238,8 +281,14 @@ class vvp_fun_anyedge : public vvp_net_fun_t, public waitable_hooks_s {
       explicit vvp_fun_anyedge();
       virtual ~vvp_fun_anyedge();
 
+	// Only watch the bits [base +: wid] of the vector on the
+	// port. A zero width (the default) watches the whole vector.
+      void set_part(unsigned port, unsigned base, unsigned wid);
+
     protected:
       anyedge_value*last_value_[4];
+      unsigned part_base_[4];
+      unsigned part_wid_[4];
 };
 
 /*
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "intrinsic.h"
+# include  "vpi_user.h"
+# include  <climits>
+
+/*
+ * These are the IEEE1364-2001 uniform generator routines, with slight
+ * modifications for 64bit machines. They are exported to the VPI
+ * modules as vpip_random_uniform() and vpip_dist_uniform(), so the
+ * $random et al. in vpi/sys_random.c and the intrinsic instructions
+ * use the one generator.
+ */
+
+#if ULONG_MAX > 4294967295UL
+# define UNIFORM_MAX INT_MAX
+# define UNIFORM_MIN INT_MIN
+#else
+# define UNIFORM_MAX LONG_MAX
+# define UNIFORM_MIN LONG_MIN
+#endif
+
+extern "C" double vpip_random_uniform(long*seed, long start, long end)
+{
+      double d = 0.00000011920928955078125;
+      double a, b, c;
+      unsigned long oldseed, newseed;
+
+      oldseed = *seed;
+      if (oldseed == 0)
+            oldseed = 259341593;
+
+      if (start >= end) {
+            a = 0.0;
+            b = 2147483647.0;
+      } else {
+            a = (double)start;
+            b = (double)end;
+      }
+
+      /* Original routine used signed arithmetic, and the (frequent)
+       * overflows trigger "Undefined Behavior" according to the
+       * C standard (both c89 and c99).  Using unsigned arithmetic
+       * forces a conforming C implementation to get the result
+       * that the IEEE-1364-2001 committee wants.
+       */
+      newseed = 69069 * oldseed + 1;
+
+      /* Emulate a 32-bit unsigned long, even if the native machine
+       * uses wider words.
+       */
+#if ULONG_MAX > 4294967295UL
+      newseed = newseed & 4294967295UL;
+#endif
+      *seed = newseed;
+
+      /* Convert from unsigned int to double without assuming IEEE
+       * 32-bit float. The constant is 2^(-23).
+       */
+      c = 1.0 + (newseed >> 9) * 0.00000011920928955078125;
+      c = c + (c*d);
+      c = ((b - a) * (c - 1.0)) + a;
+
+      return c;
+}
+
+extern "C" long vpip_dist_uniform(long*seed, long start, long end)
+{
+      double r;
+      long i;
+
+      if (start >= end) return(start);
+
+      /* NOTE: The cast of r to i can overflow and generate strange
+         values, so cast to unsigned long first. This eliminates
+         the underflow and gets the twos complement value. That in
+         turn can be cast to the long value that is expected. */
+
+      if (end != UNIFORM_MAX) {
+            end++;
+            r = vpip_random_uniform(seed, start, end);
+            if (r >= 0) {
+                  i = (unsigned long) r;
+            } else {
+	          i = - ( (unsigned long) (-(r - 1)) );
+            }
+            if (i < start) i = start;
+            if (i >= end) i = end - 1;
+      } else if (start != UNIFORM_MIN) {
+            start--;
+            r = vpip_random_uniform( seed, start, end) + 1.0;
+            if (r >= 0) {
+                  i = (unsigned long) r;
+            } else {
+	          i = - ( (unsigned long) (-(r - 1)) );
+            }
+            if (i <= start) i = start + 1;
+            if (i > end) i = end;
+      } else {
+            r = (vpip_random_uniform(seed, start, end) + 2147483648.0) / 4294967295.0;
+            r = r * 4294967296.0 - 2147483648.0;
+
+            if (r >= 0) {
+                  i = (unsigned long) r;
+            } else {
+	            /* At least some compilers will notice that (r-1)
+		       is <0 when castling to unsigned long and
+		       replace the result with a zero. This causes
+		       much wrongness, so do the casting to the
+		       positive version and invert it back. */
+	          i = - ( (unsigned long) (-(r - 1)) );
+            }
+      }
+
+      return i;
+}
+
+/*
+ * The generator state is shared with vpi/sys_random.c through the
+ * vpip_random_seed() and vpip_urandom_seed() extensions, so the
+ * intrinsic and the VPI calls continue the same sequence, and a
+ * seeded $urandom(seed) call reseeds the intrinsic calls too.
+ */
+static long random_seed = 0;
+static long urandom_seed = 0;
+
+extern "C" long* vpip_random_seed(void)
+{
+      return &random_seed;
+}
+
+extern "C" long* vpip_urandom_seed(void)
+{
+      return &urandom_seed;
+}
+
+long intrinsic_random(void)
+{
+      return vpip_dist_uniform(&random_seed, INT_MIN, INT_MAX);
+}
+
+unsigned long intrinsic_urandom(unsigned long max, unsigned long min)
+{
+      long max_i, min_i;
+
+      max_i =  max + INT_MIN;
+      min_i =  min + INT_MIN;
+      return vpip_dist_uniform(&urandom_seed, min_i, max_i) - INT_MIN;
+}
@@ -0,0 +1,32 @@
+#ifndef IVL_intrinsic_H
+#define IVL_intrinsic_H
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * These are the native implementations of the random number system
+ * functions that the %sys/random, %sys/urandom and %sys/urandom_range
+ * instructions use. They share the generator state with the unseeded
+ * $random, $urandom and $urandom_range in vpi/sys_random.c, so the
+ * two versions draw from the same stream.
+ */
+extern long intrinsic_random(void);
+extern unsigned long intrinsic_urandom(unsigned long max, unsigned long min);
+
+#endif /* IVL_intrinsic_H */
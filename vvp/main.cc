@@ -22,9 +22,12 @@
 # include  "config.h"
 # include  "parse_misc.h"
 # include  "compile.h"
+# include  "codes.h"
 # include  "schedule.h"
 # include  "vpi_priv.h"
 # include  "statistics.h"
+# include  "coverage.h"
+# include  "partition.h"
 # include  "vvp_cleanup.h"
 # include  "vvp_object.h"
 # include  <cstdio>
@@ -237,6 +240,8 @@ static void final_cleanup()
 
 #ifdef CHECK_WITH_VALGRIND
       simulator_cb_delete();
+      iterator_pool_delete();
+      array_iterator_pool_delete();
 	/* This is needed to prevent valgrind from complaining about
 	 * _dlerror_run() having a memory leak. */
 // HERE: Is this portable? Does it break anything?
@@ -255,6 +260,7 @@ int main(int argc, char*argv[])
       int opt;
       unsigned flag_errors = 0;
       const char*design_path = 0;
+      bool coverage_report_flag = false;
       struct rusage cycles[3];
       const char *logfile_name = 0x0;
       FILE *logfile = 0x0;
@@ -278,12 +284,18 @@ int main(int argc, char*argv[])
         /* For non-interactive runs we do not want to run the interactive
          * debugger, so make $stop just execute a $finish. */
       stop_is_finish = false;
-      while ((opt = getopt(argc, argv, "+hil:M:m:nNsvV")) != EOF) switch (opt) {
+      while ((opt = getopt(argc, argv, "+c:C:hH:il:M:m:nNPRsvV")) != EOF) switch (opt) {
          case 'h':
            fprintf(stderr,
                    "Usage: vvp [options] input-file [+plusargs...]\n"
                    "Options:\n"
+                   " -c scope       Collect coverage for scope and below.\n"
+                   "                Nets with strengths and array words\n"
+                   "                get no toggle coverage.\n"
+                   " -C file        Coverage database, default vvp.cov.\n"
                    " -h             Print this help message.\n"
+                   " -H file[,sec]  Write a performance heartbeat every sec\n"
+                   "                seconds (default 10) to file.\n"
                    " -i             Interactive mode (unbuffered stdio).\n"
                    " -l file        Logfile, '-' for <stderr>\n"
                    " -M path        VPI module directory\n"
@@ -291,10 +303,24 @@ int main(int argc, char*argv[])
                    " -m module      Load vpi module.\n"
 		   " -n             Non-interactive ($stop = $finish).\n"
                    " -N             Same as -n, but exit code is 1 instead of 0\n"
+                   " -P             Run each partition of the design in a\n"
+                   "                separate process.\n"
+                   " -R [file...]   Merge the coverage database files into\n"
+                   "                the -C database, and print a coverage\n"
+                   "                report instead of running a design.\n"
 		   " -s             $stop right away.\n"
                    " -v             Verbose progress messages.\n"
                    " -V             Print the version information.\n" );
            exit(0);
+	  case 'c':
+	    coverage_add_scope(optarg);
+	    break;
+	  case 'C':
+	    coverage_set_file(optarg);
+	    break;
+	  case 'H':
+	    perf_heartbeat_open(optarg);
+	    break;
 	  case 'i':
 	    setvbuf(stdout, 0, _IONBF, 0);
 	    break;
@@ -318,6 +344,12 @@ int main(int argc, char*argv[])
             stop_is_finish = true;
             stop_is_finish_exit_code = 1;
             break;
+	  case 'P':
+	    partition_enabled = true;
+	    break;
+	  case 'R':
+	    coverage_report_flag = true;
+	    break;
 	  case 's':
 	    schedule_stop(0);
 	    break;
@@ -358,7 +390,7 @@ int main(int argc, char*argv[])
 	    return 0;
       }
 
-      if (optind == argc) {
+      if (optind == argc && !coverage_report_flag) {
 	    fprintf(stderr, "%s: no input file.\n", argv[0]);
 	    return -1;
       }
@@ -370,7 +402,20 @@ int main(int argc, char*argv[])
 	    debug_file.open(path, ios::out);
       }
 
-      design_path = argv[optind];
+      if (const char*list = getenv("VVP_NO_MEMO")) {
+	    vvp_send_memo::disable(list);
+      }
+
+      if (getenv("VVP_NO_LAZY_CODE")) {
+	    codespace_lazy = false;
+      }
+
+      if (getenv("VVP_NO_CONST_INIT")) {
+	    schedule_init_constants = false;
+      }
+
+      if (! coverage_report_flag)
+	    design_path = argv[optind];
 
 	/* This is needed to get the MCD I/O routines ready for
 	   anything. It is done early because it is plausible that the
@@ -391,6 +436,9 @@ int main(int argc, char*argv[])
 
       vpip_mcd_init(logfile);
 
+      if (coverage_report_flag)
+	    return coverage_report(argc-optind, argv+optind);
+
       if (verbose_flag) {
 	    my_getrusage(cycles+0);
 	    vpi_mcd_printf(1, "Compiling VVP ...\n");
@@ -422,6 +470,7 @@ int main(int argc, char*argv[])
       }
 
       compile_cleanup();
+      coverage_check_lines();
 
       if (compile_errors > 0) {
 	    vpi_mcd_printf(1, "%s: Program not runnable, %u errors.\n",
@@ -437,10 +486,15 @@ int main(int argc, char*argv[])
 	    vpi_mcd_printf(1, "           %8lu bufif\n",  count_functors_bufif);
 	    vpi_mcd_printf(1, "           %8lu resolv\n",count_functors_resolv);
 	    vpi_mcd_printf(1, "           %8lu signals\n", count_functors_sig);
+	    vpi_mcd_printf(1, " ... %8lu fused variables (%zu bytes)\n",
+			   count_fused_vars, fused_var_heap_total());
 	    vpi_mcd_printf(1, " ... %8lu filters (net_fil pool=%zu bytes)\n",
 			   count_filters, vvp_net_fil_t::heap_total());
 	    vpi_mcd_printf(1, " ... %8lu opcodes (%zu bytes)\n",
 	                   count_opcodes, size_opcodes);
+	    if (codespace_lazy)
+		  vpi_mcd_printf(1, "           %8lu blocks (%zu bytes packed)\n",
+				 count_code_blocks, size_opcodes_packed);
 	    vpi_mcd_printf(1, " ... %8lu nets\n",     count_vpi_nets);
 	    vpi_mcd_printf(1, " ... %8lu vvp_nets (%zu bytes)\n",
 			   count_vvp_nets, size_vvp_nets);
@@ -462,7 +516,14 @@ int main(int argc, char*argv[])
       }
 
 
+      if (partition_enabled)
+	    partition_start();
+
+      perf_counters_start();
       schedule_simulate();
+      perf_heartbeat_close();
+
+      coverage_write();
 
       if (verbose_flag) {
 	    my_getrusage(cycles+2);
@@ -487,6 +548,26 @@ int main(int argc, char*argv[])
 			   count_assign_arword_pool());
 	    vpi_mcd_printf(1, "    %8lu other events (pool=%lu)\n",
 			   count_gen_events, count_gen_pool());
+	    vpi_mcd_printf(1, "    %8lu constant inputs sent before time 0\n",
+			   count_init_constants);
+	    vpi_mcd_printf(1, "    %8lu functor evaluations to settle them\n",
+			   count_init_settled);
+	    vpi_mcd_printf(1, "    %8lu events executed\n", count_events_run);
+	    vpi_mcd_printf(1, "    %8lu delta cycles\n", count_delta_cycles);
+	    vpi_mcd_printf(1, "    %8lu nonblocking assign events\n",
+			   count_nbassign_events);
+	    vpi_mcd_printf(1, "    %8lu thread runs\n", count_thread_runs);
+	    if (codespace_lazy)
+		  vpi_mcd_printf(1, "    %8lu of %lu opcodes decoded"
+				 " (%lu of %lu blocks)\n",
+				 count_opcodes_decoded, count_opcodes,
+				 count_code_blocks_decoded, count_code_blocks);
+	    vpi_mcd_printf(1, "    %8lu unchanged sends dropped\n",
+			   vvp_send_memo::suppressed_total());
+	    for (unsigned idx = 0 ; idx < vvp_send_memo::KIND_COUNT ; idx += 1)
+		  vpi_mcd_printf(1, "             ...%s %lu\n",
+				 vvp_send_memo::kind_name(idx),
+				 vvp_send_memo::suppressed(idx));
       }
 
       final_cleanup();
@@ -84,18 +84,19 @@ static struct __vpiModPath*modpath_dst = 0;
 %token K_CMP_EEQ K_CMP_EQ K_CMP_EQX K_CMP_EQZ K_CMP_WEQ K_CMP_WNE
 %token K_CMP_EQ_R K_CMP_NEE K_CMP_NE K_CMP_NE_R
 %token K_CMP_GE K_CMP_GE_R K_CMP_GE_S K_CMP_GT K_CMP_GT_R K_CMP_GT_S
+%token K_BOUNDARY
 %token K_CONCAT K_CONCAT8 K_DEBUG K_DELAY K_DFF_N K_DFF_N_ACLR
 %token K_DFF_N_ASET K_DFF_P K_DFF_P_ACLR K_DFF_P_ASET
 %token K_ENUM2 K_ENUM2_S K_ENUM4 K_ENUM4_S K_EVENT K_EVENT_OR
 %token K_EXPORT K_EXTEND_S K_FUNCTOR K_IMPORT K_ISLAND K_LATCH K_MODPATH
 %token K_NET K_NET_S K_NET_R K_NET_2S K_NET_2U
 %token K_NET8 K_NET8_2S K_NET8_2U K_NET8_S
-%token K_PARAM_STR K_PARAM_L K_PARAM_REAL K_PART K_PART_PV
+%token K_PARAM_STR K_PARAM_L K_PARAM_REAL K_PART K_PARTITION K_PART_PV
 %token K_PART_V K_PART_V_S K_PORT K_PORT_INFO K_PV K_REDUCE_AND K_REDUCE_OR K_REDUCE_XOR
 %token K_REDUCE_NAND K_REDUCE_NOR K_REDUCE_XNOR K_REPEAT
 %token K_RESOLV K_RTRAN K_RTRANIF0 K_RTRANIF1
 %token K_SCOPE K_SFUNC K_SFUNC_E K_SHIFTL K_SHIFTR K_SHIFTRS
-%token K_SUBSTITUTE
+%token K_SUBSTITUTE K_TCHK
 %token K_THREAD K_TIMESCALE K_TRAN K_TRANIF0 K_TRANIF1 K_TRANVP
 %token K_UFUNC_REAL K_UFUNC_VEC4 K_UFUNC_E K_UDP K_UDP_C K_UDP_S
 %token K_VAR K_VAR_COBJECT K_VAR_DARRAY
@@ -508,6 +509,16 @@ statement
    modpath_src_list ';'
     { modpath_dst = 0; }
 
+  /* Partition boundaries carry a net from one partition of the design
+     to the others that read it, with the delay of the driver of the
+     net. */
+ | T_LABEL K_BOUNDARY T_NUMBER '[' numbers ']' delay ',' symbol ',' symbol ';'
+    { compile_boundary($1, $3, $5, $7, $9, $11); }
+
+  /* Specify block timing checks. */
+ | T_LABEL K_TCHK T_NUMBER T_NUMBER T_NUMBER ',' numbers ',' symbols ';'
+    { compile_tchk($1, $3, $4, $5, $7, $9); }
+
   /* DFF nodes have an output and take up to 4 inputs. */
 
   | T_LABEL K_DFF_N T_NUMBER symbol ',' symbol ',' symbol ';'
@@ -614,6 +625,9 @@ statement
 	| T_LABEL K_EVENT K_DEBUG T_SYMBOL ',' symbols ';'
                 { compile_event($1, $4, $6.cnt, $6.vect); }
 
+	| T_LABEL K_EVENT T_SYMBOL '[' numbers ']' ',' symbols ';'
+                { compile_event_part($1, $3, $5, $8.cnt, $8.vect); }
+
 	| T_LABEL K_EVENT T_STRING ';'
 		{ compile_named_event($1, $3); }
 
@@ -725,6 +739,12 @@ statement
 	|         K_TIMESCALE '-' T_NUMBER '-' T_NUMBER';'
 		{ compile_timescale(-$3, -$5); }
 
+  /* The .partition directive sets the partition of the current scope
+     and the scopes inside it. */
+
+	|         K_PARTITION T_NUMBER ';'
+		{ compile_partition($2); }
+
   /* Thread statements declare a thread with its starting address. The
      starting address must already be defined. The .thread statement
      may also take an optional flag word. */
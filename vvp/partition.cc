@@ -0,0 +1,640 @@
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "partition.h"
+# include  "compile.h"
+# include  "vpi_priv.h"
+# include  <cassert>
+# include  <cerrno>
+# include  <cstdio>
+# include  <cstdlib>
+# include  <cstring>
+# include  <vector>
+#if !defined(__MINGW32__)
+# include  <fcntl.h>
+# include  <poll.h>
+# include  <unistd.h>
+# include  <sys/socket.h>
+# include  <sys/wait.h>
+#endif
+
+using namespace std;
+
+bool partition_enabled = false;
+unsigned partition_self = 0;
+unsigned partition_count = 1;
+vvp_time64_t partition_window_end = 0;
+
+static const vvp_time64_t TIME_NEVER = ~(vvp_time64_t)0;
+
+  /* The window length is the smallest delay of all the boundaries. */
+static vvp_time64_t partition_lookahead = TIME_NEVER;
+
+static vector<vvp_fun_boundary*> boundary_table;
+
+struct deferred_thread_s {
+      vthread_t thr;
+      unsigned part;
+      bool push_flag;
+      bool final_flag;
+};
+static vector<deferred_thread_s> deferred_threads;
+
+void partition_declare(unsigned part)
+{
+      if (part >= partition_count)
+	    partition_count = part + 1;
+}
+
+void partition_add_thread(vthread_t thr, __vpiScope*scope,
+			  bool push_flag, bool final_flag)
+{
+      deferred_thread_s tmp;
+      tmp.thr = thr;
+      tmp.part = scope? scope->partition : 0;
+      tmp.push_flag = push_flag;
+      tmp.final_flag = final_flag;
+      deferred_threads.push_back(tmp);
+}
+
+static void schedule_deferred_threads(void)
+{
+      for (size_t idx = 0 ; idx < deferred_threads.size() ; idx += 1) {
+	    deferred_thread_s&cur = deferred_threads[idx];
+	      /* The threads of the other partitions are never run
+		 in this process. */
+	    if (partition_enabled && cur.part != partition_self)
+		  continue;
+
+	    if (cur.final_flag)
+		  schedule_final_vthread(cur.thr);
+	    else
+		  schedule_vthread(cur.thr, 0, cur.push_flag);
+      }
+      deferred_threads.clear();
+}
+
+/*
+ * The partitions talk through a full mesh of stream sockets. Every
+ * message starts with this header, and a VALUE message is followed by
+ * the bits of the value, one byte per bit. A VALUE8 message is the
+ * same for a strength value, with the raw vvp_scalar_t encoding of
+ * each bit.
+ */
+enum msg_kind_t { MSG_VALUE = 1, MSG_END = 2, MSG_TIME = 3, MSG_VALUE8 = 4 };
+
+struct msg_head_s {
+      uint32_t kind;
+      uint32_t id;
+      uint64_t time;
+      uint32_t len;
+      uint32_t flag;
+};
+
+struct peer_s {
+      int fd;
+      vector<char> out;
+      size_t out_pos;
+      vector<char> in;
+      size_t in_pos;
+	// Set when the END or TIME message of this round is read.
+      bool end_seen;
+      bool time_seen;
+      bool have_time;
+      vvp_time64_t time;
+      bool finish;
+};
+
+static vector<peer_s> peers;
+static bool session_open = false;
+#if !defined(__MINGW32__)
+static vector<pid_t> children;
+#endif
+
+static void post_message(unsigned part, const msg_head_s&head,
+			 const char*data)
+{
+      assert(part < peers.size() && peers[part].fd >= 0);
+      vector<char>&out = peers[part].out;
+      const char*hp = reinterpret_cast<const char*>(&head);
+      out.insert(out.end(), hp, hp + sizeof head);
+      if (head.len > 0)
+	    out.insert(out.end(), data, data + head.len);
+}
+
+static void post_all(const msg_head_s&head)
+{
+      for (unsigned idx = 0 ; idx < peers.size() ; idx += 1) {
+	    if (peers[idx].fd >= 0)
+		  post_message(idx, head, 0);
+      }
+}
+
+/*
+ * Parse the complete messages in the input buffer of a peer. Parsing
+ * stops after the TIME message of the round, so that anything the
+ * peer already sent for the next round is left for the next round.
+ */
+static void parse_messages(peer_s&peer)
+{
+      while (! peer.time_seen) {
+	    size_t avail = peer.in.size() - peer.in_pos;
+	    if (avail < sizeof(msg_head_s))
+		  break;
+
+	    msg_head_s head;
+	    memcpy(&head, &peer.in[peer.in_pos], sizeof head);
+	    if (avail < sizeof head + head.len)
+		  break;
+
+	    const char*data = &peer.in[peer.in_pos + sizeof head];
+	    switch (head.kind) {
+		case MSG_VALUE: {
+		      assert(head.id < boundary_table.size());
+		      vvp_vector4_t val (head.len);
+		      for (unsigned idx = 0 ; idx < head.len ; idx += 1)
+			    val.set_bit(idx, (vvp_bit4_t)data[idx]);
+		      boundary_table[head.id]->receive(head.time, val);
+		      break;
+		}
+		case MSG_VALUE8: {
+		      assert(head.id < boundary_table.size());
+		      boundary_table[head.id]->receive(head.time, data, head.len);
+		      break;
+		}
+		case MSG_END:
+		  peer.end_seen = true;
+		  break;
+		case MSG_TIME:
+		  peer.time_seen = true;
+		  peer.have_time = head.id != 0;
+		  peer.time = head.time;
+		  peer.finish = head.flag != 0;
+		  break;
+		default:
+		  fprintf(stderr, "partition %u: Bad message kind %u\n",
+			  partition_self, head.kind);
+		  exit(1);
+	    }
+
+	    peer.in_pos += sizeof head + head.len;
+      }
+
+	/* Drop the consumed part of the buffer. */
+      if (peer.in_pos > 0 && peer.in_pos == peer.in.size()) {
+	    peer.in.clear();
+	    peer.in_pos = 0;
+      }
+}
+
+#if !defined(__MINGW32__)
+/*
+ * Send all the pending output to the peers and read from the peers
+ * until the test is true for all of them. Reading and writing are
+ * interleaved so that two partitions that both send a lot of values
+ * cannot deadlock on full socket buffers.
+ */
+static void exchange_until(bool (*done)(const peer_s&))
+{
+      vector<struct pollfd> fds;
+      vector<unsigned> fd_peer;
+
+      for (;;) {
+	    fds.clear();
+	    fd_peer.clear();
+
+	    for (unsigned idx = 0 ; idx < peers.size() ; idx += 1) {
+		  peer_s&peer = peers[idx];
+		  if (peer.fd < 0)
+			continue;
+
+		  parse_messages(peer);
+
+		  short events = 0;
+		  if (peer.out_pos < peer.out.size())
+			events |= POLLOUT;
+		  if (! done(peer))
+			events |= POLLIN;
+		  if (events == 0)
+			continue;
+
+		  struct pollfd tmp;
+		  tmp.fd = peer.fd;
+		  tmp.events = events;
+		  tmp.revents = 0;
+		  fds.push_back(tmp);
+		  fd_peer.push_back(idx);
+	    }
+
+	    if (fds.empty())
+		  return;
+
+	    int rc = poll(&fds[0], fds.size(), -1);
+	    if (rc < 0) {
+		  if (errno == EINTR)
+			continue;
+		  perror("partition poll");
+		  exit(1);
+	    }
+
+	    for (size_t idx = 0 ; idx < fds.size() ; idx += 1) {
+		  peer_s&peer = peers[fd_peer[idx]];
+
+		  if (fds[idx].revents & POLLOUT) {
+			ssize_t cnt = write(peer.fd, &peer.out[peer.out_pos],
+					    peer.out.size() - peer.out_pos);
+			if (cnt < 0 && errno != EAGAIN && errno != EINTR) {
+			      perror("partition write");
+			      exit(1);
+			}
+			if (cnt > 0)
+			      peer.out_pos += cnt;
+			if (peer.out_pos == peer.out.size()) {
+			      peer.out.clear();
+			      peer.out_pos = 0;
+			}
+		  }
+
+		  if (fds[idx].revents & (POLLIN|POLLHUP|POLLERR)) {
+			char buf[65536];
+			ssize_t cnt = read(peer.fd, buf, sizeof buf);
+			if (cnt < 0 && errno != EAGAIN && errno != EINTR) {
+			      perror("partition read");
+			      exit(1);
+			}
+			if (cnt == 0) {
+			      fprintf(stderr, "partition %u: Partition %u "
+				      "exited unexpectedly.\n",
+				      partition_self, fd_peer[idx]);
+			      exit(1);
+			}
+			if (cnt > 0)
+			      peer.in.insert(peer.in.end(), buf, buf + cnt);
+		  }
+	    }
+      }
+}
+#else
+static void exchange_until(bool (*)(const peer_s&))
+{
+}
+#endif
+
+static bool end_done(const peer_s&peer)
+{
+      return peer.end_seen;
+}
+
+static bool time_done(const peer_s&peer)
+{
+      return peer.time_seen;
+}
+
+void partition_start(void)
+{
+      if (partition_count <= 1) {
+	    partition_enabled = false;
+	    schedule_deferred_threads();
+	    return;
+      }
+
+#if defined(__MINGW32__)
+      fprintf(stderr, "Warning: Distributed simulation is not supported "
+	      "on this platform, running %u partitions in one process.\n",
+	      partition_count);
+      partition_enabled = false;
+      schedule_deferred_threads();
+#else
+      unsigned count = partition_count;
+
+	/* Make a socket pair for every pair of partitions. The
+	   fd_tab[a*count+b] is the end that partition a uses to talk
+	   to partition b. */
+      vector<int> fd_tab (count*count, -1);
+      for (unsigned a = 0 ; a < count ; a += 1) {
+	    for (unsigned b = a+1 ; b < count ; b += 1) {
+		  int sv[2];
+		  if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0) {
+			perror("partition socketpair");
+			exit(1);
+		  }
+		  fd_tab[a*count+b] = sv[0];
+		  fd_tab[b*count+a] = sv[1];
+	    }
+      }
+
+	/* Make sure the buffered output is not duplicated into the
+	   children. */
+      fflush(stdout);
+      fflush(stderr);
+
+      partition_self = 0;
+      for (unsigned part = 1 ; part < count ; part += 1) {
+	    pid_t pid = fork();
+	    if (pid < 0) {
+		  perror("partition fork");
+		  exit(1);
+	    }
+	    if (pid == 0) {
+		  partition_self = part;
+		  children.clear();
+		  break;
+	    }
+	    children.push_back(pid);
+      }
+
+      peers.resize(count);
+      for (unsigned idx = 0 ; idx < count*count ; idx += 1) {
+	    if (fd_tab[idx] < 0)
+		  continue;
+	    unsigned a = idx / count;
+	    unsigned b = idx % count;
+	    if (a != partition_self) {
+		  close(fd_tab[idx]);
+		  continue;
+	    }
+	    fcntl(fd_tab[idx], F_SETFL, fcntl(fd_tab[idx], F_GETFL) | O_NONBLOCK);
+	    peers[b].fd = fd_tab[idx];
+      }
+      peers[partition_self].fd = -1;
+      for (unsigned idx = 0 ; idx < count ; idx += 1) {
+	    peers[idx].out_pos = 0;
+	    peers[idx].in_pos = 0;
+	    peers[idx].end_seen = false;
+	    peers[idx].time_seen = false;
+      }
+
+      session_open = true;
+      partition_window_end = 0;
+      schedule_deferred_threads();
+#endif
+}
+
+void partition_exchange(void)
+{
+      msg_head_s head;
+      memset(&head, 0, sizeof head);
+      head.kind = MSG_END;
+      post_all(head);
+
+      exchange_until(end_done);
+}
+
+bool partition_agree(bool have_next, vvp_time64_t next_time,
+		     bool finish_flag)
+{
+      msg_head_s head;
+      memset(&head, 0, sizeof head);
+      head.kind = MSG_TIME;
+      head.id = have_next? 1 : 0;
+      head.time = next_time;
+      head.flag = finish_flag? 1 : 0;
+      post_all(head);
+
+      exchange_until(time_done);
+
+	/* All the partitions now know the same next times, so they
+	   all pick the same next window. */
+      bool any_next = have_next;
+      vvp_time64_t min_time = have_next? next_time : TIME_NEVER;
+      bool any_finish = finish_flag;
+      for (unsigned idx = 0 ; idx < peers.size() ; idx += 1) {
+	    peer_s&peer = peers[idx];
+	    if (peer.fd < 0)
+		  continue;
+	    if (peer.have_time && (!any_next || peer.time < min_time))
+		  min_time = peer.time;
+	    any_next |= peer.have_time;
+	    any_finish |= peer.finish;
+	    peer.end_seen = false;
+	    peer.time_seen = false;
+      }
+
+	/* A $finish ends the simulation at the end of this window.
+	   The events after it are not run in any partition. */
+      if (any_finish || !any_next) {
+	    session_open = false;
+	    return false;
+      }
+
+      if (min_time > TIME_NEVER - partition_lookahead)
+	    partition_window_end = TIME_NEVER;
+      else
+	    partition_window_end = min_time + partition_lookahead;
+
+      return true;
+}
+
+void partition_finish(void)
+{
+      if (session_open) {
+	    partition_exchange();
+	    partition_agree(false, 0, true);
+      }
+
+#if !defined(__MINGW32__)
+      for (unsigned idx = 0 ; idx < peers.size() ; idx += 1) {
+	    if (peers[idx].fd >= 0)
+		  close(peers[idx].fd);
+	    peers[idx].fd = -1;
+      }
+
+      for (size_t idx = 0 ; idx < children.size() ; idx += 1)
+	    waitpid(children[idx], 0, 0);
+      children.clear();
+#endif
+}
+
+vvp_fun_boundary::vvp_fun_boundary(vvp_net_t*net, unsigned driver,
+				   const vector<unsigned>&receivers,
+				   const vvp_delay_t&delay)
+: net_(net), driver_(driver), receivers_(receivers), delay_(delay)
+{
+      id_ = boundary_table.size();
+      boundary_table.push_back(this);
+      if (delay_.get_min_delay() < partition_lookahead)
+	    partition_lookahead = delay_.get_min_delay();
+}
+
+vvp_fun_boundary::~vvp_fun_boundary()
+{
+}
+
+bool vvp_fun_boundary::local_input_() const
+{
+	/* The partitions that read the boundary get their values
+	   from the driving partition, not from the local copy. */
+      if (! partition_enabled)
+	    return true;
+      for (size_t idx = 0 ; idx < receivers_.size() ; idx += 1) {
+	    if (receivers_[idx] == partition_self)
+		  return false;
+      }
+      return true;
+}
+
+bool vvp_fun_boundary::send_remote_() const
+{
+      return partition_enabled && partition_self == driver_;
+}
+
+/*
+ * Use the largest delay of all the bit changes, like vvp_fun_delay
+ * does. The first value is compared with X.
+ */
+vvp_time64_t vvp_fun_boundary::send_delay_(const vvp_vector4_t&bit)
+{
+      if (sent_.size() != bit.size())
+	    sent_ = vvp_vector4_t(bit.size(), BIT4_X);
+
+      vvp_time64_t use_delay = delay_.get_min_delay();
+      for (unsigned idx = 0 ; idx < bit.size() ; idx += 1) {
+	    vvp_time64_t tmp = delay_.get_delay(sent_.value(idx), bit.value(idx));
+	    if (tmp > use_delay) use_delay = tmp;
+      }
+
+      sent_ = bit;
+      return use_delay;
+}
+
+void vvp_fun_boundary::post_value_(unsigned kind, vvp_time64_t delay,
+				   const vector<char>&data)
+{
+      msg_head_s head;
+      memset(&head, 0, sizeof head);
+      head.kind = kind;
+      head.id = id_;
+      head.time = schedule_simtime() + delay;
+      head.len = data.size();
+
+      for (size_t idx = 0 ; idx < receivers_.size() ; idx += 1)
+	    post_message(receivers_[idx], head, head.len? &data[0] : 0);
+}
+
+void vvp_fun_boundary::recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
+				 vvp_context_t)
+{
+      switch (port.port()) {
+	  case 0:
+	    if (local_input_())
+		  net_->send_vec4(bit, 0);
+	    break;
+
+	  case 1:
+	    if (send_remote_()) {
+		  vector<char> data (bit.size());
+		  for (unsigned idx = 0 ; idx < data.size() ; idx += 1)
+			data[idx] = bit.value(idx);
+
+		  post_value_(MSG_VALUE, send_delay_(bit), data);
+	    }
+	    break;
+
+	  default:
+	    break;
+      }
+}
+
+void vvp_fun_boundary::recv_vec4_pv(vvp_net_ptr_t port, const vvp_vector4_t&bit,
+				    unsigned base, unsigned wid, unsigned vwid,
+				    vvp_context_t ctx)
+{
+      recv_vec4_pv_(port, bit, base, wid, vwid, ctx);
+}
+
+void vvp_fun_boundary::recv_vec8(vvp_net_ptr_t port, const vvp_vector8_t&bit)
+{
+      switch (port.port()) {
+	  case 0:
+	    if (local_input_())
+		  net_->send_vec8(bit);
+	    break;
+
+	  case 1:
+	    if (send_remote_()) {
+		  vector<char> data (bit.size());
+		  for (unsigned idx = 0 ; idx < data.size() ; idx += 1)
+			data[idx] = bit.value(idx).raw();
+
+		  post_value_(MSG_VALUE8, send_delay_(reduce4(bit)), data);
+	    }
+	    break;
+
+	  default:
+	    break;
+      }
+}
+
+void vvp_fun_boundary::recv_vec8_pv(vvp_net_ptr_t port, const vvp_vector8_t&bit,
+				    unsigned base, unsigned wid, unsigned vwid)
+{
+      recv_vec8_pv_(port, bit, base, wid, vwid);
+}
+
+void vvp_fun_boundary::receive(vvp_time64_t at, const vvp_vector4_t&bit)
+{
+      vvp_time64_t now = schedule_simtime();
+      assert(at >= now);
+      schedule_propagate_vector(net_, at - now, bit);
+}
+
+void vvp_fun_boundary::receive(vvp_time64_t at, const char*raw, unsigned wid)
+{
+      vvp_vector8_t bit (wid);
+      for (unsigned idx = 0 ; idx < wid ; idx += 1)
+	    bit.set_bit(idx, vvp_scalar_t((unsigned char)raw[idx]));
+
+      vvp_time64_t now = schedule_simtime();
+      assert(at >= now);
+      schedule_propagate_vector(net_, at - now, bit);
+}
+
+void compile_boundary(char*label, unsigned driver, struct numbv_s receivers,
+		      vvp_delay_t*delay, struct symb_s input,
+		      struct symb_s source)
+{
+      vvp_net_t*net = new vvp_net_t;
+
+	/* The boundary takes its delay from the driver of the net, so
+	   the delay must not be zero or there can be no time window.
+	   Do not make one up, because that would change the timing of
+	   the design. */
+      if (delay->get_min_delay() == 0) {
+	    fprintf(stderr, "%s: .boundary must have a non-zero delay\n",
+		    label);
+	    compile_errors += 1;
+      }
+
+      vector<unsigned> rcv (receivers.cnt);
+      for (unsigned idx = 0 ; idx < receivers.cnt ; idx += 1) {
+	    rcv[idx] = receivers.nvec[idx];
+	    partition_declare(rcv[idx]);
+      }
+      numbv_clear(&receivers);
+      partition_declare(driver);
+
+      vvp_fun_boundary*obj = new vvp_fun_boundary(net, driver, rcv, *delay);
+      net->fun = obj;
+      delete delay;
+
+      input_connect(net, 0, input.text);
+      input_connect(net, 1, source.text);
+      define_functor_symbol(label, net);
+      free(label);
+}
@@ -0,0 +1,141 @@
+#ifndef IVL_partition_H
+#define IVL_partition_H
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "vvp_net.h"
+# include  "schedule.h"
+# include  "delay.h"
+# include  <vector>
+
+class __vpiScope;
+
+/*
+ * A design may be split into partitions by the compiler. Every scope
+ * belongs to a partition (the .partition directive) and the nets that
+ * cross from one partition to another pass through .boundary
+ * functors. A boundary does not add any delay of its own. Its delay is
+ * the delay of the gate or continuous assignment that drives the net,
+ * which is the lookahead of the distributed simulation.
+ *
+ * With the -P flag, vvp forks a process for each partition after the
+ * design is compiled. Each process runs only the threads of its own
+ * partition, and sends the values of the boundaries that it drives to
+ * the process that reads them. The processes advance in lock step
+ * through time windows as long as the smallest boundary delay, so no
+ * process can receive a value for a time it has already passed.
+ */
+extern bool partition_enabled;
+extern unsigned partition_self;
+extern unsigned partition_count;
+
+  /* The scheduler synchronizes with the other partitions before
+     running any event at or after this time. */
+extern vvp_time64_t partition_window_end;
+
+  /* Note that the design has the given partition. */
+extern void partition_declare(unsigned part);
+
+  /* In a distributed simulation the threads are not scheduled until
+     the process knows which partition it runs. */
+extern void partition_add_thread(vthread_t thr, __vpiScope*scope,
+				 bool push_flag, bool final_flag);
+
+  /* Fork the partition processes and schedule the threads of this
+     partition. */
+extern void partition_start(void);
+
+  /* Exchange the boundary values and the next event times with the
+     other partitions. The next time is the time of the next local
+     event, if there is one. The finish flag is true if this partition
+     called $finish. Return false if the simulation is over in all the
+     partitions.
+
+     A $finish is only seen by the other partitions at the end of the
+     time window, so they may still run the events of the rest of the
+     window, at most the smallest boundary delay past the $finish.
+     Nothing after the window is run. */
+extern void partition_exchange(void);
+extern bool partition_agree(bool have_next, vvp_time64_t next_time,
+			    bool finish_flag);
+
+  /* Tell the other partitions that this one is done, and wait for
+     the child processes. */
+extern void partition_finish(void);
+
+/*
+ * The vvp_fun_boundary functor has two inputs. Port 0 is the output of
+ * the .delay node of the driver, and is passed through unchanged, so
+ * in a single process the boundary is invisible. Port 1 is the value
+ * before that delay. In a distributed simulation the partition that
+ * drives the boundary sends the port 1 values to the partitions that
+ * read it, stamped with the time the delay node would give them, and
+ * the reading partitions ignore their own inputs. Part values are
+ * widened to the full vector, like most functors do, and strength
+ * values keep their strength across the boundary.
+ */
+class vvp_fun_boundary  : public vvp_net_fun_t {
+
+    public:
+      vvp_fun_boundary(vvp_net_t*net, unsigned driver,
+		       const std::vector<unsigned>&receivers,
+		       const vvp_delay_t&delay);
+      ~vvp_fun_boundary();
+
+      void recv_vec4(vvp_net_ptr_t port, const vvp_vector4_t&bit,
+                     vvp_context_t);
+      void recv_vec4_pv(vvp_net_ptr_t port, const vvp_vector4_t&bit,
+			unsigned base, unsigned wid, unsigned vwid,
+			vvp_context_t);
+      void recv_vec8(vvp_net_ptr_t port, const vvp_vector8_t&bit);
+      void recv_vec8_pv(vvp_net_ptr_t port, const vvp_vector8_t&bit,
+			unsigned base, unsigned wid, unsigned vwid);
+
+	// Receive a value from the driving partition.
+      void receive(vvp_time64_t at, const vvp_vector4_t&bit);
+	// Receive a strength value, as the raw encoding of each bit.
+      void receive(vvp_time64_t at, const char*raw, unsigned wid);
+
+      unsigned id() const { return id_; }
+
+    private:
+	// True if this process uses the local input of the boundary.
+      bool local_input_() const;
+	// True if this process sends the value to the receiver.
+      bool send_remote_() const;
+	// The delay of a change from the last value sent, like the
+	// .delay node of the driver calculates it.
+      vvp_time64_t send_delay_(const vvp_vector4_t&bit);
+      void post_value_(unsigned kind, vvp_time64_t delay,
+		       const std::vector<char>&data);
+
+    private:
+      vvp_net_t*net_;
+      unsigned id_;
+      unsigned driver_;
+      std::vector<unsigned> receivers_;
+      vvp_delay_t delay_;
+      vvp_vector4_t sent_;
+
+    private: // not implemented
+      vvp_fun_boundary(const vvp_fun_boundary&);
+      vvp_fun_boundary& operator= (const vvp_fun_boundary&);
+};
+
+#endif /* IVL_partition_H */
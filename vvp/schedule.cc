@@ -24,12 +24,16 @@
 # include  "vvp_net_sig.h"
 # include  "slab.h"
 # include  "compile.h"
+# include  "statistics.h"
+# include  "partition.h"
 # include  <new>
 # include  <typeinfo>
 # include  <csignal>
 # include  <cstdlib>
 # include  <cassert>
 # include  <iostream>
+# include  <set>
+# include  <vector>
 #ifdef CHECK_WITH_VALGRIND
 # include  "vvp_cleanup.h"
 # include  "ivl_alloc.h"
@@ -40,6 +44,15 @@ unsigned long count_gen_events = 0;
 unsigned long count_thread_events = 0;
   // Count the time events (A time cell created)
 unsigned long count_time_events = 0;
+  // Count the events executed, the delta cycles and the nonblocking
+  // assignments scheduled. These are the $ivl_perf_counters values.
+unsigned long count_events_run = 0;
+unsigned long count_delta_cycles = 0;
+unsigned long count_nbassign_events = 0;
+  // Count the constant inputs that were sent before time 0.
+unsigned long count_init_constants = 0;
+  // Count the functor evaluations that settled them.
+unsigned long count_init_settled = 0;
 
 
 
@@ -432,6 +445,30 @@ void propagate_vector4_event_s::single_step_display(void)
       cerr << "propagate_vector4_event: Propagate val=" << val << endl;
 }
 
+struct propagate_vector8_event_s : public event_s {
+      explicit propagate_vector8_event_s(const vvp_vector8_t&that) : val(that) {
+	    net = NULL;
+      }
+
+	/* Propagate the output of this net. */
+      vvp_net_t*net;
+	/* value to propagate */
+      vvp_vector8_t val;
+	/* Action */
+      void run_run(void);
+      void single_step_display(void);
+};
+
+void propagate_vector8_event_s::run_run(void)
+{
+      net->send_vec8(val);
+}
+
+void propagate_vector8_event_s::single_step_display(void)
+{
+      cerr << "propagate_vector8_event: Propagate val=" << val << endl;
+}
+
 /*
  * This class supports the propagation of real outputs from a
  * vvp_net_t object.
@@ -756,6 +793,7 @@ static void schedule_event_(struct event_s*cur, vvp_time64_t delay,
 	    break;
 
 	  case SEQ_NBASSIGN:
+	    count_nbassign_events += 1;
 	    q = &ctim->nbassign;
 	    break;
 
@@ -891,6 +929,16 @@ void schedule_propagate_vector(vvp_net_t*net,
       schedule_event_(cur, delay, SEQ_NBASSIGN);
 }
 
+void schedule_propagate_vector(vvp_net_t*net,
+			       vvp_time64_t delay,
+			       const vvp_vector8_t&src)
+{
+      struct propagate_vector8_event_s*cur
+	    = new struct propagate_vector8_event_s(src);
+      cur->net = net;
+      schedule_event_(cur, delay, SEQ_NBASSIGN);
+}
+
 void schedule_assign_array_word(vvp_array_t mem,
 				unsigned word_addr,
 				unsigned off,
@@ -967,6 +1015,157 @@ void schedule_init_vector(vvp_net_ptr_t ptr, double bit)
       schedule_init_event(cur);
 }
 
+/*
+ * The constant inputs of functors are kept in these tables until the
+ * simulation starts. They are not events, so there is no event to
+ * allocate and no queue to go through for each of them.
+ */
+template <class T> struct init_constant_s {
+      init_constant_s(vvp_net_ptr_t p, const T&v) : ptr(p), val(v) { }
+      vvp_net_ptr_t ptr;
+      T val;
+};
+
+bool schedule_init_constants = true;
+bool schedule_settling_constants = false;
+
+  /* The functors that the constants wake while they settle. They are
+     evaluated in order from this list instead of through events. */
+static std::vector<vvp_gen_event_t> settle_list;
+
+  /* The signals whose value change callbacks wait for time 0. A signal
+     is listed each time it changes, so the list may repeat it. */
+static std::vector<vvp_vpi_callback*> settled_callbacks_list;
+
+struct settled_callbacks_event_s : public event_s {
+      std::vector<vvp_vpi_callback*> list;
+      void run_run(void);
+};
+
+void settled_callbacks_event_s::run_run(void)
+{
+      for (size_t idx = 0 ; idx < list.size() ; idx += 1)
+	    list[idx]->run_settled_callbacks();
+}
+
+static std::vector< init_constant_s<vvp_vector4_t> > init_constant4_list;
+static std::vector< init_constant_s<vvp_vector8_t> > init_constant8_list;
+static std::vector< init_constant_s<double> > init_constantr_list;
+
+void schedule_init_constant(vvp_net_ptr_t ptr, const vvp_vector4_t&bit)
+{
+      if (! schedule_init_constants) {
+	    schedule_set_vector(ptr, bit);
+	    return;
+      }
+      init_constant4_list.push_back(init_constant_s<vvp_vector4_t>(ptr, bit));
+}
+
+void schedule_init_constant(vvp_net_ptr_t ptr, const vvp_vector8_t&bit)
+{
+      if (! schedule_init_constants) {
+	    schedule_set_vector(ptr, bit);
+	    return;
+      }
+      init_constant8_list.push_back(init_constant_s<vvp_vector8_t>(ptr, bit));
+}
+
+void schedule_init_constant(vvp_net_ptr_t ptr, double bit)
+{
+      if (! schedule_init_constants) {
+	    schedule_set_vector(ptr, bit);
+	    return;
+      }
+      init_constantr_list.push_back(init_constant_s<double>(ptr, bit));
+}
+
+void schedule_settled_edge(vvp_net_ptr_t ptr, const vvp_vector4_t&bit,
+			   unsigned base, unsigned vwid)
+{
+      struct assign_vector4_event_s*cur = new struct assign_vector4_event_s(bit);
+      cur->ptr = ptr;
+      cur->base = base;
+      cur->vwid = vwid;
+      schedule_event_(cur, 0, SEQ_ACTIVE);
+}
+
+void schedule_settled_edge(vvp_net_ptr_t ptr, double bit)
+{
+      schedule_set_vector(ptr, bit);
+}
+
+void schedule_settled_callbacks(vvp_vpi_callback*obj)
+{
+      settled_callbacks_list.push_back(obj);
+}
+
+/*
+ * Run the callbacks of each listed signal once, in the order the
+ * signals first changed.
+ */
+static void push_settled_callbacks(void)
+{
+      if (settled_callbacks_list.empty())
+	    return;
+
+      settled_callbacks_event_s*cur = new settled_callbacks_event_s;
+      std::set<vvp_vpi_callback*> seen;
+      for (size_t idx = 0 ; idx < settled_callbacks_list.size() ; idx += 1) {
+	    vvp_vpi_callback*obj = settled_callbacks_list[idx];
+	    if (seen.insert(obj).second)
+		  cur->list.push_back(obj);
+      }
+      std::vector<vvp_vpi_callback*>().swap(settled_callbacks_list);
+
+      schedule_event_push_(cur);
+}
+
+/*
+ * Send all the constant inputs, and release the tables. The logic
+ * they drive is evaluated right here, at load time: the functors that
+ * the constants wake are kept in a plain list and run in the order
+ * they woke, so there is no event to allocate or queue for them.
+ * Return true if there were any constants.
+ */
+static bool send_init_constants(void)
+{
+      size_t cnt = init_constant4_list.size() + init_constant8_list.size()
+	         + init_constantr_list.size();
+      if (cnt == 0)
+	    return false;
+
+      schedule_settling_constants = true;
+
+      for (size_t idx = 0 ; idx < init_constant4_list.size() ; idx += 1) {
+	    const init_constant_s<vvp_vector4_t>&cur = init_constant4_list[idx];
+	    vvp_send_vec4(cur.ptr, cur.val, 0);
+      }
+      for (size_t idx = 0 ; idx < init_constant8_list.size() ; idx += 1) {
+	    const init_constant_s<vvp_vector8_t>&cur = init_constant8_list[idx];
+	    vvp_send_vec8(cur.ptr, cur.val);
+      }
+      for (size_t idx = 0 ; idx < init_constantr_list.size() ; idx += 1) {
+	    const init_constant_s<double>&cur = init_constantr_list[idx];
+	    vvp_send_real(cur.ptr, cur.val, 0);
+      }
+
+	// The list grows while the functors run.
+      for (size_t idx = 0 ; idx < settle_list.size() ; idx += 1)
+	    settle_list[idx]->run_run();
+
+      count_init_constants += cnt;
+      count_init_settled += settle_list.size();
+
+      std::vector<vvp_gen_event_t>().swap(settle_list);
+      schedule_settling_constants = false;
+      push_settled_callbacks();
+
+      std::vector< init_constant_s<vvp_vector4_t> >().swap(init_constant4_list);
+      std::vector< init_constant_s<vvp_vector8_t> >().swap(init_constant8_list);
+      std::vector< init_constant_s<double> >().swap(init_constantr_list);
+      return true;
+}
+
 void schedule_init_propagate(vvp_net_t*net, vvp_vector4_t bit)
 {
       struct propagate_vector4_event_s*cur = new struct propagate_vector4_event_s(bit);
@@ -1009,6 +1208,11 @@ static bool sim_started;
 
 void schedule_functor(vvp_gen_event_t obj)
 {
+      if (schedule_settling_constants) {
+	    settle_list.push_back(obj);
+	    return;
+      }
+
       struct generic_event_s*cur = new generic_event_s;
 
       cur->obj = obj;
@@ -1100,6 +1304,20 @@ static void run_rosync(struct event_time_s*ctim)
       }
 }
 
+static void run_init_events(void)
+{
+      while (schedule_init_list) {
+	    struct event_s*cur = schedule_init_list->next;
+	    if (cur->next == cur) {
+		  schedule_init_list = 0;
+	    } else {
+		  schedule_init_list->next = cur->next;
+	    }
+	    cur->run_run();
+	    delete cur;
+      }
+}
+
 void schedule_simulate(void)
 {
       bool run_finals;
@@ -1118,17 +1336,19 @@ void schedule_simulate(void)
 	    vpi_mcd_printf(1, " ...propagate initialization events\n");
       }
 
-	// Execute initialization events.
-      while (schedule_init_list) {
-	    struct event_s*cur = schedule_init_list->next;
-	    if (cur->next == cur) {
-		  schedule_init_list = 0;
-	    } else {
-		  schedule_init_list->next = cur->next;
-	    }
-	    cur->run_run();
-	    delete cur;
-      }
+	// Execute initialization events. Then send the constant inputs
+	// of functors, and execute the initialization events that the
+	// logic they drive creates. The constants go after the initial
+	// values of the signals, as they would if they were sent at
+	// time 0, but the logic is settled before time 0 starts. The
+	// edges that the settling makes are still sent to the event and
+	// timing check functors at time 0, so processes that wait on
+	// them see them as before, and the value change callbacks of
+	// the nets run at time 0, after the StartOfSim callbacks. The
+	// StartOfSim callbacks do see the settled values of the nets.
+      run_init_events();
+      if (send_init_constants())
+	    run_init_events();
 
       if (verbose_flag) {
 	    vpi_mcd_printf(1, " ...execute StartOfSim callbacks\n");
@@ -1149,7 +1369,7 @@ void schedule_simulate(void)
       // process events and when done run the final blocks.
       run_finals = schedule_runnable;
 
-      if (schedule_runnable) while (sched_list) {
+      if (schedule_runnable) while (sched_list || partition_enabled) {
 
 	    if (schedule_stopped_flag) {
 		  schedule_stopped_flag = false;
@@ -1159,6 +1379,23 @@ void schedule_simulate(void)
 		  continue;
 	    }
 
+	      /* In a distributed simulation, synchronize with the
+		 other partitions before running past the end of the
+		 time window, or when this partition is idle. The
+		 exchange may schedule new events, so start over after
+		 it. */
+	    if (partition_enabled
+		&& (sched_list == 0
+		    || schedule_time + sched_list->delay >= partition_window_end)) {
+		  partition_exchange();
+		  bool have_next = sched_list != 0;
+		  vvp_time64_t next_time = have_next
+			? schedule_time + sched_list->delay : 0;
+		  if (! partition_agree(have_next, next_time, !schedule_runnable))
+			break;
+		  continue;
+	    }
+
 	      /* ctim is the current time step. */
 	    struct event_time_s* ctim = sched_list;
 
@@ -1217,6 +1454,7 @@ void schedule_simulate(void)
 			      }
 			}
 		  }
+		  count_delta_cycles += 1;
 	    }
 
 	      /* Pull the first item off the list. If this is the last
@@ -1236,10 +1474,17 @@ void schedule_simulate(void)
 	    }
 
 	    cur->run_run();
+	    count_events_run += 1;
 
 	    delete (cur);
+
+	    if (perf_heartbeat_due)
+		  perf_heartbeat_poll();
       }
 
+      if (partition_enabled)
+	    partition_finish();
+
 	// Execute final events.
       schedule_runnable = run_finals;
       while (schedule_runnable && schedule_final_list) {
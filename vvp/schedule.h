@@ -77,6 +77,9 @@ extern void schedule_force_vector(vvp_net_t*net,
 extern void schedule_propagate_vector(vvp_net_t*ptr,
 				      vvp_time64_t  delay,
 				      const vvp_vector4_t&val);
+extern void schedule_propagate_vector(vvp_net_t*ptr,
+				      vvp_time64_t  delay,
+				      const vvp_vector8_t&val);
 
 /*
  * This is very similar to schedule_assign_vector, but generates an
@@ -88,6 +91,43 @@ extern void schedule_set_vector(vvp_net_ptr_t ptr, const vvp_vector4_t&val);
 extern void schedule_set_vector(vvp_net_ptr_t ptr, vvp_vector8_t val);
 extern void schedule_set_vector(vvp_net_ptr_t ptr, double val);
 
+/*
+ * The schedule_init_constant function is used at link time instead of
+ * schedule_set_vector to give a constant value to the input of a
+ * functor. The constants are kept in a table and sent after the
+ * initialization events, so that the logic they drive is settled
+ * before time 0 starts. If schedule_init_constants is false (the
+ * VVP_NO_CONST_INIT environment variable) this is the same as
+ * schedule_set_vector.
+ *
+ * While the constants settle, schedule_settling_constants is true. The
+ * edge sensitive functors (events and timing checks) must not take a
+ * value then, because a process that waits for the edge at time 0 would
+ * miss it. They pass the value to schedule_settled_edge instead, which
+ * delivers it again with a time 0 active event, as if the constant had
+ * been a time 0 event.
+ */
+extern bool schedule_init_constants;
+extern void schedule_init_constant(vvp_net_ptr_t ptr, const vvp_vector4_t&val);
+extern void schedule_init_constant(vvp_net_ptr_t ptr, const vvp_vector8_t&val);
+extern void schedule_init_constant(vvp_net_ptr_t ptr, double val);
+
+extern bool schedule_settling_constants;
+extern void schedule_settled_edge(vvp_net_ptr_t ptr, const vvp_vector4_t&val,
+				  unsigned base =0, unsigned vwid =0);
+extern void schedule_settled_edge(vvp_net_ptr_t ptr, double val);
+
+/*
+ * The value change callbacks of the signals that the constants change
+ * are not run while the constants settle either: the StartOfSim
+ * callbacks have not run yet. schedule_settled_callbacks notes the
+ * signal instead, and its callbacks are run once, with the settled
+ * value, by an event pushed in front of the time 0 active queue. This
+ * is after the StartOfSim callbacks and before the time 0 threads.
+ */
+class vvp_vpi_callback;
+extern void schedule_settled_callbacks(vvp_vpi_callback*obj);
+
 /*
  * Create a T0 event for always_comb/latch processes. This is the first
  * event in the first inactive region.
@@ -24,6 +24,14 @@
  */
 unsigned long count_opcodes = 0;
 
+/*
+ * With a lazy code space, these count the basic blocks and the
+ * opcodes that were actually decoded for execution.
+ */
+unsigned long count_opcodes_decoded = 0;
+unsigned long count_code_blocks = 0;
+unsigned long count_code_blocks_decoded = 0;
+
 unsigned long count_functors = 0;
 unsigned long count_functors_logic = 0;
 unsigned long count_functors_bufif = 0;
@@ -31,9 +39,11 @@ unsigned long count_functors_resolv= 0;
 unsigned long count_functors_sig   = 0;
 
 unsigned long count_filters = 0;
+unsigned long count_fused_vars = 0;
 unsigned long count_vpi_nets = 0;
 
 unsigned long count_vpi_scopes = 0;
 
 size_t size_opcodes = 0;
+size_t size_opcodes_packed = 0;
 
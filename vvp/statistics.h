@@ -25,8 +25,12 @@
 #else
 # include  <cstddef>
 #endif
+# include  <csignal>
 
 extern unsigned long count_opcodes;
+extern unsigned long count_opcodes_decoded;
+extern unsigned long count_code_blocks;
+extern unsigned long count_code_blocks_decoded;
 extern unsigned long count_functors;
 extern unsigned long count_functors_logic;
 extern unsigned long count_functors_bufif;
@@ -34,6 +38,7 @@ extern unsigned long count_functors_resolv;
 extern unsigned long count_functors_sig;
 extern unsigned long count_filters;
 extern unsigned long count_vvp_nets;
+extern unsigned long count_fused_vars;
 extern unsigned long count_vpi_nets;
 extern unsigned long count_vpi_scopes;
 
@@ -58,8 +63,26 @@ extern unsigned long count_assign_arword_pool(void);
 extern unsigned long count_gen_events;
 extern unsigned long count_gen_pool(void);
 
+extern unsigned long count_init_constants;
+extern unsigned long count_init_settled;
+
+  /* Runtime counters, also readable through $ivl_perf_counters. */
+extern unsigned long count_events_run;
+extern unsigned long count_delta_cycles;
+extern unsigned long count_nbassign_events;
+extern unsigned long count_thread_runs;
+
+  /* The periodic heartbeat file (vvp -H), see vpi_perf.cc. */
+extern volatile sig_atomic_t perf_heartbeat_due;
+extern void perf_heartbeat_open(const char*arg);
+extern void perf_heartbeat_poll(void);
+extern void perf_heartbeat_close(void);
+extern void perf_counters_start(void);
+
 extern size_t size_opcodes;
+extern size_t size_opcodes_packed;
 extern size_t size_vvp_nets;
+extern size_t fused_var_heap_total(void);
 extern size_t size_vvp_net_funs;
 
 #endif /* IVL_statistics_H */
@@ -761,10 +761,18 @@ void vvp_vpi_callback::clear_all_callbacks()
  * A vvp_fun_signal uses this method to run its callbacks whenever it
  * has a value change. If the cb_rtn is non-nil, then call the
  * callback function. If the cb_rtn pointer is nil, then the object
- * has been marked for deletion. Free it.
+ * has been marked for deletion. Free it. A change made while the
+ * constants settle is passed to schedule_settled_callbacks instead.
  */
 void vvp_vpi_callback::run_vpi_callbacks()
 {
+	// The value changes that the constants make before time 0 are
+	// reported at time 0, after the StartOfSim callbacks.
+      if (schedule_settling_constants) {
+	    schedule_settled_callbacks(this);
+	    return;
+      }
+
       struct __vpi_array_word*array_word = array_words_;
       while (array_word) {
 	    array_word->array->word_change(array_word->word);
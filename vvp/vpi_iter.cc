@@ -22,10 +22,39 @@
  */
 
 # include  "vpi_priv.h"
+# include  "slab.h"
 # include  <cstdlib>
 # include  <cassert>
+#ifdef CHECK_WITH_VALGRIND
+# include  "vvp_cleanup.h"
+#endif
 # include  "ivl_alloc.h"
 
+/*
+ * Iterators are made and freed for every vpi_iterate, so keep them in
+ * a slab instead of going to the heap each time.
+ */
+static const size_t ITERATOR_CHUNK_COUNT = 8192 / sizeof(struct __vpiIterator);
+static slab_t<sizeof(__vpiIterator),ITERATOR_CHUNK_COUNT> iterator_heap;
+
+void* __vpiIterator::operator new(size_t size)
+{
+      assert(size == sizeof(__vpiIterator));
+      return iterator_heap.alloc_slab();
+}
+
+void __vpiIterator::operator delete(void*ptr)
+{
+      iterator_heap.free_slab(ptr);
+}
+
+#ifdef CHECK_WITH_VALGRIND
+void iterator_pool_delete(void)
+{
+      iterator_heap.delete_pool();
+}
+#endif
+
 static int iterator_free_object(vpiHandle ref)
 {
       struct __vpiIterator*hp = dynamic_cast<__vpiIterator*>(ref);
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "vpi_priv.h"
+# include  "schedule.h"
+# include  "statistics.h"
+# include  <cstdio>
+# include  <cstdlib>
+# include  <cstring>
+# include  <ctime>
+# include  <cassert>
+# include  <csignal>
+#if !defined(__MINGW32__)
+# include  <sys/time.h>
+#endif
+# include  "ivl_alloc.h"
+
+/*
+ * The runtime performance counters are made available to VPI code as
+ * read-only _vpiPerfCounter objects. vpi_iterate(_vpiPerfCounter, 0)
+ * returns all the counters. Each has a vpiName and a 64 bit value
+ * that can be read with vpi_get_value in any of the integral formats
+ * or as a real. The $ivl_perf_counters system function is built on
+ * top of this.
+ */
+
+static time_t perf_start_time = 0;
+
+static uint64_t perf_wall_seconds(void)
+{
+      if (perf_start_time == 0)
+	    return 0;
+      return (uint64_t) difftime(time(0), perf_start_time);
+}
+
+static uint64_t perf_events(void)        { return count_events_run; }
+static uint64_t perf_deltas(void)        { return count_delta_cycles; }
+static uint64_t perf_time_steps(void)    { return count_time_events; }
+static uint64_t perf_thread_runs(void)   { return count_thread_runs; }
+static uint64_t perf_thread_events(void) { return count_thread_events; }
+static uint64_t perf_assign_events(void) { return count_assign_events; }
+static uint64_t perf_nb_assigns(void)    { return count_nbassign_events; }
+static uint64_t perf_gen_events(void)    { return count_gen_events; }
+static uint64_t perf_memo_suppressed(void)
+{ return vvp_send_memo::suppressed_total(); }
+static uint64_t perf_sim_time(void)      { return schedule_simtime(); }
+
+static const struct perf_counter_def_s {
+      const char*name;
+      uint64_t (*value)(void);
+} perf_counter_defs[] = {
+      { "events",        perf_events },
+      { "delta_cycles",  perf_deltas },
+      { "time_steps",    perf_time_steps },
+      { "thread_runs",   perf_thread_runs },
+      { "thread_events", perf_thread_events },
+      { "assign_events", perf_assign_events },
+      { "nb_assigns",    perf_nb_assigns },
+      { "gen_events",    perf_gen_events },
+      { "memo_suppressed", perf_memo_suppressed },
+      { "sim_time",      perf_sim_time },
+      { "wall_seconds",  perf_wall_seconds }
+};
+
+static const unsigned perf_counter_count
+      = sizeof perf_counter_defs / sizeof perf_counter_defs[0];
+
+struct __vpiPerfCounter : public __vpiHandle {
+      explicit __vpiPerfCounter(const perf_counter_def_s*d) : def(d) { }
+      int get_type_code(void) const { return _vpiPerfCounter; }
+      int vpi_get(int code);
+      char*vpi_get_str(int code);
+      void vpi_get_value(p_vpi_value val);
+
+      const perf_counter_def_s*def;
+};
+
+int __vpiPerfCounter::vpi_get(int code)
+{
+      switch (code) {
+	  case vpiSize:
+	    return 64;
+	  case vpiSigned:
+	    return 0;
+	  default:
+	    return vpiUndefined;
+      }
+}
+
+char* __vpiPerfCounter::vpi_get_str(int code)
+{
+      if (code == vpiName)
+	    return simple_set_rbuf_str(def->name);
+
+      return 0;
+}
+
+void __vpiPerfCounter::vpi_get_value(p_vpi_value vp)
+{
+      uint64_t val = (def->value)();
+
+      if (vp->format == vpiRealVal) {
+	    vp->value.real = (double) val;
+	    return;
+      }
+
+      vvp_vector4_t tmp (64, BIT4_0);
+      for (unsigned idx = 0 ; idx < 64 ; idx += 1) {
+	    if ((val >> idx) & 1)
+		  tmp.set_bit(idx, BIT4_1);
+      }
+      vpip_vec4_get_value(tmp, 64, false, vp);
+}
+
+static __vpiPerfCounter**perf_counter_handles = 0;
+
+vpiHandle vpip_make_perf_counter_iterator(void)
+{
+      if (perf_counter_handles == 0) {
+	    perf_counter_handles = new __vpiPerfCounter*[perf_counter_count];
+	    for (unsigned idx = 0 ; idx < perf_counter_count ; idx += 1)
+		  perf_counter_handles[idx]
+			= new __vpiPerfCounter(perf_counter_defs+idx);
+      }
+
+	/* The iterator owns its copy of the handle array, but the
+	   handles themselves are permanent. */
+      vpiHandle*args = (vpiHandle*)
+	    malloc(perf_counter_count * sizeof(vpiHandle));
+      for (unsigned idx = 0 ; idx < perf_counter_count ; idx += 1)
+	    args[idx] = perf_counter_handles[idx];
+
+      return vpip_make_iterator(perf_counter_count, args, true);
+}
+
+/*
+ * The heartbeat is enabled with the -H flag. While the simulation
+ * runs, a line with the current counters and the rates since the
+ * previous line is appended to the heartbeat file every N wall-clock
+ * seconds. An interval timer (SIGALRM) sets perf_heartbeat_due, and
+ * the scheduler writes the line at the next event after that. This
+ * keeps to the interval however slow the event rate is, and costs the
+ * scheduler only a flag test per event. Windows has no interval
+ * timer, so there the flag stays set and every event checks the clock.
+ */
+volatile sig_atomic_t perf_heartbeat_due = 0;
+static bool perf_heartbeat_enabled = false;
+
+static FILE*heartbeat_fd = 0;
+static unsigned heartbeat_interval = 10;
+static time_t heartbeat_last = 0;
+
+static uint64_t last_events = 0;
+static uint64_t last_deltas = 0;
+static uint64_t last_steps = 0;
+static uint64_t last_simtime = 0;
+
+void perf_heartbeat_open(const char*arg)
+{
+      char*path = strdup(arg);
+      char*cp = strrchr(path, ',');
+      if (cp) {
+	    *cp++ = 0;
+	    unsigned long tmp = strtoul(cp, 0, 10);
+	    heartbeat_interval = tmp > 0 ? tmp : 1;
+      }
+
+      heartbeat_fd = fopen(path, "w");
+      if (heartbeat_fd == 0) {
+	    fprintf(stderr, "Unable to open heartbeat file %s\n", path);
+	    free(path);
+	    return;
+      }
+      free(path);
+
+      perf_heartbeat_enabled = true;
+}
+
+static void heartbeat_write(time_t now)
+{
+      double dt = difftime(now, heartbeat_last);
+      if (dt <= 0.0) dt = 1.0;
+
+      uint64_t events = count_events_run;
+      uint64_t deltas = count_delta_cycles;
+      uint64_t steps = count_time_events;
+      uint64_t simtime = schedule_simtime();
+
+      uint64_t dsteps = steps - last_steps;
+      double deltas_per_step = dsteps
+	    ? (double)(deltas - last_deltas) / (double)dsteps : 0.0;
+
+      fprintf(heartbeat_fd,
+	      "wall=%lus sim_time=%llu events=%llu events/s=%.0f "
+	      "deltas/step=%.2f time_steps/s=%.0f sim_time/s=%.6g\n",
+	      (unsigned long) perf_wall_seconds(),
+	      (unsigned long long) simtime,
+	      (unsigned long long) events,
+	      (double)(events - last_events) / dt,
+	      deltas_per_step,
+	      (double)dsteps / dt,
+	      (double)(simtime - last_simtime) / dt);
+      fflush(heartbeat_fd);
+
+      heartbeat_last = now;
+      last_events = events;
+      last_deltas = deltas;
+      last_steps = steps;
+      last_simtime = simtime;
+}
+
+void perf_heartbeat_poll(void)
+{
+#if !defined(__MINGW32__)
+      perf_heartbeat_due = 0;
+#endif
+      time_t now = time(0);
+      if (difftime(now, heartbeat_last) >= heartbeat_interval)
+	    heartbeat_write(now);
+}
+
+#if !defined(__MINGW32__)
+extern "C" void heartbeat_alarm(int)
+{
+      perf_heartbeat_due = 1;
+}
+
+static void heartbeat_timer(unsigned interval)
+{
+      struct itimerval tv;
+      tv.it_interval.tv_sec = interval;
+      tv.it_interval.tv_usec = 0;
+      tv.it_value = tv.it_interval;
+      setitimer(ITIMER_REAL, &tv, 0);
+}
+#endif
+
+void perf_counters_start(void)
+{
+      perf_start_time = time(0);
+      heartbeat_last = perf_start_time;
+
+      if (!perf_heartbeat_enabled)
+	    return;
+
+#if defined(__MINGW32__)
+      perf_heartbeat_due = 1;
+#else
+	/* Restart interrupted system calls, so that the alarm does
+	   not make VPI file I/O fail with EINTR. */
+      struct sigaction sa;
+      memset(&sa, 0, sizeof sa);
+      sa.sa_handler = &heartbeat_alarm;
+      sigemptyset(&sa.sa_mask);
+      sa.sa_flags = SA_RESTART;
+      sigaction(SIGALRM, &sa, 0);
+      heartbeat_timer(heartbeat_interval);
+#endif
+}
+
+void perf_heartbeat_close(void)
+{
+      if (heartbeat_fd == 0)
+	    return;
+
+#if !defined(__MINGW32__)
+      heartbeat_timer(0);
+      signal(SIGALRM, SIG_DFL);
+#endif
+      perf_heartbeat_due = 0;
+
+      heartbeat_write(time(0));
+      fclose(heartbeat_fd);
+      heartbeat_fd = 0;
+      perf_heartbeat_enabled = false;
+}
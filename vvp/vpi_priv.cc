@@ -1246,6 +1246,9 @@ static vpiHandle vpi_iterate_global(int type)
 
 	  case vpiUserSystf:
 	    return vpip_make_systf_iterator();
+
+	  case _vpiPerfCounter:
+	    return vpip_make_perf_counter_iterator();
       }
 
       return 0;
@@ -1746,5 +1749,9 @@ vpip_routines_s vpi_routines = {
     .make_systf_system_defined  = vpip_make_systf_system_defined,
     .mcd_rawwrite               = vpip_mcd_rawwrite,
     .set_return_value           = vpip_set_return_value,
+    .random_seed                = vpip_random_seed,
+    .urandom_seed               = vpip_urandom_seed,
+    .random_uniform             = vpip_random_uniform,
+    .dist_uniform               = vpip_dist_uniform,
 };
 #endif
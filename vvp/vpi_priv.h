@@ -147,6 +147,9 @@ struct __vpiIterator : public __vpiHandle {
       int get_type_code(void) const;
       free_object_fun_t free_object_fun(void);
 
+      static void* operator new(size_t);
+      static void operator delete(void*);
+
       vpiHandle *args;
       unsigned  nargs;
       unsigned  next;
@@ -261,6 +264,9 @@ class __vpiScope : public __vpiHandle {
       unsigned def_file_idx;
       unsigned def_lineno;
       bool is_cell;
+	/* The partition of a distributed simulation that owns the
+	   processes of this scope. */
+      unsigned partition;
 	/* The scope has a system time of its own. */
       __vpiScopedTime scoped_time;
       struct __vpiScopedSTime scoped_stime;
@@ -505,6 +511,38 @@ extern struct __vpiModPathSrc* vpip_make_modpath_src(struct __vpiModPath*path,
 
 extern struct __vpiModPath* vpip_make_modpath(vvp_net_t *net) ;
 
+/*
+ * The __vpiTchk is the vpiTchk object of a .tchk timing check. The
+ * terms are the vpiTchkRefTerm and vpiTchkDataTerm of the check, and
+ * the data term has no expression for $width and $period.
+ */
+struct __vpiTchkTerm : public __vpiHandle {
+      int get_type_code(void) const;
+      int vpi_get(int code);
+      vpiHandle vpi_handle(int code);
+
+      vpiHandle expr;
+      int edge;
+};
+
+struct __vpiTchk : public __vpiHandle {
+      __vpiTchk();
+      int get_type_code(void) const;
+      int vpi_get(int code);
+      char* vpi_get_str(int code);
+      vpiHandle vpi_handle(int code);
+      void vpi_get_delays(p_vpi_delay del);
+      void vpi_put_delays(p_vpi_delay del);
+
+      __vpiScope*scope;
+      class vvp_fun_tchk*fun;
+      struct __vpiTchkTerm ref_term;
+      struct __vpiTchkTerm data_term;
+      vpiHandle notifier;
+};
+
+extern struct __vpiTchk* vpip_make_tchk(class vvp_fun_tchk*fun);
+
 
 /*
  * These methods support the vpi creation of events. The name string
@@ -617,10 +655,13 @@ class __vpiStringVar : public __vpiBaseVar {
 extern vpiHandle vpip_make_string_var(const char*name, vvp_net_t*net);
 
 struct __vpiArrayBase {
-      __vpiArrayBase() : vals_words(NULL) {}
+      __vpiArrayBase()
+      : word_pages_(NULL), word_page_count_(0), word_page_size_(0) {}
       virtual ~__vpiArrayBase() {}
 
       virtual unsigned get_size(void) const = 0;
+	// True if get_size() never changes (not a dynamic array or queue).
+      virtual bool fixed_size() const { return false; }
       virtual vpiHandle get_left_range() = 0;
       virtual vpiHandle get_right_range() = 0;
       virtual __vpiScope*get_scope() const = 0;
@@ -637,9 +678,17 @@ struct __vpiArrayBase {
     // code in the following function
       vpiHandle vpi_array_base_iterate(int code);
 
-      virtual void make_vals_words();
+	// Get the handle for a variable word. The handles are made a
+	// page at a time, as they are asked for. See __vpiArrayWord.
+      vpiHandle get_word_handle(unsigned idx);
+#ifdef CHECK_WITH_VALGRIND
+      void delete_word_handles(void);
+#endif
 
-      struct __vpiArrayWord*vals_words;
+    private:
+      struct __vpiArrayWord**word_pages_;
+      unsigned word_page_count_;
+      unsigned word_page_size_;
 };
 
 /*
@@ -670,6 +719,7 @@ struct __vpiArrayBase {
 struct __vpiArray : public __vpiArrayBase, public __vpiHandle {
       int get_type_code(void) const { return vpiMemory; }
       unsigned get_size() const { return array_count; }
+      bool fixed_size() const { return true; }
       vpiHandle get_left_range() { assert(nets == 0); return &msb; }
       vpiHandle get_right_range() { assert(nets == 0); return &lsb; }
       __vpiScope*get_scope() const { return scope; }
@@ -812,6 +862,9 @@ struct __vpiUserSystf : public __vpiHandle {
 
 extern vpiHandle vpip_make_systf_iterator(void);
 
+  /* Iterate over the runtime performance counters (vpi_perf.cc). */
+extern vpiHandle vpip_make_perf_counter_iterator(void);
+
 extern struct __vpiUserSystf* vpip_find_systf(const char*name);
 
 
@@ -21,6 +21,7 @@
 # include  "vpi_priv.h"
 # include  "symbols.h"
 # include  "statistics.h"
+# include  "partition.h"
 # include  "config.h"
 #ifdef CHECK_WITH_VALGRIND
 # include  "vvp_cleanup.h"
@@ -572,6 +573,7 @@ compile_scope_decl(char*label, char*type, char*name, char*tname,
 	      /* Inherit time units and precision from the parent scope. */
 	    scope->time_units = sp->time_units;
 	    scope->time_precision = sp->time_precision;
+	    scope->partition = sp->partition;
 
       } else {
 	    scope->scope = 0x0;
@@ -582,6 +584,7 @@ compile_scope_decl(char*label, char*type, char*name, char*tname,
 	         system precision. */
 	    scope->time_units = vpip_get_time_precision();
 	    scope->time_precision = vpip_get_time_precision();
+	    scope->partition = 0;
       }
 }
 
@@ -605,6 +608,18 @@ void compile_timescale(long units, long precision)
       current_scope->time_precision = precision;
 }
 
+/*
+ * This function handles the ".partition" directive in the vvp
+ * source. It sets the partition of the current scope. The scopes
+ * declared later inside this scope inherit it.
+ */
+void compile_partition(long part)
+{
+      assert(current_scope);
+      current_scope->partition = part;
+      partition_declare(part);
+}
+
 __vpiScope* vpip_peek_current_scope(void)
 {
       return current_scope;
@@ -25,6 +25,9 @@
 # include  "event.h"
 # include  "vpi_priv.h"
 # include  "vvp_net_sig.h"
+# include  "coverage.h"
+# include  "intrinsic.h"
+# include  "statistics.h"
 # include  "vvp_cobject.h"
 # include  "vvp_darray.h"
 # include  "class_type.h"
@@ -373,6 +376,9 @@ __vpiScope* vthread_scope(struct vthread_s*thr)
 
 struct vthread_s*running_thread = 0;
 
+  // Count the times a thread is resumed by vthread_run().
+unsigned long count_thread_runs = 0;
+
 string get_fileline()
 {
       return running_thread->get_fileline();
@@ -800,6 +806,7 @@ void vthread_run(vthread_t thr)
 	    thr->is_scheduled = 0;
 
             running_thread = thr;
+	    count_thread_runs += 1;
 
 	    for (;;) {
 		  vvp_code_t cp = thr->pc;
@@ -829,6 +836,17 @@ bool of_CHUNK_LINK(vthread_t thr, vvp_code_t code)
       return true;
 }
 
+/*
+ * The DECODE_BLOCK instruction is the stub of a code block that has
+ * not run yet. Decoding the block turns the stub into a CHUNK_LINK.
+ */
+bool of_DECODE_BLOCK(vthread_t thr, vvp_code_t code)
+{
+      codespace_decode(code);
+      thr->pc = code->cptr;
+      return true;
+}
+
 /*
  * This is called by an event functor to wake up all the threads on
  * its list. I in fact created that list in the %wait instruction, and
@@ -975,6 +993,46 @@ bool of_ADD(vthread_t thr, vvp_code_t)
       return true;
 }
 
+/*
+ * The 2-state arithmetic and compare instructions are generated for
+ * operands that the code generator knows to be 2-state. Values that
+ * fit in a CPU word are calculated directly on the word. Wider values
+ * go through the 4-state instruction, which gets the same result for
+ * 2-state operands. An intermediate result can still hold X, for
+ * example from a division by zero, so operands with X or Z bits also
+ * go through the 4-state instruction and keep propagating the X.
+ */
+static inline bool fits_word2(vthread_t thr)
+{
+      const vvp_vector4_t&rval = thr->peek_vec4(0);
+      const vvp_vector4_t&lval = thr->peek_vec4(1);
+      return lval.size() > 0 && lval.size() <= CPU_WORD_BITS
+	    && ! lval.has_xz() && ! rval.has_xz();
+}
+
+static inline long sign_word2(unsigned long val, unsigned wid)
+{
+      if (wid < CPU_WORD_BITS && ((val >> (wid-1)) & 1))
+	    val |= -1UL << wid;
+      return (long)val;
+}
+
+/*
+ * %add/2
+ */
+bool of_ADD_2(vthread_t thr, vvp_code_t cp)
+{
+      if (! fits_word2(thr))
+	    return of_ADD(thr, cp);
+
+      unsigned long r = thr->peek_vec4(0).get_word2();
+      thr->pop_vec4(1);
+      vvp_vector4_t&l = thr->peek_vec4();
+
+      l.set_word2(l.get_word2() + r);
+      return true;
+}
+
 /*
  * %addi <vala>, <valb>, <wid>
  *
@@ -1935,6 +1993,29 @@ bool of_CMPS(vthread_t thr, vvp_code_t)
       return true;
 }
 
+/*
+ * %cmp/2/s
+ */
+bool of_CMPS_2(vthread_t thr, vvp_code_t cp)
+{
+      const vvp_vector4_t&rval = thr->peek_vec4(0);
+      const vvp_vector4_t&lval = thr->peek_vec4(1);
+
+      if (! fits_word2(thr))
+	    return of_CMPS(thr, cp);
+
+      assert(rval.size() == lval.size());
+      long lv = sign_word2(lval.get_word2(), lval.size());
+      long rv = sign_word2(rval.get_word2(), rval.size());
+
+      thr->flags[4] = lv == rv? BIT4_1 : BIT4_0; // eq
+      thr->flags[5] = lv <  rv? BIT4_1 : BIT4_0; // lt
+      thr->flags[6] = thr->flags[4];             // eeq
+
+      thr->pop_vec4(2);
+      return true;
+}
+
 /*
  * %cmpi/s <vala>, <valb>, <wid>
  *
@@ -2071,6 +2152,29 @@ bool of_CMPU(vthread_t thr, vvp_code_t)
       return true;
 }
 
+/*
+ * %cmp/2/u
+ */
+bool of_CMPU_2(vthread_t thr, vvp_code_t cp)
+{
+      const vvp_vector4_t&rval = thr->peek_vec4(0);
+      const vvp_vector4_t&lval = thr->peek_vec4(1);
+
+      if (! fits_word2(thr))
+	    return of_CMPU(thr, cp);
+
+      assert(rval.size() == lval.size());
+      unsigned long lv = lval.get_word2();
+      unsigned long rv = rval.get_word2();
+
+      thr->flags[4] = lv == rv? BIT4_1 : BIT4_0; // eq
+      thr->flags[5] = lv <  rv? BIT4_1 : BIT4_0; // lt
+      thr->flags[6] = thr->flags[4];             // eeq
+
+      thr->pop_vec4(2);
+      return true;
+}
+
 /*
  * %cmpi/u <vala>, <valb>, <wid>
  *
@@ -2891,6 +2995,54 @@ bool of_DIV(vthread_t thr, vvp_code_t)
 }
 
 
+/*
+ * %div/2
+ *
+ * Division by zero is left to the 4-state instruction so that the
+ * result is the same X value.
+ */
+bool of_DIV_2(vthread_t thr, vvp_code_t cp)
+{
+      if (! fits_word2(thr))
+	    return of_DIV(thr, cp);
+
+      unsigned long r = thr->peek_vec4(0).get_word2();
+      if (r == 0)
+	    return of_DIV(thr, cp);
+
+      thr->pop_vec4(1);
+      vvp_vector4_t&l = thr->peek_vec4();
+
+      l.set_word2(l.get_word2() / r);
+      return true;
+}
+
+/*
+ * %div/2/s
+ */
+bool of_DIV_2_S(vthread_t thr, vvp_code_t cp)
+{
+      if (! fits_word2(thr))
+	    return of_DIV_S(thr, cp);
+
+      const vvp_vector4_t&rval = thr->peek_vec4(0);
+      long r = sign_word2(rval.get_word2(), rval.size());
+      if (r == 0)
+	    return of_DIV_S(thr, cp);
+
+      thr->pop_vec4(1);
+      vvp_vector4_t&l = thr->peek_vec4();
+      unsigned long lv = l.get_word2();
+
+	// Dividing the most negative value by -1 overflows a long,
+	// so do that one as a negate.
+      if (r == -1)
+	    l.set_word2(-lv);
+      else
+	    l.set_word2((unsigned long)(sign_word2(lv, l.size()) / r));
+      return true;
+}
+
 static void negate_words(unsigned long*val, unsigned words)
 {
       unsigned long carry = 1;
@@ -3129,6 +3281,21 @@ bool of_EVCTLS(vthread_t thr, vvp_code_t cp)
       return true;
 }
 
+/*
+ * %evtest <functor-label>, <type>
+ *
+ * Push a single bit that is 1 if the vvp_fun_edge_vhdl functor saw a
+ * change of the requested type at the current simulation time. This
+ * implements the VHDL 'event, rising_edge() and falling_edge().
+ */
+bool of_EVTEST(vthread_t thr, vvp_code_t cp)
+{
+      vvp_fun_edge_vhdl*fun = dynamic_cast<vvp_fun_edge_vhdl*> (cp->net->fun);
+      assert(fun);
+      thr->push_vec4(vvp_vector4_t(1, fun->test(cp->bit_idx[0])));
+      return true;
+}
+
 bool of_FLAG_GET_VEC4(vthread_t thr, vvp_code_t cp)
 {
       int flag = cp->number;
@@ -3680,6 +3847,45 @@ bool of_JMP1XZ(vthread_t thr, vvp_code_t cp)
       return true;
 }
 
+/*
+ * These are the %jmp/0, %jmp/0xz, %jmp/1 and %jmp/1xz instructions
+ * of a covered scope. They work like the plain versions, but also
+ * count whether the branch was taken. The counter is in bit_idx[1].
+ */
+static bool do_jmp_cov(vthread_t thr, vvp_code_t cp, bool taken)
+{
+      coverage_branch_hit(cp->bit_idx[1], taken);
+      if (taken)
+	    thr->pc = cp->cptr;
+
+      if (schedule_stopped()) {
+	    schedule_vthread(thr, 0, false);
+	    return false;
+      }
+
+      return true;
+}
+
+bool of_JMP0_COV(vthread_t thr, vvp_code_t cp)
+{
+      return do_jmp_cov(thr, cp, thr->flags[cp->bit_idx[0]] == BIT4_0);
+}
+
+bool of_JMP0XZ_COV(vthread_t thr, vvp_code_t cp)
+{
+      return do_jmp_cov(thr, cp, thr->flags[cp->bit_idx[0]] != BIT4_1);
+}
+
+bool of_JMP1_COV(vthread_t thr, vvp_code_t cp)
+{
+      return do_jmp_cov(thr, cp, thr->flags[cp->bit_idx[0]] == BIT4_1);
+}
+
+bool of_JMP1XZ_COV(vthread_t thr, vvp_code_t cp)
+{
+      return do_jmp_cov(thr, cp, thr->flags[cp->bit_idx[0]] != BIT4_0);
+}
+
 /*
  * The %join instruction causes the thread to wait for one child
  * to die.  If a child is already dead (and a zombie) then I reap
@@ -4238,6 +4444,48 @@ bool of_MOD_S(vthread_t thr, vvp_code_t)
       return true;
 }
 
+/*
+ * %mod/2
+ */
+bool of_MOD_2(vthread_t thr, vvp_code_t cp)
+{
+      if (! fits_word2(thr))
+	    return of_MOD(thr, cp);
+
+      unsigned long r = thr->peek_vec4(0).get_word2();
+      if (r == 0)
+	    return of_MOD(thr, cp);
+
+      thr->pop_vec4(1);
+      vvp_vector4_t&l = thr->peek_vec4();
+
+      l.set_word2(l.get_word2() % r);
+      return true;
+}
+
+/*
+ * %mod/2/s
+ */
+bool of_MOD_2_S(vthread_t thr, vvp_code_t cp)
+{
+      if (! fits_word2(thr))
+	    return of_MOD_S(thr, cp);
+
+      const vvp_vector4_t&rval = thr->peek_vec4(0);
+      long r = sign_word2(rval.get_word2(), rval.size());
+      if (r == 0)
+	    return of_MOD_S(thr, cp);
+
+      thr->pop_vec4(1);
+      vvp_vector4_t&l = thr->peek_vec4();
+
+      if (r == -1)
+	    l.set_word2(0);
+      else
+	    l.set_word2((unsigned long)(sign_word2(l.get_word2(), l.size()) % r));
+      return true;
+}
+
 /*
  * %mod/wr
  */
@@ -4429,6 +4677,22 @@ bool of_MUL(vthread_t thr, vvp_code_t)
       return true;
 }
 
+/*
+ * %mul/2
+ */
+bool of_MUL_2(vthread_t thr, vvp_code_t cp)
+{
+      if (! fits_word2(thr))
+	    return of_MUL(thr, cp);
+
+      unsigned long r = thr->peek_vec4(0).get_word2();
+      thr->pop_vec4(1);
+      vvp_vector4_t&l = thr->peek_vec4();
+
+      l.set_word2(l.get_word2() * r);
+      return true;
+}
+
 /*
  * %muli <vala>, <valb>, <wid>
  *
@@ -6366,6 +6630,22 @@ bool of_SUB(vthread_t thr, vvp_code_t)
       return true;
 }
 
+/*
+ * %sub/2
+ */
+bool of_SUB_2(vthread_t thr, vvp_code_t cp)
+{
+      if (! fits_word2(thr))
+	    return of_SUB(thr, cp);
+
+      unsigned long r = thr->peek_vec4(0).get_word2();
+      thr->pop_vec4(1);
+      vvp_vector4_t&l = thr->peek_vec4();
+
+      l.set_word2(l.get_word2() - r);
+      return true;
+}
+
 /*
  * %subi <vala>, <valb>, <wid>
  *
@@ -6451,10 +6731,163 @@ bool of_SUBSTR_VEC4(vthread_t thr, vvp_code_t cp)
       return true;
 }
 
+/*
+ * Push the low <wid> bits (at most 64) of the value as a vec4.
+ */
+static void push_uint64(vthread_t thr, uint64_t val, unsigned wid)
+{
+      const unsigned bits_per_word = 8*sizeof(unsigned long);
+      unsigned long buf[64 / (8*sizeof(unsigned long))];
+
+      assert(wid <= 64);
+      for (unsigned idx = 0 ; idx*bits_per_word < wid ; idx += 1)
+	    buf[idx] = val >> (idx*bits_per_word);
+
+      vvp_vector4_t res (wid, BIT4_0);
+      res.setarray(0, wid, buf);
+      thr->push_vec4(res);
+}
+
+/*
+ * %sys/countones
+ * %sys/isunknown
+ * %sys/onehot <zero_ok>
+ *
+ * These are intrinsic versions of $countones, $isunknown, $onehot and
+ * $onehot0. The argument is popped from the vec4 stack, and the
+ * result is pushed in its place. $countones returns a 32 bit integer
+ * and the others a single bit. Only 1 bits count, x and z bits do not.
+ */
+bool of_SYS_COUNTONES(vthread_t thr, vvp_code_t)
+{
+      vvp_vector4_t val = thr->pop_vec4();
+
+      uint32_t count = 0;
+      for (unsigned idx = 0 ; idx < val.size() ; idx += 1) {
+	    if (val.value(idx) == BIT4_1)
+		  count += 1;
+      }
+
+      push_uint64(thr, count, 32);
+      return true;
+}
+
+bool of_SYS_ISUNKNOWN(vthread_t thr, vvp_code_t)
+{
+      vvp_vector4_t val = thr->pop_vec4();
+
+      vvp_vector4_t res (1, val.has_xz()? BIT4_1 : BIT4_0);
+      thr->push_vec4(res);
+      return true;
+}
+
+bool of_SYS_ONEHOT(vthread_t thr, vvp_code_t cp)
+{
+      vvp_vector4_t val = thr->pop_vec4();
+
+      unsigned count = 0;
+      for (unsigned idx = 0 ; idx < val.size() && count < 2 ; idx += 1) {
+	    if (val.value(idx) == BIT4_1)
+		  count += 1;
+      }
+
+      bool flag = count == 1 || (count == 0 && cp->number != 0);
+      vvp_vector4_t res (1, flag? BIT4_1 : BIT4_0);
+      thr->push_vec4(res);
+      return true;
+}
+
+/*
+ * %sys/random
+ * %sys/urandom
+ * %sys/urandom_range <nargs>
+ *
+ * These are intrinsic versions of the unseeded $random and $urandom,
+ * and of $urandom_range. The $urandom_range arguments, the maximum
+ * and then the optional minimum, are 32 bit vectors on the stack.
+ * The argument handling matches the vpiIntVal conversion done by the
+ * VPI version, including the order swap.
+ */
+bool of_SYS_RANDOM(vthread_t thr, vvp_code_t)
+{
+      push_uint64(thr, (uint32_t) intrinsic_random(), 32);
+      return true;
+}
+
+bool of_SYS_URANDOM(vthread_t thr, vvp_code_t)
+{
+      push_uint64(thr, (uint32_t) intrinsic_urandom(UINT_MAX, 0), 32);
+      return true;
+}
+
+bool of_SYS_URANDOM_RANGE(vthread_t thr, vvp_code_t cp)
+{
+      int32_t tmp;
+      unsigned long i_maxval, i_minval = 0;
+
+      if (cp->number > 1) {
+	    tmp = 0;
+	    vector4_to_value(thr->pop_vec4(), tmp, false, false);
+	    i_minval = tmp;
+      }
+
+      tmp = 0;
+      vector4_to_value(thr->pop_vec4(), tmp, false, false);
+      i_maxval = tmp;
+
+      if (i_minval > i_maxval) {
+	    unsigned long swap = i_minval;
+	    i_minval = i_maxval;
+	    i_maxval = swap;
+      }
+
+      push_uint64(thr, (uint32_t) intrinsic_urandom(i_maxval, i_minval), 32);
+      return true;
+}
+
+/*
+ * %sys/time
+ * %sys/realtime
+ *
+ * These are intrinsic versions of $time and $realtime. The scope
+ * operand is the module that contains the instruction. It is bound
+ * when the instruction is compiled and gives the time units.
+ */
+bool of_SYS_REALTIME(vthread_t thr, vvp_code_t cp)
+{
+      thr->push_real(vpip_time_to_scaled_real(schedule_simtime(), cp->scope));
+      return true;
+}
+
+bool of_SYS_TIME(vthread_t thr, vvp_code_t cp)
+{
+      vvp_time64_t now = schedule_simtime();
+      int units = cp->scope->time_units;
+      int prec = vpip_get_time_precision();
+
+      vvp_time64_t scale = 1;
+      while (units > prec) {
+	    scale *= 10;
+	    units -= 1;
+      }
+
+	/* Round to the nearest integer, which may be up. */
+      vvp_time64_t frac = now % scale;
+      now /= scale;
+      if ((scale > 1) && (frac >= scale/2))
+	    now += 1;
+
+      push_uint64(thr, now, 64);
+      return true;
+}
+
 bool of_FILE_LINE(vthread_t thr, vvp_code_t cp)
 {
       vpiHandle handle = cp->handle;
 
+      if (cp->bit_idx[0])
+	    coverage_line_hit(cp->bit_idx[0]);
+
 	/* When it is available, keep the file/line information in the
 	   thread for error/warning messages. */
       thr->set_fileline(vpi_get_str(vpiFile, handle),
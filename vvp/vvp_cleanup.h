@@ -29,6 +29,8 @@ extern void codespace_delete(void);
 extern void dec_str_delete(void);
 extern void def_table_delete(void);
 extern void island_delete(void);
+extern void iterator_pool_delete(void);
+extern void array_iterator_pool_delete(void);
 extern void vpi_mcd_delete(void);
 extern void load_module_delete(void);
 extern void modpath_delete(void);
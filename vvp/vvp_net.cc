@@ -194,6 +194,52 @@ vvp_net_t::vvp_net_t()
       fil = 0;
 }
 
+bool vvp_send_memo::enabled_[vvp_send_memo::KIND_COUNT] = { true, true, true };
+unsigned long vvp_send_memo::suppressed_[vvp_send_memo::KIND_COUNT] = { 0, 0, 0 };
+
+static const char*memo_kind_names[vvp_send_memo::KIND_COUNT] = {
+      "arith", "cmp", "concat"
+};
+
+const char* vvp_send_memo::kind_name(unsigned kind)
+{
+      assert(kind < KIND_COUNT);
+      return memo_kind_names[kind];
+}
+
+unsigned long vvp_send_memo::suppressed_total()
+{
+      unsigned long total = 0;
+      for (unsigned idx = 0 ; idx < KIND_COUNT ; idx += 1)
+	    total += suppressed_[idx];
+      return total;
+}
+
+void vvp_send_memo::disable(const char*list)
+{
+      while (*list) {
+	    size_t len = strcspn(list, ",");
+	    bool found = false;
+
+	    for (unsigned idx = 0 ; idx < KIND_COUNT ; idx += 1) {
+		  if ((len == 3 && strncmp(list, "all", 3) == 0)
+		      || (strlen(memo_kind_names[idx]) == len
+			  && strncmp(list, memo_kind_names[idx], len) == 0)) {
+			enabled_[idx] = false;
+			found = true;
+		  }
+	    }
+
+	    if (! found && len > 0)
+		  fprintf(stderr, "Warning: VVP_NO_MEMO: unknown functor "
+			  "kind %.*s.\n", (int)len, list);
+
+	    list += len;
+	    if (*list == ',')
+		  list += 1;
+      }
+}
+
 void vvp_net_t::link(vvp_net_ptr_t port_to_link)
 {
       vvp_net_t*net = port_to_link.ptr();
@@ -1805,6 +1851,79 @@ bool vvp_vector4_t::has_xz() const
       return false;
 }
 
+static inline unsigned count_toggle_bits(unsigned long val)
+{
+      unsigned cnt = 0;
+      while (val) {
+	    val &= val - 1;
+	    cnt += 1;
+      }
+      return cnt;
+}
+
+unsigned vvp_vector4_t::toggle_masks(const vvp_vector4_t&to,
+				     unsigned long*rise,
+				     unsigned long*fall) const
+{
+      assert(size_ == to.size_);
+      if (size_ == 0)
+	    return 0;
+
+	// A bit toggles only if both the old and new values are
+	// 0 or 1 (the bbits are clear) and the abits differ.
+      if (size_ <= BITS_PER_WORD) {
+	    unsigned long mask = -1UL >> (BITS_PER_WORD - size_);
+	    unsigned long known = ~(bbits_val_ | to.bbits_val_) & mask;
+	    unsigned long r = ~abits_val_ &  to.abits_val_ & known;
+	    unsigned long f =  abits_val_ & ~to.abits_val_ & known;
+	    rise[0] |= r;
+	    fall[0] |= f;
+	    return count_toggle_bits(r|f);
+      }
+
+      unsigned cnt = 0;
+      unsigned words = (size_+BITS_PER_WORD-1) / BITS_PER_WORD;
+      for (unsigned idx = 0 ; idx < words ; idx += 1) {
+	    unsigned long mask = -1UL;
+	    if (idx == words-1 && size_%BITS_PER_WORD)
+		  mask >>= BITS_PER_WORD - size_%BITS_PER_WORD;
+	    unsigned long known = ~(bbits_ptr_[idx] | to.bbits_ptr_[idx]) & mask;
+	    unsigned long r = ~abits_ptr_[idx] &  to.abits_ptr_[idx] & known;
+	    unsigned long f =  abits_ptr_[idx] & ~to.abits_ptr_[idx] & known;
+	    rise[idx] |= r;
+	    fall[idx] |= f;
+	    cnt += count_toggle_bits(r|f);
+      }
+
+      return cnt;
+}
+
+unsigned vvp_vector4_t::toggle_masks(unsigned base, const vvp_vector4_t&to,
+				     unsigned long*rise,
+				     unsigned long*fall) const
+{
+      if (base == 0 && to.size_ == size_)
+	    return toggle_masks(to, rise, fall);
+
+      assert(base + to.size_ <= size_);
+      unsigned cnt = 0;
+      for (unsigned idx = 0 ; idx < to.size_ ; idx += 1) {
+	    vvp_bit4_t old_bit = value(base+idx);
+	    vvp_bit4_t new_bit = to.value(idx);
+	    unsigned long mask = 1UL << ((base+idx) % BITS_PER_WORD);
+	    unsigned word = (base+idx) / BITS_PER_WORD;
+	    if (old_bit == BIT4_0 && new_bit == BIT4_1) {
+		  rise[word] |= mask;
+		  cnt += 1;
+	    } else if (old_bit == BIT4_1 && new_bit == BIT4_0) {
+		  fall[word] |= mask;
+		  cnt += 1;
+	    }
+      }
+
+      return cnt;
+}
+
 void vvp_vector4_t::change_z2x()
 {
 	// This method relies on the fact that both BIT4_X and BIT4_Z
@@ -312,6 +312,22 @@ class vvp_vector4_t {
 	// Return true if there is an X or Z anywhere in the vector.
       bool has_xz() const;
 
+	// Get or set the value of a vector that is no wider than a
+	// word as a native 2-state value. X and Z bits read as 0.
+      unsigned long get_word2() const;
+      void set_word2(unsigned long val);
+
+	// OR into the rise/fall masks the bits that make a clean 0->1
+	// or 1->0 transition going from this value to the "to"
+	// value. The masks are arrays of words laid out like the
+	// vector itself. Return the number of bits that toggled.
+      unsigned toggle_masks(const vvp_vector4_t&to,
+			    unsigned long*rise, unsigned long*fall) const;
+	// The same, but the "to" value replaces only the part of this
+	// vector that starts at bit "base".
+      unsigned toggle_masks(unsigned base, const vvp_vector4_t&to,
+			    unsigned long*rise, unsigned long*fall) const;
+
 	// Change all Z bits to X bits.
       void change_z2x();
 
@@ -410,6 +426,24 @@ inline vvp_vector4_t::vvp_vector4_t(unsigned size__, vvp_bit4_t val)
       allocate_words_(init_atable[val], init_btable[val]);
 }
 
+inline unsigned long vvp_vector4_t::get_word2() const
+{
+      assert(size_ > 0 && size_ <= BITS_PER_WORD);
+      unsigned long val = abits_val_ & ~bbits_val_;
+      if (size_ < BITS_PER_WORD)
+	    val &= ~(-1UL << size_);
+      return val;
+}
+
+inline void vvp_vector4_t::set_word2(unsigned long val)
+{
+      assert(size_ > 0 && size_ <= BITS_PER_WORD);
+      if (size_ < BITS_PER_WORD)
+	    val &= ~(-1UL << size_);
+      abits_val_ = val;
+      bbits_val_ = 0;
+}
+
 inline vvp_vector4_t::~vvp_vector4_t()
 {
       if (size_ > BITS_PER_WORD) {
@@ -822,8 +856,10 @@ class vvp_scalar_t {
     private:
 	// This class and the vvp_vector8_t class are closely related,
 	// so allow vvp_vector8_t access to the raw encoding so that
-	// it can do compact vectoring of vvp_scalar_t objects.
+	// it can do compact vectoring of vvp_scalar_t objects. The
+	// partition boundary sends the raw encoding to other processes.
       friend class vvp_vector8_t;
+      friend class vvp_fun_boundary;
       explicit vvp_scalar_t(unsigned char val) : value_(val) { }
       unsigned char raw() const { return value_; }
 
@@ -1078,6 +1114,89 @@ typedef vvp_sub_pointer_t<vvp_net_t> vvp_net_ptr_t;
 template <class T> ostream& operator << (ostream&out, vvp_sub_pointer_t<T> val)
 { out << val.ptr() << "[" << val.port() << "]"; return out; }
 
+/*
+ * Many functors compute a fresh output value each time an input
+ * arrives, and the new output is often the same as the last one. A
+ * functor like that keeps a vvp_send_memo and sends its output with
+ * vvp_net_t::send_vec4_memo, which drops a value that is the same as
+ * the last value sent, so that an unchanged result does not ripple
+ * through the rest of the net. A functor that already holds its
+ * output value can instead pass the "changed" result of updating it.
+ * The output of a functor that drives a net goes through the net
+ * filter, which already drops an unchanged value, so for those the
+ * memo only counts the dropped sends.
+ *
+ * Memoization can be switched off for each kind of functor with the
+ * VVP_NO_MEMO environment variable, a comma separated list of kind
+ * names (or "all"). The suppressed sends are counted for each kind.
+ */
+class vvp_send_memo {
+
+    public:
+      enum kind_t { ARITH = 0, CMP, CONCAT, KIND_COUNT };
+
+      explicit vvp_send_memo(kind_t kind) : kind_(kind), valid_(false) { }
+
+	// Return true if the value must be sent, and remember it.
+      inline bool changed(const vvp_vector4_t&val);
+	// Return true if the value must be sent, given whether the
+	// functor output changed.
+      inline bool changed(bool diff);
+	// Forget the last value.
+      void reset() { valid_ = false; }
+	// Count a send that was dropped elsewhere, for example by a
+	// net filter.
+      inline void dropped();
+
+      static void disable(const char*list);
+      static const char*kind_name(unsigned kind);
+      static unsigned long suppressed(unsigned kind) { return suppressed_[kind]; }
+      static unsigned long suppressed_total();
+
+    private:
+      kind_t kind_;
+      bool valid_;
+      vvp_vector4_t last_;
+
+      static bool enabled_[KIND_COUNT];
+      static unsigned long suppressed_[KIND_COUNT];
+};
+
+inline bool vvp_send_memo::changed(const vvp_vector4_t&val)
+{
+      if (! enabled_[kind_])
+	    return true;
+
+	// set_vec compares and copies in one pass over the words.
+      if (valid_ && last_.size() == val.size()) {
+	    if (last_.set_vec(0, val))
+		  return true;
+	    suppressed_[kind_] += 1;
+	    return false;
+      }
+
+      last_ = val;
+      valid_ = true;
+      return true;
+}
+
+inline void vvp_send_memo::dropped()
+{
+      if (enabled_[kind_])
+	    suppressed_[kind_] += 1;
+}
+
+inline bool vvp_send_memo::changed(bool diff)
+{
+      if (diff || !valid_ || !enabled_[kind_]) {
+	    valid_ = true;
+	    return true;
+      }
+
+      suppressed_[kind_] += 1;
+      return false;
+}
+
 /*
  * This is the basic unit of netlist connectivity. It is a fan-in of
  * up to 4 inputs, and output pointer, and a pointer to the node's
@@ -1135,6 +1254,10 @@ class vvp_net_t {
 
     public: // Methods to propagate output from this node.
       void send_vec4(const vvp_vector4_t&val, vvp_context_t context);
+	// Send the value unless it is the same as the last value sent
+	// through the memo. See vvp_send_memo.
+      void send_vec4_memo(const vvp_vector4_t&val, vvp_send_memo&memo,
+			  vvp_context_t context);
       void send_vec8(const vvp_vector8_t&val);
       void send_real(double val, vvp_context_t context);
       void send_long(long val);
@@ -1311,6 +1434,9 @@ class vvp_net_fil_t  : public vvp_vpi_callback {
 
       virtual unsigned filter_size() const =0;
 
+	// Return true if any bits of the filter are forced.
+      bool is_forced() const { return !test_force_mask_is_zero(); }
+
     public:
 	// Support for force methods. These are called by the
 	// vvp_net_t::force_* methods to set the force value and mask
@@ -1400,6 +1526,7 @@ class vvp_fun_concat  : public vvp_net_fun_t {
     private:
       unsigned wid_[4];
       vvp_vector4_t val_;
+      vvp_send_memo memo_;
 };
 
 class vvp_fun_concat8  : public vvp_net_fun_t {
@@ -1712,6 +1839,43 @@ inline void vvp_net_t::send_vec4(const vvp_vector4_t&val, vvp_context_t context)
       }
 }
 
+inline void vvp_net_t::send_vec4_memo(const vvp_vector4_t&val,
+				      vvp_send_memo&memo,
+				      vvp_context_t context)
+{
+	// Each automatic context has its own output, so the memo only
+	// works for static nodes.
+      if (context) {
+	    memo.reset();
+	    send_vec4(val, context);
+	    return;
+      }
+
+      if (fil == 0) {
+	    if (memo.changed(val))
+		  vvp_send_vec4(out_, val, 0);
+	    return;
+      }
+
+	// The net filter already keeps the driven value and stops a
+	// value that is the same, and the driven value may also be
+	// deposited through VPI, so the filter is the memo here. Only
+	// count the sends that it stops while it is not forced.
+      vvp_vector4_t rep;
+      switch (fil->filter_vec4(val, rep, 0, val.size())) {
+	  case vvp_net_fil_t::STOP:
+	    if (! fil->is_forced())
+		  memo.dropped();
+	    break;
+	  case vvp_net_fil_t::PROP:
+	    vvp_send_vec4(out_, val, 0);
+	    break;
+	  case vvp_net_fil_t::REPL:
+	    vvp_send_vec4(out_, rep, 0);
+	    break;
+      }
+}
+
 inline void vvp_net_t::send_vec4_pv(const vvp_vector4_t&val,
 				    unsigned base, unsigned wid, unsigned vwid,
 				    vvp_context_t context)
@@ -21,6 +21,7 @@
 # include  "vvp_net.h"
 # include  "vvp_net_sig.h"
 # include  "statistics.h"
+# include  "coverage.h"
 # include  "vpi_priv.h"
 # include  <vector>
 # include  <cassert>
@@ -937,6 +938,130 @@ vvp_net_fil_t::prop_t vvp_wire_vec4::filter_vec8(const vvp_vector8_t&bit,
       return filter_mask_(bit, vvp_vector8_t(force4_,6,6), rep, base);
 }
 
+vvp_wire_vec4_cov::vvp_wire_vec4_cov(unsigned wid, vvp_bit4_t init,
+				     coverage_toggle_s*cov)
+: vvp_wire_vec4(wid, init), cov_(cov)
+{
+}
+
+/*
+ * The toggles are counted on the driven value, before the filter
+ * stores the new value, by comparing the new value with the part of
+ * the driven value that it replaces. That way there is no copy of the
+ * old value for each write.
+ */
+vvp_net_fil_t::prop_t vvp_wire_vec4_cov::filter_vec4(const vvp_vector4_t&bit,
+						     vvp_vector4_t&rep,
+						     unsigned base,
+						     unsigned vwid)
+{
+      cov_->toggles += driven_vec4_().toggle_masks(base, bit,
+						   cov_->rise, cov_->fall);
+      return vvp_wire_vec4::filter_vec4(bit, rep, base, vwid);
+}
+
+vvp_net_fil_t::prop_t vvp_wire_vec4_cov::filter_vec8(const vvp_vector8_t&bit,
+						     vvp_vector8_t&rep,
+						     unsigned base,
+						     unsigned vwid)
+{
+      cov_->toggles += driven_vec4_().toggle_masks(base, reduce4(bit),
+						   cov_->rise, cov_->fall);
+      return vvp_wire_vec4::filter_vec8(bit, rep, base, vwid);
+}
+
+vvp_wire_vec2::vvp_wire_vec2(unsigned wid)
+: vvp_wire_vec4(wid, BIT4_0)
+{
+}
+
+static inline vvp_vector4_t vec2_value(const vvp_vector4_t&bit)
+{
+      return vector2_to_vector4(vvp_vector2_t(bit), bit.size());
+}
+
+vvp_net_fil_t::prop_t vvp_wire_vec2::filter_vec4(const vvp_vector4_t&bit,
+						 vvp_vector4_t&rep,
+						 unsigned base,
+						 unsigned vwid)
+{
+	// Values from the 2-state instructions never have X or Z
+	// bits, so this is the usual path.
+      if (! bit.has_xz())
+	    return vvp_wire_vec4::filter_vec4(bit, rep, base, vwid);
+
+      vvp_vector4_t tmp = vec2_value(bit);
+      prop_t rc = vvp_wire_vec4::filter_vec4(tmp, rep, base, vwid);
+      if (rc == PROP) {
+	    rep = tmp;
+	    rc = REPL;
+      }
+      return rc;
+}
+
+vvp_net_fil_t::prop_t vvp_wire_vec2::filter_vec8(const vvp_vector8_t&bit,
+						 vvp_vector8_t&rep,
+						 unsigned base,
+						 unsigned vwid)
+{
+      vvp_vector4_t bit4 (reduce4(bit));
+      if (! bit4.has_xz())
+	    return vvp_wire_vec4::filter_vec8(bit, rep, base, vwid);
+
+      vvp_vector8_t tmp (vec2_value(bit4), 6, 6);
+      prop_t rc = vvp_wire_vec4::filter_vec8(tmp, rep, base, vwid);
+      if (rc == PROP) {
+	    rep = tmp;
+	    rc = REPL;
+      }
+      return rc;
+}
+
+void vvp_wire_vec2::force_fil_vec4(const vvp_vector4_t&val,
+				   const vvp_vector2_t&mask)
+{
+      if (val.has_xz())
+	    vvp_wire_vec4::force_fil_vec4(vec2_value(val), mask);
+      else
+	    vvp_wire_vec4::force_fil_vec4(val, mask);
+}
+
+vvp_wire_vec2_cov::vvp_wire_vec2_cov(unsigned wid, coverage_toggle_s*cov)
+: vvp_wire_vec2(wid), cov_(cov)
+{
+}
+
+/*
+ * The 2-state filter stores X and Z bits as 0, so count the toggles
+ * against the value that is stored.
+ */
+vvp_net_fil_t::prop_t vvp_wire_vec2_cov::filter_vec4(const vvp_vector4_t&bit,
+						     vvp_vector4_t&rep,
+						     unsigned base,
+						     unsigned vwid)
+{
+      if (bit.has_xz())
+	    cov_->toggles += driven_vec4_().toggle_masks(base, vec2_value(bit),
+							 cov_->rise, cov_->fall);
+      else
+	    cov_->toggles += driven_vec4_().toggle_masks(base, bit,
+							 cov_->rise, cov_->fall);
+      return vvp_wire_vec2::filter_vec4(bit, rep, base, vwid);
+}
+
+vvp_net_fil_t::prop_t vvp_wire_vec2_cov::filter_vec8(const vvp_vector8_t&bit,
+						     vvp_vector8_t&rep,
+						     unsigned base,
+						     unsigned vwid)
+{
+      vvp_vector4_t bit4 (reduce4(bit));
+      if (bit4.has_xz())
+	    bit4 = vec2_value(bit4);
+      cov_->toggles += driven_vec4_().toggle_masks(base, bit4,
+						   cov_->rise, cov_->fall);
+      return vvp_wire_vec2::filter_vec8(bit, rep, base, vwid);
+}
+
 unsigned vvp_wire_vec4::filter_size() const
 {
       return bits4_.size();
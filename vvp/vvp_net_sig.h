@@ -453,6 +453,9 @@ class vvp_wire_vec4 : public vvp_wire_base {
       vvp_bit4_t driven_value(unsigned idx) const;
       bool is_forced(unsigned idx) const;
 
+    protected:
+      const vvp_vector4_t& driven_vec4_() const { return bits4_; }
+
     private:
       vvp_bit4_t filtered_value_(unsigned idx) const;
 
@@ -462,6 +465,65 @@ class vvp_wire_vec4 : public vvp_wire_base {
       vvp_vector4_t force4_; // the value being forced
 };
 
+/*
+ * This is a vvp_wire_vec4 that also collects toggle coverage. It is
+ * only used for the signals of scopes that are selected for coverage
+ * (see coverage.h) so that all the other signals pay nothing.
+ */
+class vvp_wire_vec4_cov : public vvp_wire_vec4 {
+
+    public:
+      vvp_wire_vec4_cov(unsigned wid, vvp_bit4_t init,
+			struct coverage_toggle_s*cov);
+
+      prop_t filter_vec4(const vvp_vector4_t&bit, vvp_vector4_t&rep,
+			 unsigned base, unsigned vwid);
+      prop_t filter_vec8(const vvp_vector8_t&val, vvp_vector8_t&rep,
+			 unsigned base, unsigned vwid);
+
+    private:
+      struct coverage_toggle_s*cov_;
+};
+
+/*
+ * This is the filter for static 2-state variables (bit, byte, int,
+ * ...). The X and Z bits of any value that is written or forced into
+ * the variable are turned into 0, so the variable only ever holds and
+ * propagates 2-state values. That is what lets the 2-state thread
+ * instructions skip the X/Z handling.
+ */
+class vvp_wire_vec2 : public vvp_wire_vec4 {
+
+    public:
+      explicit vvp_wire_vec2(unsigned wid);
+
+      prop_t filter_vec4(const vvp_vector4_t&bit, vvp_vector4_t&rep,
+			 unsigned base, unsigned vwid);
+      prop_t filter_vec8(const vvp_vector8_t&val, vvp_vector8_t&rep,
+			 unsigned base, unsigned vwid);
+
+      void force_fil_vec4(const vvp_vector4_t&val, const vvp_vector2_t&mask);
+};
+
+/*
+ * This is the vvp_wire_vec2 for 2-state variables in covered scopes.
+ * The toggle counting sits on top of the 2-state filter, so turning
+ * coverage on does not change the values the variable can hold.
+ */
+class vvp_wire_vec2_cov : public vvp_wire_vec2 {
+
+    public:
+      vvp_wire_vec2_cov(unsigned wid, struct coverage_toggle_s*cov);
+
+      prop_t filter_vec4(const vvp_vector4_t&bit, vvp_vector4_t&rep,
+			 unsigned base, unsigned vwid);
+      prop_t filter_vec8(const vvp_vector8_t&val, vvp_vector8_t&rep,
+			 unsigned base, unsigned vwid);
+
+    private:
+      struct coverage_toggle_s*cov_;
+};
+
 class vvp_wire_vec8 : public vvp_wire_base {
 
     public:
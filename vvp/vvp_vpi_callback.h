@@ -50,6 +50,10 @@ class vvp_vpi_callback {
 	// vpi to get at the vvp value of the object.
       virtual void get_value(struct t_vpi_value*value) =0;
 
+	// Run the callbacks of a value change made while the constants
+	// settled. See schedule_settled_callbacks().
+      void run_settled_callbacks() { run_vpi_callbacks(); }
+
     protected:
 	// Derived classes call this method to indicate that it is
 	// time to call the callback.
@@ -21,8 +21,11 @@
 # include  "vpi_priv.h"
 # include  "array.h"
 # include  "vvp_net_sig.h"
+# include  "coverage.h"
 # include  "logic.h"
 # include  "schedule.h"
+# include  "permaheap.h"
+# include  "statistics.h"
 #ifdef CHECK_WITH_VALGRIND
 # include  "vvp_cleanup.h"
 #endif
@@ -170,6 +173,89 @@ void compile_var_cobject(char*label, char*name)
       delete[] name;
 }
 
+/*
+ * A static variable is normally three objects, the vvp_net_t, the
+ * signal functor and the filter, each allocated from its own heap. A
+ * design with many small variables then touches three scattered
+ * cache lines for every read or write. So static variables are made
+ * as a single object with the three parts laid out together. The
+ * value bits of a vector that fits in a word are inline in the
+ * vvp_vector4_t members, so they are in the same object too.
+ *
+ * The fused object has the same functor and filter as an unfused
+ * variable, so force, release and %cassign still work. It is not
+ * used for automatic variables, which have no filter, or for
+ * variables that collect toggle coverage.
+ */
+template <class FIL> struct fused_var_s {
+      explicit fused_var_s(unsigned wid)
+      : fun(wid, BIT4_0), fil(wid) { link(); }
+      fused_var_s(unsigned wid, vvp_bit4_t init)
+      : fun(wid), fil(wid, init) { link(); }
+
+      void link() { net.fun = &fun; net.fil = &fil; }
+
+      vvp_net_t net;
+      vvp_fun_signal4_sa fun;
+      FIL fil;
+
+    private: // not implemented
+      fused_var_s(const fused_var_s&);
+      fused_var_s& operator= (const fused_var_s&);
+};
+
+#ifndef CHECK_WITH_VALGRIND
+/* The valgrind cleanup deletes the parts of a net one at a time, so
+   the fused objects are only used without it. */
+static permaheap fused_var_heap;
+# define FUSED_VARS 1
+#else
+# define FUSED_VARS 0
+#endif
+
+static vvp_net_t* make_fused_var4(unsigned wid, vvp_bit4_t init)
+{
+#if FUSED_VARS
+      typedef fused_var_s<vvp_wire_vec4> var_t;
+      void*mem = fused_var_heap.alloc(sizeof(var_t));
+      var_t*var = new (mem) var_t(wid, init);
+      count_vvp_nets += 1;
+      count_fused_vars += 1;
+      return &var->net;
+#else
+      vvp_net_t*net = new vvp_net_t;
+      net->fil = new vvp_wire_vec4(wid, init);
+      net->fun = new vvp_fun_signal4_sa(wid);
+      return net;
+#endif
+}
+
+static vvp_net_t* make_fused_var2(unsigned wid)
+{
+#if FUSED_VARS
+      typedef fused_var_s<vvp_wire_vec2> var_t;
+      void*mem = fused_var_heap.alloc(sizeof(var_t));
+      var_t*var = new (mem) var_t(wid);
+      count_vvp_nets += 1;
+      count_fused_vars += 1;
+      return &var->net;
+#else
+      vvp_net_t*net = new vvp_net_t;
+      net->fil = new vvp_wire_vec2(wid);
+      net->fun = new vvp_fun_signal4_sa(wid, BIT4_0);
+      return net;
+#endif
+}
+
+size_t fused_var_heap_total()
+{
+#if FUSED_VARS
+      return fused_var_heap.heap_total();
+#else
+      return 0;
+#endif
+}
+
 /*
  * A variable is a special functor, so we allocate that functor and
  * write the label into the symbol table.
@@ -180,18 +266,29 @@ void compile_variable(char*label, char*name,
 {
       unsigned wid = ((msb > lsb)? msb-lsb : lsb-msb) + 1;
 
-      vvp_net_t*net = new vvp_net_t;
+      vvp_net_t*net;
 
-      if (vpip_peek_current_scope()->is_automatic()) {
+      __vpiScope*scope = vpip_peek_current_scope();
+      if (scope->is_automatic()) {
+	    net = new vvp_net_t;
 	    vvp_fun_signal4_aa*tmp = new vvp_fun_signal4_aa(wid);
 	    net->fil = tmp;
             net->fun = tmp;
-      } else if (vpi_type_code == vpiIntVar) {
-	    net->fil = new vvp_wire_vec4(wid, BIT4_0);
+      } else if (coverage_scope_p(scope) && vpi_type_code == vpiIntVar) {
+	    net = new vvp_net_t;
+	    net->fil = coverage_make_wire_vec2(scope, local_flag? 0 : name,
+					       wid);
+            net->fun = new vvp_fun_signal4_sa(wid, BIT4_0);
+      } else if (coverage_scope_p(scope)) {
+	    net = new vvp_net_t;
+	    net->fil = coverage_make_wire_vec4(scope, local_flag? 0 : name,
+					       wid, BIT4_X);
             net->fun = new vvp_fun_signal4_sa(wid);
+      } else if (vpi_type_code == vpiIntVar) {
+	      // 2-state variables keep to 2-state values.
+	    net = make_fused_var2(wid);
       } else {
-	    net->fil = new vvp_wire_vec4(wid, BIT4_X);
-            net->fun = new vvp_fun_signal4_sa(wid);
+	    net = make_fused_var4(wid, BIT4_X);
       }
       vvp_signal_value*vfil = dynamic_cast<vvp_signal_value*>(net->fil);
 
@@ -332,12 +429,14 @@ static void do_compile_net(vvp_net_t*node, vvp_array_t array,
       vvp_wire_base*vsig = dynamic_cast<vvp_wire_base*>(node->fil);
 
       if (vsig == 0) {
+	      // Array words and local nets are not covered.
+	    const char*cov_name = (array || local_flag)? 0 : name;
 	    switch (vpi_type_code) {
 		case vpiIntVar:
-		  vsig = new vvp_wire_vec4(wid,BIT4_0);
+		  vsig = coverage_make_wire_vec4(scope, cov_name, wid, BIT4_0);
 		  break;
 		case vpiLogicVar:
-		  vsig = new vvp_wire_vec4(wid,BIT4_Z);
+		  vsig = coverage_make_wire_vec4(scope, cov_name, wid, BIT4_Z);
 		  break;
 		case -vpiLogicVar:
 		  vsig = new vvp_wire_vec8(wid);